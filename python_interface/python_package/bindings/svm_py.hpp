@@ -63,6 +63,11 @@ class py_svm : public pyda_handle {
         exception_check(status);
         status = da_options_set(handle, "max_iter", max_iter);
         exception_check(status);
+        // The Python classes solve the same problems as LIBSVM, with a free intercept,
+        // which the dual coordinate descent solver for the linear kernel does not
+        std::string solver = "smo";
+        status = da_options_set(handle, "solver", solver.c_str());
+        exception_check(status);
         if (check_data == true) {
             std::string yes_str = "yes";
             status = da_options_set(handle, "check data", yes_str.data());
@@ -39,12 +39,11 @@
 #include "pairwise_distances.hpp"
 #include "radius_neighbors.hpp"
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <random>
-#include <set>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 namespace ARCH {
 
@@ -52,39 +51,37 @@ namespace da_dbscan {
 
 using namespace da_dbscan_types;
 
-/* Utility function to add a rule in an unordered map. Recursively searches for rules with the same
-   key and updates them accordingly. */
-inline void add_to_label_map(std::unordered_map<da_int, da_int> &map, da_int key,
-                             da_int value) {
-    // Try to insert the key_value pair into the map
-    if (value >= key)
-        return;
-
-    auto [it, inserted] = map.emplace(key, value);
-    if (!inserted) {
-        // A map with that key already exists, so update the value with minimum
-        std::pair<da_int, da_int> tmp_values = std::minmax(it->second, value);
-        it->second = tmp_values.first;
-        // Recursively update the rest of the map: add a map to correct the larger value
-        add_to_label_map(map, tmp_values.second, tmp_values.first);
+/* Find the root of x in the concurrent union-find forest parent, halving the path on the
+   way. Parents only ever decrease, so a failed compare-and-swap just means that another
+   thread has already shortened the path. */
+inline da_int uf_find(std::atomic<da_int> *parent, da_int x) {
+    da_int p = parent[x].load();
+    while (p != x) {
+        da_int gp = parent[p].load();
+        if (gp != p)
+            parent[x].compare_exchange_weak(p, gp);
+        x = gp;
+        p = parent[x].load();
     }
-    return;
+    return x;
 }
 
-/* Utility function to merge unordered maps, keeping minimum values of duplicate keys.
-   Used in parallel DBSCAN loop. */
-inline void merge_unordered_maps(std::unordered_map<da_int, da_int> &map1,
-                                 std::unordered_map<da_int, da_int> &map2) {
-    //std::unordered_map<da_int, da_int> result = map1;
-    for (const auto &[key, value] : map2) {
-        //auto [it, inserted] = map1.emplace(key, value);
-        //if (!inserted) {
-        // key already exists so update value with minimum
-        //  it->second = std::min(it->second, value);
-        //}
-        add_to_label_map(map1, key, value);
+/* Merge the trees of x and y in the concurrent union-find forest parent. The larger root is
+   always linked to the smaller one, so that each tree ends up rooted at its smallest index
+   whatever the order in which the threads link them. */
+inline void uf_union(std::atomic<da_int> *parent, da_int x, da_int y) {
+    while (true) {
+        x = uf_find(parent, x);
+        y = uf_find(parent, y);
+        if (x == y)
+            return;
+        if (x < y)
+            std::swap(x, y);
+        // Fails if x has been linked by another thread since it was found to be a root
+        da_int root = x;
+        if (parent[x].compare_exchange_strong(root, y))
+            return;
     }
-    return;
 }
 
 template <typename T> dbscan<T>::~dbscan() {
@@ -237,6 +234,8 @@ template <typename T> da_status dbscan<T>::compute() {
 
     this->opts.get("leaf size", leaf_size);
 
+    this->opts.get("max memory", max_memory);
+
     this->opts.get("power", p);
 
     std::string opt_tmp;
@@ -261,7 +260,6 @@ template <typename T> da_status dbscan<T>::compute() {
         labels.resize(
             n_samples,
             NOISE); // Initialize to NOISE to indicate that the point has not been assigned to a cluster
-        neighbors.resize(n_samples);
     } catch (std::bad_alloc const &) {
         return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
@@ -269,7 +267,8 @@ template <typename T> da_status dbscan<T>::compute() {
 
     // Form in neighbors the list of indices within the epsilon neighborhood of each sample point
     status = da_radius_neighbors::radius_neighbors(n_samples, n_features, A, lda, eps,
-                                                   neighbors, this->err);
+                                                   max_memory, neighbors_offsets,
+                                                   neighbors_indices, this->err);
     if (status != da_status_success)
         return da_error(this->err, status, // LCOV_EXCL_LINE
                         "Failed to compute radius neighbors prior to clustering.");
@@ -291,6 +290,12 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
 
     // Work with min_samples - 1 since we are not counting points as being in their own neighbourhood
     da_int min_samples_m1 = min_samples - 1;
+    const da_int *offsets = neighbors_offsets.data();
+    const da_int *indices = neighbors_indices.data();
+
+    // Discard the results of any previous computation
+    n_clusters = 0;
+    core_sample_indices.clear();
 
     if (algorithm == brute_serial || omp_get_max_threads() == 1) {
         da_std::fill(labels.begin(), labels.end(), UNVISITED);
@@ -305,7 +310,7 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
                     continue;
 
                 // Find the neighbors of the current sample
-                if ((da_int)neighbors[i].size() < min_samples_m1) {
+                if (offsets[i + 1] - offsets[i] < min_samples_m1) {
                     //Epsilon neighborhood is too small to form a cluster; label as noise
                     labels[i] = NOISE;
                 } else {
@@ -315,7 +320,8 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
 
                     da_vector::da_vector<da_int> search_indices;
                     // The epsilon neighbors of this point form the start of our search vector
-                    search_indices.append(neighbors[i]);
+                    search_indices.append(indices + offsets[i],
+                                          offsets[i + 1] - offsets[i]);
 
                     for (da_int j = 0; j < (da_int)search_indices.size(); j++) {
                         da_int neigh = search_indices[j];
@@ -331,9 +337,10 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
 
                         labels[neigh] = n_clusters;
 
-                        if ((da_int)neighbors[neigh].size() >= min_samples_m1) {
+                        if (offsets[neigh + 1] - offsets[neigh] >= min_samples_m1) {
                             // This point is also a core sample point so mark it as such and add its neighbors to the search vector
-                            search_indices.append(neighbors[neigh]);
+                            search_indices.append(indices + offsets[neigh],
+                                                 offsets[neigh + 1] - offsets[neigh]);
                             core_sample_indices.push_back(neigh);
                         }
                     }
@@ -347,125 +354,83 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
         }
 
     } else {
-
-        std::unordered_map<da_int, da_int> label_map;
-
-#pragma omp declare reduction(                                                           \
-        merge_unordered_maps_red : std::unordered_map<                                   \
-                da_int, da_int> : merge_unordered_maps(omp_out, omp_in))                 \
-    initializer(omp_priv = omp_orig)
+        // Parallel labelling: the core samples within eps of each other are merged in a
+        // lock-free union-find forest, in which each cluster is rooted at its smallest core
+        // sample. Border samples then join the cluster of their first core neighbor.
+        std::vector<std::atomic<da_int>> parent;
+        std::vector<da_int> cluster_ids;
+        try {
+            parent = std::vector<std::atomic<da_int>>(n_samples);
+            cluster_ids.resize(n_samples);
+        } catch (std::bad_alloc const &) {                      // LCOV_EXCL_LINE
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        std::atomic<da_int> *uf_parent = parent.data();
 
 #pragma omp parallel default(none)                                                       \
-    shared(labels, neighbors, n_clusters, n_core_samples, core_sample_indices,           \
-               min_samples_m1, n_samples, status, label_map)
+    shared(labels, offsets, indices, uf_parent, min_samples_m1, n_samples)
         {
-            bool local_failure = false;
-
-            da_vector::da_vector<da_int> local_core_sample_indices;
+#pragma omp for schedule(static)
+            for (da_int i = 0; i < n_samples; i++)
+                uf_parent[i].store(i);
 
-            try {
-// Parallel loop to compute DBSCAN clusters
-#pragma omp for schedule(dynamic, 32) reduction(merge_unordered_maps_red : label_map)    \
-    nowait
-                for (da_int i = 0; i < n_samples; i++) {
-                    if ((da_int)neighbors[i].size() >= min_samples_m1) {
-                        // This is a core point
-                        da_int tmp_label_i;
-#pragma omp atomic read
-                        tmp_label_i = labels[i];
-                        if (i < tmp_label_i || tmp_label_i == NOISE) {
-#pragma omp atomic write
-                            // Assign it it's own index as the cluster label - we will combine clusters later
-                            labels[i] = i;
-                        }
-                        // Record that it's a core sample point
-                        local_core_sample_indices.push_back(i);
-                        // Loop through each point in the epsilon neighborhood of point i
-                        for (da_int j = 0; j < (da_int)neighbors[i].size(); j++) {
-                            da_int sample_point_j = neighbors[i][j];
-                            da_int tmp_label_j;
-#pragma omp atomic read
-                            tmp_label_j = labels[sample_point_j];
-                            // Record that i and j are in the same cluster
-                            std::pair<da_int, da_int> key_value_tmp =
-                                std::minmax(i, sample_point_j);
-                            // Add this pair to the label map to deal with duplicate cluster labels
-                            add_to_label_map(label_map, key_value_tmp.second,
-                                             key_value_tmp.first);
-
-                            if (i < tmp_label_j || tmp_label_j == NOISE) {
-#pragma omp atomic write
-                                labels[sample_point_j] = i;
-                            }
-                        }
-                    }
+            // Each edge between two core samples is seen from both ends, link it once
+#pragma omp for schedule(dynamic, 32)
+            for (da_int i = 0; i < n_samples; i++) {
+                if (offsets[i + 1] - offsets[i] < min_samples_m1)
+                    continue;
+                for (da_int j = offsets[i]; j < offsets[i + 1]; j++) {
+                    da_int neigh = indices[j];
+                    if (neigh < i && offsets[neigh + 1] - offsets[neigh] >= min_samples_m1)
+                        uf_union(uf_parent, i, neigh);
                 }
+            }
 
-#pragma omp critical
-                { core_sample_indices.append(local_core_sample_indices); }
-            } catch (std::bad_alloc const &) {
-                local_failure = true; // LCOV_EXCL_LINE
+#pragma omp for schedule(static)
+            for (da_int i = 0; i < n_samples; i++) {
+                if (offsets[i + 1] - offsets[i] >= min_samples_m1)
+                    labels[i] = uf_find(uf_parent, i);
             }
-#pragma omp barrier
-            if (!local_failure) {
-                try {
-#pragma omp for schedule(dynamic, 32)
-                    for (da_int i = 0; i < n_samples; i++) {
-                        da_int current_label = labels[i];
-                        if (current_label == NOISE) {
-                            continue;
-                        }
 
-                        auto it = label_map.find(current_label);
-                        while (it != label_map.end()) {
-                            current_label = it->second;
-                            it = label_map.find(current_label);
-                        }
-                        labels[i] = current_label;
+            // Border samples: the neighbors are sorted, so this picks the core neighbor
+            // with the smallest index
+#pragma omp for schedule(dynamic, 32)
+            for (da_int i = 0; i < n_samples; i++) {
+                if (offsets[i + 1] - offsets[i] >= min_samples_m1)
+                    continue;
+                da_int label = NOISE;
+                for (da_int j = offsets[i]; j < offsets[i + 1]; j++) {
+                    da_int neigh = indices[j];
+                    if (offsets[neigh + 1] - offsets[neigh] >= min_samples_m1) {
+                        label = labels[neigh];
+                        break;
                     }
-                } catch (std::bad_alloc const &) {
-                    local_failure = true;
                 }
+                labels[i] = label;
             }
-            if (local_failure)
-                status = da_status_memory_error;
         }
 
-        if (status == da_status_memory_error)
+        // Number the clusters by increasing smallest core sample, as the serial algorithm
+        // does, and record the core samples
+        try {
+            for (da_int i = 0; i < n_samples; i++) {
+                if (offsets[i + 1] - offsets[i] >= min_samples_m1) {
+                    core_sample_indices.push_back(i);
+                    if (labels[i] == i)
+                        cluster_ids[i] = n_clusters++;
+                }
+            }
+        } catch (std::bad_alloc const &) {                      // LCOV_EXCL_LINE
             return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                             "Memory allocation failed.");
-    }
-
-    // Record how many distinct clusters and how many core samples we have and form a new map for relabeling
-    n_core_samples = core_sample_indices.size();
-    std::sort(&core_sample_indices[0], &core_sample_indices[0] + n_core_samples);
-    std::set<da_int> unique_labels;
-
-    try {
-        for (auto &label : labels) {
-            if (label != NOISE)
-                unique_labels.insert(label);
         }
-    } catch (std::bad_alloc const &) {
-        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
-                        "Memory allocation failed.");
-    }
-    n_clusters = unique_labels.size();
-
-    std::unordered_map<da_int, da_int> relabel_map;
 
-    // This map is because labels may not be named 0, 1, 2, etc
-    da_int label_count = 0;
-    for (const auto &label : unique_labels) {
-        relabel_map[label] = label_count++;
-    }
-
-#pragma omp parallel for default(none) schedule(dynamic, 32)                             \
-    shared(relabel_map, labels, n_samples)
-    for (da_int i = 0; i < n_samples; i++) {
-        auto it = relabel_map.find(labels[i]);
-        if (it != relabel_map.end()) {
-            labels[i] = it->second;
+#pragma omp parallel for default(none) schedule(static)                                  \
+    shared(labels, cluster_ids, n_samples)
+        for (da_int i = 0; i < n_samples; i++) {
+            if (labels[i] != NOISE)
+                labels[i] = cluster_ids[labels[i]];
         }
     }
 
@@ -474,6 +439,10 @@ template <typename T> da_status dbscan<T>::dbscan_clusters() {
                         "Memory allocation failed.");
     }
 
+    // The core samples are found in search order by the serial algorithm
+    n_core_samples = core_sample_indices.size();
+    std::sort(core_sample_indices.data(), core_sample_indices.data() + n_core_samples);
+
     return da_status_success;
 }
 
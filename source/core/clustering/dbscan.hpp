@@ -68,6 +68,7 @@ template <typename T> class dbscan : public basic_handle<T> {
     T eps = 0.5;
     da_int min_samples = 5;
     da_int leaf_size = 30;
+    da_int max_memory = 0;
     T p = 2.0;
 
     da_int algorithm = brute;
@@ -83,8 +84,9 @@ template <typename T> class dbscan : public basic_handle<T> {
     std::vector<da_int> labels;
 
     // Internal arrays
-    std::vector<da_vector::da_vector<da_int>>
-        neighbors; // Use da_vector since we will be dynamically expanding this array
+    // Epsilon neighborhoods in CSR format: the neighbors of sample i are
+    // neighbors_indices[neighbors_offsets[i]], ..., neighbors_indices[neighbors_offsets[i+1]-1]
+    std::vector<da_int> neighbors_offsets, neighbors_indices;
 
     da_status dbscan_clusters();
 
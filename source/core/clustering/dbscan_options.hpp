@@ -56,6 +56,13 @@ inline da_status register_dbscan_options(da_options::OptionRegistry &opts,
             1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
             30));
         opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "max memory",
+            "Maximum memory, in megabytes, used by the blocks of pairwise distances "
+            "computed at once during the neighborhood search. If 0, a default block size "
+            "is used.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 0));
+        opts.register_opt(oi);
         std::shared_ptr<OptionString> os;
         os = std::make_shared<OptionString>(
             OptionString("algorithm", "Choice of algorithm (reserved for future use).",
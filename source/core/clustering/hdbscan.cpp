@@ -0,0 +1,730 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "hdbscan.hpp"
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "da_omp.hpp"
+#include "hdbscan_options.hpp"
+#include "hdbscan_types.hpp"
+#include "macros.h"
+#include "pairwise_distances.hpp"
+#include "radius_neighbors.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace ARCH {
+
+namespace da_hdbscan {
+
+using namespace da_hdbscan_types;
+
+/* Find the root of x in a union-find structure, with path halving */
+inline da_int uf_find(std::vector<da_int> &parent, da_int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/* Lambda value (inverse distance) at which a node of the single linkage tree splits */
+inline double lambda_value(double distance) {
+    return distance > 0 ? 1.0 / distance : std::numeric_limits<double>::infinity();
+}
+
+template <typename T> hdbscan<T>::~hdbscan() {
+    // Destructor needs to handle arrays that were allocated due to row major storage of input data
+    if (A_temp)
+        delete[] (A_temp);
+}
+
+template <typename T>
+hdbscan<T>::hdbscan(da_errors::da_error_t &err) : basic_handle<T>(err) {
+    // Initialize the options registry
+    // Any error is stored err->status[.] and this needs to be checked
+    // by the caller.
+    register_hdbscan_options<T>(this->opts, *this->err);
+};
+
+template <typename T>
+da_status hdbscan<T>::get_result(da_result query, da_int *dim, T *result) {
+    // Don't return anything if HDBSCAN has not been computed
+    if (!iscomputed) {
+        return da_warn(this->err, da_status_no_data,
+                       "HDBSCAN clustering has not yet been computed. Please call "
+                       "da_hdbscan_compute_s "
+                       "or da_hdbscan_compute_d before extracting results.");
+    }
+
+    da_int rinfo_size = 6;
+    da_int n_merges = n_samples - 1;
+
+    switch (query) {
+    case da_result::da_rinfo:
+        if (*dim < rinfo_size) {
+            *dim = rinfo_size;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(rinfo_size) + ".");
+        }
+        result[0] = (T)n_samples;
+        result[1] = (T)n_features;
+        result[2] = (T)lda_in;
+        result[3] = (T)min_samples;
+        result[4] = (T)min_cluster_size;
+        result[5] = (T)n_clusters;
+        break;
+    case da_result::da_hdbscan_probabilities:
+        if (*dim < n_samples) {
+            *dim = n_samples;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(n_samples) + ".");
+        }
+        for (da_int i = 0; i < n_samples; i++)
+            result[i] = probabilities[i];
+        break;
+    case da_result::da_hdbscan_core_distances:
+        if (*dim < n_samples) {
+            *dim = n_samples;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(n_samples) + ".");
+        }
+        for (da_int i = 0; i < n_samples; i++)
+            result[i] = core_distances[i];
+        break;
+    case da_result::da_hdbscan_single_linkage_tree:
+        if (*dim < 4 * n_merges) {
+            *dim = 4 * n_merges;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(4 * n_merges) + ".");
+        }
+        // (n_samples - 1) x 4 matrix stored in column-major order
+        for (da_int k = 0; k < n_merges; k++) {
+            result[k] = (T)slt_left[k];
+            result[k + n_merges] = (T)slt_right[k];
+            result[k + 2 * n_merges] = slt_distance[k];
+            result[k + 3 * n_merges] = (T)slt_size[k];
+        }
+        break;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+    return da_status_success;
+};
+
+template <typename T>
+da_status hdbscan<T>::get_result(da_result query, da_int *dim, da_int *result) {
+    // Don't return anything if HDBSCAN has not been computed
+    if (!iscomputed) {
+        return da_warn(this->err, da_status_no_data,
+                       "HDBSCAN clustering has not yet been computed. Please call "
+                       "da_hdbscan_compute_s "
+                       "or da_hdbscan_compute_d before extracting results.");
+    }
+
+    switch (query) {
+    case da_result::da_hdbscan_labels:
+        if (*dim < n_samples) {
+            *dim = n_samples;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(n_samples) + ".");
+        }
+        for (da_int i = 0; i < n_samples; i++)
+            result[i] = labels[i];
+        break;
+    case da_result::da_hdbscan_n_clusters:
+        *result = n_clusters;
+        break;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+
+    return da_status_success;
+};
+
+template <typename T> void hdbscan<T>::refresh() {
+    if (A_temp) {
+        delete[] (A_temp);
+        A_temp = nullptr;
+    }
+    iscomputed = false;
+}
+
+/* Store details about user's data matrix in preparation for HDBSCAN computation */
+template <typename T>
+da_status hdbscan<T>::set_data(da_int n_samples, da_int n_features, const T *A_in,
+                               da_int lda_in) {
+
+    // Guard against errors due to multiple calls using the same class instantiation
+    refresh();
+
+    da_status status =
+        this->store_2D_array(n_samples, n_features, A_in, lda_in, &A_temp, &A, lda,
+                             "n_samples", "n_features", "A", "lda");
+    if (status != da_status_success)
+        return status;
+
+    // Store dimensions of A
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->lda_in = lda_in;
+
+    // Record that initialization is complete but computation has not yet been performed
+    initdone = true;
+    iscomputed = false;
+
+    return da_status_success;
+}
+
+/* Core distance of each sample: distance to its (min_samples - 1)-th nearest neighbor */
+template <typename T> da_status hdbscan<T>::compute_core_distances() {
+    da_int k = min_samples - 1;
+    try {
+        core_distances.assign(n_samples, (T)0);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    if (k == 0)
+        return da_status_success;
+
+    da_int block_size =
+        da_radius_neighbors::distance_block_size(n_samples, max_memory, sizeof(T));
+    da_int n_blocks, block_rem;
+    ARCH::da_utils::blocking_scheme(n_samples, block_size, n_blocks, block_rem);
+    da_int n_threads = ARCH::da_utils::get_n_threads_loop(n_blocks);
+
+    std::vector<T> D, A_norms, heaps;
+    std::vector<da_int> heap_sizes;
+    try {
+        D.resize(block_size * block_size * n_threads);
+        heaps.resize(block_size * k * n_threads);
+        heap_sizes.resize(block_size * n_threads);
+        A_norms.resize(n_samples, (T)0);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int j = 0; j < n_features; j++) {
+        for (da_int i = 0; i < n_samples; i++) {
+            A_norms[i] += A[i + j * lda] * A[i + j * lda];
+        }
+    }
+
+    // Each thread handles a block of rows and keeps, for each row, a max-heap of the k
+    // smallest squared distances to the other samples
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic) default(none)           \
+    shared(n_blocks, block_size, block_rem, k, D, heaps, heap_sizes, A_norms)
+    for (da_int block_i = 0; block_i < n_blocks; block_i++) {
+        da_int this_thread = omp_get_thread_num();
+        T *D_thread = &D[this_thread * block_size * block_size];
+        T *heap_thread = &heaps[this_thread * block_size * k];
+        da_int i0 = block_i * block_size;
+        da_int m = (block_i == n_blocks - 1 && block_rem > 0) ? block_rem : block_size;
+        da_int *heap_size = &heap_sizes[this_thread * block_size];
+        for (da_int ii = 0; ii < m; ii++)
+            heap_size[ii] = 0;
+        for (da_int block_j = 0; block_j < n_blocks; block_j++) {
+            da_int j0 = block_j * block_size;
+            da_int n =
+                (block_j == n_blocks - 1 && block_rem > 0) ? block_rem : block_size;
+            ARCH::euclidean_distance(da_order::column_major, m, n, n_features, &A[i0],
+                                     lda, &A[j0], lda, D_thread, block_size,
+                                     &A_norms[i0], 1, &A_norms[j0], 1, true, false);
+            for (da_int ii = 0; ii < m; ii++) {
+                T *heap = &heap_thread[ii * k];
+                for (da_int jj = 0; jj < n; jj++) {
+                    if (i0 + ii == j0 + jj)
+                        continue;
+                    T d = std::max(D_thread[ii + jj * block_size], (T)0);
+                    if (heap_size[ii] < k) {
+                        heap[heap_size[ii]++] = d;
+                        std::push_heap(heap, heap + heap_size[ii]);
+                    } else if (d < heap[0]) {
+                        std::pop_heap(heap, heap + k);
+                        heap[k - 1] = d;
+                        std::push_heap(heap, heap + k);
+                    }
+                }
+            }
+        }
+        for (da_int ii = 0; ii < m; ii++)
+            core_distances[i0 + ii] = std::sqrt(heap_thread[ii * k]);
+    }
+
+    return da_status_success;
+}
+
+/* Minimum spanning tree of the mutual reachability graph, where the weight of the edge
+ * (i, j) is max(core_distances[i], core_distances[j], ||A_i - A_j||), computed with
+ * Boruvka's algorithm: in each round, every component is joined to its nearest component.
+ * The mutual reachability distances are computed on the fly, tile by tile, so that the
+ * dense graph is never stored. Ties are broken on the sample indices so that the edge
+ * weights are effectively distinct.
+ */
+template <typename T>
+da_status hdbscan<T>::minimum_spanning_tree(std::vector<da_int> &edge_i,
+                                            std::vector<da_int> &edge_j,
+                                            std::vector<T> &edge_w) {
+    da_int block_size =
+        da_radius_neighbors::distance_block_size(n_samples, max_memory, sizeof(T));
+    da_int n_blocks, block_rem;
+    ARCH::da_utils::blocking_scheme(n_samples, block_size, n_blocks, block_rem);
+    da_int n_threads = ARCH::da_utils::get_n_threads_loop(n_blocks);
+
+    std::vector<T> D, A_norms, core_sq, best_w, comp_w;
+    std::vector<da_int> comp, parent, best_j, comp_i, comp_j, block_comp;
+    try {
+        D.resize(block_size * block_size * n_threads);
+        A_norms.resize(n_samples, (T)0);
+        core_sq.resize(n_samples);
+        best_w.resize(n_samples);
+        best_j.resize(n_samples);
+        comp.resize(n_samples);
+        parent.resize(n_samples);
+        comp_w.resize(n_samples);
+        comp_i.resize(n_samples);
+        comp_j.resize(n_samples);
+        block_comp.resize(n_blocks);
+        edge_i.reserve(n_samples - 1);
+        edge_j.reserve(n_samples - 1);
+        edge_w.reserve(n_samples - 1);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int j = 0; j < n_features; j++) {
+        for (da_int i = 0; i < n_samples; i++) {
+            A_norms[i] += A[i + j * lda] * A[i + j * lda];
+        }
+    }
+    for (da_int i = 0; i < n_samples; i++) {
+        core_sq[i] = core_distances[i] * core_distances[i];
+        comp[i] = i;
+        parent[i] = i;
+    }
+
+    T inf = std::numeric_limits<T>::infinity();
+    da_int n_components = n_samples;
+    while (n_components > 1) {
+        // Tiles whose rows and columns all lie in the same component can be skipped
+        for (da_int b = 0; b < n_blocks; b++) {
+            da_int i0 = b * block_size;
+            da_int m = (b == n_blocks - 1 && block_rem > 0) ? block_rem : block_size;
+            block_comp[b] = comp[i0];
+            for (da_int i = i0 + 1; i < i0 + m; i++) {
+                if (comp[i] != block_comp[b]) {
+                    block_comp[b] = -1;
+                    break;
+                }
+            }
+        }
+
+        // For each sample, find the nearest sample in another component
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic) default(none)           \
+    shared(n_blocks, block_size, block_rem, D, A_norms, core_sq, comp, block_comp,        \
+               best_w, best_j, inf)
+        for (da_int block_i = 0; block_i < n_blocks; block_i++) {
+            da_int this_thread = omp_get_thread_num();
+            T *D_thread = &D[this_thread * block_size * block_size];
+            da_int i0 = block_i * block_size;
+            da_int m =
+                (block_i == n_blocks - 1 && block_rem > 0) ? block_rem : block_size;
+            for (da_int i = i0; i < i0 + m; i++) {
+                best_w[i] = inf;
+                best_j[i] = -1;
+            }
+            for (da_int block_j = 0; block_j < n_blocks; block_j++) {
+                if (block_comp[block_i] >= 0 &&
+                    block_comp[block_i] == block_comp[block_j])
+                    continue;
+                da_int j0 = block_j * block_size;
+                da_int n =
+                    (block_j == n_blocks - 1 && block_rem > 0) ? block_rem : block_size;
+                ARCH::euclidean_distance(da_order::column_major, m, n, n_features,
+                                         &A[i0], lda, &A[j0], lda, D_thread, block_size,
+                                         &A_norms[i0], 1, &A_norms[j0], 1, true, false);
+                for (da_int jj = 0; jj < n; jj++) {
+                    da_int j = j0 + jj;
+                    for (da_int ii = 0; ii < m; ii++) {
+                        da_int i = i0 + ii;
+                        if (comp[i] == comp[j])
+                            continue;
+                        T w = std::max(D_thread[ii + jj * block_size], core_sq[i]);
+                        w = std::max(w, core_sq[j]);
+                        // Columns are visited in increasing order: ties keep the smallest j
+                        if (w < best_w[i]) {
+                            best_w[i] = w;
+                            best_j[i] = j;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Cheapest outgoing edge of each component
+        for (da_int i = 0; i < n_samples; i++)
+            comp_j[i] = -1;
+        for (da_int i = 0; i < n_samples; i++) {
+            da_int c = comp[i], j = best_j[i];
+            if (j < 0)
+                continue;
+            da_int lo = std::min(i, j), hi = std::max(i, j);
+            bool better = comp_j[c] < 0 || best_w[i] < comp_w[c];
+            if (!better && best_w[i] == comp_w[c]) {
+                da_int clo = std::min(comp_i[c], comp_j[c]);
+                da_int chi = std::max(comp_i[c], comp_j[c]);
+                better = lo < clo || (lo == clo && hi < chi);
+            }
+            if (better) {
+                comp_w[c] = best_w[i];
+                comp_i[c] = i;
+                comp_j[c] = j;
+            }
+        }
+
+        // Merge the components along their cheapest edges
+        da_int n_merged = 0;
+        for (da_int c = 0; c < n_samples; c++) {
+            if (comp[c] != c || comp_j[c] < 0)
+                continue;
+            da_int ri = uf_find(parent, comp_i[c]), rj = uf_find(parent, comp_j[c]);
+            if (ri == rj)
+                continue;
+            parent[std::max(ri, rj)] = std::min(ri, rj);
+            edge_i.push_back(comp_i[c]);
+            edge_j.push_back(comp_j[c]);
+            edge_w.push_back(std::sqrt(comp_w[c]));
+            n_merged++;
+        }
+        if (n_merged == 0)
+            return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Failed to compute the minimum spanning tree.");
+        n_components -= n_merged;
+        for (da_int i = 0; i < n_samples; i++)
+            comp[i] = uf_find(parent, i);
+    }
+
+    return da_status_success;
+}
+
+/* Sort the edges of the minimum spanning tree and merge them into the single linkage tree */
+template <typename T>
+da_status hdbscan<T>::single_linkage_tree(std::vector<da_int> &edge_i,
+                                          std::vector<da_int> &edge_j,
+                                          std::vector<T> &edge_w) {
+    da_int n_merges = n_samples - 1;
+    std::vector<da_int> order, parent, node;
+    try {
+        order.resize(n_merges);
+        parent.resize(n_samples);
+        node.resize(n_samples);
+        slt_left.resize(n_merges);
+        slt_right.resize(n_merges);
+        slt_size.resize(n_merges);
+        slt_distance.resize(n_merges);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&edge_w](da_int a, da_int b) { return edge_w[a] < edge_w[b]; });
+    std::iota(parent.begin(), parent.end(), 0);
+    // node[r] is the single linkage tree node of the component with root r
+    std::iota(node.begin(), node.end(), 0);
+
+    for (da_int k = 0; k < n_merges; k++) {
+        da_int e = order[k];
+        da_int ri = uf_find(parent, edge_i[e]), rj = uf_find(parent, edge_j[e]);
+        da_int left = node[ri], right = node[rj];
+        slt_left[k] = std::min(left, right);
+        slt_right[k] = std::max(left, right);
+        slt_distance[k] = edge_w[e];
+        slt_size[k] = (left < n_samples ? 1 : slt_size[left - n_samples]) +
+                      (right < n_samples ? 1 : slt_size[right - n_samples]);
+        parent[rj] = ri;
+        node[ri] = n_samples + k;
+    }
+
+    return da_status_success;
+}
+
+/* Condense the single linkage tree with respect to min_cluster_size, then select the
+ * clusters with the excess of mass or leaf method and label the samples
+ */
+template <typename T> da_status hdbscan<T>::extract_clusters() {
+    da_int n_merges = n_samples - 1;
+    auto node_size = [this](da_int node) {
+        return node < n_samples ? (da_int)1 : slt_size[node - n_samples];
+    };
+
+    // Condensed tree: cluster 0 is the root, the clusters have larger indices than their
+    // parents. Each sample records the cluster it falls out of and the lambda at which
+    // it does
+    std::vector<da_int> cl_parent, cl_size, cl_selected, cl_label, point_cluster;
+    std::vector<double> cl_birth, cl_lambda_sum, cl_stability, cl_children_stability;
+    std::vector<double> point_lambda, cl_max_lambda;
+    std::vector<std::pair<da_int, da_int>> stack, leaves;
+    try {
+        point_cluster.assign(n_samples, 0);
+        point_lambda.assign(n_samples, 0.0);
+        labels.assign(n_samples, -1);
+        probabilities.assign(n_samples, (T)0);
+        cl_parent.push_back(-1);
+        cl_size.push_back(n_samples);
+        cl_birth.push_back(0.0);
+        cl_lambda_sum.push_back(0.0);
+        if (n_merges > 0)
+            stack.push_back({2 * n_samples - 2, 0});
+
+        while (!stack.empty()) {
+            auto [nd, cl] = stack.back();
+            stack.pop_back();
+            da_int k = nd - n_samples;
+            double lambda = lambda_value((double)slt_distance[k]);
+            da_int children[2] = {slt_left[k], slt_right[k]};
+            bool split = node_size(children[0]) >= min_cluster_size &&
+                         node_size(children[1]) >= min_cluster_size;
+            for (da_int child : children) {
+                da_int size = node_size(child);
+                if (split) {
+                    // Both children are large enough: they are new clusters
+                    cl_parent.push_back(cl);
+                    cl_size.push_back(size);
+                    cl_birth.push_back(lambda);
+                    cl_lambda_sum.push_back(0.0);
+                    cl_lambda_sum[cl] += lambda * size;
+                    stack.push_back({child, (da_int)cl_parent.size() - 1});
+                } else if (size >= min_cluster_size) {
+                    // The cluster cl continues in this child
+                    stack.push_back({child, cl});
+                } else {
+                    // All the samples of the child fall out of cl
+                    cl_lambda_sum[cl] += lambda * size;
+                    leaves.push_back({child, 0});
+                    while (!leaves.empty()) {
+                        da_int leaf = leaves.back().first;
+                        leaves.pop_back();
+                        if (leaf < n_samples) {
+                            point_cluster[leaf] = cl;
+                            point_lambda[leaf] = lambda;
+                        } else {
+                            leaves.push_back({slt_left[leaf - n_samples], 0});
+                            leaves.push_back({slt_right[leaf - n_samples], 0});
+                        }
+                    }
+                }
+            }
+        }
+
+        da_int n_cl = (da_int)cl_parent.size();
+        cl_stability.resize(n_cl);
+        cl_children_stability.assign(n_cl, 0.0);
+        cl_selected.assign(n_cl, 0);
+        cl_label.assign(n_cl, -1);
+        cl_max_lambda.assign(n_cl, 0.0);
+        std::vector<da_int> has_children(n_cl, 0);
+        for (da_int c = 1; c < n_cl; c++)
+            has_children[cl_parent[c]] = 1;
+        for (da_int c = 0; c < n_cl; c++)
+            cl_stability[c] = cl_lambda_sum[c] - cl_birth[c] * cl_size[c];
+
+        // Bottom-up selection; the root is never selected
+        for (da_int c = n_cl - 1; c > 0; c--) {
+            if (selection_method == leaf) {
+                cl_selected[c] = !has_children[c];
+            } else if (has_children[c] &&
+                       cl_children_stability[c] > cl_stability[c]) {
+                cl_stability[c] = cl_children_stability[c];
+            } else {
+                cl_selected[c] = 1;
+            }
+            cl_children_stability[cl_parent[c]] += cl_stability[c];
+        }
+
+        // Top-down: clusters below a selected cluster are part of it
+        n_clusters = 0;
+        for (da_int c = 1; c < n_cl; c++) {
+            da_int p = cl_parent[c];
+            if (cl_label[p] >= 0)
+                cl_label[c] = cl_label[p];
+            else if (cl_selected[c])
+                cl_label[c] = n_clusters++;
+        }
+        std::vector<da_int> label_cluster(n_clusters);
+        for (da_int c = 1; c < n_cl; c++) {
+            if (cl_selected[c] && (cl_label[cl_parent[c]] < 0))
+                label_cluster[cl_label[c]] = c;
+        }
+
+        // Labels, and membership probabilities relative to the densest sample of the cluster
+        for (da_int i = 0; i < n_samples; i++) {
+            da_int c = point_cluster[i];
+            labels[i] = cl_label[c];
+            if (labels[i] >= 0) {
+                da_int sel = label_cluster[labels[i]];
+                cl_max_lambda[sel] = std::max(cl_max_lambda[sel], point_lambda[i]);
+            }
+        }
+        for (da_int i = 0; i < n_samples; i++) {
+            if (labels[i] < 0)
+                continue;
+            double max_lambda = cl_max_lambda[label_cluster[labels[i]]];
+            if (max_lambda == 0.0 || !std::isfinite(point_lambda[i]))
+                probabilities[i] = (T)1;
+            else
+                probabilities[i] =
+                    (T)(std::min(point_lambda[i], max_lambda) / max_lambda);
+        }
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    return da_status_success;
+}
+
+/* Compute the HDBSCAN clusters */
+template <typename T> da_status hdbscan<T>::compute() {
+
+    da_status status = da_status_success;
+    if (initdone == false)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Please call "
+                        "da_hdbscan_set_data_s or da_hdbscan_set_data_d.");
+
+    // Read in options and store in class
+    this->opts.get("min samples", min_samples);
+    this->opts.get("min cluster size", min_cluster_size);
+    this->opts.get("max memory", max_memory);
+    std::string opt_tmp;
+    this->opts.get("cluster selection method", opt_tmp, selection_method);
+
+    if (min_samples > n_samples) {
+        return da_error(this->err, da_status_incompatible_options,
+                        "The option 'min samples' must not exceed the number of "
+                        "samples, " +
+                            std::to_string(n_samples) + ".");
+    }
+
+    iscomputed = false;
+    std::vector<da_int> edge_i, edge_j;
+    std::vector<T> edge_w;
+
+    status = compute_core_distances();
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    status = minimum_spanning_tree(edge_i, edge_j, edge_w);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    status = single_linkage_tree(edge_i, edge_j, edge_w);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    status = extract_clusters();
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    iscomputed = true;
+
+    return status;
+}
+
+/* DBSCAN* labels for a given eps: the connected components of the samples whose core
+ * distance is at most eps, linked by the edges of the minimum spanning tree of weight at
+ * most eps. Clusters are numbered in order of their first sample and border samples are
+ * labelled as noise.
+ */
+template <typename T>
+da_status hdbscan<T>::dbscan_labels(T eps, da_int n_labels, da_int *labels_out) {
+    if (!iscomputed) {
+        return da_error(this->err, da_status_no_data,
+                        "HDBSCAN clustering has not yet been computed. Please call "
+                        "da_hdbscan_compute_s or da_hdbscan_compute_d first.");
+    }
+    if (labels_out == nullptr)
+        return da_error(this->err, da_status_invalid_pointer, "labels is not valid.");
+    if (n_labels < n_samples)
+        return da_error(this->err, da_status_invalid_array_dimension,
+                        "n_samples must be at least " + std::to_string(n_samples) +
+                            ", the number of samples used to compute the clustering.");
+    if (eps < 0 || std::isnan(eps))
+        return da_error(this->err, da_status_invalid_input,
+                        "eps must be nonnegative.");
+
+    std::vector<da_int> parent, root_label;
+    try {
+        parent.resize(2 * n_samples - 1);
+        root_label.assign(2 * n_samples - 1, -1);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    std::iota(parent.begin(), parent.end(), 0);
+    // The merges are sorted by distance
+    for (da_int k = 0; k < n_samples - 1 && slt_distance[k] <= eps; k++) {
+        parent[slt_left[k]] = n_samples + k;
+        parent[slt_right[k]] = n_samples + k;
+    }
+
+    da_int n_labelled = 0;
+    for (da_int i = 0; i < n_samples; i++) {
+        if (core_distances[i] > eps) {
+            labels_out[i] = -1;
+            continue;
+        }
+        da_int root = uf_find(parent, i);
+        if (root_label[root] < 0)
+            root_label[root] = n_labelled++;
+        labels_out[i] = root_label[root];
+    }
+
+    return da_status_success;
+}
+
+template class hdbscan<double>;
+template class hdbscan<float>;
+
+} // namespace da_hdbscan
+
+} // namespace ARCH
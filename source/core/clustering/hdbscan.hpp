@@ -0,0 +1,119 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "aoclda.h"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "hdbscan_types.hpp"
+#include "macros.h"
+#include <string>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_hdbscan {
+
+using namespace da_hdbscan_types;
+
+/* HDBSCAN class
+ *
+ * The clusters are extracted from the minimum spanning tree of the mutual reachability
+ * graph, so that the whole hierarchy of DBSCAN* clusterings (for all values of eps) is
+ * available after a single computation.
+ */
+template <typename T> class hdbscan : public basic_handle<T> {
+  public:
+    ~hdbscan();
+
+  private:
+    da_int n_samples = 0;
+    da_int n_features = 0;
+
+    // Set true when initialization is complete
+    bool initdone = false;
+
+    // Set true when hdbscan clustering is computed successfully
+    bool iscomputed = false;
+
+    // User's data
+    const T *A = nullptr;
+    da_int lda = 0;
+    da_int lda_in = 0;
+
+    // Utility pointer to column major allocated copy of user's data
+    T *A_temp = nullptr;
+
+    // Options
+    da_int min_samples = 5;
+    da_int min_cluster_size = 5;
+    da_int max_memory = 0;
+    da_int selection_method = eom;
+
+    // Scalar outputs
+    da_int n_clusters = 0;
+
+    // Arrays containing output data
+    std::vector<da_int> labels;
+    std::vector<T> probabilities;
+    std::vector<T> core_distances;
+
+    // Single linkage tree of the mutual reachability graph: row k merges the nodes
+    // slt_left[k] and slt_right[k] (samples are nodes 0 to n_samples-1, row k creates
+    // node n_samples+k) at distance slt_distance[k] into a cluster of slt_size[k] samples
+    std::vector<da_int> slt_left, slt_right, slt_size;
+    std::vector<T> slt_distance;
+
+    da_status compute_core_distances();
+    da_status minimum_spanning_tree(std::vector<da_int> &edge_i,
+                                    std::vector<da_int> &edge_j, std::vector<T> &edge_w);
+    da_status single_linkage_tree(std::vector<da_int> &edge_i,
+                                  std::vector<da_int> &edge_j, std::vector<T> &edge_w);
+    da_status extract_clusters();
+
+  public:
+    hdbscan(da_errors::da_error_t &err);
+
+    da_status get_result(da_result query, da_int *dim, T *result);
+
+    da_status get_result(da_result query, da_int *dim, da_int *result);
+
+    void refresh();
+
+    /* Store details about user's data matrix in preparation for HDBSCAN computation */
+    da_status set_data(da_int n_samples, da_int n_features, const T *A_in, da_int lda_in);
+
+    /* Compute the HDBSCAN clusters */
+    da_status compute();
+
+    /* Labels of the DBSCAN* clustering for a given eps, from the single linkage tree */
+    da_status dbscan_labels(T eps, da_int n_samples, da_int *labels);
+};
+
+} // namespace da_hdbscan
+
+} // namespace ARCH
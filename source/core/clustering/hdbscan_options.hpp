@@ -0,0 +1,84 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "aoclda_types.h"
+#include "da_error.hpp"
+#include "hdbscan_types.hpp"
+#include "macros.h"
+#include "options.hpp"
+
+#include <limits>
+
+namespace ARCH {
+
+namespace da_hdbscan {
+
+using namespace da_hdbscan_types;
+
+template <class T>
+inline da_status register_hdbscan_options(da_options::OptionRegistry &opts,
+                                          da_errors::da_error_t &err) {
+    using namespace da_options;
+    da_int imax = std::numeric_limits<da_int>::max();
+
+    try {
+        std::shared_ptr<OptionNumeric<da_int>> oi;
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "min samples",
+            "Number of neighborhood samples, including the sample itself, defining the "
+            "core distance of a sample.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 5));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "min cluster size", "Minimum number of samples in a cluster.", 2,
+            da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 5));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "max memory",
+            "Maximum memory, in megabytes, used by the blocks of pairwise distances "
+            "computed at once. If 0, a default block size is used.",
+            0, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 0));
+        opts.register_opt(oi);
+        std::shared_ptr<OptionString> os;
+        os = std::make_shared<OptionString>(OptionString(
+            "cluster selection method",
+            "Method used to select the clusters from the condensed cluster tree.",
+            {{"eom", eom}, {"leaf", leaf}}, "eom"));
+        opts.register_opt(os);
+
+    } catch (std::bad_alloc &) {
+        return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    } catch (...) { // LCOV_EXCL_LINE
+        // Invalid use of the constructor, shouldn't happen (invalid_argument)
+        return da_error(&err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "Unexpected error while registering options");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_hdbscan
+
+} // namespace ARCH
@@ -0,0 +1,142 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "hdbscan_public.hpp"
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "da_store_data.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+
+using namespace hdbscan_public;
+
+da_status da_hdbscan_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
+                                const double *A, da_int lda) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (hdbscan_set_data<da_hdbscan::hdbscan<double>, double>(
+                   handle, n_samples, n_features, A, lda)));
+}
+
+da_status da_hdbscan_set_data_s(da_handle handle, da_int n_samples, da_int n_features,
+                                const float *A, da_int lda) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err, return (hdbscan_set_data<da_hdbscan::hdbscan<float>, float>(
+                                handle, n_samples, n_features, A, lda)));
+}
+
+da_status da_hdbscan_set_data_from_store_d(da_handle handle, da_datastore store,
+                                           const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx) {
+            return da_hdbscan_set_data_d(handle, n_samples, n_features, X, ldx);
+        });
+}
+
+da_status da_hdbscan_set_data_from_store_s(da_handle handle, da_datastore store,
+                                           const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx) {
+            return da_hdbscan_set_data_s(handle, n_samples, n_features, X, ldx);
+        });
+}
+
+da_status da_hdbscan_compute_d(da_handle handle) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than double.");
+    DISPATCHER(handle->err,
+               return (hdbscan_compute<da_hdbscan::hdbscan<double>, double>(handle)));
+}
+
+da_status da_hdbscan_compute_s(da_handle handle) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than single.");
+    DISPATCHER(handle->err,
+               return (hdbscan_compute<da_hdbscan::hdbscan<float>, float>(handle)));
+}
+
+da_status da_hdbscan_dbscan_labels_d(da_handle handle, double eps, da_int n_samples,
+                                     da_int *labels) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than double.");
+    DISPATCHER(handle->err,
+               return (hdbscan_dbscan_labels<da_hdbscan::hdbscan<double>, double>(
+                   handle, eps, n_samples, labels)));
+}
+
+da_status da_hdbscan_dbscan_labels_s(da_handle handle, float eps, da_int n_samples,
+                                     da_int *labels) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than single.");
+    DISPATCHER(handle->err,
+               return (hdbscan_dbscan_labels<da_hdbscan::hdbscan<float>, float>(
+                   handle, eps, n_samples, labels)));
+}
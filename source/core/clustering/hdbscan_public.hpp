@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+
+namespace hdbscan_public {
+
+template <typename hdbscan_class, typename T>
+da_status hdbscan_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                           const T *A, da_int lda) {
+    hdbscan_class *hdbscan = dynamic_cast<hdbscan_class *>(handle->get_alg_handle<T>());
+    if (hdbscan == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with "
+                        "handle_type=da_handle_hdbscan or handle is invalid.");
+
+    return hdbscan->set_data(n_samples, n_features, A, lda);
+}
+
+template <typename hdbscan_class, typename T>
+da_status hdbscan_compute(da_handle handle) {
+    hdbscan_class *hdbscan = dynamic_cast<hdbscan_class *>(handle->get_alg_handle<T>());
+    if (hdbscan == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with "
+                        "handle_type=da_handle_hdbscan or handle is invalid.");
+
+    return hdbscan->compute();
+}
+
+template <typename hdbscan_class, typename T>
+da_status hdbscan_dbscan_labels(da_handle handle, T eps, da_int n_samples,
+                                da_int *labels) {
+    hdbscan_class *hdbscan = dynamic_cast<hdbscan_class *>(handle->get_alg_handle<T>());
+    if (hdbscan == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with "
+                        "handle_type=da_handle_hdbscan or handle is invalid.");
+
+    return hdbscan->dbscan_labels(eps, n_samples, labels);
+}
+
+} // namespace hdbscan_public
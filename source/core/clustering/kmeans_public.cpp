@@ -24,6 +24,7 @@
 #include "kmeans_public.hpp"
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_store_data.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -55,6 +56,38 @@ da_status da_kmeans_set_data_s(da_handle handle, da_int n_samples, da_int n_feat
                                 handle, n_samples, n_features, A, lda)));
 }
 
+da_status da_kmeans_set_data_from_store_d(da_handle handle, da_datastore store,
+                                          const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const double *A, da_int lda) {
+            return da_kmeans_set_data_d(handle, n_samples, n_features, A, lda);
+        });
+}
+
+da_status da_kmeans_set_data_from_store_s(da_handle handle, da_datastore store,
+                                          const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const float *A, da_int lda) {
+            return da_kmeans_set_data_s(handle, n_samples, n_features, A, lda);
+        });
+}
+
 da_status da_kmeans_set_init_centres_d(da_handle handle, const double *C, da_int ldc) {
     if (!handle)
         return da_status_handle_not_initialized;
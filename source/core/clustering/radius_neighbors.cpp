@@ -25,47 +25,110 @@
 #include "aoclda.h"
 #include "da_error.hpp"
 #include "da_omp.hpp"
-#include "da_vector.hpp"
 #include "macros.h"
 #include "pairwise_distances.hpp"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #define RADIUS_NEIGHBORS_BLOCK_SIZE da_int(128)
+#define RADIUS_NEIGHBORS_MIN_BLOCK_SIZE da_int(8)
 
 namespace ARCH {
 
 namespace da_radius_neighbors {
 
-using neighbors_t = std::vector<da_vector::da_vector<da_int>>;
+/*
+Size of the square tiles of pairwise distances computed at once by each thread, such that
+all the tiles fit in max_memory megabytes (the default size is used if max_memory is 0)
+*/
+da_int distance_block_size(da_int n_samples, da_int max_memory, size_t type_size) {
+    da_int block_size = RADIUS_NEIGHBORS_BLOCK_SIZE;
+    if (max_memory > 0) {
+        double max_bytes = (double)max_memory * 1024.0 * 1024.0;
+        block_size = (da_int)std::sqrt(
+            max_bytes / ((double)omp_get_max_threads() * (double)type_size));
+        block_size = std::max(block_size, RADIUS_NEIGHBORS_MIN_BLOCK_SIZE);
+    }
+    return std::max(std::min(block_size, n_samples), (da_int)1);
+}
+
+/*
+Scan the tile D of squared distances between the samples [i0, i0 + m) and [j0, j0 + n)
+and count, for each row and column of the tile, the number of pairs within the radius.
+For diagonal tiles, only the strict upper triangle is referenced.
+*/
+template <typename T>
+static void count_tile(da_int m, da_int n, const T *D, da_int ldd, T eps_squared,
+                       bool diagonal_block, da_int *row_count, da_int *col_count) {
+    for (da_int ii = 0; ii < m; ii++)
+        row_count[ii] = 0;
+    for (da_int jj = 0; jj < n; jj++) {
+        da_int ii_max = diagonal_block ? jj : m;
+        da_int count = 0;
+        for (da_int ii = 0; ii < ii_max; ii++) {
+            if (D[ii + ldd * jj] <= eps_squared) {
+                row_count[ii] += 1;
+                count += 1;
+            }
+        }
+        col_count[jj] = count;
+    }
+}
 
 /*
 Compute the radius neighbors: for each sample point, the indices of the samples within a given
-radius are returned. The brute-force method is used.
+radius are returned in compressed sparse row format, that is the neighbors of sample i are
+indices[offsets[i]], ..., indices[offsets[i+1]-1], sorted in increasing order.
+
+The brute-force method is used. The squared distances are computed tile by tile with the
+gemm-based Euclidean distance kernel, exploiting the symmetry of the problem, and the neighbors
+are gathered in two passes over the tiles: the first one counts the neighbors of each sample,
+so that the offsets are known and the indices array can be allocated once, and the second one
+recomputes the tiles and writes the indices directly in their final location. Each thread only
+holds one tile of distances at a time; max_memory (in megabytes, 0 for the default) bounds the
+total size of these tiles.
 */
 template <typename T>
 da_status radius_neighbors(da_int n_samples, da_int n_features, const T *A, da_int lda,
-                           T eps, std::vector<da_vector::da_vector<da_int>> &neighbors,
-                           da_errors::da_error_t *err) {
+                           T eps, da_int max_memory, std::vector<da_int> &offsets,
+                           std::vector<da_int> &indices, da_errors::da_error_t *err) {
 
-    // 2D blocking scheme and threading scheme
-    da_int max_block_size = std::min(RADIUS_NEIGHBORS_BLOCK_SIZE, n_samples);
+    // 2D blocking scheme; the tile size is chosen from the memory bound, if given
+    da_int max_block_size = distance_block_size(n_samples, max_memory, sizeof(T));
 
     da_int block_rem, n_blocks;
     ARCH::da_utils::blocking_scheme(n_samples, max_block_size, n_blocks, block_rem);
 
-    da_int n_threads = ARCH::da_utils::get_n_threads_loop(n_blocks * n_blocks);
+    // List the tiles (block_i, block_j), block_i <= block_j, of the upper triangle
+    da_int n_tiles = n_blocks * (n_blocks + 1) / 2;
+    da_int n_threads = ARCH::da_utils::get_n_threads_loop(n_tiles);
 
     std::vector<T> D, A_norms;
+    std::vector<da_int> tiles, counts, cursor;
     T eps_squared = eps * eps;
+    da_int ldd = max_block_size;
 
     try {
         D.resize(max_block_size * max_block_size * n_threads);
-        A_norms.resize(n_samples);
+        counts.resize(2 * max_block_size * n_threads);
+        A_norms.resize(n_samples, (T)0);
+        tiles.resize(2 * n_tiles);
+        offsets.assign(n_samples + 1, 0);
+        cursor.resize(n_samples);
     } catch (std::bad_alloc const &) {
         return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
-    da_int ldd = max_block_size;
+
+    da_int tile = 0;
+    for (da_int block_j = 0; block_j < n_blocks; block_j++) {
+        for (da_int block_i = 0; block_i <= block_j; block_i++) {
+            tiles[2 * tile] = block_i;
+            tiles[2 * tile + 1] = block_j;
+            tile++;
+        }
+    }
 
     // Precompute the row norms of A to speed up Euclidean distance computation
     for (da_int j = 0; j < n_features; j++) {
@@ -76,114 +139,139 @@ da_status radius_neighbors(da_int n_samples, da_int n_features, const T *A, da_i
 
     da_int threading_error = 0;
 
-    // Local storage for neighbors to help avoid thread contention
-    std::vector<neighbors_t> neighbors_local(n_threads);
-
+    // Pass 0 counts the neighbors of each sample, pass 1 writes their indices
+    for (da_int pass = 0; pass < 2; pass++) {
 #pragma omp parallel num_threads(n_threads) default(none)                                \
-    shared(threading_error, neighbors, max_block_size, n_samples, D, A, A_norms,         \
-               block_rem, ldd, lda, eps_squared, n_blocks, n_features, neighbors_local)
-    {
+    shared(max_block_size, n_samples, D, A, A_norms, block_rem, ldd, lda, eps_squared,   \
+               n_blocks, n_features, n_tiles, tiles, counts, offsets, indices, cursor,     \
+               pass, threading_error)
+        {
+            da_int this_thread = omp_get_thread_num();
+            T *D_thread = &D[this_thread * max_block_size * max_block_size];
+            da_int *row_count = &counts[2 * this_thread * max_block_size];
+            da_int *col_count = row_count + max_block_size;
 
-        // Thread 0 can write to neighbors; all other threads need to use neighbors_local
-        da_int this_thread = omp_get_thread_num();
-        if (this_thread > 0) {
-            try {
-                neighbors_local[this_thread].resize(n_samples);
-            } catch (std::bad_alloc const &) {
-#pragma omp atomic write
-                threading_error = 1;
-            }
-        }
+#pragma omp for schedule(dynamic)
+            for (da_int t = 0; t < n_tiles; t++) {
+                da_int block_i = tiles[2 * t], block_j = tiles[2 * t + 1];
+                da_int i0 = block_i * max_block_size;
+                da_int j0 = block_j * max_block_size;
+                da_int block_size_dim1 = max_block_size;
+                if (block_i == n_blocks - 1 && block_rem > 0)
+                    block_size_dim1 = block_rem;
+                da_int block_size_dim2 = max_block_size;
+                if (block_j == n_blocks - 1 && block_rem > 0)
+                    block_size_dim2 = block_rem;
+                bool diagonal_block = (block_i == block_j);
 
-#pragma omp single
-        {
-            for (da_int block_j = 0; block_j < n_blocks; block_j++) {
-                for (da_int block_i = 0; block_i <= block_j; block_i++) {
-#pragma omp task firstprivate(block_i, block_j)
-                    {
-                        da_int task_error;
-#pragma omp atomic read
-                        task_error = threading_error;
-                        if (task_error == 0) {
-                            // Need a separate thread_num variable here since we don't know which thread will execute this task
-                            da_int task_thread = omp_get_thread_num();
-                            da_int D_index =
-                                task_thread * max_block_size * max_block_size;
-                            da_int A_index_block_i = block_i * max_block_size;
-                            da_int A_index_block_j = block_j * max_block_size;
-                            da_int block_size_dim1 = max_block_size;
-                            if (block_i == n_blocks - 1 && block_rem > 0)
-                                block_size_dim1 = block_rem;
-                            da_int block_size_dim2 = max_block_size;
-                            if (block_j == n_blocks - 1 && block_rem > 0)
-                                block_size_dim2 = block_rem;
-                            bool diagonal_block = (block_i == block_j) ? true : false;
-
-                            // Compute the distance matrix
-                            ARCH::euclidean_distance(
-                                da_order::column_major, block_size_dim1, block_size_dim2,
-                                n_features, &A[A_index_block_i], lda, &A[A_index_block_j],
-                                lda, &D[D_index], ldd, &A_norms[A_index_block_i], 1,
-                                &A_norms[A_index_block_j], 1, true, diagonal_block);
-
-                            // Iterate through the distance matrix and store the indices of the samples within the radius
-                            for (da_int jj = 0; jj < block_size_dim2; jj++) {
-                                da_int ii_max =
-                                    (diagonal_block) ? jj : block_size_dim1 - 1;
-                                for (da_int ii = 0; ii <= ii_max; ii++) {
-                                    // i and j correspond to the actual sample point indices we are considering
-                                    da_int i = A_index_block_i + ii;
-                                    da_int j = A_index_block_j + jj;
-                                    if (D[D_index + ii + ldd * jj] <= eps_squared &&
-                                        i != j) {
-                                        try {
-                                            if (task_thread == 0) {
-                                                neighbors[i].push_back(j);
-                                                neighbors[j].push_back(i);
-                                            } else {
-                                                neighbors_local[task_thread][i].push_back(
-                                                    j);
-                                                neighbors_local[task_thread][j].push_back(
-                                                    i);
-                                            }
-                                        } catch (std::bad_alloc const &) {
+                // Compute the squared distances of the tile
+                ARCH::euclidean_distance(da_order::column_major, block_size_dim1,
+                                         block_size_dim2, n_features, &A[i0], lda,
+                                         &A[j0], lda, D_thread, ldd, &A_norms[i0], 1,
+                                         &A_norms[j0], 1, true, diagonal_block);
+                count_tile(block_size_dim1, block_size_dim2, D_thread, ldd, eps_squared,
+                           diagonal_block, row_count, col_count);
+
+                if (pass == 0) {
+                    // The counts of sample i are accumulated in offsets[i+1]
+                    for (da_int ii = 0; ii < block_size_dim1; ii++) {
+                        if (row_count[ii] > 0) {
+#pragma omp atomic
+                            offsets[i0 + ii + 1] += row_count[ii];
+                        }
+                    }
+                    for (da_int jj = 0; jj < block_size_dim2; jj++) {
+                        if (col_count[jj] > 0) {
+#pragma omp atomic
+                            offsets[j0 + jj + 1] += col_count[jj];
+                        }
+                    }
+                } else {
+                    // Reserve a contiguous range of the indices of each sample of the tile,
+                    // then fill it. The counts are turned into write positions in place
+                    bool overflow = false;
+                    for (da_int ii = 0; ii < block_size_dim1; ii++) {
+                        if (row_count[ii] > 0) {
+                            da_int start;
+#pragma omp atomic capture
+                            {
+                                start = cursor[i0 + ii];
+                                cursor[i0 + ii] += row_count[ii];
+                            }
+                            overflow |= start + row_count[ii] > offsets[i0 + ii + 1];
+                            row_count[ii] = start;
+                        }
+                    }
+                    for (da_int jj = 0; jj < block_size_dim2; jj++) {
+                        if (col_count[jj] > 0) {
+                            da_int start;
+#pragma omp atomic capture
+                            {
+                                start = cursor[j0 + jj];
+                                cursor[j0 + jj] += col_count[jj];
+                            }
+                            overflow |= start + col_count[jj] > offsets[j0 + jj + 1];
+                            col_count[jj] = start;
+                        }
+                    }
+                    if (overflow) {
+                        // The distances differ from the first pass, should not happen
 #pragma omp atomic write
-                                            threading_error = 1;
-                                        }
-                                    }
+                        threading_error = 1; // LCOV_EXCL_LINE
+                    } else {
+                        for (da_int jj = 0; jj < block_size_dim2; jj++) {
+                            da_int ii_max = diagonal_block ? jj : block_size_dim1;
+                            for (da_int ii = 0; ii < ii_max; ii++) {
+                                if (D_thread[ii + ldd * jj] <= eps_squared) {
+                                    indices[row_count[ii]++] = j0 + jj;
+                                    indices[col_count[jj]++] = i0 + ii;
                                 }
                             }
                         }
                     }
                 }
             }
-        }
+        } // End of parallel region
 
-// Merge the local neighbors into the global neighbors
-#pragma omp critical
-        {
-            if (threading_error == 0 && this_thread != 0) {
-                for (da_int i = 0; i < n_samples; i++) {
-                    neighbors[i].append(neighbors_local[this_thread][i]);
-                }
+        if (threading_error != 0)
+            return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Inconsistent distances in the radius neighbors search.");
+
+        if (pass == 0) {
+            // Prefix sum of the counts, then allocate the indices once
+            for (da_int i = 0; i < n_samples; i++)
+                offsets[i + 1] += offsets[i];
+            for (da_int i = 0; i < n_samples; i++)
+                cursor[i] = offsets[i];
+            try {
+                indices.resize(offsets[n_samples]);
+            } catch (std::bad_alloc const &) {
+                return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation failed.");
             }
         }
-    } // End of parallel region
-    if (threading_error != 0)
-        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
-                        "Memory allocation failed.");
+    }
+
+    // The order in which the tiles are processed is not deterministic: sort each row
+    da_int n_threads_sort = ARCH::da_utils::get_n_threads_loop(n_samples);
+#pragma omp parallel for num_threads(n_threads_sort) schedule(dynamic, 64) default(none) \
+    shared(n_samples, offsets, indices)
+    for (da_int i = 0; i < n_samples; i++)
+        std::sort(indices.begin() + offsets[i], indices.begin() + offsets[i + 1]);
 
     return da_status_success;
 }
 
-template da_status
-radius_neighbors<double>(da_int n_samples, da_int n_features, const double *A, da_int lda,
-                         double eps, std::vector<da_vector::da_vector<da_int>> &neighbors,
-                         da_errors::da_error_t *err);
-template da_status
-radius_neighbors<float>(da_int n_samples, da_int n_features, const float *A, da_int lda,
-                        float eps, std::vector<da_vector::da_vector<da_int>> &neighbors,
-                        da_errors::da_error_t *err);
+template da_status radius_neighbors<double>(da_int n_samples, da_int n_features,
+                                            const double *A, da_int lda, double eps,
+                                            da_int max_memory, std::vector<da_int> &offsets,
+                                            std::vector<da_int> &indices,
+                                            da_errors::da_error_t *err);
+template da_status radius_neighbors<float>(da_int n_samples, da_int n_features,
+                                           const float *A, da_int lda, float eps,
+                                           da_int max_memory, std::vector<da_int> &offsets,
+                                           std::vector<da_int> &indices,
+                                           da_errors::da_error_t *err);
 
 } // namespace da_radius_neighbors
 
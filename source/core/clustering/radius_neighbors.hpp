@@ -23,7 +23,6 @@
 
 #include "aoclda.h"
 #include "da_error.hpp"
-#include "da_vector.hpp"
 #include "macros.h"
 #include <vector>
 
@@ -41,14 +40,22 @@ da_int get_n_threads_loop(da_int loop_size);
 
 namespace da_radius_neighbors {
 
+/*
+Size of the square tiles of pairwise distances computed at once by each thread, such that
+all the tiles fit in max_memory megabytes (the default size is used if max_memory is 0)
+*/
+da_int distance_block_size(da_int n_samples, da_int max_memory, size_t type_size);
+
 /*
 Compute the radius neighbors: for each sample point, the indices of the samples within a given
-radius are returned. The brute-force method is used.
+radius are returned in compressed sparse row format (offsets of size n_samples+1, indices of
+size offsets[n_samples]). The brute-force method is used, with the distance tiles bounded by
+max_memory megabytes (0 for the default tile size).
 */
 template <typename T>
 da_status radius_neighbors(da_int n_samples, da_int n_features, const T *A, da_int lda,
-                           T eps, std::vector<da_vector::da_vector<da_int>> &neighbors,
-                           da_errors::da_error_t *err);
+                           T eps, da_int max_memory, std::vector<da_int> &offsets,
+                           std::vector<da_int> &indices, da_errors::da_error_t *err);
 
 } // namespace da_radius_neighbors
 
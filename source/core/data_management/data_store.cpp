@@ -26,6 +26,7 @@
  */
 
 #include "data_store.hpp"
+#include <cstdint>
 
 namespace da_data {
 
@@ -85,4 +86,256 @@ da_status data_store::raw_ptr_from_csv_columns<char **>(
     C_data = true;
     return da_status_success;
 }
-} // namespace da_data
\ No newline at end of file
+/* ********************************** Arrow import *********************************** */
+/* *********************************************************************************** */
+
+namespace {
+
+/* Keep an imported Arrow array alive as long as some blocks point to its buffers.
+ * The producer's release callback is invoked when the last block is destroyed.
+ */
+struct arrow_array_owner {
+    ArrowArray array;
+    arrow_array_owner() { array.release = nullptr; }
+    ~arrow_array_owner() {
+        if (array.release != nullptr)
+            array.release(&array);
+    }
+};
+
+bool arrow_bit(const void *bitmap, int64_t i) {
+    return (static_cast<const uint8_t *>(bitmap)[i >> 3] >> (i & 7)) & 1;
+}
+
+bool arrow_supported_format(const std::string &fmt) {
+    std::string int_fmt = sizeof(da_int) == 4 ? "i" : "l";
+    return fmt == "g" || fmt == "f" || fmt == int_fmt || fmt == "C" || fmt == "b" ||
+           fmt == "u" || fmt == "U";
+}
+
+/* Build the validity mask of the nrows entries of a column starting at index offset.
+ * The bitmap of the column is combined with the one of its parent struct array, if any.
+ * On output, mask is left empty if none of the entries is null.
+ */
+void arrow_validity(const ArrowArray *array, int64_t offset, const void *parent_bitmap,
+                    int64_t parent_offset, da_int nrows, std::vector<uint8_t> &mask) {
+    const void *bitmap = array->null_count != 0 ? array->buffers[0] : nullptr;
+    mask.clear();
+    if (bitmap == nullptr && parent_bitmap == nullptr)
+        return;
+
+    bool any_null = false;
+    mask.resize((nrows + 7) / 8, 0);
+    for (da_int i = 0; i < nrows; i++) {
+        bool valid = (bitmap == nullptr || arrow_bit(bitmap, offset + i)) &&
+                     (parent_bitmap == nullptr || arrow_bit(parent_bitmap, parent_offset + i));
+        if (valid)
+            mask[i >> 3] |= (uint8_t)(1 << (i & 7));
+        else
+            any_null = true;
+    }
+    if (!any_null)
+        mask.clear();
+}
+
+/* Convert the nrows entries of a UTF-8 array starting at index offset */
+template <class O>
+void arrow_strings(const ArrowArray *array, int64_t offset, da_int nrows,
+                   std::vector<uint8_t> &mask, std::vector<std::string> &col) {
+    const O *offsets = static_cast<const O *>(array->buffers[1]);
+    const char *chars = static_cast<const char *>(array->buffers[2]);
+    col.resize(nrows);
+    for (da_int i = 0; i < nrows; i++) {
+        bool valid = mask.empty() || ((mask[i >> 3] >> (i & 7)) & 1);
+        O start = offsets[offset + i], end = offsets[offset + i + 1];
+        if (valid && chars != nullptr && end > start)
+            col[i].assign(chars + start, end - start);
+    }
+}
+
+/* Fixed-width buffers are shared with the store unless they are not correctly aligned for T */
+template <class T> T *arrow_data(const ArrowArray *array, int64_t offset, bool &aligned) {
+    T *data = const_cast<T *>(static_cast<const T *>(array->buffers[1])) + offset;
+    aligned = reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0;
+    return data;
+}
+
+} // namespace
+
+template <class T>
+da_status data_store::add_arrow_column(da_int nrows, T *data, bool copy_data,
+                                       bool own_data, std::vector<uint8_t> &validity,
+                                       std::shared_ptr<void> owner) {
+    da_status status =
+        concatenate_columns(nrows, 1, data, column_major, copy_data, own_data);
+    if (status != da_status_success)
+        return status; // Error message already loaded
+
+    // The new column is the last one of the store
+    block_dense<T> *bd = static_cast<block_dense<T> *>(cmap.find(n - 1)->second->b);
+    bd->set_validity(std::move(validity));
+    if (!copy_data && !own_data)
+        bd->set_owner(owner);
+    return da_status_success;
+}
+
+/* Add the columns of an Arrow array to the right of the store.
+ * array is either a struct array (each child is a column) or a single primitive array.
+ * All columns are checked before the store is modified. On success, array is moved into the store
+ * and released with the last block referring to it; schema is only read.
+ */
+da_status data_store::load_from_arrow(ArrowArray *array, const ArrowSchema *schema) {
+    if (missing_block)
+        return da_error(
+            err, da_status_missing_block,
+            "Row blocks are not complete, cannot concatenate columns at this point");
+    if (array == nullptr || schema == nullptr || schema->format == nullptr)
+        return da_error(err, da_status_invalid_input,
+                        "The Arrow array and schema must be defined");
+    if (array->release == nullptr)
+        return da_error(err, da_status_invalid_input,
+                        "The Arrow array has already been released");
+
+    std::vector<const ArrowArray *> col_arrays;
+    std::vector<const ArrowSchema *> col_schemas;
+    const void *parent_bitmap = nullptr;
+    int64_t parent_offset = 0;
+    bool is_struct = std::string(schema->format) == "+s";
+    try {
+        if (is_struct) {
+            if (array->n_children <= 0 || array->n_children != schema->n_children ||
+                array->children == nullptr || schema->children == nullptr)
+                return da_error(err, da_status_invalid_input,
+                                "The children of the Arrow array and schema do not match");
+            if (array->null_count != 0 && array->n_buffers > 0 &&
+                array->buffers != nullptr)
+                parent_bitmap = array->buffers[0];
+            parent_offset = array->offset;
+            for (int64_t k = 0; k < array->n_children; k++) {
+                col_arrays.push_back(array->children[k]);
+                col_schemas.push_back(schema->children[k]);
+            }
+        } else {
+            col_arrays.push_back(array);
+            col_schemas.push_back(schema);
+        }
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    if (array->length <= 0 || array->length > DA_INT_MAX)
+        return da_error(err, da_status_invalid_input,
+                        "The length of the Arrow array must be positive and fit in da_int");
+    da_int nrows = (da_int)array->length;
+    if (m > 0 && m != nrows)
+        return da_error(err, da_status_invalid_input,
+                        "Number of rows must match " + std::to_string(m) +
+                            " (input: " + std::to_string(nrows) + ")");
+
+    // Check all the columns before modifying the store
+    for (size_t k = 0; k < col_arrays.size(); k++) {
+        const ArrowArray *a = col_arrays[k];
+        const ArrowSchema *sc = col_schemas[k];
+        std::string col = "Arrow column " + std::to_string(k);
+        if (a == nullptr || sc == nullptr || sc->format == nullptr)
+            return da_error(err, da_status_invalid_input, col + " is not defined");
+        std::string fmt(sc->format);
+        if (!arrow_supported_format(fmt) || sc->dictionary != nullptr)
+            return da_error(err, da_status_invalid_input,
+                            col + ": format '" + fmt + "' is not supported");
+        int64_t n_buffers = (fmt == "u" || fmt == "U") ? 3 : 2;
+        if (a->n_buffers != n_buffers || a->buffers == nullptr ||
+            a->buffers[1] == nullptr)
+            return da_error(err, da_status_invalid_input,
+                            col + ": unexpected buffer layout");
+        if (a->offset < 0 || a->length < parent_offset + nrows)
+            return da_error(err, da_status_invalid_input,
+                            col + " contains fewer elements than the array");
+    }
+
+    // Take ownership of the array, following the move semantics of the C data interface
+    std::shared_ptr<arrow_array_owner> owner;
+    try {
+        owner = std::make_shared<arrow_array_owner>();
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    owner->array = *array;
+    array->release = nullptr;
+    if (!is_struct)
+        col_arrays[0] = &owner->array;
+
+    da_status status = da_status_success;
+    try {
+        std::vector<uint8_t> validity;
+        for (size_t k = 0; k < col_arrays.size(); k++) {
+            const ArrowArray *a = col_arrays[k];
+            const ArrowSchema *sc = col_schemas[k];
+            int64_t offset = a->offset + parent_offset;
+            arrow_validity(a, offset, parent_bitmap, parent_offset, nrows, validity);
+
+            bool aligned;
+            switch (sc->format[0]) {
+            case 'g': {
+                double *data = arrow_data<double>(a, offset, aligned);
+                status = add_arrow_column(nrows, data, !aligned, false, validity, owner);
+                break;
+            }
+            case 'f': {
+                float *data = arrow_data<float>(a, offset, aligned);
+                status = add_arrow_column(nrows, data, !aligned, false, validity, owner);
+                break;
+            }
+            case 'i':
+            case 'l': {
+                da_int *data = arrow_data<da_int>(a, offset, aligned);
+                status = add_arrow_column(nrows, data, !aligned, false, validity, owner);
+                break;
+            }
+            case 'C': {
+                uint8_t *data = arrow_data<uint8_t>(a, offset, aligned);
+                status = add_arrow_column(nrows, data, false, false, validity, owner);
+                break;
+            }
+            case 'b': {
+                // Booleans are bit-packed, unpack them into a new uint8 block
+                std::vector<uint8_t> data(nrows);
+                for (da_int i = 0; i < nrows; i++)
+                    data[i] = arrow_bit(a->buffers[1], offset + i);
+                status = add_arrow_column(nrows, data.data(), true, false, validity, owner);
+                break;
+            }
+            default: {
+                // UTF-8 strings
+                std::vector<std::string> strings;
+                if (sc->format[0] == 'u')
+                    arrow_strings<int32_t>(a, offset, nrows, validity, strings);
+                else
+                    arrow_strings<int64_t>(a, offset, nrows, validity, strings);
+                status =
+                    add_arrow_column(nrows, strings.data(), true, false, validity, owner);
+                break;
+            }
+            }
+            if (status != da_status_success)
+                return da_error_trace(err, status, "Could not add Arrow column " +
+                                                       std::to_string(k));
+
+            if (sc->name != nullptr && sc->name[0] != '\0') {
+                status = label_column(std::string(sc->name), n - 1);
+                if (status != da_status_success)
+                    return da_error_trace( // LCOV_EXCL_LINE
+                        err, da_status_internal_error, "Unexpected error in column labeling");
+            }
+        }
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+
+    return da_status_success;
+}
+
+} // namespace da_data
@@ -31,11 +31,15 @@
 #include "aoclda.h"
 #include "auto_detect_csv.hpp"
 #include "csv_reader.hpp"
+#include "da_omp.hpp"
 #include "interval.hpp"
 #include "interval_map.hpp"
 #include "interval_set.hpp"
 #include "read_csv.hpp"
+#include "row_bitmap.hpp"
+#include <algorithm>
 #include <ciso646> // Fixes an MSVC issue
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -113,37 +117,114 @@ template <class T> struct non_missing_types {
     static constexpr bool value = !std::is_floating_point_v<T> && !std::is_integral_v<T>;
 };
 template <class T>
-std::enable_if_t<std::is_floating_point_v<T>, bool> is_missing_value(T &val) {
+std::enable_if_t<std::is_floating_point_v<T>, bool> is_missing_value(const T &val) {
     return std::isnan(val);
 }
 template <class T>
-std::enable_if_t<std::is_integral_v<T>, bool> is_missing_value(T &val) {
+std::enable_if_t<std::is_integral_v<T>, bool> is_missing_value(const T &val) {
     return val == std::numeric_limits<T>::max();
 }
 template <class T>
 std::enable_if_t<non_missing_types<T>::value, bool>
-is_missing_value([[maybe_unused]] T &val) {
+is_missing_value([[maybe_unused]] const T &val) {
     return false;
 }
 
+/* Value used to represent a missing entry when data is extracted from a block
+ * holding a validity mask (see block_base)
+ */
+template <class T> std::enable_if_t<std::is_floating_point_v<T>, T> missing_value() {
+    return std::numeric_limits<T>::quiet_NaN();
+}
+template <class T> std::enable_if_t<std::is_integral_v<T>, T> missing_value() {
+    return std::numeric_limits<T>::max();
+}
+
+/* Evaluate a row predicate on n elements x[i * stride]:
+ * mask[i] = 1 if x[i * stride] <op> value holds and the element is not missing, 0 otherwise.
+ * The loops are branch-free so that they can be vectorized.
+ */
+template <class T, class Cmp>
+void compare_values(const T *x, da_int stride, da_int n, T value, Cmp cmp,
+                    uint8_t *mask) {
+    if (stride == 1) {
+#pragma omp simd
+        for (da_int i = 0; i < n; i++)
+            mask[i] = (uint8_t)(cmp(x[i], value) & !is_missing_value(x[i]));
+    } else {
+#pragma omp simd
+        for (da_int i = 0; i < n; i++)
+            mask[i] =
+                (uint8_t)(cmp(x[i * stride], value) & !is_missing_value(x[i * stride]));
+    }
+}
+template <class T>
+void compare_values(const T *x, da_int stride, da_int n, T value, da_data_compare op,
+                    uint8_t *mask) {
+    switch (op) {
+    case da_compare_lt:
+        compare_values(x, stride, n, value, std::less<T>(), mask);
+        break;
+    case da_compare_le:
+        compare_values(x, stride, n, value, std::less_equal<T>(), mask);
+        break;
+    case da_compare_gt:
+        compare_values(x, stride, n, value, std::greater<T>(), mask);
+        break;
+    case da_compare_ge:
+        compare_values(x, stride, n, value, std::greater_equal<T>(), mask);
+        break;
+    case da_compare_eq:
+        compare_values(x, stride, n, value, std::equal_to<T>(), mask);
+        break;
+    case da_compare_ne:
+        compare_values(x, stride, n, value, std::not_equal_to<T>(), mask);
+        break;
+    }
+}
+
+/* Statistics of the rows sharing the same key, computed by data_store::group_by */
+template <class T> struct group_stats {
+    da_int key = 0;
+    da_int count = 0;
+    T sum = 0, min = 0, max = 0;
+};
+
 class block {
   public:
     da_int m, n;
     block_type btype = block_none;
     da_errors::da_error_t *err = nullptr;
     virtual ~block(){};
-    /* mark in a boolean vector which rows contain missing
-     * the vector is expected to be initialized, rows marked as containing missing values will be skipped
+    /* mark in a byte mask which rows contain missing values (0: missing, 1: valid)
+     * the mask is expected to be initialized, rows already marked as missing stay missing
      * Input:
-     * - idx_valid: index in the bool vector of the first row of the block.
+     * - idx_valid: index in the mask of the first row of the block.
      * - rows, cols: intervals of rows and columns in the block to be considered in the missing rows detection
      */
-    virtual da_status missing_rows(std::vector<bool> &valid_row, da_int idx_valid,
+    virtual da_status missing_rows(std::vector<uint8_t> &valid_row, da_int idx_valid,
                                    interval rows, interval cols) = 0;
 };
 
 template <class T> class block_base : public block {
+  protected:
+    /* validity: optional bit-packed mask (least significant bit first, as in the Arrow
+     * columnar format) marking the non-null rows of the block. Bit i refers to row i.
+     * An empty mask means that all the entries are valid.
+     */
+    std::vector<uint8_t> validity;
+
   public:
+    void set_validity(std::vector<uint8_t> &&mask) { validity = std::move(mask); }
+    bool has_validity() { return !validity.empty(); }
+    bool is_null(da_int i) {
+        return !validity.empty() && !((validity[i >> 3] >> (i & 7)) & 1);
+    }
+    void set_valid(da_int i) {
+        if (!validity.empty())
+            validity[i >> 3] |= (uint8_t)(1 << (i & 7));
+    }
+
     /* Get a column of the block
      * on output:
      * - col contains a pointer to the column idx of the block, data is not copied.
@@ -176,11 +257,14 @@ template <class T> class block_dense : public block_base<T> {
      * order: storage scheme used for the matrix in bl, row major or column major
      * own_data: mark if the memory is owned by the block
      * C_data: if true, bl needs to be deallocated with free instead of new.
+     * owner: optional handle keeping alive external memory that bl points to
+     *        (e.g., an imported Arrow array), released with the block.
      */
     T *bl = nullptr;
     da_order order;
     bool own_data = false;
     bool C_data = false;
+    std::shared_ptr<void> owner = nullptr;
 
   public:
     ~block_dense() {
@@ -213,6 +297,7 @@ template <class T> class block_dense : public block_base<T> {
     };
 
     void set_own_data(bool own) { own_data = own; }
+    void set_owner(std::shared_ptr<void> owner) { this->owner = owner; }
 
     da_status get_col(da_int idx, T **col, da_int &stride) {
 
@@ -288,11 +373,23 @@ template <class T> class block_dense : public block_base<T> {
             }
             break;
         }
+
+        // Entries marked as null in the validity mask are exported as missing values
+        if constexpr (!non_missing_types<T>::value) {
+            if (this->has_validity()) {
+                for (da_int i = 0; i < nrows; i++) {
+                    if (this->is_null(rows.lower + i)) {
+                        for (da_int j = 0; j < ncols; j++)
+                            data[idx_start + j * ld_data + i] = missing_value<T>();
+                    }
+                }
+            }
+        }
         return da_status_success;
     }
 
-    da_status missing_rows(std::vector<bool> &valid_row, da_int idx_valid, interval rows,
-                           interval cols) {
+    da_status missing_rows(std::vector<uint8_t> &valid_row, da_int idx_valid,
+                           interval rows, interval cols) {
 
         if (!cols.is_valid_idx(this->n)) {
             std::string msg = "Column interval not valid. Input bounds: ";
@@ -309,47 +406,45 @@ template <class T> class block_dense : public block_base<T> {
             return da_error(this->err, da_status_invalid_input, msg);
         }
 
-        da_int ncols, nrows, idx;
+        da_int ncols, nrows;
         ncols = cols.upper - cols.lower + 1;
         nrows = rows.upper - rows.lower + 1;
         if (idx_valid + nrows > (da_int)valid_row.size() || idx_valid < 0)
             return da_error(this->err, da_status_invalid_input,
                             "mismatch between the size of the block and the size of the "
-                            "boolean vector");
-
-        if (non_missing_types<T>::value) {
-            return da_status_success;
-        }
+                            "mask");
 
-        switch (order) {
-        case row_major:
+        uint8_t *valid = valid_row.data() + idx_valid;
+        if (this->has_validity()) {
             for (da_int i = 0; i < nrows; i++) {
-                idx = (rows.lower + i) * this->n + cols.lower;
-                if (valid_row[idx_valid + i]) {
-                    for (da_int j = 0; j < ncols; j++) {
-                        if (is_missing_value<T>(bl[idx])) {
-                            valid_row[idx_valid + i] = false;
-                            break;
-                        }
-                        idx++;
-                    }
-                }
+                if (this->is_null(rows.lower + i))
+                    valid[i] = 0;
             }
-            break;
+        }
 
-        case column_major:
-            idx = cols.lower * this->m + rows.lower;
-            for (da_int j = 0; j < ncols; j++) {
+        // The scans below are branch-free so that they can be vectorized
+        if constexpr (!non_missing_types<T>::value) {
+            switch (order) {
+            case row_major:
                 for (da_int i = 0; i < nrows; i++) {
-                    if (valid_row[idx_valid + i]) {
-                        if (is_missing_value<T>(bl[idx]))
-                            valid_row[idx_valid + i] = false;
-                    }
-                    idx++;
+                    const T *row = &bl[(rows.lower + i) * this->n + cols.lower];
+                    uint8_t row_valid = valid[i];
+#pragma omp simd reduction(& : row_valid)
+                    for (da_int j = 0; j < ncols; j++)
+                        row_valid &= (uint8_t)!is_missing_value<T>(row[j]);
+                    valid[i] = row_valid;
                 }
-                idx += this->m - nrows;
+                break;
+
+            case column_major:
+                for (da_int j = 0; j < ncols; j++) {
+                    const T *col = &bl[(cols.lower + j) * this->m + rows.lower];
+#pragma omp simd
+                    for (da_int i = 0; i < nrows; i++)
+                        valid[i] &= (uint8_t)!is_missing_value<T>(col[i]);
+                }
+                break;
             }
-            break;
         }
 
         return da_status_success;
@@ -381,9 +476,16 @@ using namespace da_interval;
 using columns_map = interval_map<std::shared_ptr<block_id>>;
 using idx_slice = interval_map<da_int>;
 
+/* Selection of columns and rows
+ * The rows are stored in row_slice as a set of intervals, unless row_bits is allocated.
+ * In that case, the rows are the ones of the compressed bitmap row_bits and row_slice is
+ * empty. It is used for scattered selections made of too many intervals, such as the
+ * ones produced by select_non_missing.
+ */
 struct coord_slice {
     std::unique_ptr<interval_set> col_slice;
     std::unique_ptr<interval_set> row_slice;
+    std::unique_ptr<row_bitmap> row_bits = nullptr;
     coord_slice() {
         col_slice = std::make_unique<interval_set>();
         row_slice = std::make_unique<interval_set>();
@@ -690,6 +792,14 @@ class data_store {
             nrows = bb->m;
             for (da_int i = 0; i < nrows; i++)
                 col[idxrow + i] = c[i * stride];
+            if constexpr (!non_missing_types<T>::value) {
+                if (bb->has_validity()) {
+                    for (da_int i = 0; i < nrows; i++) {
+                        if (bb->is_null(i))
+                            col[idxrow + i] = missing_value<T>();
+                    }
+                }
+            }
             idxrow += nrows;
             id = id->next;
         }
@@ -814,13 +924,13 @@ class data_store {
                 // LCOV_EXCL_STOP
             }
         }
-        exit_status = it->second.row_slice->insert(rows);
+        exit_status = insert_rows(it->second, rows);
         if (exit_status != da_status_success)
             return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
                             "Unexpected failure in row selection.");
         exit_status = it->second.col_slice->insert(cols);
         if (exit_status != da_status_success) {
-            it->second.row_slice->erase(rows);             // LCOV_EXCL_LINE
+            erase_rows(it->second, rows);                  // LCOV_EXCL_LINE
             return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
                             "Unexpected failure in col selection.");
         }
@@ -884,7 +994,7 @@ class data_store {
             }
         }
 
-        exit_status = it->second.row_slice->insert(rows);
+        exit_status = insert_rows(it->second, rows);
 
         return exit_status;
     }
@@ -937,7 +1047,7 @@ class data_store {
             msg += " is not a valid selection.";
             return da_warn(err, da_status_invalid_input, msg);
         }
-        exit_status = it->second.row_slice->erase(rows);
+        exit_status = erase_rows(it->second, rows);
 
         return exit_status;
     }
@@ -953,8 +1063,6 @@ class data_store {
 
         auto it = selections.find(key);
         bool clear_selections = false, clear_cols = false, clear_rows = false;
-        da_int idx = 0;
-        da_int ncols = 0;
         std::string internal_key;
 
         if (selections.empty()) {
@@ -976,7 +1084,7 @@ class data_store {
             goto exit;
         }
 
-        if (it->second.row_slice->empty()) {
+        if (!it->second.row_bits && it->second.row_slice->empty()) {
             // No rows in the current selection, create a temporary one containing all
             status = select_rows(key, {0, m - 1});
             if (status != da_status_success) {
@@ -1000,68 +1108,59 @@ class data_store {
             clear_cols = true;
         }
 
-        if (order == column_major) {
-
-            for (auto it_col = it->second.col_slice->begin();
-                 it_col != it->second.col_slice->end(); ++it_col) {
-                idx = ncols * ld;
-                ncols += it_col->upper - it_col->lower + 1;
-                for (auto it_row = it->second.row_slice->begin();
-                     it_row != it->second.row_slice->end(); ++it_row) {
-                    da_int nrows = it_row->upper - it_row->lower + 1;
-                    status = extract_slice(*it_row, *it_col, ld, idx, data);
-                    if (status != da_status_success) {
-                        exit_status = status;
-                        goto exit;
-                    }
-                    idx += nrows;
-                }
-            }
-
-        } else {
+        {
+            da_int n_rows, n_cols;
+            selection_dims(it->second, n_rows, n_cols);
 
-            // For row-major ordering, we need to create a temporary array first
-            da_int n_cols = 0, n_rows = 0, ldd = 0;
-            for (auto it_col = it->second.col_slice->begin();
-                 it_col != it->second.col_slice->end(); ++it_col) {
-                n_cols += it_col->upper - it_col->lower + 1;
-                for (auto it_row = it->second.row_slice->begin();
-                     it_row != it->second.row_slice->end(); ++it_row) {
-                    n_rows += it_row->upper - it_row->lower + 1;
-                }
-            }
-            ldd = n_rows;
-            // ncols and nrows are now correctly set
-            std::vector<T> tmp_data;
-
-            try {
-                tmp_data.resize(n_cols * n_rows);
-            } catch (std::bad_alloc const &) {
-                exit_status = da_status_memory_error;
-                da_error(err, exit_status, "Memory allocation error");
+            if (ld < (order == column_major ? n_rows : n_cols)) {
+                exit_status = da_status_invalid_input;
+                da_error(err, exit_status,
+                         "The leading dimension must be at least " +
+                             std::to_string(order == column_major ? n_rows : n_cols));
                 goto exit;
             }
 
-            for (auto it_col = it->second.col_slice->begin();
-                 it_col != it->second.col_slice->end(); ++it_col) {
-                idx = ncols * ld;
-                ncols += it_col->upper - it_col->lower + 1;
-                for (auto it_row = it->second.row_slice->begin();
-                     it_row != it->second.row_slice->end(); ++it_row) {
-                    da_int nrows = it_row->upper - it_row->lower + 1;
-                    status = extract_slice(*it_row, *it_col, ldd, idx, tmp_data.data());
-                    if (status != da_status_success) {
-                        exit_status = status;
-                        goto exit;
-                    }
-                    idx += nrows;
+            if (order == column_major) {
+                status = extract_coord_slice(it->second, ld, data);
+                if (status != da_status_success) {
+                    exit_status = status;
+                    goto exit;
+                }
+            } else {
+                // For row-major ordering, extract into a column-major temporary first.
+                // The temporary is left uninitialized so that its pages are first
+                // touched by the threads that fill it.
+                da_int ldd = n_rows;
+                std::unique_ptr<T[]> tmp_data;
+                try {
+                    tmp_data.reset(new T[(size_t)n_cols * (size_t)n_rows]);
+                } catch (std::bad_alloc const &) {
+                    exit_status = da_status_memory_error; // LCOV_EXCL_LINE
+                    da_error(err, exit_status,            // LCOV_EXCL_LINE
+                             "Memory allocation error");
+                    goto exit; // LCOV_EXCL_LINE
+                }
+                status = extract_coord_slice(it->second, ldd, tmp_data.get());
+                if (status != da_status_success) {
+                    exit_status = status;
+                    goto exit;
                 }
-            }
 
-            // Convert tmp_data to row-major output array
-            for (da_int i = 0; i < n_rows; i++) {
-                for (da_int j = 0; j < n_cols; j++) {
-                    data[j + i * ld] = tmp_data[i + j * ldd];
+                // Convert tmp_data to the row-major output array, by blocks of rows
+                T *tmp = tmp_data.get();
+                const da_int tb = extract_transpose_block;
+                da_int n_blocks = (n_rows + tb - 1) / tb;
+#pragma omp parallel for schedule(static) if (n_rows > tb) default(none)                 \
+    shared(n_blocks, n_rows, n_cols, tb, ld, ldd, tmp, data)
+                for (da_int ib = 0; ib < n_blocks; ib++) {
+                    da_int i_end = std::min((ib + 1) * tb, n_rows);
+                    for (da_int jb = 0; jb < n_cols; jb += tb) {
+                        da_int j_end = std::min(jb + tb, n_cols);
+                        for (da_int i = ib * tb; i < i_end; i++) {
+                            for (da_int j = jb; j < j_end; j++)
+                                data[j + i * ld] = tmp[i + j * ldd];
+                        }
+                    }
                 }
             }
         }
@@ -1077,6 +1176,126 @@ class data_store {
         return exit_status;
     }
 
+    /* Dimensions of the matrix extracted by extract_selection for the selection key.
+     * As in extract_selection, the whole store is considered if no selection is defined,
+     * and all the rows (resp. columns) if the selection has no rows (resp. columns).
+     * exit status:
+     * - invalid_input: key not found
+     * - missing_block
+     */
+    da_status selection_size(std::string key, da_int &n_rows, da_int &n_cols) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+
+        n_rows = m;
+        n_cols = n;
+        if (selections.empty())
+            return da_status_success;
+        auto it = selections.find(key);
+        if (it == selections.end())
+            return da_error(err, da_status_invalid_input, "key was not found");
+        da_int sel_rows, sel_cols;
+        selection_dims(it->second, sel_rows, sel_cols);
+        if (it->second.row_bits || !it->second.row_slice->empty())
+            n_rows = sel_rows;
+        if (!it->second.col_slice->empty())
+            n_cols = sel_cols;
+        return da_status_success;
+    }
+
+    /* Get direct access to the data of the selection key, without copying it.
+     * This is only possible if the selection maps onto a single column-major block: its
+     * columns and rows must form one contiguous interval each, located in the same block,
+     * and the block must not have a validity mask.
+     * If no selection is defined in the store, the whole store is considered.
+     * On output, data points to the first element of the selection in the block, which is
+     * a n_rows x n_cols column-major matrix with leading dimension ld. The pointer is
+     * invalidated by any operation modifying the store.
+     * exit status:
+     * - invalid_input: key not found, incompatible type or the selection cannot be viewed
+     * - missing_block
+     */
+    template <class T>
+    da_status selection_view(std::string key, T *&data, da_int &n_rows, da_int &n_cols,
+                             da_int &ld) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+
+        // Bounds of the selection, each set of indices must be contiguous
+        interval rows = {0, m - 1}, cols = {0, n - 1};
+        if (!selections.empty()) {
+            auto it = selections.find(key);
+            if (it == selections.end())
+                return da_error(err, da_status_invalid_input, "key was not found");
+            bool contiguous = contiguous_bounds(*it->second.col_slice, cols);
+            if (it->second.row_bits) {
+                da_int n_runs = 0;
+                it->second.row_bits->for_each_run([&](da_int lower, da_int upper) {
+                    rows = {lower, upper};
+                    n_runs++;
+                });
+                contiguous = contiguous && n_runs == 1;
+            } else {
+                contiguous = contiguous && contiguous_bounds(*it->second.row_slice, rows);
+            }
+            if (!contiguous)
+                return da_error(err, da_status_invalid_input,
+                                "The selection is not contiguous and cannot be accessed "
+                                "without a copy");
+        }
+
+        // Find the block containing all the columns, then the rows in its vertical chain
+        columns_map::iterator it_map = cmap.find(cols.lower);
+        if (it_map == cmap.end())
+            return da_error(err, da_status_invalid_input,
+                            "The store does not contain any data");
+        if (it_map->second->b->btype != get_block_type<T>())
+            return da_error(err, da_status_invalid_input,
+                            "Incompatible types between the datastore and the output "
+                            "data");
+        if (cols.upper > it_map->first.upper)
+            return da_error(err, da_status_invalid_input,
+                            "The selected columns are not stored in a single block and "
+                            "cannot be accessed without a copy");
+        std::shared_ptr<block_id> bid = it_map->second;
+        da_int first_row = 0;
+        while (bid != nullptr && first_row + bid->b->m <= rows.lower) {
+            first_row += bid->b->m;
+            bid = bid->next;
+        }
+        if (bid == nullptr || rows.upper >= first_row + bid->b->m)
+            return da_error(err, da_status_invalid_input,
+                            "The selected rows are not stored in a single block and "
+                            "cannot be accessed without a copy");
+
+        block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
+        T *col;
+        da_int stride;
+        if (bb->get_col(cols.lower - bid->offset, &col, stride) != da_status_success)
+            return da_error_trace( // LCOV_EXCL_LINE
+                err, da_status_internal_error,
+                "Unexpected error occurred. Possible memory corruption.");
+        if (stride != 1)
+            return da_error(err, da_status_invalid_input,
+                            "The selection is stored in row-major order and cannot be "
+                            "accessed without a copy");
+        if (bb->has_validity())
+            return da_error(err, da_status_invalid_input,
+                            "The selection contains a validity mask and cannot be "
+                            "accessed without a copy");
+
+        data = col + (rows.lower - first_row);
+        n_rows = rows.upper - rows.lower + 1;
+        n_cols = cols.upper - cols.lower + 1;
+        ld = bb->m;
+
+        return da_status_success;
+    }
+
     /* From a given selection remove all rows that have missing data in it.
      * Input:
      * - key: name of the selection. If the key is not already present in the map, all rows will be considered
@@ -1086,7 +1305,6 @@ class data_store {
     da_status select_non_missing(std::string key, bool full_rows) {
 
         da_status status = da_status_success;
-        da_int i;
 
         if (missing_block)
             return da_error(
@@ -1105,14 +1323,15 @@ class data_store {
 
         std::unique_ptr<interval_set> &col_slice = it->second.col_slice;
         std::unique_ptr<interval_set> &row_slice = it->second.row_slice;
-        if (row_slice->empty()) {
+        std::unique_ptr<row_bitmap> &row_bits = it->second.row_bits;
+        if (!row_bits && row_slice->empty()) {
             select_rows(key, {0, m - 1});
         }
 
-        // Check ALL the rows
-        std::vector<bool> valid_rows;
+        // Check ALL the rows: valid_rows[i] is set to 0 if row i contains missing data
+        std::vector<uint8_t> valid_rows;
         try {
-            valid_rows.resize(m, true);
+            valid_rows.resize(m, 1);
         } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
             return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
                             "Memory allocation error");
@@ -1148,41 +1367,45 @@ class data_store {
         }
 
         // Loop over the columns and rows of the selection to mark the rows with missing
-        // data in valid_rows
+        // data in valid_rows. Bitmap selections are scattered: all their rows are checked
+        // in a single pass.
         for (; it_col != it_col_end; ++it_col) {
-            for (auto it_row = row_slice->begin(); it_row != row_slice->end(); ++it_row) {
-                status = mark_missing_slice(*it_row, *it_col, valid_rows);
-                if (status != da_status_success) {
-                    status =
-                        da_error_trace(err, da_status_internal_error, // LCOV_EXCL_LINE
-                                       "Unexpected error. Possible memory corruption.");
-                    goto exit; // LCOV_EXCL_LINE
+            if (row_bits) {
+                status = mark_missing_slice({0, m - 1}, *it_col, valid_rows);
+            } else {
+                for (auto it_row = row_slice->begin(); it_row != row_slice->end();
+                     ++it_row) {
+                    status = mark_missing_slice(*it_row, *it_col, valid_rows);
+                    if (status != da_status_success)
+                        break; // LCOV_EXCL_LINE
                 }
             }
+            if (status != da_status_success) {
+                status = da_error_trace(err, da_status_internal_error, // LCOV_EXCL_LINE
+                                        "Unexpected error. Possible memory corruption.");
+                goto exit; // LCOV_EXCL_LINE
+            }
         }
 
-        // Remove the rows with missing data from the selection 'key'
-        i = 0;
-        while (i < m) {
-            if (!valid_rows[i]) {
-                da_int idx_stop = i;
-                while (!valid_rows[idx_stop] && idx_stop < m) {
-                    idx_stop++;
-                }
-                status = row_slice->erase({i, idx_stop - 1});
-                if (status != da_status_success) {
-                    // LCOV_EXCL_START
-                    status = da_status_internal_error;
-                    da_error_trace(err, status,
-                                   "Failed to erase missing rows from the selection.");
-                    goto exit;
-                    // LCOV_EXCL_STOP
-                }
-                i = idx_stop - 1;
-            }
-            i++;
+        {
+            // Keep only the valid rows that are in the selection
+            da_int next = 0;
+            auto drop_gap = [&](da_int lower, da_int upper) {
+                std::fill(valid_rows.begin() + next, valid_rows.begin() + lower, 0);
+                next = upper + 1;
+            };
+            if (row_bits)
+                row_bits->for_each_run(drop_gap);
+            else
+                for (auto it_row = row_slice->begin(); it_row != row_slice->end();
+                     ++it_row)
+                    drop_gap(it_row->lower, it_row->upper);
+            std::fill(valid_rows.begin() + next, valid_rows.end(), 0);
         }
 
+        // Store the remaining rows in the selection
+        status = set_selection_rows(it->second, valid_rows);
+
     exit:
         if (clear_cols)
             it->second.col_slice->clear();
@@ -1192,7 +1415,7 @@ class data_store {
     }
 
     da_status mark_missing_slice(interval rows, interval cols,
-                                 std::vector<bool> &valid_rows) {
+                                 std::vector<uint8_t> &valid_rows) {
         if (!cols.is_valid_idx(this->n)) {
             std::string msg = "Column interval not valid. Input bounds: ";
             msg += "[" + std::to_string(cols.lower) + ", " + std::to_string(cols.upper) +
@@ -1236,8 +1459,8 @@ class data_store {
                             err, da_status_internal_error,
                             "Internal error. Possible  memory corruption.");
                 }
-                lr = ur + 1;
-                first_row_idx = lr;
+                lr = std::max(ur + 1, lrow);
+                first_row_idx = ur + 1;
                 bid = bid->next;
             }
             lcol = uc + 1;
@@ -1245,6 +1468,232 @@ class data_store {
         return da_status_success;
     }
 
+    /* Filter the rows of the selection key with the predicate data[i, col] <op> value.
+     * Rows with a missing value in the column col never satisfy the predicate.
+     * - combine = da_combine_and: only the rows of the selection satisfying the predicate
+     *   are kept,
+     * - combine = da_combine_or: the rows satisfying the predicate are added to the
+     *   selection.
+     * If the selection does not exist or has no rows selected, its rows are set to the
+     * ones satisfying the predicate. The columns of the selection are not modified.
+     * exit status:
+     * - invalid_input
+     * - missing_block
+     * - memory_error
+     */
+    template <class T>
+    da_status select_where(std::string key, da_int col, da_data_compare op, T value,
+                           da_data_combine combine) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot select elements at this time");
+        if (col < 0 || col >= this->n)
+            return da_error(err, da_status_invalid_input,
+                            "col = " + std::to_string(col) +
+                                ". The column index must be between 0 and " +
+                                std::to_string(this->n - 1) + ".");
+        if (op < da_compare_lt || op > da_compare_ne)
+            return da_error(err, da_status_invalid_input,
+                            "Unknown comparison operator.");
+        if (combine != da_combine_and && combine != da_combine_or)
+            return da_error(err, da_status_invalid_input,
+                            "combine must be either da_combine_and or da_combine_or.");
+        if (!column_has_type<T>(col))
+            return da_error(err, da_status_invalid_input,
+                            "Incompatible types between column " + std::to_string(col) +
+                                " and the value to compare with.");
+
+        std::vector<uint8_t> valid_rows, current_rows;
+        try {
+            valid_rows.resize(m);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        da_status status = compare_column(col, op, value, valid_rows.data());
+        if (status != da_status_success)
+            return da_error_trace(err, da_status_internal_error, // LCOV_EXCL_LINE
+                                  "Unexpected error. Possible memory corruption.");
+
+        auto it = selections.find(key);
+        if (it == selections.end()) {
+            bool inserted;
+            std::tie(it, inserted) =
+                selections.insert(std::make_pair(key, coord_slice()));
+            if (!inserted) {
+                return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                                "Unexpected error in the selection creation");
+            }
+        }
+        coord_slice &sl = it->second;
+        if (sl.row_bits || !sl.row_slice->empty()) {
+            // Combine with the rows already in the selection
+            try {
+                current_rows.resize(m, 0);
+            } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+                return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation error");
+            }
+            if (sl.row_bits)
+                sl.row_bits->fill_mask(m, current_rows.data());
+            else
+                for (auto it_row = sl.row_slice->begin(); it_row != sl.row_slice->end();
+                     ++it_row)
+                    std::fill(current_rows.begin() + it_row->lower,
+                              current_rows.begin() + it_row->upper + 1, 1);
+            uint8_t *valid = valid_rows.data(), *current = current_rows.data();
+            if (combine == da_combine_and) {
+#pragma omp simd
+                for (da_int i = 0; i < m; i++)
+                    valid[i] &= current[i];
+            } else {
+#pragma omp simd
+                for (da_int i = 0; i < m; i++)
+                    valid[i] |= current[i];
+            }
+        }
+
+        return set_selection_rows(sl, valid_rows);
+    }
+
+    /* Aggregate the values of the column value_col for each distinct value of the integer
+     * column key_col, over the rows of the selection key. All the rows are considered if
+     * key is empty or if the selection has no rows selected. The columns of the selection
+     * are ignored.
+     * Rows with a missing key or value are skipped. The groups are sorted by increasing
+     * key and, for each of them, the key, the number of rows, the sum, mean, minimum and
+     * maximum of the values are written in the output arrays (any of them can be
+     * nullptr).
+     * n_groups is the size of the output arrays on input and the number of groups on
+     * output, invalid_array_dimension is returned if it is too small.
+     * The rows are split into chunks aggregated in parallel into thread-local hash maps,
+     * which are merged at the end.
+     * exit status:
+     * - invalid_input
+     * - invalid_array_dimension
+     * - missing_block
+     * - memory_error
+     */
+    template <class T>
+    da_status group_by(std::string key, da_int key_col, da_int value_col,
+                       da_int &n_groups, da_int *group_keys, da_int *counts, T *sums,
+                       T *means, T *mins, T *maxs) {
+        if (missing_block)
+            return da_error(
+                err, da_status_missing_block,
+                "Row blocks are not complete, cannot extract data at this point");
+        for (da_int col : {key_col, value_col}) {
+            if (col < 0 || col >= this->n)
+                return da_error(err, da_status_invalid_input,
+                                "col = " + std::to_string(col) +
+                                    ". The column index must be between 0 and " +
+                                    std::to_string(this->n - 1) + ".");
+        }
+        if (!column_has_type<da_int>(key_col))
+            return da_error(err, da_status_invalid_input,
+                            "The key column must contain integer data.");
+        if (!column_has_type<T>(value_col))
+            return da_error(err, da_status_invalid_input,
+                            "Incompatible types between the value column and the output "
+                            "data.");
+
+        // Rows to aggregate, split into chunks
+        std::vector<interval> tasks;
+        try {
+            auto add_rows = [&](da_int lower, da_int upper) {
+                for (da_int lr = lower; lr <= upper; lr += extract_task_min)
+                    tasks.push_back({lr, std::min(lr + extract_task_min - 1, upper)});
+            };
+            auto it = selections.end();
+            if (!key.empty()) {
+                it = selections.find(key);
+                if (it == selections.end())
+                    return da_error(err, da_status_invalid_input, "key was not found");
+            }
+            if (it == selections.end() ||
+                (!it->second.row_bits && it->second.row_slice->empty()))
+                add_rows(0, m - 1);
+            else if (it->second.row_bits)
+                it->second.row_bits->for_each_run(add_rows);
+            else
+                for (auto it_row = it->second.row_slice->begin();
+                     it_row != it->second.row_slice->end(); ++it_row)
+                    add_rows(it_row->lower, it_row->upper);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+
+        using group_map = std::unordered_map<da_int, group_stats<T>>;
+        group_map groups;
+        da_status status = da_status_success;
+        da_int n_tasks = (da_int)tasks.size();
+#pragma omp parallel if (n_tasks > 1) default(none)                                       \
+    shared(tasks, n_tasks, key_col, value_col, groups, status)
+        {
+            group_map local_groups;
+            da_status local_status = da_status_success;
+#pragma omp for schedule(dynamic)
+            for (da_int t = 0; t < n_tasks; t++) {
+                if (local_status == da_status_success)
+                    local_status =
+                        aggregate_rows(tasks[t], key_col, value_col, local_groups);
+            }
+#pragma omp critical
+            {
+                if (local_status == da_status_success)
+                    local_status = merge_groups(local_groups, groups);
+                if (local_status != da_status_success)
+                    status = local_status; // LCOV_EXCL_LINE
+            }
+        }
+        if (status == da_status_memory_error)
+            return da_error(err, status, "Memory allocation error"); // LCOV_EXCL_LINE
+        if (status != da_status_success)
+            return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                            "Unexpected error. Possible memory corruption.");
+
+        if (n_groups < (da_int)groups.size()) {
+            n_groups = (da_int)groups.size();
+            return da_warn(err, da_status_invalid_array_dimension,
+                           "The output arrays are too small, they must be of size at "
+                           "least " +
+                               std::to_string(n_groups) + ".");
+        }
+        std::vector<group_stats<T>> sorted_groups;
+        try {
+            sorted_groups.reserve(groups.size());
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+        for (auto &group : groups)
+            sorted_groups.push_back(group.second);
+        std::sort(sorted_groups.begin(), sorted_groups.end(),
+                  [](const group_stats<T> &g1, const group_stats<T> &g2) {
+                      return g1.key < g2.key;
+                  });
+        n_groups = (da_int)sorted_groups.size();
+        for (da_int g = 0; g < n_groups; g++) {
+            const group_stats<T> &group = sorted_groups[g];
+            if (group_keys)
+                group_keys[g] = group.key;
+            if (counts)
+                counts[g] = group.count;
+            if (sums)
+                sums[g] = group.sum;
+            if (means)
+                means[g] = group.sum / (T)group.count;
+            if (mins)
+                mins[g] = group.min;
+            if (maxs)
+                maxs[g] = group.max;
+        }
+
+        return da_status_success;
+    }
+
     /* get|set_element access and modify a single element in the data store
      * exit status:
      * - invalid_input
@@ -1286,6 +1735,10 @@ class data_store {
         block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
         bb->get_col(colidx, &col, stride);
         elem = col[rowidx * stride];
+        if constexpr (!non_missing_types<T>::value) {
+            if (bb->is_null(rowidx))
+                elem = missing_value<T>();
+        }
 
         return da_status_success;
     }
@@ -1325,6 +1778,7 @@ class data_store {
         block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
         bb->get_col(colidx, &col, stride);
         col[rowidx * stride] = elem;
+        bb->set_valid(rowidx);
 
         return da_status_success;
     }
@@ -1666,6 +2120,427 @@ class data_store {
 
         return exit_status;
     }
+
+    /* Import columns from Arrow C data interface structures, see data_store.cpp
+     * Fixed-width numerical buffers are not copied, the store takes ownership of array instead.
+     * Exit status:
+     * - invalid_input
+     * - missing_block
+     * - memory_error
+     */
+    da_status load_from_arrow(ArrowArray *array, const ArrowSchema *schema);
+
+  private:
+    /* Tuning parameters of the parallel selection extraction
+     * extract_task_min: minimum number of elements copied by one extraction task
+     * extract_tasks_per_thread: target number of tasks per thread, for load balancing
+     * extract_transpose_block: block size of the row-major conversion
+     */
+    static constexpr da_int extract_task_min = 16384;
+    static constexpr da_int extract_tasks_per_thread = 4;
+    static constexpr da_int extract_transpose_block = 64;
+
+    /* Row selections made of more intervals than max_selection_intervals are stored as
+     * compressed bitmaps by select_non_missing and select_where
+     */
+    static constexpr da_int max_selection_intervals = 64;
+
+    /* Number of rows and columns in the selection sl */
+    void selection_dims(coord_slice &sl, da_int &n_rows, da_int &n_cols) {
+        n_rows = 0;
+        n_cols = 0;
+        for (auto it_col = sl.col_slice->begin(); it_col != sl.col_slice->end(); ++it_col)
+            n_cols += it_col->upper - it_col->lower + 1;
+        if (sl.row_bits) {
+            n_rows = sl.row_bits->cardinality();
+        } else {
+            for (auto it_row = sl.row_slice->begin(); it_row != sl.row_slice->end();
+                 ++it_row)
+                n_rows += it_row->upper - it_row->lower + 1;
+        }
+    }
+
+    /* Extract the selection sl in column major ordering into data (leading dimension ld)
+     * The selection is split into independent tasks, each copying a chunk of rows and
+     * columns to a disjoint part of data, that are distributed among the threads.
+     * For interval-based row selections, each task walks the blocks of the store through
+     * extract_slice. For bitmap-based ones, a task gathers the rows of one chunk of the
+     * bitmap (see gather_rows).
+     * The types of the blocks are checked serially before the parallel copy.
+     */
+    template <class T>
+    da_status extract_coord_slice(coord_slice &sl, da_int ld, T *data) {
+        struct extract_task {
+            interval rows, cols;
+            da_int idx;
+            da_int chunk; // bitmap chunk to gather, -1 for interval-based selections
+        };
+
+        for (auto it_col = sl.col_slice->begin(); it_col != sl.col_slice->end();
+             ++it_col) {
+            da_int lcol = it_col->lower;
+            while (lcol <= it_col->upper) {
+                columns_map::iterator it = cmap.find(lcol);
+                if (it->second->b->btype != get_block_type<T>())
+                    return da_error(err, da_status_invalid_input,
+                                    "Incompatible type in the slice");
+                lcol = it->first.upper + 1;
+            }
+        }
+        da_int n_rows, n_cols;
+        selection_dims(sl, n_rows, n_cols);
+        if (n_rows == 0 || n_cols == 0)
+            return da_status_success;
+
+        // Size of the chunks: aim for a few tasks per thread, but not too small ones
+        da_int n_threads = (da_int)omp_get_max_threads();
+        int64_t n_elements = (int64_t)n_rows * (int64_t)n_cols;
+        int64_t task_size_64 =
+            std::max((int64_t)extract_task_min,
+                     n_elements / (int64_t)(extract_tasks_per_thread * n_threads));
+        da_int task_size = (da_int)std::min(
+            task_size_64, (int64_t)std::numeric_limits<da_int>::max());
+        da_int chunk_rows = std::min(n_rows, task_size);
+        da_int chunk_cols = std::max((da_int)1, task_size / chunk_rows);
+        if (sl.row_bits) {
+            // The rows are chunked by the bitmap containers
+            chunk_rows = std::min(n_rows, row_bitmap::chunk_size);
+            chunk_cols = std::max((da_int)1, task_size / chunk_rows);
+        }
+
+        std::vector<extract_task> tasks;
+        try {
+            std::vector<da_int> chunk_offset;
+            if (sl.row_bits) {
+                // Position of the first row of each bitmap chunk in the output
+                chunk_offset.resize(sl.row_bits->n_chunks(), 0);
+                for (da_int k = 1; k < sl.row_bits->n_chunks(); k++)
+                    chunk_offset[k] =
+                        chunk_offset[k - 1] + sl.row_bits->chunk_cardinality(k - 1);
+            }
+            da_int col_offset = 0;
+            for (auto it_col = sl.col_slice->begin(); it_col != sl.col_slice->end();
+                 ++it_col) {
+                for (da_int lc = it_col->lower; lc <= it_col->upper; lc += chunk_cols) {
+                    da_int uc = std::min(lc + chunk_cols - 1, it_col->upper);
+                    da_int idx = col_offset * ld;
+                    if (sl.row_bits) {
+                        for (da_int k = 0; k < sl.row_bits->n_chunks(); k++)
+                            tasks.push_back(
+                                {{-1, -1}, {lc, uc}, idx + chunk_offset[k], k});
+                    } else {
+                        for (auto it_row = sl.row_slice->begin();
+                             it_row != sl.row_slice->end(); ++it_row) {
+                            for (da_int lr = it_row->lower; lr <= it_row->upper;
+                                 lr += chunk_rows) {
+                                da_int ur = std::min(lr + chunk_rows - 1, it_row->upper);
+                                tasks.push_back({{lr, ur}, {lc, uc}, idx, -1});
+                                idx += ur - lr + 1;
+                            }
+                        }
+                    }
+                    col_offset += uc - lc + 1;
+                }
+            }
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");  // LCOV_EXCL_LINE
+        }
+
+        da_status status = da_status_success;
+        da_int n_tasks = (da_int)tasks.size();
+        row_bitmap *row_bits = sl.row_bits.get();
+#pragma omp parallel for schedule(dynamic) if (n_tasks > 1) default(none)                 \
+    shared(tasks, n_tasks, ld, data, status, row_bits)
+        for (da_int t = 0; t < n_tasks; t++) {
+            da_status task_status;
+            if (tasks[t].chunk >= 0)
+                task_status = gather_rows(*row_bits, tasks[t].chunk, tasks[t].cols, ld,
+                                          tasks[t].idx, data);
+            else
+                task_status = extract_slice(tasks[t].rows, tasks[t].cols, ld,
+                                            tasks[t].idx, data);
+            if (task_status != da_status_success) {
+#pragma omp critical
+                status = task_status; // LCOV_EXCL_LINE
+            }
+        }
+
+        return status;
+    }
+
+    /* Copy the rows of the chunk k of the bitmap rows, restricted to the columns cols,
+     * into data in column major ordering, starting at index first_idx with leading
+     * dimension ld.
+     * The rows are gathered directly from the blocks, run by run, walking the vertical
+     * chain of blocks of each column once.
+     * The block types are not checked.
+     */
+    template <class T>
+    da_status gather_rows(row_bitmap &rows, da_int k, interval cols, da_int ld,
+                          da_int first_idx, T *data) {
+        da_status status = da_status_success;
+        for (da_int j = cols.lower; j <= cols.upper; j++) {
+            std::shared_ptr<block_id> bid = cmap.find(j)->second;
+            block_base<T> *bb = static_cast<block_base<T> *>(bid->b);
+            da_int first_row = 0, stride;
+            T *col;
+            status = bb->get_col(j - bid->offset, &col, stride);
+            da_int idx = first_idx + (j - cols.lower) * ld;
+            rows.for_each_run(k, [&](da_int lr, da_int ur) {
+                while (lr <= ur && status == da_status_success) {
+                    // Move down the chain to the block containing row lr
+                    while (lr >= first_row + bb->m) {
+                        first_row += bb->m;
+                        bid = bid->next;
+                        bb = static_cast<block_base<T> *>(bid->b);
+                        status = bb->get_col(j - bid->offset, &col, stride);
+                    }
+                    da_int ub = std::min(ur, first_row + bb->m - 1);
+                    const T *c = col + (lr - first_row) * stride;
+                    da_int nr = ub - lr + 1;
+                    if (stride == 1) {
+                        for (da_int i = 0; i < nr; i++)
+                            data[idx + i] = c[i];
+                    } else {
+                        for (da_int i = 0; i < nr; i++)
+                            data[idx + i] = c[i * stride];
+                    }
+                    if constexpr (!non_missing_types<T>::value) {
+                        if (bb->has_validity()) {
+                            for (da_int i = 0; i < nr; i++) {
+                                if (bb->is_null(lr - first_row + i))
+                                    data[idx + i] = missing_value<T>();
+                            }
+                        }
+                    }
+                    idx += nr;
+                    lr = ub + 1;
+                }
+            });
+            if (status != da_status_success)
+                return status; // LCOV_EXCL_LINE
+        }
+        return status;
+    }
+
+    /* Add or remove rows from the selection sl, in whichever representation it uses */
+    da_status insert_rows(coord_slice &sl, interval rows) {
+        if (!sl.row_bits)
+            return sl.row_slice->insert(rows);
+        try {
+            return sl.row_bits->insert(rows);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+    }
+    da_status erase_rows(coord_slice &sl, interval rows) {
+        if (!sl.row_bits)
+            return sl.row_slice->erase(rows);
+        try {
+            return sl.row_bits->erase(rows);
+        } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+            return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation error");
+        }
+    }
+
+    /* Replace the rows of the selection sl by the rows i such that valid_rows[i] != 0.
+     * A few intervals are kept in the interval set, scattered rows are stored in a
+     * bitmap. An empty set of rows is stored as an empty bitmap, since an empty interval
+     * set stands for all the rows.
+     */
+    da_status set_selection_rows(coord_slice &sl, std::vector<uint8_t> &valid_rows) {
+        da_int n_runs = m > 0 && valid_rows[0] ? 1 : 0;
+        for (da_int i = 1; i < m; i++)
+            n_runs += valid_rows[i] > valid_rows[i - 1];
+        if (n_runs > 0 && n_runs <= max_selection_intervals) {
+            sl.row_bits = nullptr;
+            sl.row_slice->clear();
+            da_int i = 0;
+            while (i < m) {
+                if (valid_rows[i]) {
+                    da_int idx_stop = i;
+                    while (idx_stop < m && valid_rows[idx_stop])
+                        idx_stop++;
+                    if (sl.row_slice->insert({i, idx_stop - 1}) != da_status_success)
+                        return da_error_trace( // LCOV_EXCL_LINE
+                            err, da_status_internal_error,
+                            "Failed to update the rows of the selection.");
+                    i = idx_stop;
+                }
+                i++;
+            }
+        } else {
+            try {
+                if (!sl.row_bits)
+                    sl.row_bits = std::make_unique<row_bitmap>();
+                sl.row_bits->assign_mask(m, valid_rows.data());
+            } catch (std::bad_alloc const &) {               // LCOV_EXCL_LINE
+                return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                                "Memory allocation error");
+            }
+            sl.row_slice->clear();
+        }
+        return da_status_success;
+    }
+
+    /* Check that all the blocks storing the column col are of type T */
+    template <class T> bool column_has_type(da_int col) {
+        for (block_id *bid = cmap.find(col)->second.get(); bid != nullptr;
+             bid = bid->next.get()) {
+            if (bid->b->btype != get_block_type<T>())
+                return false;
+        }
+        return true;
+    }
+
+    /* Find the block storing the row i of the column j. On output, bb is the block,
+     * first_row the index in the store of its first row, and col, stride give access to
+     * the column j in the block (see get_col).
+     * The store is not modified: it can be called concurrently by several threads.
+     * The block type is not checked.
+     */
+    template <class T>
+    da_status locate_row(da_int j, da_int i, block_base<T> *&bb, da_int &first_row,
+                         T *&col, da_int &stride) {
+        block_id *bid = cmap.find(j)->second.get();
+        first_row = 0;
+        while (bid != nullptr && i >= first_row + bid->b->m) {
+            first_row += bid->b->m;
+            bid = bid->next.get();
+        }
+        if (bid == nullptr)
+            return da_status_internal_error; // LCOV_EXCL_LINE
+        bb = static_cast<block_base<T> *>(bid->b);
+        return bb->get_col(j - bid->offset, &col, stride);
+    }
+
+    /* Evaluate the predicate data[i, col] <op> value on all the rows of the store into
+     * mask, in parallel over chunks of rows.
+     */
+    template <class T>
+    da_status compare_column(da_int col, da_data_compare op, T value, uint8_t *mask) {
+        da_status status = da_status_success;
+        da_int n_rows = m;
+        const da_int chunk = extract_task_min;
+        da_int n_tasks = (n_rows + chunk - 1) / chunk;
+#pragma omp parallel for schedule(dynamic) if (n_tasks > 1) default(none)                 \
+    shared(n_tasks, n_rows, chunk, col, op, value, mask, status)
+        for (da_int t = 0; t < n_tasks; t++) {
+            da_int lr = t * chunk, ur = std::min(n_rows, lr + chunk) - 1;
+            while (lr <= ur) {
+                block_base<T> *bb;
+                da_int first_row, stride;
+                T *c;
+                if (locate_row(col, lr, bb, first_row, c, stride) != da_status_success) {
+#pragma omp critical
+                    status = da_status_internal_error; // LCOV_EXCL_LINE
+                    break;                             // LCOV_EXCL_LINE
+                }
+                da_int ub = std::min(ur, first_row + bb->m - 1);
+                compare_values(c + (lr - first_row) * stride, stride, ub - lr + 1, value,
+                               op, mask + lr);
+                if (bb->has_validity()) {
+                    for (da_int i = lr; i <= ub; i++) {
+                        if (bb->is_null(i - first_row))
+                            mask[i] = 0;
+                    }
+                }
+                lr = ub + 1;
+            }
+        }
+        return status;
+    }
+
+    /* Aggregate the rows of the store in [rows.lower, rows.upper] into the hash map
+     * groups, see group_by. The column types are not checked.
+     */
+    template <class T>
+    da_status aggregate_rows(interval rows, da_int key_col, da_int value_col,
+                             std::unordered_map<da_int, group_stats<T>> &groups) {
+        da_int lr = rows.lower;
+        while (lr <= rows.upper) {
+            block_base<da_int> *kb;
+            block_base<T> *vb;
+            da_int kfirst, vfirst, kstride, vstride;
+            da_int *kc;
+            T *vc;
+            if (locate_row(key_col, lr, kb, kfirst, kc, kstride) != da_status_success ||
+                locate_row(value_col, lr, vb, vfirst, vc, vstride) != da_status_success)
+                return da_status_internal_error; // LCOV_EXCL_LINE
+            da_int ur = std::min({rows.upper, kfirst + kb->m - 1, vfirst + vb->m - 1});
+            try {
+                for (da_int i = lr; i <= ur; i++) {
+                    da_int k = kc[(i - kfirst) * kstride];
+                    T v = vc[(i - vfirst) * vstride];
+                    if (is_missing_value(k) || is_missing_value(v) ||
+                        kb->is_null(i - kfirst) || vb->is_null(i - vfirst))
+                        continue;
+                    auto [it, inserted] = groups.try_emplace(k);
+                    group_stats<T> &group = it->second;
+                    if (inserted) {
+                        group.key = k;
+                        group.min = v;
+                        group.max = v;
+                    }
+                    group.count++;
+                    group.sum += v;
+                    group.min = std::min(group.min, v);
+                    group.max = std::max(group.max, v);
+                }
+            } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+                return da_status_memory_error; // LCOV_EXCL_LINE
+            }
+            lr = ur + 1;
+        }
+        return da_status_success;
+    }
+
+    /* Merge the groups of src into dst */
+    template <class T>
+    da_status merge_groups(std::unordered_map<da_int, group_stats<T>> &src,
+                           std::unordered_map<da_int, group_stats<T>> &dst) {
+        try {
+            for (auto &group : src) {
+                auto [it, inserted] = dst.try_emplace(group.first, group.second);
+                if (!inserted) {
+                    group_stats<T> &dst_group = it->second;
+                    dst_group.count += group.second.count;
+                    dst_group.sum += group.second.sum;
+                    dst_group.min = std::min(dst_group.min, group.second.min);
+                    dst_group.max = std::max(dst_group.max, group.second.max);
+                }
+            }
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+            return da_status_memory_error; // LCOV_EXCL_LINE
+        }
+        return da_status_success;
+    }
+
+    /* Merge the intervals of set into bounds. Return false if they are not contiguous.
+     * bounds is unchanged if the set is empty.
+     */
+    bool contiguous_bounds(interval_set &set, interval &bounds) {
+        bool first = true;
+        for (auto it = set.begin(); it != set.end(); ++it) {
+            if (first) {
+                bounds = *it;
+                first = false;
+            } else if (it->lower == bounds.upper + 1) {
+                bounds.upper = it->upper;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    da_status add_arrow_column(da_int nrows, T *data, bool copy_data, bool own_data,
+                               std::vector<uint8_t> &validity,
+                               std::shared_ptr<void> owner);
 }; // end of data_store
 
 /* Template specialization declaration
@@ -260,6 +260,21 @@ da_status da_data_load_row_uint8(da_datastore store, da_int n_rows, da_int n_col
     return store->store->concatenate_rows(n_rows, n_cols, block, order, cpy);
 }
 
+da_status da_data_load_col_arrow(da_datastore store, ArrowArray *array,
+                                 ArrowSchema *schema) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!array || !schema)
+        return da_error(store->err, da_status_invalid_input,
+                        "array and schema have to be defined");
+
+    return store->store->load_from_arrow(array, schema);
+}
+
 /* ************************************* selection *********************************** */
 /* *********************************************************************************** */
 da_status da_data_select_columns(da_datastore store, const char *key, da_int lbound,
@@ -344,6 +359,90 @@ da_status da_data_select_non_missing(da_datastore store, const char *key,
 
     return store->store->select_non_missing(key_str, fr);
 }
+da_status da_data_select_where_int(da_datastore store, const char *key, da_int col_idx,
+                                   da_data_compare op, da_int value,
+                                   da_data_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+
+    return store->store->select_where(key_str, col_idx, op, value, combine);
+}
+da_status da_data_select_where_real_d(da_datastore store, const char *key,
+                                      da_int col_idx, da_data_compare op, double value,
+                                      da_data_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+
+    return store->store->select_where(key_str, col_idx, op, value, combine);
+}
+da_status da_data_select_where_real_s(da_datastore store, const char *key,
+                                      da_int col_idx, da_data_compare op, float value,
+                                      da_data_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+
+    return store->store->select_where(key_str, col_idx, op, value, combine);
+}
+da_status da_data_select_where_uint8(da_datastore store, const char *key, da_int col_idx,
+                                     da_data_compare op, uint8_t value,
+                                     da_data_combine combine) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+
+    std::string key_str(key);
+    if (!da_data::check_internal_string(key_str)) {
+        std::string errmsg = "key cannot contain the prefix: ";
+        errmsg += DA_STRINTERNAL;
+        return da_error(store->err, da_status_invalid_input, errmsg);
+    }
+
+    return store->store->select_where(key_str, col_idx, op, value, combine);
+}
 da_status da_data_select_remove_columns(da_datastore store, const char *key,
                                         da_int lbound, da_int ubound) {
     if (!store)
@@ -515,6 +614,120 @@ da_status da_data_extract_selection_uint8(da_datastore store, const char *key,
     return store->store->extract_selection(key, order, lddata, data);
 }
 
+da_status da_data_get_selection_view_int(da_datastore store, const char *key,
+                                         da_int **data, da_int *n_rows, da_int *n_cols,
+                                         da_int *lddata) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!data || !n_rows || !n_cols || !lddata)
+        return da_error(store->err, da_status_invalid_input,
+                        "data, n_rows, n_cols and lddata have to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    return store->store->selection_view(key, *data, *n_rows, *n_cols, *lddata);
+}
+da_status da_data_get_selection_view_real_d(da_datastore store, const char *key,
+                                            double **data, da_int *n_rows, da_int *n_cols,
+                                            da_int *lddata) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!data || !n_rows || !n_cols || !lddata)
+        return da_error(store->err, da_status_invalid_input,
+                        "data, n_rows, n_cols and lddata have to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    return store->store->selection_view(key, *data, *n_rows, *n_cols, *lddata);
+}
+da_status da_data_get_selection_view_real_s(da_datastore store, const char *key,
+                                            float **data, da_int *n_rows, da_int *n_cols,
+                                            da_int *lddata) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!data || !n_rows || !n_cols || !lddata)
+        return da_error(store->err, da_status_invalid_input,
+                        "data, n_rows, n_cols and lddata have to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    return store->store->selection_view(key, *data, *n_rows, *n_cols, *lddata);
+}
+da_status da_data_get_selection_view_uint8(da_datastore store, const char *key,
+                                           uint8_t **data, da_int *n_rows, da_int *n_cols,
+                                           da_int *lddata) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!key)
+        return da_error(store->err, da_status_invalid_input, "key has to be defined");
+    if (!data || !n_rows || !n_cols || !lddata)
+        return da_error(store->err, da_status_invalid_input,
+                        "data, n_rows, n_cols and lddata have to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    return store->store->selection_view(key, *data, *n_rows, *n_cols, *lddata);
+}
+
+/* ************************************ aggregation ********************************** */
+/* *********************************************************************************** */
+da_status da_data_group_by_real_d(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, double *sums, double *means,
+                                  double *mins, double *maxs) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!n_groups)
+        return da_error(store->err, da_status_invalid_input,
+                        "n_groups has to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    std::string key_str = key ? key : "";
+    return store->store->group_by(key_str, key_col, value_col, *n_groups, group_keys,
+                                  counts, sums, means, mins, maxs);
+}
+da_status da_data_group_by_real_s(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, float *sums, float *means, float *mins,
+                                  float *maxs) {
+    if (!store)
+        return da_status_store_not_initialized;
+    store->clear(); // Clean up store logs
+    if (!n_groups)
+        return da_error(store->err, da_status_invalid_input,
+                        "n_groups has to be defined");
+
+    if (store->store == nullptr)
+        return da_error(store->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");        // LCOV_EXCL_LINE
+
+    std::string key_str = key ? key : "";
+    return store->store->group_by(key_str, key_col, value_col, *n_groups, group_keys,
+                                  counts, sums, means, mins, maxs);
+}
+
 /* ************************************* headings ************************************ */
 /* *********************************************************************************** */
 da_status da_data_label_column(da_datastore store, const char *label, da_int col_idx) {
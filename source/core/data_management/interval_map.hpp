@@ -151,10 +151,11 @@ template <class T> class interval_map {
         auto it_lb = imap.lower_bound(key_pair);
         if (it_lb == imap.end() || key_pair != it_lb->first)
             --it_lb;
-        iterator it(it_lb);
-        if (it == this->end() || key < it->first.lower || key > it->first.upper)
-            it = this->end();
-        return it;
+        // Compare directly with imap.end(): the lookup does not modify the map and can be
+        // performed concurrently by several threads
+        if (it_lb == imap.end() || key < it_lb->first.lower || key > it_lb->first.upper)
+            return iterator(imap.end());
+        return iterator(it_lb);
     }
 
     /* Returns an iterator to the biggest interval smaller than the key.
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "row_bitmap.hpp"
+#include "aoclda.h"
+#include "interval.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace da_interval {
+
+namespace {
+// Portable population count of a 64-bit word
+inline da_int popcount64(uint64_t w) {
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (da_int)((w * 0x0101010101010101ULL) >> 56);
+}
+
+// Set (or clear) the bits [lo, hi] of the bitset words
+void set_bits(std::vector<uint64_t> &words, da_int lo, da_int hi, bool value) {
+    da_int wlo = lo / 64, whi = hi / 64;
+    for (da_int w = wlo; w <= whi; w++) {
+        da_int blo = w == wlo ? lo % 64 : 0;
+        da_int bhi = w == whi ? hi % 64 : 63;
+        uint64_t mask = (bhi == 63 ? ~(uint64_t)0 : (((uint64_t)1 << (bhi + 1)) - 1)) &
+                        ~(((uint64_t)1 << blo) - 1);
+        if (value)
+            words[w] |= mask;
+        else
+            words[w] &= ~mask;
+    }
+}
+} // namespace
+
+void row_bitmap::container::to_bitset() {
+    if (is_bitset)
+        return;
+    bits.assign(n_words, 0);
+    for (uint16_t off : array)
+        bits[off / 64] |= (uint64_t)1 << (off % 64);
+    std::vector<uint16_t>().swap(array);
+    is_bitset = true;
+}
+
+void row_bitmap::container::to_array() {
+    if (!is_bitset)
+        return;
+    std::vector<uint16_t> new_array;
+    new_array.reserve(card);
+    for_each_run([&](da_int lo, da_int hi) {
+        for (da_int off = lo; off <= hi; off++)
+            new_array.push_back((uint16_t)off);
+    });
+    array.swap(new_array);
+    std::vector<uint64_t>().swap(bits);
+    is_bitset = false;
+}
+
+void row_bitmap::container::normalize() {
+    if (is_bitset && card <= array_max)
+        to_array();
+    else if (!is_bitset && card > array_max)
+        to_bitset();
+}
+
+void row_bitmap::container::insert(da_int lo, da_int hi) {
+    if (!is_bitset && card + (hi - lo + 1) > array_max)
+        to_bitset();
+    if (is_bitset) {
+        set_bits(bits, lo, hi, true);
+        card = 0;
+        for (uint64_t w : bits)
+            card += popcount64(w);
+    } else {
+        // Merge the sorted range into the array
+        auto first = std::lower_bound(array.begin(), array.end(), (uint16_t)lo);
+        auto last = std::upper_bound(first, array.end(), (uint16_t)hi);
+        da_int pos = (da_int)(first - array.begin());
+        array.erase(first, last);
+        std::vector<uint16_t> range(hi - lo + 1);
+        for (da_int off = lo; off <= hi; off++)
+            range[off - lo] = (uint16_t)off;
+        array.insert(array.begin() + pos, range.begin(), range.end());
+        card = (da_int)array.size();
+    }
+    normalize();
+}
+
+void row_bitmap::container::erase(da_int lo, da_int hi) {
+    if (is_bitset) {
+        set_bits(bits, lo, hi, false);
+        card = 0;
+        for (uint64_t w : bits)
+            card += popcount64(w);
+    } else {
+        auto first = std::lower_bound(array.begin(), array.end(), (uint16_t)lo);
+        auto last = std::upper_bound(first, array.end(), (uint16_t)hi);
+        array.erase(first, last);
+        card = (da_int)array.size();
+    }
+    normalize();
+}
+
+bool row_bitmap::container::contains(da_int off) const {
+    if (is_bitset)
+        return (bits[off / 64] >> (off % 64)) & 1;
+    return std::binary_search(array.begin(), array.end(), (uint16_t)off);
+}
+
+da_int row_bitmap::find_chunk(da_int key, bool create) {
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    da_int pos = (da_int)(it - keys.begin());
+    if (it != keys.end() && *it == key)
+        return pos;
+    if (!create)
+        return -1;
+    keys.insert(it, key);
+    conts.insert(conts.begin() + pos, container());
+    return pos;
+}
+
+void row_bitmap::clear() {
+    keys.clear();
+    conts.clear();
+}
+
+da_int row_bitmap::cardinality() const {
+    da_int card = 0;
+    for (const container &c : conts)
+        card += c.card;
+    return card;
+}
+
+bool row_bitmap::contains(da_int row) const {
+    if (row < 0)
+        return false;
+    auto it = std::lower_bound(keys.begin(), keys.end(), row >> chunk_bits);
+    if (it == keys.end() || *it != row >> chunk_bits)
+        return false;
+    return conts[it - keys.begin()].contains(row & (chunk_size - 1));
+}
+
+da_status row_bitmap::insert(interval rows) {
+    if (rows.lower < 0 || rows.upper < rows.lower)
+        return da_status_invalid_input;
+    for (da_int key = rows.lower >> chunk_bits; key <= rows.upper >> chunk_bits; key++) {
+        da_int first = key << chunk_bits;
+        da_int lo = std::max(rows.lower, first) - first;
+        da_int hi = std::min(rows.upper, first + chunk_size - 1) - first;
+        conts[find_chunk(key, true)].insert(lo, hi);
+    }
+    return da_status_success;
+}
+
+da_status row_bitmap::erase(interval rows) {
+    if (rows.lower < 0 || rows.upper < rows.lower)
+        return da_status_invalid_input;
+    for (da_int key = rows.lower >> chunk_bits; key <= rows.upper >> chunk_bits; key++) {
+        da_int pos = find_chunk(key, false);
+        if (pos < 0)
+            continue;
+        da_int first = key << chunk_bits;
+        da_int lo = std::max(rows.lower, first) - first;
+        da_int hi = std::min(rows.upper, first + chunk_size - 1) - first;
+        conts[pos].erase(lo, hi);
+        if (conts[pos].card == 0) {
+            keys.erase(keys.begin() + pos);
+            conts.erase(conts.begin() + pos);
+        }
+    }
+    return da_status_success;
+}
+
+void row_bitmap::assign_mask(da_int n, const uint8_t *mask) {
+    clear();
+    for (da_int first = 0; first < n; first += chunk_size) {
+        da_int len = std::min(chunk_size, n - first);
+        da_int card = 0;
+        for (da_int i = 0; i < len; i++)
+            card += mask[first + i] != 0;
+        if (card == 0)
+            continue;
+        container c;
+        c.card = card;
+        if (card > array_max) {
+            c.is_bitset = true;
+            c.bits.assign(n_words, 0);
+            for (da_int i = 0; i < len; i++)
+                c.bits[i / 64] |= (uint64_t)(mask[first + i] != 0) << (i % 64);
+        } else {
+            c.array.reserve(card);
+            for (da_int i = 0; i < len; i++) {
+                if (mask[first + i])
+                    c.array.push_back((uint16_t)i);
+            }
+        }
+        keys.push_back(first >> chunk_bits);
+        conts.push_back(std::move(c));
+    }
+}
+
+void row_bitmap::fill_mask(da_int n, uint8_t *mask) const {
+    for (da_int k = 0; k < n_chunks(); k++) {
+        for_each_run(k, [&](da_int lo, da_int hi) {
+            for (da_int i = lo; i <= std::min(hi, n - 1); i++)
+                mask[i] = 1;
+        });
+    }
+}
+
+da_int row_bitmap::n_runs() const {
+    da_int runs = 0;
+    for_each_run([&](da_int, da_int) { runs++; });
+    return runs;
+}
+
+} // namespace da_interval
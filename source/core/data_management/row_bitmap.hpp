@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef ROW_BITMAP_HPP
+#define ROW_BITMAP_HPP
+
+#include "aoclda.h"
+#include "interval.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace da_interval {
+
+/* Compressed set of row indices, in the spirit of roaring bitmaps
+ *
+ * The index space is split into chunks of 2^16 rows. Each non-empty chunk is stored in a
+ * container that is either:
+ * - a sorted array of the 16-bit offsets of its rows, if it contains at most array_max rows,
+ * - a bitset of 2^16 bits otherwise.
+ * Both scattered and dense sets of rows are stored compactly, whatever the number of
+ * intervals they are made of, and the rows can be traversed chunk by chunk in increasing
+ * order, which allows the chunks to be processed independently.
+ *
+ * Functions allocating memory can throw std::bad_alloc, it should be caught by the caller.
+ */
+class row_bitmap {
+  public:
+    static constexpr da_int chunk_bits = 16;
+    static constexpr da_int chunk_size = (da_int)1 << chunk_bits;
+    static constexpr da_int array_max = 4096;
+
+  private:
+    static constexpr da_int n_words = chunk_size / 64;
+
+    struct container {
+        bool is_bitset = false;
+        da_int card = 0;
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bits;
+
+        void to_bitset();
+        void to_array();
+        // Choose the representation according to the cardinality
+        void normalize();
+        void insert(da_int lo, da_int hi);
+        void erase(da_int lo, da_int hi);
+        bool contains(da_int off) const;
+        // Call f(lower, upper) for the maximal runs of consecutive offsets
+        template <class F> void for_each_run(F f) const;
+    };
+
+    // Sorted chunk keys (row index >> chunk_bits) and their containers
+    std::vector<da_int> keys;
+    std::vector<container> conts;
+
+    // Position of key in keys, inserting an empty container if create is true.
+    // Return -1 if the key is not found and not created.
+    da_int find_chunk(da_int key, bool create);
+
+  public:
+    bool empty() const { return keys.empty(); }
+    void clear();
+    da_int cardinality() const;
+    bool contains(da_int row) const;
+
+    // Add or remove all the rows in [rows.lower, rows.upper]
+    da_status insert(interval rows);
+    da_status erase(interval rows);
+
+    // Replace the content with all the indices i in [0, n) such that mask[i] != 0
+    void assign_mask(da_int n, const uint8_t *mask);
+    // Set mask[i] to 1 for all the rows i of the set, mask is of size at least n
+    void fill_mask(da_int n, uint8_t *mask) const;
+
+    // Number of maximal intervals of consecutive rows in the set
+    da_int n_runs() const;
+
+    // Chunk-wise access: rows of the chunk k are all in
+    // [chunk_first_row(k), chunk_first_row(k) + chunk_size - 1]
+    da_int n_chunks() const { return (da_int)keys.size(); }
+    da_int chunk_first_row(da_int k) const { return keys[k] << chunk_bits; }
+    da_int chunk_cardinality(da_int k) const { return conts[k].card; }
+
+    // Call f(lower, upper) for all the maximal intervals of consecutive rows of the
+    // chunk k (respectively of the whole set) in increasing order.
+    // The second version merges the runs crossing the chunk boundaries.
+    template <class F> void for_each_run(da_int k, F f) const {
+        da_int first = chunk_first_row(k);
+        conts[k].for_each_run(
+            [&](da_int lo, da_int hi) { f(first + lo, first + hi); });
+    }
+    template <class F> void for_each_run(F f) const {
+        da_int lower = -1, upper = -2;
+        for (da_int k = 0; k < n_chunks(); k++) {
+            for_each_run(k, [&](da_int lo, da_int hi) {
+                if (lo == upper + 1) {
+                    upper = hi;
+                } else {
+                    if (upper >= lower && lower >= 0)
+                        f(lower, upper);
+                    lower = lo;
+                    upper = hi;
+                }
+            });
+        }
+        if (upper >= lower && lower >= 0)
+            f(lower, upper);
+    }
+};
+
+template <class F> void row_bitmap::container::for_each_run(F f) const {
+    if (!is_bitset) {
+        da_int n = (da_int)array.size();
+        da_int i = 0;
+        while (i < n) {
+            da_int lo = array[i];
+            while (i + 1 < n && array[i + 1] == array[i] + 1)
+                i++;
+            f(lo, (da_int)array[i]);
+            i++;
+        }
+        return;
+    }
+    da_int lo = -1;
+    for (da_int w = 0; w < n_words; w++) {
+        uint64_t word = bits[w];
+        if (word == 0 || word == ~(uint64_t)0) {
+            // Whole word empty or full: close or extend the current run
+            if (word == 0 && lo >= 0) {
+                f(lo, 64 * w - 1);
+                lo = -1;
+            } else if (word != 0 && lo < 0) {
+                lo = 64 * w;
+            }
+            continue;
+        }
+        for (da_int b = 0; b < 64; b++) {
+            bool set = (word >> b) & 1;
+            if (set && lo < 0) {
+                lo = 64 * w + b;
+            } else if (!set && lo >= 0) {
+                f(lo, 64 * w + b - 1);
+                lo = -1;
+            }
+        }
+    }
+    if (lo >= 0)
+        f(lo, chunk_size - 1);
+}
+
+} // namespace da_interval
+
+#endif
@@ -57,9 +57,11 @@ template <typename T> class node {
 
     // prediction data
     // y_pred: contains the predicted class of the data if all children were pruned
+    // y_mean: mean of the node targets, used instead of y_pred in regression
     // feature: Index of the feature the node is branching on, ignore if leaf
     // x_threshold: branch to the left child if x[feature] < threshold, right otherwise
     da_int y_pred = 0;
+    T y_mean = 0.0;
     da_int feature = -1;
     T x_threshold = 0.0;
 
@@ -99,12 +101,15 @@ template <typename T> class decision_tree : public basic_handle<T> {
     // user data. Never modified by the classifier
     // X[n_samples x n_features]: features -- floating point matrix, column major
     // y[n_samples]: labels -- integer array, 0,...,n_classes-1 values
+    // y_reg[n_samples]: targets -- floating point array, used instead of y in regression
     // n_obs: the number of observations to pick randomly from the total samples.
     //        After call to set_training_data, 0 < n_obs <= n_samples
     // depth: the depth of the tree once trained
     // ldx: X leading dimension
     const T *X = nullptr;
     const da_int *y = nullptr;
+    const T *y_reg = nullptr;
+    bool regression = false;
     da_int ldx;
     da_int n_samples = 0;
     da_int n_features = 0;
@@ -142,6 +147,14 @@ template <typename T> class decision_tree : public basic_handle<T> {
     std::vector<da_int> count_left_classes, count_right_classes;
     std::vector<T> feature_values;
 
+    // Regression working memory
+    // reg_scale: impurity of the root node. The regression scores of all the nodes are
+    //            divided by it, so that the score options do not depend on the scale of y
+    // reg_work: size 4*n_obs. used by the absolute error criterion, see
+    //           find_best_split_regression
+    T reg_scale = 1.0;
+    std::vector<T> reg_work;
+
     // features_idx: size n_features. Vector containing all the indices of the features.
     //               primarily used to pick a random subselection of indices to consider
     //               for splitting a node
@@ -180,15 +193,28 @@ template <typename T> class decision_tree : public basic_handle<T> {
     da_status set_training_data(da_int n_samples, da_int n_features, const T *X,
                                 da_int ldx, const da_int *y, da_int n_class = 0,
                                 da_int n_obs = 0, da_int *samples_subset = nullptr);
+    da_status set_regression_data(da_int n_samples, da_int n_features, const T *X,
+                                  da_int ldx, const T *y, da_int n_obs = 0,
+                                  da_int *samples_subset = nullptr);
     void count_class_occurences(std::vector<da_int> &class_occ, da_int start_idx,
                                 da_int end_idx);
     void sort_samples(node<T> &nd, da_int feat_idx);
+    void sort_samples(const node<T> &nd, da_int feat_idx, da_int *samples, T *values);
 
     void partition_samples(const node<T> &nd);
     da_status add_node(da_int parent_idx, bool is_left, T score, da_int split_idx);
     da_int get_next_node_idx(da_int build_order);
-    void find_best_split(node<T> &current_node, T feat_thresh, T maximum_split_score,
-                         split<T> &sp);
+    void find_best_split(const node<T> &current_node, T feat_thresh,
+                         T maximum_split_score, const da_int *samples, const T *values,
+                         const da_int *node_count_classes,
+                         std::vector<da_int> &count_left_classes,
+                         std::vector<da_int> &count_right_classes, split<T> &sp);
+    void find_best_split_regression(const node<T> &current_node, T feat_thresh,
+                                    T maximum_split_score, const da_int *samples,
+                                    const T *values, T *work, split<T> &sp);
+    T regression_impurity(const node<T> &nd);
+    da_status find_best_splits(const std::vector<da_int> &batch,
+                               std::vector<split<T>> &best_splits);
     da_status fit();
     da_status predict(da_int nsamp, da_int n_features, const T *X_test, da_int ldx,
                       da_int *y_pred, da_int mode = 0);
@@ -198,6 +224,10 @@ template <typename T> class decision_tree : public basic_handle<T> {
                                 da_int ldx, T *y_pred, da_int n_class, da_int ldy);
     da_status score(da_int nsamp, da_int nfeat, const T *X_test, da_int ldx,
                     const da_int *y_test, T *accuracy);
+    da_status predict_regression(da_int nsamp, da_int n_features, const T *X_test,
+                                 da_int ldx, T *y_pred, da_int mode = 0);
+    da_status score_regression(da_int nsamp, da_int nfeat, const T *X_test, da_int ldx,
+                               const T *y_test, T *score);
     void clear_working_memory();
 
     void refresh();
@@ -231,8 +261,11 @@ template <typename T> class random_forest : public basic_handle<T> {
     // User data. Never modified by the classifier
     // X[n_samples X n_features]: features -- floating point matrix, column major
     // y[n_samples]: labels -- integer array, 0,...,n_classes-1 values
+    // y_reg[n_samples]: targets -- floating point array, used instead of y in regression
     const T *X = nullptr;
     const da_int *y = nullptr;
+    const T *y_reg = nullptr;
+    bool regression = false;
     da_int n_samples = 0;
     da_int ldx = 0;
     da_int n_features = 0;
@@ -254,6 +287,8 @@ template <typename T> class random_forest : public basic_handle<T> {
     ~random_forest();
     da_status set_training_data(da_int n_samples, da_int n_features, const T *X,
                                 da_int ldx, const da_int *y, da_int n_class = 0);
+    da_status set_regression_data(da_int n_samples, da_int n_features, const T *X,
+                                  da_int ldx, const T *y);
     da_status fit();
     void parallel_count_classes(const T *X_test, da_int ldx_test, const da_int &n_blocks,
                                 const da_int &block_size, const da_int &block_rem,
@@ -268,6 +303,10 @@ template <typename T> class random_forest : public basic_handle<T> {
                                 da_int ldx, T *y_pred, da_int n_class, da_int ldy);
     da_status score(da_int nsamp, da_int nfeat, const T *X_test, da_int ldx_test,
                     const da_int *y_test, T *score);
+    da_status predict_regression(da_int nsamp, da_int nfeat, const T *X_test,
+                                 da_int ldx_test, T *y_pred);
+    da_status score_regression(da_int nsamp, da_int nfeat, const T *X_test,
+                               da_int ldx_test, const T *y_test, T *score);
 
     da_status get_result(da_result query, da_int *dim, T *result);
     da_status get_result([[maybe_unused]] da_result query, [[maybe_unused]] da_int *dim,
@@ -287,6 +326,8 @@ template <class T>
 T misclassification_score(da_int n_samples, [[maybe_unused]] da_int n_class,
                           std::vector<da_int> &count_classes);
 
+template <class T> T r2_score(da_int n, const T *y, const T *y_pred);
+
 } // namespace da_decision_forest
 
 } // namespace ARCH
@@ -35,6 +35,7 @@
 #include "macros.h"
 #include "options.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <deque>
 #include <functional>
@@ -99,6 +100,65 @@ T misclassification_score(da_int n_samples, [[maybe_unused]] da_int n_class,
     return score;
 }
 
+/* Coefficient of determination of the predictions y_pred of the n targets y. As in most
+ * libraries, constant targets give 1 if they are predicted exactly and 0 otherwise. */
+template <class T> T r2_score(da_int n, const T *y, const T *y_pred) {
+    T mean = 0.0;
+    for (da_int i = 0; i < n; i++)
+        mean += y[i];
+    mean /= (T)n;
+    T ss_res = 0.0, ss_tot = 0.0;
+    for (da_int i = 0; i < n; i++) {
+        ss_res += (y[i] - y_pred[i]) * (y[i] - y_pred[i]);
+        ss_tot += (y[i] - mean) * (y[i] - mean);
+    }
+    if (ss_tot <= (T)0.0)
+        return ss_res <= (T)0.0 ? (T)1.0 : (T)0.0;
+    return (T)1.0 - ss_res / ss_tot;
+}
+
+/* Compute cost[i], the sum of the absolute deviations of value(0),...,value(i) to their
+ * median, for all i < n in a single pass. The values seen so far are split between a
+ * max-heap lo holding the lower half and a min-heap hi holding the upper half, so that
+ * the median is lo[0] and each new value costs O(log n). lo and hi are workspaces of
+ * size n.
+ */
+template <class T, class Value>
+void abs_deviation_costs(da_int n, Value value, T *cost, T *lo, T *hi) {
+    da_int n_lo = 0, n_hi = 0;
+    T sum_lo = 0.0, sum_hi = 0.0;
+    for (da_int i = 0; i < n; i++) {
+        T v = value(i);
+        if (n_lo == 0 || v <= lo[0]) {
+            lo[n_lo++] = v;
+            std::push_heap(lo, lo + n_lo);
+            sum_lo += v;
+        } else {
+            hi[n_hi++] = v;
+            std::push_heap(hi, hi + n_hi, std::greater<T>());
+            sum_hi += v;
+        }
+        // Rebalance the halves so that lo holds one more value than hi at most
+        if (n_lo > n_hi + 1) {
+            std::pop_heap(lo, lo + n_lo);
+            v = lo[--n_lo];
+            sum_lo -= v;
+            hi[n_hi++] = v;
+            std::push_heap(hi, hi + n_hi, std::greater<T>());
+            sum_hi += v;
+        } else if (n_hi > n_lo) {
+            std::pop_heap(hi, hi + n_hi, std::greater<T>());
+            v = hi[--n_hi];
+            sum_hi -= v;
+            lo[n_lo++] = v;
+            std::push_heap(lo, lo + n_lo);
+            sum_lo += v;
+        }
+        T median = lo[0];
+        cost[i] = std::max(median * (T)n_lo - sum_lo + sum_hi - median * (T)n_hi, (T)0.0);
+    }
+}
+
 template <typename T>
 decision_tree<T>::decision_tree(da_errors::da_error_t &err) : basic_handle<T>(err) {
     // Initialize the options registry
@@ -137,7 +197,8 @@ template <typename T> void decision_tree<T>::refresh() {
 template <typename T> da_status decision_tree<T>::resize_tree(size_t new_size) {
     try {
         tree.resize(new_size);
-        class_props.resize(new_size * this->n_class);
+        if (predict_proba_opt && !regression)
+            class_props.resize(new_size * this->n_class);
         return da_status_success;
     } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
         return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
@@ -251,6 +312,8 @@ da_status decision_tree<T>::set_training_data(da_int n_samples, da_int n_feature
 
     this->refresh();
     this->y = y;
+    this->y_reg = nullptr;
+    this->regression = false;
     this->n_samples = n_samples;
     this->n_features = n_features;
     this->n_class = n_class;
@@ -279,6 +342,63 @@ da_status decision_tree<T>::set_training_data(da_int n_samples, da_int n_feature
     return da_status_success;
 }
 
+template <typename T>
+da_status decision_tree<T>::set_regression_data(da_int n_samples, da_int n_features,
+                                                const T *X, da_int ldx, const T *y,
+                                                da_int n_obs, da_int *samples_subset) {
+
+    // Guard against errors due to multiple calls using the same class instantiation
+    if (X_temp) {
+        delete[] (X_temp);
+        X_temp = nullptr;
+    }
+
+    da_status status =
+        this->store_2D_array(n_samples, n_features, X, ldx, &X_temp, &this->X, this->ldx,
+                             "n_samples", "n_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    status = this->check_1D_array(n_samples, y, "n_samples", "y", 1);
+    if (status != da_status_success)
+        return status;
+
+    if (n_obs > n_samples || n_obs < 0) {
+        return da_error_bypass(this->err, da_status_invalid_input,
+                               "n_obs = " + std::to_string(n_obs) +
+                                   ", it must be set between 0 and n_samples = " +
+                                   std::to_string(n_samples));
+    }
+
+    this->refresh();
+    this->y = nullptr;
+    this->y_reg = y;
+    this->regression = true;
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->n_class = 0;
+    this->n_obs = n_obs;
+    if (this->n_obs == 0)
+        this->n_obs = this->n_samples;
+    this->samples_subset = samples_subset;
+
+    // Initialize working memory, the class counts are not used
+    try {
+        samples_idx.resize(this->n_obs);
+        feature_values.resize(this->n_obs);
+        features_idx.resize(this->n_features);
+    } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
+        return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                               "Memory allocation error");
+    }
+    count_classes.clear();
+    count_left_classes.clear();
+    count_right_classes.clear();
+    da_std::iota(features_idx.begin(), features_idx.end(), 0);
+
+    return da_status_success;
+}
+
 template <class T>
 void decision_tree<T>::count_class_occurences(std::vector<da_int> &class_occ,
                                               da_int start_idx, da_int end_idx) {
@@ -301,8 +421,7 @@ da_status decision_tree<T>::add_node(da_int parent_idx, bool is_left, T score,
     if (tree.size() <= (size_t)n_nodes) {
         size_t new_size = 2 * tree.size() + 1;
         // Resize the tree and class_props arrays
-        if (predict_proba_opt)
-            status = resize_tree(new_size);
+        status = resize_tree(new_size);
         if (status != da_status_success)
             return status;
     }
@@ -321,6 +440,15 @@ da_status decision_tree<T>::add_node(da_int parent_idx, bool is_left, T score,
         this->depth = tree[n_nodes].depth;
     tree[n_nodes].score = score;
     tree[n_nodes].n_samples = tree[n_nodes].end_idx - tree[n_nodes].start_idx + 1;
+    if (regression) {
+        // Prediction: mean of the targets in the samples subset
+        T sum = 0.0;
+        for (da_int i = tree[n_nodes].start_idx; i <= tree[n_nodes].end_idx; i++)
+            sum += y_reg[samples_idx[i]];
+        tree[n_nodes].y_mean = sum / (T)tree[n_nodes].n_samples;
+        n_nodes += 1;
+        return status;
+    }
     // Prediction: most represented class in the samples subset
     count_class_occurences(count_classes, tree[n_nodes].start_idx, tree[n_nodes].end_idx);
     tree[n_nodes].y_pred = (da_int)std::distance(
@@ -357,9 +485,8 @@ template <typename T> void decision_tree<T>::partition_samples(const node<T> &nd
 }
 
 template <class T>
-void boost_sort_samples(const T *X, da_int ldx, da_int feat_idx,
-                        std::vector<da_int>::iterator start,
-                        std::vector<da_int>::iterator stop) {
+void boost_sort_samples(const T *X, da_int ldx, da_int feat_idx, da_int *start,
+                        da_int *stop) {
     // namespace for spreadsort::float_sort and spreadsort::float_mem_cast
     using namespace boost::sort;
     auto rightshift_64 = [&](const da_int &idx, const unsigned offset) {
@@ -389,9 +516,8 @@ void boost_sort_samples(const T *X, da_int ldx, da_int feat_idx,
 }
 
 template <class T>
-void std_sort_samples(const T *X, da_int ldx, da_int feat_idx,
-                      std::vector<da_int>::iterator start,
-                      std::vector<da_int>::iterator stop) {
+void std_sort_samples(const T *X, da_int ldx, da_int feat_idx, da_int *start,
+                      da_int *stop) {
     std::sort(start, stop, [&](const da_int &i1, const da_int &i2) {
         return X[ldx * feat_idx + i1] < X[ldx * feat_idx + i2];
     });
@@ -405,10 +531,19 @@ template <class T> void decision_tree<T>::sort_samples(node<T> &nd, da_int feat_
      * - feature_values[nd.start_idx:nd.end_idx] will contain the values of the feat_idx feature
      *   corresponding to the indices in samples_idx
      */
+    sort_samples(nd, feat_idx, samples_idx.data() + nd.start_idx,
+                 feature_values.data() + nd.start_idx);
+}
 
-    std::vector<da_int>::iterator start = samples_idx.begin() + nd.start_idx;
-    std::vector<da_int>::iterator stop =
-        samples_idx.begin() + nd.start_idx + nd.n_samples;
+template <class T>
+void decision_tree<T>::sort_samples(const node<T> &nd, da_int feat_idx, da_int *samples,
+                                    T *values) {
+    /* Same as above on the nd.n_samples sample indices stored in samples, which do not
+     * need to be part of samples_idx. values[0:nd.n_samples-1] will contain the sorted
+     * values of the feature.
+     */
+    da_int *start = samples;
+    da_int *stop = samples + nd.n_samples;
 
     switch (sort_method) {
     case stl_sort:
@@ -420,8 +555,8 @@ template <class T> void decision_tree<T>::sort_samples(node<T> &nd, da_int feat_
         break;
     }
 
-    for (da_int i = nd.start_idx; i <= nd.end_idx; i++)
-        feature_values[i] = X[ldx * feat_idx + samples_idx[i]];
+    for (da_int i = 0; i < nd.n_samples; i++)
+        values[i] = X[ldx * feat_idx + samples[i]];
 }
 
 template <class T> da_int decision_tree<T>::get_next_node_idx(da_int build_order) {
@@ -443,41 +578,49 @@ template <class T> da_int decision_tree<T>::get_next_node_idx(da_int build_order
     return node_idx;
 }
 
-/* Test all the possible splits and return the best one */
+/* Test all the possible splits of current_node on one feature and return the best one.
+ * samples and values contain the indices of the samples of the node and their feature
+ * values, sorted by value. node_count_classes contains the number of occurrences of each
+ * class in the node, count_left|right_classes are working memory of size n_class.
+ */
 template <typename T>
-void decision_tree<T>::find_best_split(node<T> &current_node, T feat_thresh,
-                                       T maximum_split_score, split<T> &sp) {
+void decision_tree<T>::find_best_split(const node<T> &current_node, T feat_thresh,
+                                       T maximum_split_score, const da_int *samples,
+                                       const T *values, const da_int *node_count_classes,
+                                       std::vector<da_int> &count_left_classes,
+                                       std::vector<da_int> &count_right_classes,
+                                       split<T> &sp) {
 
     // Initialize the split, all nodes to the right child.
-    // count_class, samples_idx and feature_values are required to be up to date
-    std::copy(count_classes.begin(), count_classes.end(), count_right_classes.begin());
+    std::copy_n(node_count_classes, n_class, count_right_classes.begin());
     da_std::fill(count_left_classes.begin(), count_left_classes.end(), 0);
     T right_score = current_node.score, left_score = 0.0;
     da_int ns_left = 0;
     da_int ns_right = current_node.n_samples;
+    da_int last = current_node.n_samples - 1;
     sp.score = current_node.score;
     sp.samp_idx = -1;
 
     T split_score;
-    da_int sidx = current_node.start_idx;
-    while (sidx <= current_node.end_idx - 1) {
-        da_int c = y[samples_idx[sidx]];
+    da_int sidx = 0;
+    while (sidx <= last - 1) {
+        da_int c = y[samples[sidx]];
         count_left_classes[c] += 1;
         count_right_classes[c] -= 1;
         ns_left += 1;
         ns_right -= 1;
 
         // Skip testing splits where feature values are too close
-        while (sidx + 1 <= current_node.end_idx &&
-               std::abs(feature_values[sidx + 1] - feature_values[sidx]) < feat_thresh) {
-            c = y[samples_idx[sidx + 1]];
+        while (sidx + 1 <= last &&
+               std::abs(values[sidx + 1] - values[sidx]) < feat_thresh) {
+            c = y[samples[sidx + 1]];
             count_left_classes[c]++;
             count_right_classes[c]--;
             ns_left += 1;
             ns_right -= 1;
             sidx++;
         }
-        if (sidx == current_node.end_idx)
+        if (sidx == last)
             // All samples are in the left child. Do not check the split
             break;
 
@@ -489,8 +632,8 @@ void decision_tree<T>::find_best_split(node<T> &current_node, T feat_thresh,
         // compared to the parent node
         if (split_score < sp.score && split_score < maximum_split_score) {
             sp.score = split_score;
-            sp.samp_idx = sidx;
-            sp.threshold = (feature_values[sidx] + feature_values[sidx + 1]) / 2;
+            sp.samp_idx = current_node.start_idx + sidx;
+            sp.threshold = (values[sidx] + values[sidx + 1]) / 2;
             sp.right_score = right_score;
             sp.left_score = left_score;
         }
@@ -499,6 +642,253 @@ void decision_tree<T>::find_best_split(node<T> &current_node, T feat_thresh,
     }
 }
 
+/* Regression counterpart of find_best_split. The impurity of a node is the mean squared
+ * (or absolute) deviation of its targets, divided by reg_scale. The squared deviations
+ * are updated with running sums of the targets, centered on the node mean, as the split
+ * point moves along the sorted samples. The absolute deviations of all the possible left
+ * and right children are computed beforehand with two passes of abs_deviation_costs,
+ * which need work to be of size 4*current_node.n_samples.
+ */
+template <typename T>
+void decision_tree<T>::find_best_split_regression(const node<T> &current_node,
+                                                  T feat_thresh, T maximum_split_score,
+                                                  const da_int *samples, const T *values,
+                                                  T *work, split<T> &sp) {
+
+    da_int ns = current_node.n_samples;
+    da_int last = ns - 1;
+    T mean = current_node.y_mean;
+    bool abs_error = method == absolute_error;
+    // cost_left[i]: cost of the samples 0,...,i
+    // cost_right[i]: cost of the last i+1 samples
+    T *cost_left = work, *cost_right = work + ns;
+    T sum = 0.0, sum_sq = 0.0;
+    if (abs_error) {
+        abs_deviation_costs(
+            ns, [&](da_int i) { return y_reg[samples[i]] - mean; }, cost_left,
+            work + 2 * ns, work + 3 * ns);
+        abs_deviation_costs(
+            ns, [&](da_int i) { return y_reg[samples[last - i]] - mean; }, cost_right,
+            work + 2 * ns, work + 3 * ns);
+    } else {
+        for (da_int i = 0; i < ns; i++) {
+            T dev = y_reg[samples[i]] - mean;
+            sum += dev;
+            sum_sq += dev * dev;
+        }
+    }
+
+    // Initialize the split, all nodes to the right child.
+    T left_score, right_score, split_score;
+    T sum_left = 0.0, sum_sq_left = 0.0;
+    sp.score = current_node.score;
+    sp.samp_idx = -1;
+
+    da_int sidx = 0;
+    while (sidx <= last - 1) {
+        T dev = y_reg[samples[sidx]] - mean;
+        sum_left += dev;
+        sum_sq_left += dev * dev;
+
+        // Skip testing splits where feature values are too close
+        while (sidx + 1 <= last &&
+               std::abs(values[sidx + 1] - values[sidx]) < feat_thresh) {
+            sidx++;
+            dev = y_reg[samples[sidx]] - mean;
+            sum_left += dev;
+            sum_sq_left += dev * dev;
+        }
+        if (sidx == last)
+            // All samples are in the left child. Do not check the split
+            break;
+
+        da_int ns_left = sidx + 1, ns_right = ns - ns_left;
+        if (abs_error) {
+            left_score = cost_left[sidx] / (T)ns_left;
+            right_score = cost_right[ns_right - 1] / (T)ns_right;
+        } else {
+            T sum_right = sum - sum_left, sum_sq_right = sum_sq - sum_sq_left;
+            left_score = (sum_sq_left - sum_left * sum_left / (T)ns_left) / (T)ns_left;
+            right_score =
+                (sum_sq_right - sum_right * sum_right / (T)ns_right) / (T)ns_right;
+            left_score = std::max(left_score, (T)0.0);
+            right_score = std::max(right_score, (T)0.0);
+        }
+        left_score /= reg_scale;
+        right_score /= reg_scale;
+        split_score = (left_score * ns_left + right_score * ns_right) / (T)ns;
+        // Consider the split only if it brings at least minimum improvement
+        // compared to the parent node
+        if (split_score < sp.score && split_score < maximum_split_score) {
+            sp.score = split_score;
+            sp.samp_idx = current_node.start_idx + sidx;
+            sp.threshold = (values[sidx] + values[sidx + 1]) / 2;
+            sp.right_score = right_score;
+            sp.left_score = left_score;
+        }
+
+        sidx++;
+    }
+}
+
+/* Unscaled impurity of the samples of nd for the regression criterion in use. nd.y_mean
+ * is required to be up to date.
+ */
+template <typename T> T decision_tree<T>::regression_impurity(const node<T> &nd) {
+    const da_int *samples = samples_idx.data() + nd.start_idx;
+    T mean = nd.y_mean;
+    if (method == absolute_error) {
+        da_int ns = nd.n_samples;
+        abs_deviation_costs(
+            ns, [&](da_int i) { return y_reg[samples[i]] - mean; }, reg_work.data(),
+            reg_work.data() + ns, reg_work.data() + 2 * ns);
+        return reg_work[ns - 1] / (T)ns;
+    }
+    T sum_sq = 0.0;
+    for (da_int i = 0; i < nd.n_samples; i++)
+        sum_sq += (y_reg[samples[i]] - mean) * (y_reg[samples[i]] - mean);
+    return sum_sq / (T)nd.n_samples;
+}
+
+/* Find the best split of each node of batch, over the candidate features.
+ *
+ * When there is enough work, the pairs (node, candidate feature) are evaluated
+ * concurrently, each thread sorting its own copy of the samples of the node. The random
+ * subsets of candidate features are still drawn one node after the other, and the best
+ * candidate of each node is selected in the same order as in the serial loop, so the
+ * tree does not depend on the number of threads.
+ * Possible errors:
+ * - memory
+ */
+template <typename T>
+da_status decision_tree<T>::find_best_splits(const std::vector<da_int> &batch,
+                                             std::vector<split<T>> &best_splits) {
+    da_int n_batch = (da_int)batch.size();
+    da_int n_tasks = n_batch * nfeat_split;
+    da_int batch_samples = 0, max_node_samples = 0;
+    for (da_int node_idx : batch) {
+        batch_samples += tree[node_idx].n_samples;
+        max_node_samples = std::max(max_node_samples, tree[node_idx].n_samples);
+    }
+    da_int n_threads = 1;
+    if ((double)batch_samples * (double)nfeat_split >= (double)DF_MIN_PARALLEL_WORK)
+        n_threads = da_utils::get_n_threads_loop(n_tasks);
+
+    std::vector<da_int> candidates, batch_count_classes;
+    std::vector<split<T>> splits;
+    try {
+        best_splits.resize(n_batch);
+        if (n_threads > 1) {
+            candidates.resize(n_tasks);
+            batch_count_classes.resize(n_batch * n_class);
+            splits.resize(n_tasks);
+        }
+    } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
+        return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                               "Memory allocation error");
+    }
+
+    split<T> sp;
+    for (da_int b = 0; b < n_batch; b++) {
+        node<T> &current_node = tree[batch[b]];
+        T maximum_split_score = current_node.score - min_improvement;
+        best_splits[b].score = current_node.score;
+        best_splits[b].feat_idx = -1;
+
+        // Explore the candidate features for splitting
+        // Randomly shuffle the index array and explore the first nfeat_split
+        if (nfeat_split < n_features)
+            std::shuffle(features_idx.begin(), features_idx.end(), mt_engine);
+        if (!regression)
+            count_class_occurences(count_classes, current_node.start_idx,
+                                   current_node.end_idx);
+        if (n_threads > 1) {
+            // Only record the candidates, they are evaluated below
+            std::copy_n(features_idx.begin(), nfeat_split,
+                        candidates.begin() + b * nfeat_split);
+            std::copy(count_classes.begin(), count_classes.end(),
+                      batch_count_classes.begin() + b * n_class);
+            continue;
+        }
+        for (da_int j = 0; j < nfeat_split; j++) {
+            da_int feat_idx = features_idx[j];
+            sort_samples(current_node, feat_idx);
+            sp.feat_idx = feat_idx;
+            if (regression)
+                find_best_split_regression(current_node, feat_thresh, maximum_split_score,
+                                           samples_idx.data() + current_node.start_idx,
+                                           feature_values.data() + current_node.start_idx,
+                                           reg_work.data(), sp);
+            else
+                find_best_split(current_node, feat_thresh, maximum_split_score,
+                                samples_idx.data() + current_node.start_idx,
+                                feature_values.data() + current_node.start_idx,
+                                count_classes.data(), count_left_classes,
+                                count_right_classes, sp);
+
+            if (sp.score < best_splits[b].score) {
+                best_splits[b].copy(sp);
+            }
+        }
+    }
+    if (n_threads == 1)
+        return da_status_success;
+
+    bool alloc_failed = false;
+    da_int work_size = regression && method == absolute_error ? 4 * max_node_samples : 0;
+#pragma omp parallel num_threads(n_threads) default(none)                                \
+    shared(batch, candidates, batch_count_classes, splits, n_tasks, max_node_samples,    \
+               alloc_failed, work_size, tree, samples_idx, nfeat_split, n_class,         \
+               feat_thresh, min_improvement, regression)
+    {
+        std::vector<da_int> samples, count_left, count_right;
+        std::vector<T> values, work;
+        bool ws_allocated = true;
+        try {
+            samples.resize(max_node_samples);
+            values.resize(max_node_samples);
+            count_left.resize(n_class);
+            count_right.resize(n_class);
+            work.resize(work_size);
+        } catch (std::bad_alloc &) { // LCOV_EXCL_LINE
+            ws_allocated = false;    // LCOV_EXCL_LINE
+#pragma omp atomic write
+            alloc_failed = true; // LCOV_EXCL_LINE
+        }
+#pragma omp for schedule(dynamic)
+        for (da_int t = 0; t < n_tasks; t++) {
+            if (!ws_allocated)
+                continue; // LCOV_EXCL_LINE
+            da_int b = t / nfeat_split;
+            const node<T> &current_node = tree[batch[b]];
+            std::copy_n(samples_idx.begin() + current_node.start_idx,
+                        current_node.n_samples, samples.begin());
+            sort_samples(current_node, candidates[t], samples.data(), values.data());
+            splits[t].feat_idx = candidates[t];
+            if (regression)
+                find_best_split_regression(current_node, feat_thresh,
+                                           current_node.score - min_improvement,
+                                           samples.data(), values.data(), work.data(),
+                                           splits[t]);
+            else
+                find_best_split(current_node, feat_thresh,
+                                current_node.score - min_improvement, samples.data(),
+                                values.data(), batch_count_classes.data() + b * n_class,
+                                count_left, count_right, splits[t]);
+        }
+    }
+    if (alloc_failed)
+        return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                               "Memory allocation error");
+
+    for (da_int t = 0; t < n_tasks; t++) {
+        da_int b = t / nfeat_split;
+        if (splits[t].score < best_splits[b].score)
+            best_splits[b].copy(splits[t]);
+    }
+    return da_status_success;
+}
+
 template <typename T> da_status decision_tree<T>::fit() {
     da_status status = da_status_success;
 
@@ -538,6 +928,25 @@ template <typename T> da_status decision_tree<T>::fit() {
                 "Unexpected error while reading the optional parameters.");
     }
 
+    if (regression) {
+        // The classification criteria do not apply, use the squared error instead
+        if (method != absolute_error)
+            method = squared_error;
+        if (method == absolute_error) {
+            try {
+                reg_work.resize(4 * n_obs);
+            } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
+                return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                       "Memory allocation error");
+            }
+        }
+    } else if (method == squared_error || method == absolute_error) {
+        return da_error_bypass(this->err, da_status_incompatible_options,
+                               "The scoring function is a regression criterion but the "
+                               "training data contains class labels. Use "
+                               "da_tree_set_regression_data to fit a regression tree.");
+    }
+
     switch (method) {
     case gini:
         score_function = gini_score<T>;
@@ -550,6 +959,10 @@ template <typename T> da_status decision_tree<T>::fit() {
     case misclassification:
         score_function = misclassification_score<T>;
         break;
+
+    default:
+        // Regression criteria are evaluated in find_best_split_regression
+        break;
     }
 
     if (nfeat_split == 0 || nfeat_split > n_features) {
@@ -567,8 +980,7 @@ template <typename T> da_status decision_tree<T>::fit() {
     // Allocate the tree and class_props arrays
     // accounting for a full binary tree of depth 10 (or maximum depth)
     size_t init_capacity = ((da_int)1 << std::min(max_depth, (da_int)9)) + (da_int)1;
-    if (predict_proba_opt)
-        status = resize_tree(init_capacity);
+    status = resize_tree(init_capacity);
     if (status != da_status_success)
         return status;
 
@@ -600,16 +1012,28 @@ template <typename T> da_status decision_tree<T>::fit() {
     tree[0].end_idx = n_obs - 1;
     tree[0].depth = 0;
     tree[0].n_samples = n_obs;
-    count_class_occurences(count_classes, 0, n_obs - 1);
-    tree[0].score = score_function(n_obs, n_class, count_classes);
-    tree[0].y_pred = (da_int)std::distance(
-        count_classes.begin(),
-        std::max_element(count_classes.begin(), count_classes.end()));
-    // Prediction probability
-    if (predict_proba_opt) {
-        for (da_int i = 0; i < n_class; i++) {
-            T p = (T)count_classes[i] / (T)n_obs;
-            class_props[i] = p;
+    if (regression) {
+        T sum = 0.0;
+        for (da_int i = 0; i < n_obs; i++)
+            sum += y_reg[samples_idx[i]];
+        tree[0].y_mean = sum / (T)n_obs;
+        // The scores are relative to the impurity of the root node
+        reg_scale = regression_impurity(tree[0]);
+        tree[0].score = reg_scale > (T)0.0 ? (T)1.0 : (T)0.0;
+        if (reg_scale <= (T)0.0)
+            reg_scale = (T)1.0;
+    } else {
+        count_class_occurences(count_classes, 0, n_obs - 1);
+        tree[0].score = score_function(n_obs, n_class, count_classes);
+        tree[0].y_pred = (da_int)std::distance(
+            count_classes.begin(),
+            std::max_element(count_classes.begin(), count_classes.end()));
+        // Prediction probability
+        if (predict_proba_opt) {
+            for (da_int i = 0; i < n_class; i++) {
+                T p = (T)count_classes[i] / (T)n_obs;
+                class_props[i] = p;
+            }
         }
     }
 
@@ -617,58 +1041,61 @@ template <typename T> da_status decision_tree<T>::fit() {
     if (max_depth > 0)
         nodes_to_treat.push_back(0);
 
-    split<T> sp, best_split;
+    // Nodes are treated in batches. Depth-first builds take the nodes one by one, while
+    // breadth-first builds take all the nodes of a level at once: they cover disjoint
+    // sets of samples, so their splits can be searched concurrently. The children are
+    // then added in the same order as if the nodes had been treated one by one.
+    std::vector<da_int> batch;
+    std::vector<split<T>> best_splits;
     while (!nodes_to_treat.empty()) {
-        da_int node_idx = get_next_node_idx(build_order);
-        node<T> &current_node = tree[node_idx];
-        T maximum_split_score = current_node.score - min_improvement;
-
-        // Explore the candidate features for splitting
-        // Randomly shuffle the index array and explore the first nfeat_split
-        if (nfeat_split < n_features)
-            std::shuffle(features_idx.begin(), features_idx.end(), mt_engine);
-        best_split.score = current_node.score;
-        best_split.feat_idx = -1;
-        count_class_occurences(count_classes, current_node.start_idx,
-                               current_node.end_idx);
-        for (da_int j = 0; j < nfeat_split; j++) {
-            da_int feat_idx = features_idx[j];
-            sort_samples(current_node, feat_idx);
-            sp.feat_idx = feat_idx;
-            find_best_split(current_node, feat_thresh, maximum_split_score, sp);
-
-            if (sp.score < best_split.score) {
-                best_split.copy(sp);
+        try {
+            if (build_order == breadth_first) {
+                batch.assign(nodes_to_treat.begin(), nodes_to_treat.end());
+                nodes_to_treat.clear();
+            } else {
+                batch.assign(1, get_next_node_idx(build_order));
             }
+        } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
+            return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                                   "Memory allocation error");
         }
-
-        // Split the node and add the 2 children
-        if (best_split.feat_idx != -1) {
-            current_node.is_leaf = false;
-            current_node.feature = best_split.feat_idx;
-            current_node.x_threshold = best_split.threshold;
-
-            // Sort again the samples according to the chosen feature
-            partition_samples(current_node);
-
-            // Add children nodes and push them into the queue
-            // if potential for further improvements is still high enough
-            add_node(node_idx, false, best_split.right_score, best_split.samp_idx);
-            if (best_split.right_score > min_split_score &&
-                tree[n_nodes - 1].n_samples >= min_node_sample &&
-                tree[n_nodes - 1].depth < max_depth)
-                nodes_to_treat.push_back(n_nodes - 1);
-            else
-                n_leaves += 1;
-            add_node(node_idx, true, best_split.left_score, best_split.samp_idx);
-            if (best_split.left_score > min_split_score &&
-                tree[n_nodes - 1].n_samples >= min_node_sample &&
-                tree[n_nodes - 1].depth < max_depth)
-                nodes_to_treat.push_back(n_nodes - 1);
-            else
+        status = find_best_splits(batch, best_splits);
+        if (status != da_status_success)
+            return status; // LCOV_EXCL_LINE
+
+        for (size_t b = 0; b < batch.size(); b++) {
+            da_int node_idx = batch[b];
+            node<T> &current_node = tree[node_idx];
+            split<T> &best_split = best_splits[b];
+
+            // Split the node and add the 2 children
+            if (best_split.feat_idx != -1) {
+                current_node.is_leaf = false;
+                current_node.feature = best_split.feat_idx;
+                current_node.x_threshold = best_split.threshold;
+
+                // Sort again the samples according to the chosen feature
+                partition_samples(current_node);
+
+                // Add children nodes and push them into the queue
+                // if potential for further improvements is still high enough
+                add_node(node_idx, false, best_split.right_score, best_split.samp_idx);
+                if (best_split.right_score > min_split_score &&
+                    tree[n_nodes - 1].n_samples >= min_node_sample &&
+                    tree[n_nodes - 1].depth < max_depth)
+                    nodes_to_treat.push_back(n_nodes - 1);
+                else
+                    n_leaves += 1;
+                add_node(node_idx, true, best_split.left_score, best_split.samp_idx);
+                if (best_split.left_score > min_split_score &&
+                    tree[n_nodes - 1].n_samples >= min_node_sample &&
+                    tree[n_nodes - 1].depth < max_depth)
+                    nodes_to_treat.push_back(n_nodes - 1);
+                else
+                    n_leaves += 1;
+            } else
                 n_leaves += 1;
-        } else
-            n_leaves += 1;
+        }
     }
 
     model_trained = true;
@@ -700,6 +1127,13 @@ da_status decision_tree<T>::predict(da_int nsamp, da_int nfeat, const T *X_test,
                                "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error_bypass(this->err, da_status_no_data,
+                               "The model was fitted to regression targets. Please call "
+                               "da_tree_predict_regression_s or "
+                               "da_tree_predict_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test", mode);
@@ -761,6 +1195,13 @@ da_status decision_tree<T>::predict_proba(da_int nsamp, da_int nfeat, const T *X
                                "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error_bypass(this->err, da_status_no_data,
+                               "The model was fitted to regression targets. Please call "
+                               "da_tree_predict_regression_s or "
+                               "da_tree_predict_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test", mode);
@@ -859,6 +1300,13 @@ da_status decision_tree<T>::score(da_int nsamp, da_int nfeat, const T *X_test,
                                "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error_bypass(this->err, da_status_no_data,
+                               "The model was fitted to regression targets. Please call "
+                               "da_tree_score_regression_s or "
+                               "da_tree_score_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test");
@@ -890,8 +1338,94 @@ da_status decision_tree<T>::score(da_int nsamp, da_int nfeat, const T *X_test,
     return da_status_success;
 }
 
+template <typename T>
+da_status decision_tree<T>::predict_regression(da_int nsamp, da_int nfeat,
+                                               const T *X_test, da_int ldx_test,
+                                               T *y_pred, da_int mode) {
+    if (y_pred == nullptr) {
+        return da_error_bypass(this->err, da_status_invalid_pointer,
+                               "y_pred is not a valid pointer.");
+    }
+
+    const T *X_test_temp;
+    T *utility_ptr1 = nullptr;
+    da_int ldx_test_temp;
+
+    if (nfeat != n_features) {
+        return da_error_bypass(this->err, da_status_invalid_input,
+                               "n_features = " + std::to_string(nfeat) +
+                                   " doesn't match the expected value " +
+                                   std::to_string(n_features) + ".");
+    }
+
+    if (!model_trained) {
+        return da_error_bypass(this->err, da_status_out_of_date,
+                               "The model has not yet been trained or the data it is "
+                               "associated with is out of date.");
+    }
+
+    if (!regression) {
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No targets for regression have been passed to the "
+                               "handle. Please call da_tree_set_regression_data_s or "
+                               "da_tree_set_regression_data_d.");
+    }
+
+    da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
+                                            &X_test_temp, ldx_test_temp, "n_samples",
+                                            "n_features", "X_test", "ldx_test", mode);
+    if (status != da_status_success)
+        return status;
+
+    // Fill y_pred with the mean target of the leaf of each requested sample
+    node<T> *current_node;
+    for (da_int i = 0; i < nsamp; i++) {
+        current_node = &tree[0];
+        while (!current_node->is_leaf) {
+            T feat_val = X_test_temp[ldx_test_temp * current_node->feature + i];
+            if (feat_val < current_node->x_threshold)
+                current_node = &tree[current_node->left_child_idx];
+            else
+                current_node = &tree[current_node->right_child_idx];
+        }
+        y_pred[i] = current_node->y_mean;
+    }
+    if (utility_ptr1)
+        delete[] (utility_ptr1);
+    return da_status_success;
+}
+
+/* Compute the coefficient of determination R^2 of the predictions on the test data */
+template <typename T>
+da_status decision_tree<T>::score_regression(da_int nsamp, da_int nfeat, const T *X_test,
+                                             da_int ldx_test, const T *y_test, T *score) {
+    if (score == nullptr) {
+        return da_error_bypass(this->err, da_status_invalid_pointer,
+                               "score is not a valid pointer.");
+    }
+
+    da_status status = this->check_1D_array(nsamp, y_test, "n_samples", "y_test", 1);
+    if (status != da_status_success)
+        return status;
+
+    std::vector<T> y_pred;
+    try {
+        y_pred.resize(nsamp);
+    } catch (std::bad_alloc &) {                                  // LCOV_EXCL_LINE
+        return da_error_bypass(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                               "Memory allocation error");
+    }
+    status = predict_regression(nsamp, nfeat, X_test, ldx_test, y_pred.data());
+    if (status != da_status_success)
+        return status;
+
+    *score = r2_score(nsamp, y_test, y_pred.data());
+    return da_status_success;
+}
+
 template <typename T> void decision_tree<T>::clear_working_memory() {
     samples_idx = std::vector<da_int>();
+    reg_work = std::vector<T>();
     count_classes = std::vector<da_int>();
     feature_values = std::vector<T>();
     count_left_classes = std::vector<da_int>();
@@ -925,6 +1459,10 @@ template double misclassification_score<double>(da_int n_samples,
 template float misclassification_score<float>(da_int n_samples,
                                               [[maybe_unused]] da_int n_class,
                                               std::vector<da_int> &count_classes);
+
+template double r2_score<double>(da_int n, const double *y, const double *y_pred);
+template float r2_score<float>(da_int n, const float *y, const float *y_pred);
+
 template class decision_tree<double>;
 template class decision_tree<float>;
 
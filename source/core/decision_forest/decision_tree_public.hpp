@@ -119,4 +119,50 @@ da_status decision_tree_score(da_handle handle, da_int n_samples, da_int n_featu
                                 mean_accuracy);
 }
 
+template <typename decision_tree_class, typename T>
+da_status decision_tree_set_regression_data(da_handle handle, da_int n_samples,
+                                            da_int n_features, const T *X, da_int ldx,
+                                            const T *y) {
+    decision_tree_class *decision_tree =
+        dynamic_cast<decision_tree_class *>(handle->get_alg_handle<T>());
+    if (decision_tree == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_tree or "
+            "handle is invalid.");
+
+    return decision_tree->set_regression_data(n_samples, n_features, X, ldx, y);
+}
+
+template <typename decision_tree_class, typename T>
+da_status decision_tree_predict_regression(da_handle handle, da_int n_obs,
+                                           da_int n_features, const T *X_test,
+                                           da_int ldx_test, T *y_pred) {
+    decision_tree_class *decision_tree =
+        dynamic_cast<decision_tree_class *>(handle->get_alg_handle<T>());
+    if (decision_tree == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_tree or "
+            "handle is invalid.");
+
+    return decision_tree->predict_regression(n_obs, n_features, X_test, ldx_test, y_pred);
+}
+
+template <typename decision_tree_class, typename T>
+da_status decision_tree_score_regression(da_handle handle, da_int n_samples,
+                                         da_int n_features, const T *X_test,
+                                         da_int ldx_test, const T *y_test, T *score) {
+    decision_tree_class *decision_tree =
+        dynamic_cast<decision_tree_class *>(handle->get_alg_handle<T>());
+    if (decision_tree == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_decision_tree or "
+            "handle is invalid.");
+
+    return decision_tree->score_regression(n_samples, n_features, X_test, ldx_test,
+                                           y_test, score);
+}
+
 } // namespace decision_tree_public
\ No newline at end of file
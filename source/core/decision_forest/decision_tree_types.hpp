@@ -29,12 +29,18 @@
 #define DECISION_TREE_TYPES
 
 #define DF_BLOCK_SIZE da_int(256)
+// Minimum number of (sample, candidate feature) pairs to search the splits of a batch of
+// nodes with several threads
+#define DF_MIN_PARALLEL_WORK da_int(32768)
 
 namespace da_decision_tree_types {
 enum score_method {
     gini = 0,
     cross_entropy,
     misclassification,
+    // Regression criteria
+    squared_error,
+    absolute_error,
 };
 
 enum sort_method { stl_sort = 0, boost_sort };
@@ -28,6 +28,7 @@
 #include "aoclda.h"
 #include "da_error.hpp"
 #include "da_omp.hpp"
+#include "da_std.hpp"
 #include "decision_forest.hpp"
 #include "decision_tree_types.hpp"
 #include "macros.h"
@@ -131,6 +132,8 @@ da_status random_forest<T>::set_training_data(da_int n_samples, da_int n_feature
 
     this->refresh();
     this->y = y;
+    this->y_reg = nullptr;
+    this->regression = false;
     this->n_samples = n_samples;
     this->n_features = n_features;
     this->n_class = n_class;
@@ -140,6 +143,37 @@ da_status random_forest<T>::set_training_data(da_int n_samples, da_int n_feature
     return da_status_success;
 }
 
+template <typename T>
+da_status random_forest<T>::set_regression_data(da_int n_samples, da_int n_features,
+                                                const T *X, da_int ldx, const T *y) {
+
+    // Guard against errors due to multiple calls using the same class instantiation
+    if (X_temp) {
+        delete[] (X_temp);
+        X_temp = nullptr;
+    }
+
+    da_status status =
+        this->store_2D_array(n_samples, n_features, X, ldx, &X_temp, &this->X, this->ldx,
+                             "n_samples", "n_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    status = this->check_1D_array(n_samples, y, "n_samples", "y", 1);
+    if (status != da_status_success)
+        return status;
+
+    this->refresh();
+    this->y = nullptr;
+    this->y_reg = y;
+    this->regression = true;
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->n_class = 0;
+
+    return da_status_success;
+}
+
 template <typename T> da_status random_forest<T>::fit() {
 
     // Read optional parameters
@@ -175,6 +209,17 @@ template <typename T> da_status random_forest<T>::fit() {
         return da_error_trace(this->err, da_status_internal_error, // LCOV_EXCL_LINE
                               "Unexpected error while reading the optional parameters.");
 
+    if (regression) {
+        // The classification criteria do not apply, use the squared error instead
+        if (method != absolute_error)
+            method = squared_error;
+    } else if (method == squared_error || method == absolute_error) {
+        return da_error(this->err, da_status_incompatible_options,
+                        "The scoring function is a regression criterion but the "
+                        "training data contains class labels. Use "
+                        "da_forest_set_regression_data to fit a regression forest.");
+    }
+
     std::vector<da_int> seed_tree;
     try {
         forest.resize(n_tree);
@@ -223,13 +268,7 @@ template <typename T> da_status random_forest<T>::fit() {
     da_int prn_times = 0;
     da_int n_failed_tree = 0;
 
-    // Train all the trees in parallel
-#pragma omp parallel for shared(                                                         \
-        n_failed_tree, forest, n_tree, max_depth, min_node_sample, method, prn_times,    \
-            build_order, seed_tree, min_split_score, feat_thresh, min_improvement,       \
-            n_samples, n_features, X, ldx, y, n_class, n_obs, nfeat_split, bootstrap,    \
-            sort_method) default(none) schedule(dynamic)
-    for (da_int i = 0; i < n_tree; i++) {
+    auto fit_tree = [&](da_int i) {
         // Set tree optional parameters
         try {
             forest[i] = std::make_unique<decision_tree<T>>(
@@ -239,17 +278,49 @@ template <typename T> da_status random_forest<T>::fit() {
         } catch (std::bad_alloc &) {
 #pragma omp atomic
             n_failed_tree++;
-            continue;
+            return;
         }
         da_status tree_status;
-        tree_status = forest[i]->set_training_data(n_samples, n_features, X, ldx, y,
-                                                   n_class, n_obs, nullptr);
+        if (regression)
+            tree_status = forest[i]->set_regression_data(n_samples, n_features, X, ldx,
+                                                         y_reg, n_obs, nullptr);
+        else
+            tree_status = forest[i]->set_training_data(n_samples, n_features, X, ldx, y,
+                                                       n_class, n_obs, nullptr);
         tree_status = forest[i]->fit();
         forest[i]->clear_working_memory();
         if (tree_status != da_status_success) {
 #pragma omp atomic
             n_failed_tree++;
         }
+    };
+
+    // Share the threads between the trees and the split searches within each tree
+    // (see decision_tree::find_best_splits). The trees are trained in parallel, and if
+    // there are fewer trees than threads and nested parallelism is enabled, the
+    // remaining threads are divided between the trees. Without nested parallelism, when
+    // the trees would keep less than half of the threads busy, they are instead trained
+    // one after the other, each with all the threads.
+    da_int n_threads_max = 1;
+    if (omp_get_max_active_levels() > omp_get_level())
+        n_threads_max = (da_int)omp_get_max_threads();
+    bool nested = omp_get_max_active_levels() > omp_get_level() + 1;
+    da_int n_threads = std::min(n_tree, n_threads_max), n_threads_tree = 1;
+    if (nested)
+        n_threads_tree = std::max(n_threads_max / n_threads, (da_int)1);
+    else if (2 * n_tree <= n_threads_max)
+        n_threads = 1;
+
+    if (n_threads == 1) {
+        for (da_int i = 0; i < n_tree; i++)
+            fit_tree(i);
+    } else {
+#pragma omp parallel for num_threads(n_threads) default(none)                            \
+    shared(n_tree, n_threads_tree, fit_tree) schedule(dynamic)
+        for (da_int i = 0; i < n_tree; i++) {
+            omp_set_num_threads((int)n_threads_tree);
+            fit_tree(i);
+        }
     }
 
     if (n_failed_tree != 0)
@@ -316,6 +387,13 @@ da_status random_forest<T>::predict(da_int nsamp, da_int nfeat, const T *X_test,
                         "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error(this->err, da_status_no_data,
+                        "The model was fitted to regression targets. Please call "
+                        "da_forest_predict_regression_s or "
+                        "da_forest_predict_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test");
@@ -395,6 +473,13 @@ da_status random_forest<T>::predict_proba(da_int nsamp, da_int nfeat, const T *X
                         "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error(this->err, da_status_no_data,
+                        "The model was fitted to regression targets. Please call "
+                        "da_forest_predict_regression_s or "
+                        "da_forest_predict_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test");
@@ -520,6 +605,13 @@ da_status random_forest<T>::score(da_int nsamp, da_int nfeat, const T *X_test,
                                "associated with is out of date.");
     }
 
+    if (regression) {
+        return da_error_bypass(this->err, da_status_no_data,
+                               "The model was fitted to regression targets. Please call "
+                               "da_forest_score_regression_s or "
+                               "da_forest_score_regression_d.");
+    }
+
     da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
                                             &X_test_temp, ldx_test_temp, "n_samples",
                                             "n_features", "X_test", "ldx_test");
@@ -573,6 +665,120 @@ da_status random_forest<T>::score(da_int nsamp, da_int nfeat, const T *X_test,
     return da_status_success;
 }
 
+template <typename T>
+da_status random_forest<T>::predict_regression(da_int nsamp, da_int nfeat,
+                                               const T *X_test, da_int ldx_test,
+                                               T *y_pred) {
+
+    const T *X_test_temp;
+    T *utility_ptr1 = nullptr;
+    da_int ldx_test_temp;
+
+    if (y_pred == nullptr) {
+        return da_error(this->err, da_status_invalid_pointer,
+                        "y_pred is not a valid pointer.");
+    }
+
+    if (nfeat != n_features) {
+        return da_error(this->err, da_status_invalid_input,
+                        "n_features = " + std::to_string(nfeat) +
+                            " doesn't match the expected value " +
+                            std::to_string(n_features) + ".");
+    }
+
+    if (!model_trained) {
+        return da_error(this->err, da_status_out_of_date,
+                        "The model has not yet been trained or the data it is "
+                        "associated with is out of date.");
+    }
+
+    if (!regression) {
+        return da_error(this->err, da_status_no_data,
+                        "No targets for regression have been passed to the handle. "
+                        "Please call da_forest_set_regression_data_s or "
+                        "da_forest_set_regression_data_d.");
+    }
+
+    da_status status = this->store_2D_array(nsamp, nfeat, X_test, ldx_test, &utility_ptr1,
+                                            &X_test_temp, ldx_test_temp, "n_samples",
+                                            "n_features", "X_test", "ldx_test");
+    if (status != da_status_success)
+        return status;
+
+    if (this->opts.get("block size", block_size) != da_status_success)
+        return da_error_trace( // LCOV_EXCL_LINE
+            this->err, da_status_internal_error,
+            "Unexpected error while reading the optional parameter 'block size' .");
+
+    // X is divided into blocks of small size. Each block is predicted by all the trees
+    // in turn by a single thread, so the sums do not depend on the number of threads.
+    std::vector<T> y_pred_tree;
+    da_int n_blocks, block_rem;
+    da_utils::blocking_scheme(nsamp, block_size, n_blocks, block_rem);
+    da_int n_threads = da_utils::get_n_threads_loop(n_blocks);
+    try {
+        y_pred_tree.resize(n_threads * block_size);
+    } catch (std::bad_alloc const &) {                     // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+#pragma omp parallel for num_threads(n_threads) default(none)                            \
+    shared(n_blocks, block_rem, X_test_temp, ldx_test_temp, y_pred, y_pred_tree, forest, \
+               block_size, n_features, n_tree)
+    for (da_int i_block = 0; i_block < n_blocks; i_block++) {
+        da_int start_idx = i_block * block_size;
+        da_int start_pred_idx = (da_int)omp_get_thread_num() * block_size;
+        da_int n_elem = block_size;
+        if (i_block == n_blocks - 1 && block_rem > 0) {
+            n_elem = block_rem;
+        }
+        T *y_block = &y_pred[start_idx];
+        da_std::fill(y_block, y_block + n_elem, (T)0.0);
+        for (auto &tree : forest) {
+            tree->predict_regression(n_elem, n_features, &X_test_temp[start_idx],
+                                     ldx_test_temp, &y_pred_tree[start_pred_idx], 2);
+            for (da_int i = 0; i < n_elem; i++)
+                y_block[i] += y_pred_tree[start_pred_idx + i];
+        }
+        for (da_int i = 0; i < n_elem; i++)
+            y_block[i] /= (T)n_tree;
+    }
+
+    if (utility_ptr1)
+        delete[] (utility_ptr1);
+
+    return da_status_success;
+}
+
+/* Compute the coefficient of determination R^2 of the predictions on the test data */
+template <typename T>
+da_status random_forest<T>::score_regression(da_int nsamp, da_int nfeat, const T *X_test,
+                                             da_int ldx_test, const T *y_test, T *score) {
+    if (score == nullptr) {
+        return da_error(this->err, da_status_invalid_pointer,
+                        "score is not a valid pointer.");
+    }
+
+    da_status status = this->check_1D_array(nsamp, y_test, "n_samples", "y_test", 1);
+    if (status != da_status_success)
+        return status;
+
+    std::vector<T> y_pred;
+    try {
+        y_pred.resize(nsamp);
+    } catch (std::bad_alloc const &) {                     // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    status = predict_regression(nsamp, nfeat, X_test, ldx_test, y_pred.data());
+    if (status != da_status_success)
+        return status;
+
+    *score = r2_score(nsamp, y_test, y_pred.data());
+    return da_status_success;
+}
+
 template class random_forest<double>;
 template class random_forest<float>;
 
@@ -56,7 +56,11 @@ inline da_status register_forest_options(da_options::OptionRegistry &opts,
                           {"entropy", cross_entropy},
                           {"misclassification-error", misclassification},
                           {"misclassification", misclassification},
-                          {"misclass", misclassification}},
+                          {"misclass", misclassification},
+                          {"squared-error", squared_error},
+                          {"mse", squared_error},
+                          {"absolute-error", absolute_error},
+                          {"mae", absolute_error}},
                          "gini"));
         status = opts.register_opt(os);
 
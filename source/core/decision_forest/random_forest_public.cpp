@@ -28,6 +28,7 @@
 #include "random_forest_public.hpp"
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_store_data.hpp"
 #include "macros.h"
 
 using namespace random_forest_public;
@@ -64,6 +65,44 @@ da_status da_forest_set_training_data_s(da_handle handle, da_int n_samples,
             handle, n_samples, n_features, n_class, X, ldx, y)));
 }
 
+da_status da_forest_set_training_data_from_store_d(da_handle handle, da_datastore store,
+                                                   da_int n_class, const char *key_X,
+                                                   const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double, da_int>(
+        handle, store, key_X, key_y,
+        [handle, n_class](da_int n_samples, da_int n_features, const double *X,
+                          da_int ldx, const da_int *y) {
+            return da_forest_set_training_data_d(handle, n_samples, n_features, n_class,
+                                                 X, ldx, y);
+        });
+}
+
+da_status da_forest_set_training_data_from_store_s(da_handle handle, da_datastore store,
+                                                   da_int n_class, const char *key_X,
+                                                   const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float, da_int>(
+        handle, store, key_X, key_y,
+        [handle, n_class](da_int n_samples, da_int n_features, const float *X, da_int ldx,
+                          const da_int *y) {
+            return da_forest_set_training_data_s(handle, n_samples, n_features, n_class,
+                                                 X, ldx, y);
+        });
+}
+
 da_status da_forest_fit_d(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -220,3 +259,139 @@ da_status da_forest_score_s(da_handle handle, da_int n_samples, da_int n_feature
         return (random_forest_score<da_decision_forest::random_forest<float>, float>(
             handle, n_samples, n_features, X_test, ldx_test, y_test, mean_accuracy)));
 }
+
+da_status da_forest_set_regression_data_d(da_handle handle, da_int n_samples,
+                                          da_int n_features, const double *X, da_int ldx,
+                                          const double *y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (random_forest_set_regression_data<
+                       da_decision_forest::random_forest<double>, double>(
+                   handle, n_samples, n_features, X, ldx, y)));
+}
+
+da_status da_forest_set_regression_data_s(da_handle handle, da_int n_samples,
+                                          da_int n_features, const float *X, da_int ldx,
+                                          const float *y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (random_forest_set_regression_data<
+                       da_decision_forest::random_forest<float>, float>(
+                   handle, n_samples, n_features, X, ldx, y)));
+}
+
+da_status da_forest_set_regression_data_from_store_d(da_handle handle, da_datastore store,
+                                                     const char *key_X,
+                                                     const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double, double>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx,
+                 const double *y) {
+            return da_forest_set_regression_data_d(handle, n_samples, n_features, X, ldx,
+                                                   y);
+        });
+}
+
+da_status da_forest_set_regression_data_from_store_s(da_handle handle, da_datastore store,
+                                                     const char *key_X,
+                                                     const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float, float>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx,
+                 const float *y) {
+            return da_forest_set_regression_data_s(handle, n_samples, n_features, X, ldx,
+                                                   y);
+        });
+}
+
+da_status da_forest_predict_regression_d(da_handle handle, da_int n_samples,
+                                         da_int n_features, const double *X_test,
+                                         da_int ldx_test, double *y_pred) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (random_forest_predict_regression<
+                       da_decision_forest::random_forest<double>, double>(
+                   handle, n_samples, n_features, X_test, ldx_test, y_pred)));
+}
+
+da_status da_forest_predict_regression_s(da_handle handle, da_int n_samples,
+                                         da_int n_features, const float *X_test,
+                                         da_int ldx_test, float *y_pred) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (random_forest_predict_regression<
+                       da_decision_forest::random_forest<float>, float>(
+                   handle, n_samples, n_features, X_test, ldx_test, y_pred)));
+}
+
+da_status da_forest_score_regression_d(da_handle handle, da_int n_samples,
+                                       da_int n_features, const double *X_test,
+                                       da_int ldx_test, const double *y_test,
+                                       double *score) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (random_forest_score_regression<
+                       da_decision_forest::random_forest<double>, double>(
+                   handle, n_samples, n_features, X_test, ldx_test, y_test, score)));
+}
+
+da_status da_forest_score_regression_s(da_handle handle, da_int n_samples,
+                                       da_int n_features, const float *X_test,
+                                       da_int ldx_test, const float *y_test,
+                                       float *score) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (random_forest_score_regression<
+                       da_decision_forest::random_forest<float>, float>(
+                   handle, n_samples, n_features, X_test, ldx_test, y_test, score)));
+}
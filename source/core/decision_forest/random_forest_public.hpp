@@ -119,4 +119,50 @@ da_status random_forest_score(da_handle handle, da_int n_samples, da_int n_featu
                                 mean_accuracy);
 }
 
+template <typename random_forest_class, typename T>
+da_status random_forest_set_regression_data(da_handle handle, da_int n_samples,
+                                            da_int n_features, const T *X, da_int ldx,
+                                            const T *y) {
+    random_forest_class *random_forest =
+        dynamic_cast<random_forest_class *>(handle->get_alg_handle<T>());
+    if (random_forest == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_random_forest or "
+            "handle is invalid.");
+
+    return random_forest->set_regression_data(n_samples, n_features, X, ldx, y);
+}
+
+template <typename random_forest_class, typename T>
+da_status random_forest_predict_regression(da_handle handle, da_int n_obs,
+                                           da_int n_features, const T *X_test,
+                                           da_int ldx_test, T *y_pred) {
+    random_forest_class *random_forest =
+        dynamic_cast<random_forest_class *>(handle->get_alg_handle<T>());
+    if (random_forest == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_random_forest or "
+            "handle is invalid.");
+
+    return random_forest->predict_regression(n_obs, n_features, X_test, ldx_test, y_pred);
+}
+
+template <typename random_forest_class, typename T>
+da_status random_forest_score_regression(da_handle handle, da_int n_samples,
+                                         da_int n_features, const T *X_test,
+                                         da_int ldx_test, const T *y_test, T *score) {
+    random_forest_class *random_forest =
+        dynamic_cast<random_forest_class *>(handle->get_alg_handle<T>());
+    if (random_forest == nullptr)
+        return da_error(
+            handle->err, da_status_invalid_handle_type,
+            "handle was not initialized with handle_type=da_handle_random_forest or "
+            "handle is invalid.");
+
+    return random_forest->score_regression(n_samples, n_features, X_test, ldx_test,
+                                           y_test, score);
+}
+
 } // namespace random_forest_public
\ No newline at end of file
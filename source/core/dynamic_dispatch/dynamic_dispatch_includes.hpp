@@ -25,6 +25,8 @@
 #include "da_utils.hpp"
 #include "dbscan.hpp"
 #include "decision_forest.hpp"
+#include "hdbscan.hpp"
+#include "kernel_approx.hpp"
 #include "kernel_functions.hpp"
 #include "kmeans.hpp"
 #include "knn.hpp"
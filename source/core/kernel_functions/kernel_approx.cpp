@@ -0,0 +1,520 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "kernel_approx.hpp"
+#include "aoclda.h"
+#include "basic_statistics.hpp"
+#include "da_cblas.hh"
+#include "da_error.hpp"
+#include "da_omp.hpp"
+#include "da_utils.hpp"
+#include "kernel_approx_options.hpp"
+#include "kernel_approx_types.hpp"
+#include "kernel_functions.hpp"
+#include "lapack_templates.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+// Below this number of entries, the random Fourier features are not computed in parallel
+#define KERNEL_APPROX_MIN_PARALLEL_SIZE 16384
+
+namespace ARCH {
+
+namespace da_kernel_approx {
+
+using namespace da_kernel_approx_types;
+
+template <typename T> kernel_approx<T>::~kernel_approx() {
+    // Destructor needs to handle arrays that were allocated due to row major storage of input data
+    if (A_temp)
+        delete[] (A_temp);
+}
+
+template <typename T>
+kernel_approx<T>::kernel_approx(da_errors::da_error_t &err) : basic_handle<T>(err) {
+    // Initialize the options registry
+    // Any error is stored err->status[.] and this needs to be checked
+    // by the caller.
+    register_kernel_approx_options<T>(this->opts, *this->err);
+};
+
+template <typename T>
+da_status kernel_approx<T>::get_result(da_result query, da_int *dim, T *result) {
+    // Don't return anything if the feature map has not been computed
+    if (!iscomputed) {
+        return da_warn(this->err, da_status_no_data,
+                       "The kernel approximation has not yet been computed. Please call "
+                       "da_kernel_approx_compute_s or da_kernel_approx_compute_d before "
+                       "extracting results.");
+    }
+
+    da_int rinfo_size = 5;
+    da_int size;
+
+    switch (query) {
+    case da_result::da_rinfo:
+        if (*dim < rinfo_size) {
+            *dim = rinfo_size;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(rinfo_size) + ".");
+        }
+        result[0] = (T)n_samples;
+        result[1] = (T)n_features;
+        result[2] = (T)n_components;
+        result[3] = gamma;
+        result[4] = (T)rank;
+        break;
+    case da_result::da_kernel_approx_components:
+        size = n_components * n_features;
+        if (*dim < size) {
+            *dim = size;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(size) + ".");
+        }
+        this->copy_2D_results_array(n_components, n_features, components.data(),
+                                    n_components, result);
+        break;
+    case da_result::da_kernel_approx_normalization:
+        if (method != nystroem)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The normalization is only available for the Nystroem "
+                           "approximation.");
+        size = n_components * n_components;
+        if (*dim < size) {
+            *dim = size;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(size) + ".");
+        }
+        for (da_int i = 0; i < size; i++)
+            result[i] = normalization[i];
+        break;
+    case da_result::da_kernel_approx_offsets:
+        if (method != rff)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The offsets are only available for the random Fourier "
+                           "features approximation.");
+        if (*dim < n_components) {
+            *dim = n_components;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(n_components) + ".");
+        }
+        for (da_int i = 0; i < n_components; i++)
+            result[i] = offsets[i];
+        break;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+    return da_status_success;
+};
+
+template <typename T>
+da_status kernel_approx<T>::get_result(da_result query, da_int *dim, da_int *result) {
+    // Don't return anything if the feature map has not been computed
+    if (!iscomputed) {
+        return da_warn(this->err, da_status_no_data,
+                       "The kernel approximation has not yet been computed. Please call "
+                       "da_kernel_approx_compute_s or da_kernel_approx_compute_d before "
+                       "extracting results.");
+    }
+
+    switch (query) {
+    case da_result::da_kernel_approx_landmarks:
+        if (method != nystroem)
+            return da_warn(this->err, da_status_unknown_query,
+                           "The landmarks are only available for the Nystroem "
+                           "approximation.");
+        if (*dim < n_components) {
+            *dim = n_components;
+            return da_warn(this->err, da_status_invalid_array_dimension,
+                           "The array is too small. Please provide an array of at "
+                           "least size: " +
+                               std::to_string(n_components) + ".");
+        }
+        for (da_int i = 0; i < n_components; i++)
+            result[i] = landmarks[i];
+        break;
+    default:
+        return da_warn(this->err, da_status_unknown_query,
+                       "The requested result could not be found.");
+    }
+
+    return da_status_success;
+};
+
+template <typename T> void kernel_approx<T>::refresh() {
+    if (A_temp) {
+        delete[] (A_temp);
+        A_temp = nullptr;
+    }
+    iscomputed = false;
+}
+
+/* Store details about user's data matrix in preparation for the computation */
+template <typename T>
+da_status kernel_approx<T>::set_data(da_int n_samples, da_int n_features, const T *A_in,
+                                     da_int lda_in) {
+
+    // Guard against errors due to multiple calls using the same class instantiation
+    refresh();
+
+    da_status status =
+        this->store_2D_array(n_samples, n_features, A_in, lda_in, &A_temp, &A, lda,
+                             "n_samples", "n_features", "A", "lda");
+    if (status != da_status_success)
+        return status;
+
+    // Store dimensions of A
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->lda_in = lda_in;
+
+    // Record that initialization is complete but computation has not yet been performed
+    initdone = true;
+    iscomputed = false;
+
+    return da_status_success;
+}
+
+/* Kernel matrix between the m rows of the column major matrix X and the landmarks */
+template <typename T>
+da_status kernel_approx<T>::landmark_kernel(da_int m, const T *X, da_int ldx, T *K,
+                                            da_int ldk, bool X_is_landmarks) {
+    const T *L = components.data();
+    switch (kernel) {
+    case approx_kernel::rbf: {
+        std::vector<T> X_norms, L_norms;
+        try {
+            X_norms.resize(m);
+            L_norms.resize(n_components);
+        } catch (std::bad_alloc const &) {
+            return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                            "Memory allocation failed.");
+        }
+        rbf_kernel_internal(column_major, m, n_components, n_features, X, X_norms.data(),
+                            ldx, L, L_norms.data(), n_components, K, ldk, gamma,
+                            X_is_landmarks);
+        break;
+    }
+    case approx_kernel::linear:
+        linear_kernel_internal(column_major, m, n_components, n_features, X, ldx, L,
+                               n_components, K, ldk, X_is_landmarks);
+        break;
+    case approx_kernel::polynomial:
+        polynomial_kernel_internal(column_major, m, n_components, n_features, X, ldx, L,
+                                   n_components, K, ldk, gamma, degree, coef0,
+                                   X_is_landmarks);
+        break;
+    case approx_kernel::sigmoid:
+        sigmoid_kernel_internal(column_major, m, n_components, n_features, X, ldx, L,
+                                n_components, K, ldk, gamma, coef0, X_is_landmarks);
+        break;
+    }
+    return da_status_success;
+}
+
+/* Nystroem: sample the landmarks without replacement and compute K_mm^{-1/2} from the
+ * eigendecomposition K_mm = V diag(w) V^T. Eigenvalues below a relative tolerance are
+ * discarded, so that the pseudo-inverse is used when K_mm is singular (for example with
+ * duplicated landmarks) or indefinite (sigmoid kernel).
+ */
+template <typename T> da_status kernel_approx<T>::compute_nystroem() {
+    std::vector<da_int> perm;
+    std::vector<T> w, work, V;
+    std::vector<da_int> iwork;
+    try {
+        perm.resize(n_samples);
+        landmarks.resize(n_components);
+        components.resize(n_components * n_features);
+        normalization.resize(n_components * n_components);
+        V.resize(n_components * n_components);
+        w.resize(n_components);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    // Partial Fisher-Yates shuffle
+    std::mt19937_64 mt_gen(seed);
+    std::iota(perm.begin(), perm.end(), 0);
+    for (da_int i = 0; i < n_components; i++) {
+        std::uniform_int_distribution<da_int> uniform(i, n_samples - 1);
+        std::swap(perm[i], perm[uniform(mt_gen)]);
+        landmarks[i] = perm[i];
+    }
+    for (da_int j = 0; j < n_features; j++) {
+        for (da_int i = 0; i < n_components; i++)
+            components[i + j * n_components] = A[landmarks[i] + j * lda];
+    }
+
+    da_status status = landmark_kernel(n_components, components.data(), n_components,
+                                       V.data(), n_components, true);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    char JOB = 'V';
+    char UPLO = 'U';
+    da_int lwork = -1, liwork = -1, INFO = 0;
+    T estworkspace[1];
+    da_int estiworkspace[1];
+    da::syevd(&JOB, &UPLO, &n_components, V.data(), &n_components, w.data(), estworkspace,
+              &lwork, estiworkspace, &liwork, &INFO);
+    if (INFO != 0)
+        return da_error(this->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "An internal error occurred while computing the eigenvalues of "
+                        "the landmark kernel matrix.");
+    lwork = (da_int)estworkspace[0];
+    liwork = std::max(estiworkspace[0], 5 * n_components + 3);
+    try {
+        work.resize(lwork);
+        iwork.resize(liwork);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    da::syevd(&JOB, &UPLO, &n_components, V.data(), &n_components, w.data(), work.data(),
+              &lwork, iwork.data(), &liwork, &INFO);
+    if (INFO != 0)
+        return da_error(this->err, da_status_internal_error,
+                        "An internal error occurred while computing the eigenvalues of "
+                        "the landmark kernel matrix. Please check the input data for "
+                        "undefined values.");
+
+    // K_mm^{-1/2} = (V diag(w^{-1/4})) (V diag(w^{-1/4}))^T, with w in ascending order
+    T tol = w[n_components - 1] * (T)n_components * std::numeric_limits<T>::epsilon();
+    rank = 0;
+    for (da_int j = 0; j < n_components; j++) {
+        T scale = (T)0;
+        if (w[j] > tol) {
+            scale = (T)1 / std::sqrt(std::sqrt(w[j]));
+            rank++;
+        }
+        for (da_int i = 0; i < n_components; i++)
+            V[i + j * n_components] *= scale;
+    }
+    da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, n_components,
+                        n_components, n_components, (T)1.0, V.data(), n_components,
+                        V.data(), n_components, (T)0.0, normalization.data(),
+                        n_components);
+
+    return da_status_success;
+}
+
+/* Random Fourier features: frequencies from N(0, 2 gamma) and offsets from U(0, 2 pi) */
+template <typename T> da_status kernel_approx<T>::compute_rff() {
+    try {
+        components.resize(n_components * n_features);
+        offsets.resize(n_components);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    // The draws are made in double precision, so that both precisions give the same map
+    const double two_pi = 6.28318530717958647692528676655900577;
+    double sigma = std::sqrt(2 * (double)gamma);
+    std::mt19937_64 mt_gen(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, two_pi);
+    for (da_int i = 0; i < n_components * n_features; i++)
+        components[i] = (T)(sigma * normal(mt_gen));
+    for (da_int i = 0; i < n_components; i++)
+        offsets[i] = (T)uniform(mt_gen);
+    rank = n_components;
+
+    return da_status_success;
+}
+
+template <typename T> da_status kernel_approx<T>::compute() {
+
+    da_status status = da_status_success;
+    if (initdone == false)
+        return da_error(this->err, da_status_no_data,
+                        "No data has been passed to the handle. Please call "
+                        "da_kernel_approx_set_data_s or da_kernel_approx_set_data_d.");
+
+    // Read in options and store in class
+    std::string opt_tmp;
+    this->opts.get("approximation method", opt_tmp, method);
+    this->opts.get("kernel", opt_tmp, kernel);
+    this->opts.get("n components", n_components);
+    this->opts.get("degree", degree);
+    this->opts.get("seed", seed);
+    this->opts.get("coef0", coef0);
+
+    if (method == rff && kernel != approx_kernel::rbf)
+        return da_error(this->err, da_status_incompatible_options,
+                        "Random Fourier features can only approximate the 'rbf' kernel.");
+    if (method == nystroem && n_components > n_samples)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The option 'n components' must not exceed the number of "
+                        "samples, " +
+                            std::to_string(n_samples) + ", for the Nystroem method.");
+
+    // Default gamma 1/(n_features*var(A)), for the kernels that use gamma
+    gamma = (T)1;
+    if (kernel != approx_kernel::linear) {
+        this->opts.get("gamma", gamma);
+        if (gamma < 0) {
+            T mean, variance = 1;
+            ARCH::da_basic_statistics::variance(column_major, da_axis_all, n_samples,
+                                                n_features, A, lda, -1, &mean, &variance);
+            if (variance == 0)
+                return da_error(
+                    this->err, da_status_invalid_input,
+                    "Variance of the input data is zero. Use different gamma.");
+            gamma = 1 / (n_features * variance);
+        }
+    }
+
+    if (seed == -1) {
+        std::random_device r;
+        seed = std::abs((da_int)r());
+    }
+
+    iscomputed = false;
+    status = (method == nystroem) ? compute_nystroem() : compute_rff();
+    if (status != da_status_success)
+        return status;
+
+    iscomputed = true;
+
+    return status;
+}
+
+template <typename T>
+da_status kernel_approx<T>::transform(da_int m, da_int p, const T *X, da_int ldx,
+                                      T *X_transform, da_int ldx_transform) {
+
+    if (!iscomputed) {
+        return da_warn(this->err, da_status_no_data,
+                       "The kernel approximation has not been computed. Please call "
+                       "da_kernel_approx_compute_s or da_kernel_approx_compute_d.");
+    }
+
+    if (p != n_features)
+        return da_error(this->err, da_status_invalid_input,
+                        "The function was called with m_features = " + std::to_string(p) +
+                            " but the kernel approximation has been computed with " +
+                            std::to_string(n_features) + " features.");
+
+    const T *X_temp;
+    T *utility_ptr1 = nullptr;
+    T *utility_ptr2 = nullptr;
+    da_int ldx_temp;
+    T *X_transform_temp;
+    da_int ldx_transform_temp;
+
+    da_status status =
+        this->store_2D_array(m, p, X, ldx, &utility_ptr1, &X_temp, ldx_temp, "m_samples",
+                             "m_features", "X", "ldx");
+    if (status != da_status_success)
+        return status;
+
+    status = this->store_2D_array(
+        m, n_components, X_transform, ldx_transform, &utility_ptr2,
+        const_cast<const T **>(&X_transform_temp), ldx_transform_temp, "m_samples",
+        "n_components", "X_transform", "ldx_transform", 1);
+    if (status != da_status_success) {
+        if (utility_ptr1)
+            delete[] (utility_ptr1);
+        return status;
+    }
+
+    if (method == nystroem) {
+        // K(X, landmarks) K_mm^{-1/2}
+        std::vector<T> K;
+        try {
+            K.resize(m * n_components);
+        } catch (std::bad_alloc const &) {
+            status = da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                              "Memory allocation failed.");
+        }
+        if (status == da_status_success)
+            status = landmark_kernel(m, X_temp, ldx_temp, K.data(), m, false);
+        if (status == da_status_success)
+            da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m,
+                                n_components, n_components, (T)1.0, K.data(), m,
+                                normalization.data(), n_components, (T)0.0,
+                                X_transform_temp, ldx_transform_temp);
+    } else {
+        // sqrt(2/n_components) cos(X W + b)
+        da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasTrans, m, n_components, p,
+                            (T)1.0, X_temp, ldx_temp, components.data(), n_components,
+                            (T)0.0, X_transform_temp, ldx_transform_temp);
+        T scale = std::sqrt((T)2 / (T)n_components);
+        da_int n_threads = (m * n_components < KERNEL_APPROX_MIN_PARALLEL_SIZE)
+                               ? 1
+                               : da_utils::get_n_threads_loop(n_components);
+        da_int n_comp = n_components;
+        const T *b = offsets.data();
+#pragma omp parallel for num_threads(n_threads) schedule(static) default(none)            \
+    shared(m, n_comp, b, scale, X_transform_temp, ldx_transform_temp)
+        for (da_int j = 0; j < n_comp; j++) {
+            T *z = &X_transform_temp[j * ldx_transform_temp];
+            for (da_int i = 0; i < m; i++)
+                z[i] = scale * std::cos(z[i] + b[j]);
+        }
+    }
+
+    if (status == da_status_success && this->order == row_major) {
+        da_utils::copy_transpose_2D_array_column_to_row_major(
+            m, n_components, X_transform_temp, ldx_transform_temp, X_transform,
+            ldx_transform);
+    }
+
+    if (utility_ptr1)
+        delete[] (utility_ptr1);
+    if (utility_ptr2)
+        delete[] (utility_ptr2);
+
+    return status;
+}
+
+template class kernel_approx<double>;
+template class kernel_approx<float>;
+
+} // namespace da_kernel_approx
+
+} // namespace ARCH
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "aoclda.h"
+#include "basic_handle.hpp"
+#include "da_error.hpp"
+#include "kernel_approx_types.hpp"
+#include "macros.h"
+#include <string>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_kernel_approx {
+
+using namespace da_kernel_approx_types;
+
+/* Kernel approximation class
+ *
+ * Computes an explicit feature map z such that z(x)^T z(y) approximates k(x, y), so that
+ * kernel methods can be replaced by linear ones on the transformed data:
+ * - Nystroem: z(x) = K_mm^{-1/2} [k(x, l_1), ..., k(x, l_m)] for m landmarks l_i sampled
+ *   from the data, where K_mm is the kernel matrix of the landmarks.
+ * - random Fourier features (rbf kernel only): z(x) = sqrt(2/m) cos(W^T x + b), with the
+ *   columns of W drawn from N(0, 2 gamma I) and b uniformly from [0, 2 pi].
+ */
+template <typename T> class kernel_approx : public basic_handle<T> {
+  public:
+    ~kernel_approx();
+
+  private:
+    da_int n_samples = 0;
+    da_int n_features = 0;
+
+    // Set true when initialization is complete
+    bool initdone = false;
+
+    // Set true when the feature map is computed successfully
+    bool iscomputed = false;
+
+    // User's data
+    const T *A = nullptr;
+    da_int lda = 0;
+    da_int lda_in = 0;
+
+    // Utility pointer to column major allocated copy of user's data
+    T *A_temp = nullptr;
+
+    // Options
+    da_int method = nystroem;
+    da_int kernel = approx_kernel::rbf;
+    da_int n_components = 100;
+    da_int degree = 3;
+    da_int seed = 0;
+    T gamma = 1.0;
+    T coef0 = 0.0;
+
+    // Number of eigenvalues of K_mm kept in the Nystroem normalization
+    da_int rank = 0;
+
+    // n_components x n_features matrix, with leading dimension n_components, containing
+    // the landmarks (Nystroem) or the random frequencies W^T (random Fourier features)
+    std::vector<T> components;
+    // Nystroem: n_components x n_components symmetric matrix K_mm^{-1/2}
+    std::vector<T> normalization;
+    // Random Fourier features: random offsets b
+    std::vector<T> offsets;
+    // Nystroem: indices of the landmarks in the data matrix
+    std::vector<da_int> landmarks;
+
+    da_status compute_nystroem();
+    da_status compute_rff();
+
+    /* m x n_components kernel matrix between the rows of X and the landmarks */
+    da_status landmark_kernel(da_int m, const T *X, da_int ldx, T *K, da_int ldk,
+                              bool X_is_landmarks);
+
+  public:
+    kernel_approx(da_errors::da_error_t &err);
+
+    da_status get_result(da_result query, da_int *dim, T *result);
+
+    da_status get_result(da_result query, da_int *dim, da_int *result);
+
+    void refresh();
+
+    /* Store details about user's data matrix in preparation for the computation */
+    da_status set_data(da_int n_samples, da_int n_features, const T *A_in, da_int lda_in);
+
+    /* Compute the approximate feature map */
+    da_status compute();
+
+    /* Map the rows of X to the approximate feature space */
+    da_status transform(da_int m, da_int p, const T *X, da_int ldx, T *X_transform,
+                        da_int ldx_transform);
+};
+
+} // namespace da_kernel_approx
+
+} // namespace ARCH
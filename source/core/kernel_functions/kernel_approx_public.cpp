@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "kernel_approx_public.hpp"
+#include "aoclda.h"
+#include "da_handle.hpp"
+#include "da_store_data.hpp"
+#include "dynamic_dispatch.hpp"
+#include "macros.h"
+
+using namespace kernel_approx_public;
+
+da_status da_kernel_approx_set_data_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *A, da_int lda) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_set_data<da_kernel_approx::kernel_approx<double>,
+                                              double>(handle, n_samples, n_features, A,
+                                                      lda)));
+}
+
+da_status da_kernel_approx_set_data_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *A, da_int lda) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_set_data<da_kernel_approx::kernel_approx<float>,
+                                              float>(handle, n_samples, n_features, A,
+                                                     lda)));
+}
+
+da_status da_kernel_approx_set_data_from_store_d(da_handle handle, da_datastore store,
+                                                 const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx) {
+            return da_kernel_approx_set_data_d(handle, n_samples, n_features, X, ldx);
+        });
+}
+
+da_status da_kernel_approx_set_data_from_store_s(da_handle handle, da_datastore store,
+                                                 const char *key) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float>(
+        handle, store, key,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx) {
+            return da_kernel_approx_set_data_s(handle, n_samples, n_features, X, ldx);
+        });
+}
+
+da_status da_kernel_approx_compute_d(da_handle handle) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than double.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_compute<da_kernel_approx::kernel_approx<double>,
+                                             double>(handle)));
+}
+
+da_status da_kernel_approx_compute_s(da_handle handle) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than single.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_compute<da_kernel_approx::kernel_approx<float>,
+                                             float>(handle)));
+}
+
+da_status da_kernel_approx_transform_d(da_handle handle, da_int m_samples,
+                                       da_int m_features, const double *X, da_int ldx,
+                                       double *X_transform, da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than double.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_transform<
+                       da_kernel_approx::kernel_approx<double>, double>(
+                   handle, m_samples, m_features, X, ldx, X_transform, ldx_transform)));
+}
+
+da_status da_kernel_approx_transform_s(da_handle handle, da_int m_samples,
+                                       da_int m_features, const float *X, da_int ldx,
+                                       float *X_transform, da_int ldx_transform) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(handle->err, da_status_wrong_type,
+                        "The handle was initialized with a different precision type "
+                        "than single.");
+    DISPATCHER(handle->err,
+               return (kernel_approx_transform<da_kernel_approx::kernel_approx<float>,
+                                               float>(handle, m_samples, m_features, X,
+                                                      ldx, X_transform, ldx_transform)));
+}
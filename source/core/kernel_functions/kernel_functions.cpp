@@ -30,11 +30,17 @@
 #include "aoclda_types.h"
 #include "da_cblas.hh"
 #include "da_error.hpp"
+#include "da_omp.hpp"
+#include "da_utils.hpp"
+#include "da_vmath.hpp"
 #include "macros.h"
 #include "pairwise_distances.hpp"
 #include <iostream>
 #include <vector>
 
+// Below this number of entries, the elementwise part of the kernels is not threaded
+#define KERNEL_MIN_PARALLEL_SIZE 16384
+
 namespace ARCH {
 
 /*
@@ -209,6 +215,31 @@ inline void fill_upper_traingular(da_order order, da_int m, T *D, da_int ldd) {
     }
 };
 
+/*
+Helper function to apply op(len, x) to each column (column major) or row (row major) x of
+the m by n matrix D, distributing them over the threads. If upper is true, only the upper
+triangle of D is processed.
+*/
+template <typename T, class Op>
+inline void apply_elementwise(da_order order, da_int m, da_int n, T *D, da_int ldd,
+                              bool upper, Op op) {
+    da_int n_vec = (order == column_major) ? n : m;
+    da_int vec_len = (order == column_major) ? m : n;
+    da_int n_threads = (m * n < KERNEL_MIN_PARALLEL_SIZE)
+                           ? 1
+                           : da_utils::get_n_threads_loop(n_vec);
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic, 16) default(none)      \
+    shared(order, D, ldd, upper, op, n_vec, vec_len)
+    for (da_int j = 0; j < n_vec; j++) {
+        if (!upper)
+            op(vec_len, D + j * ldd);
+        else if (order == column_major)
+            op(j + 1, D + j * ldd);
+        else
+            op(vec_len - j, D + j * ldd + j);
+    }
+}
+
 template <typename T>
 inline void kernel_setup(da_order order, da_int m, da_int n, da_int k, const T *X,
                          da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd, T gamma,
@@ -239,25 +270,15 @@ void rbf_kernel_internal(da_order order, da_int m, da_int n, da_int k, const T *
     // Compute |x_i-y_j|^2
     ARCH::euclidean_distance(order, m, n, k, X, ldx, Y, ldy, D, ldd, X_norms, 2, Y_norms,
                              2, true, X_is_Y);
-    // If X==Y then result of euclidean_distance() is upper triangular matrix D.
-    // This loop is to make D symmetric matrix.
+    // Exponentiate all the entries in the matrix. If X==Y then result of
+    // euclidean_distance() is upper triangular matrix D, so only the upper triangle is
+    // exponentiated before making D symmetric.
+    apply_elementwise(order, m, n, D, ldd, X_is_Y, [multiplier](da_int len, T *x) {
+        da_vmath::scaled_exp(len, multiplier, x);
+    });
     if (X_is_Y) {
         fill_upper_traingular(order, m, D, ldd);
     }
-    // Exponentiate all the entries in the matrix
-    if (order == column_major) {
-        for (da_int i = 0; i < n; i++) {
-            for (da_int j = 0; j < m; j++) {
-                D[i * ldd + j] = exp(multiplier * D[i * ldd + j]);
-            }
-        }
-    } else {
-        for (da_int i = 0; i < m; i++) {
-            for (da_int j = 0; j < n; j++) {
-                D[i * ldd + j] = exp(multiplier * D[i * ldd + j]);
-            }
-        }
-    }
 }
 /*
 Linear kernel
@@ -278,19 +299,10 @@ void polynomial_kernel_internal(da_order order, da_int m, da_int n, da_int k, co
                                 T gamma, da_int degree, T coef0, bool X_is_Y) {
     kernel_setup(order, m, n, k, X, ldx, Y, ldy, D, ldd, gamma, X_is_Y);
     // Raise to the power and add constant
-    if (order == column_major) {
-        for (da_int i = 0; i < n; i++) {
-            for (da_int j = 0; j < m; j++) {
-                D[i * ldd + j] = pow(D[i * ldd + j] + coef0, degree);
-            }
-        }
-    } else {
-        for (da_int i = 0; i < m; i++) {
-            for (da_int j = 0; j < n; j++) {
-                D[i * ldd + j] = pow(D[i * ldd + j] + coef0, degree);
-            }
-        }
-    }
+    apply_elementwise(order, m, n, D, ldd, false, [coef0, degree](da_int len, T *x) {
+        for (da_int i = 0; i < len; i++)
+            x[i] = pow(x[i] + coef0, degree);
+    });
 }
 
 /*
@@ -302,19 +314,9 @@ void sigmoid_kernel_internal(da_order order, da_int m, da_int n, da_int k, const
                              T gamma, T coef0, bool X_is_Y) {
     kernel_setup(order, m, n, k, X, ldx, Y, ldy, D, ldd, gamma, X_is_Y);
     // Compute tanh and add constant
-    if (order == column_major) {
-        for (da_int i = 0; i < n; i++) {
-            for (da_int j = 0; j < m; j++) {
-                D[i * ldd + j] = tanh(D[i * ldd + j] + coef0);
-            }
-        }
-    } else {
-        for (da_int i = 0; i < m; i++) {
-            for (da_int j = 0; j < n; j++) {
-                D[i * ldd + j] = tanh(D[i * ldd + j] + coef0);
-            }
-        }
-    }
+    apply_elementwise(order, m, n, D, ldd, false, [coef0](da_int len, T *x) {
+        da_vmath::shifted_tanh(len, coef0, x);
+    });
 }
 
 template da_status check_input<float>(da_order order, da_int m, da_int n, da_int k,
@@ -28,6 +28,7 @@
 #include "linmod_public.hpp"
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_store_data.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -87,6 +88,44 @@ da_status da_linmod_define_features_s(da_handle handle, da_int nsamples, da_int
                    handle, nsamples, nfeat, A, b)));
 }
 
+da_status da_linmod_define_features_from_store_d(da_handle handle, da_datastore store,
+                                                 const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    // The linear models do not take a leading dimension, X must be packed
+    return da_data::set_data_from_store<double, double>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int,
+                 const double *y) {
+            return da_linmod_define_features_d(handle, n_samples, n_features, X, y);
+        },
+        true);
+}
+
+da_status da_linmod_define_features_from_store_s(da_handle handle, da_datastore store,
+                                                 const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    // The linear models do not take a leading dimension, X must be packed
+    return da_data::set_data_from_store<float, float>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int,
+                 const float *y) {
+            return da_linmod_define_features_s(handle, n_samples, n_features, X, y);
+        },
+        true);
+}
+
 da_status da_linmod_fit_start_d(da_handle handle, da_int ncoefs, const double *coefs) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef LP_DISTANCE_KERNELS_HPP
+#define LP_DISTANCE_KERNELS_HPP
+
+#include "aoclda.h"
+#include "da_omp.hpp"
+#include "da_utils.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <vector>
+
+namespace ARCH {
+namespace da_metrics {
+namespace pairwise_distances {
+
+/* Blocked kernels for the Minkowski distances D_{ij} = (sum_l |X_{il} - Y_{jl}|^p)^(1/p).
+ *
+ * D is computed by tiles of lp_mc x lp_nc elements, distributed over the OpenMP threads.
+ * For each tile, blocks of lp_kc features of X and Y are packed into contiguous buffers
+ * (which also hides the storage order of the inputs), and a register-blocked micro-kernel
+ * accumulates lp_mr x lp_nr elements of the tile at a time, vectorized across the rows of
+ * X. The integer exponents have their own instantiations so that std::pow is never called
+ * in the inner loop.
+ */
+
+// Exponents with a dedicated kernel, lp_generic calls std::pow
+enum lp_exponent { lp_generic = 0, lp_1 = 1, lp_2 = 2, lp_3 = 3 };
+
+constexpr da_int lp_mc = 64;
+constexpr da_int lp_nc = 64;
+constexpr da_int lp_kc = 128;
+constexpr da_int lp_nr = 4;
+// Rows of the micro-kernel: two AVX2 registers (or one AVX-512 register)
+template <typename T> constexpr da_int lp_mr = 64 / sizeof(T);
+
+template <lp_exponent P, typename T> inline T lp_term(T diff, T p) {
+    if constexpr (P == lp_1) {
+        return std::abs(diff);
+    } else if constexpr (P == lp_2) {
+        return diff * diff;
+    } else if constexpr (P == lp_3) {
+        T a = std::abs(diff);
+        return a * a * a;
+    } else {
+        return std::pow(std::abs(diff), p);
+    }
+}
+
+template <lp_exponent P, typename T> inline T lp_root(T sum, T p) {
+    if constexpr (P == lp_1) {
+        return sum;
+    } else if constexpr (P == lp_2) {
+        return std::sqrt(sum);
+    } else if constexpr (P == lp_3) {
+        return std::cbrt(sum);
+    } else {
+        return std::pow(sum, (T)1.0 / p);
+    }
+}
+
+/* Accumulate the lp_mr x lp_nr block Dt += sum over kc features of the lp terms.
+ * Xp and Yp hold the packed features, with leading dimensions lp_mc and lp_nc.
+ */
+template <lp_exponent P, typename T>
+inline void lp_micro_kernel(da_int kc, const T *Xp, const T *Yp, T *Dt, T p) {
+    constexpr da_int mr = lp_mr<T>;
+    T acc[lp_nr][mr];
+    for (da_int jj = 0; jj < lp_nr; jj++) {
+#pragma omp simd
+        for (da_int ii = 0; ii < mr; ii++)
+            acc[jj][ii] = Dt[ii + jj * lp_mc];
+    }
+    for (da_int l = 0; l < kc; l++) {
+        const T *x = Xp + l * lp_mc;
+        const T *y = Yp + l * lp_nc;
+        for (da_int jj = 0; jj < lp_nr; jj++) {
+            T yj = y[jj];
+#pragma omp simd
+            for (da_int ii = 0; ii < mr; ii++)
+                acc[jj][ii] += lp_term<P>(x[ii] - yj, p);
+        }
+    }
+    for (da_int jj = 0; jj < lp_nr; jj++) {
+#pragma omp simd
+        for (da_int ii = 0; ii < mr; ii++)
+            Dt[ii + jj * lp_mc] = acc[jj][ii];
+    }
+}
+
+/* Pack rows [i0, i0+mb) and features [l0, l0+kc) of A into Ap(ii, l) = Ap[ii + l * ldp].
+ * The rows from mb to ldp are padded with zeros.
+ */
+template <typename T>
+void lp_pack(da_order order, const T *A, da_int lda, da_int i0, da_int mb, da_int l0,
+             da_int kc, T *Ap, da_int ldp) {
+    if (order == column_major) {
+        for (da_int l = 0; l < kc; l++) {
+            const T *a = A + i0 + (l0 + l) * lda;
+            T *ap = Ap + l * ldp;
+            for (da_int ii = 0; ii < mb; ii++)
+                ap[ii] = a[ii];
+            for (da_int ii = mb; ii < ldp; ii++)
+                ap[ii] = (T)0.0;
+        }
+    } else {
+        for (da_int ii = 0; ii < mb; ii++) {
+            const T *a = A + (i0 + ii) * lda + l0;
+            for (da_int l = 0; l < kc; l++)
+                Ap[ii + l * ldp] = a[l];
+        }
+        for (da_int l = 0; l < kc; l++) {
+            for (da_int ii = mb; ii < ldp; ii++)
+                Ap[ii + l * ldp] = (T)0.0;
+        }
+    }
+}
+
+/* Compute the m x n matrix of Minkowski distances between the rows of X (m x k) and Y
+ * (n x k), see pairwise_distance_kernel. If Y is null, the distances between the rows of
+ * X are computed and only the tiles of the upper triangle are evaluated.
+ */
+template <lp_exponent P, typename T>
+da_status lp_distance(da_order order, da_int m, da_int n, da_int k, const T *X,
+                      da_int ldx, const T *Y, da_int ldy, T *D, da_int ldd, T p) {
+    bool symmetric = Y == nullptr;
+    if (symmetric) {
+        n = m;
+        ldy = ldx;
+        Y = X;
+    }
+    da_int m_tiles = (m + lp_mc - 1) / lp_mc, n_tiles = (n + lp_nc - 1) / lp_nc;
+    da_int n_tasks = m_tiles * n_tiles;
+    da_int n_threads = da_utils::get_n_threads_loop(n_tasks);
+    da_int threading_error = 0;
+
+#pragma omp parallel num_threads(n_threads) default(none)                                \
+    shared(order, m, n, k, X, ldx, Y, ldy, D, ldd, p, symmetric, m_tiles, n_tasks,        \
+               threading_error)
+    {
+        std::vector<T> Xp, Yp, Dt;
+        bool alloc_error = false;
+        try {
+            Xp.resize(lp_mc * lp_kc);
+            Yp.resize(lp_nc * lp_kc);
+            Dt.resize(lp_mc * lp_nc);
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+            alloc_error = true;            // LCOV_EXCL_LINE
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+
+#pragma omp for schedule(dynamic)
+        for (da_int task = 0; task < n_tasks; task++) {
+            da_int it = task % m_tiles, jt = task / m_tiles;
+            if (alloc_error || (symmetric && jt < it))
+                continue;
+            da_int i0 = it * lp_mc, j0 = jt * lp_nc;
+            da_int mb = std::min(m - i0, (da_int)lp_mc);
+            da_int nb = std::min(n - j0, (da_int)lp_nc);
+            std::fill(Dt.begin(), Dt.end(), (T)0.0);
+            for (da_int l0 = 0; l0 < k; l0 += lp_kc) {
+                da_int kc = std::min(k - l0, (da_int)lp_kc);
+                lp_pack(order, X, ldx, i0, mb, l0, kc, Xp.data(), lp_mc);
+                lp_pack(order, Y, ldy, j0, nb, l0, kc, Yp.data(), lp_nc);
+                for (da_int jr = 0; jr < nb; jr += lp_nr) {
+                    for (da_int ir = 0; ir < mb; ir += lp_mr<T>)
+                        lp_micro_kernel<P>(kc, Xp.data() + ir, Yp.data() + jr,
+                                           Dt.data() + ir + jr * lp_mc, p);
+                }
+            }
+
+            // Write the tile, and its transpose for the off-diagonal symmetric tiles
+            bool mirror = symmetric && jt > it;
+            for (da_int jj = 0; jj < nb; jj++) {
+                for (da_int ii = 0; ii < mb; ii++) {
+                    T dist = lp_root<P>(Dt[ii + jj * lp_mc], p);
+                    da_int i = i0 + ii, j = j0 + jj;
+                    if (order == column_major) {
+                        D[i + j * ldd] = dist;
+                        if (mirror)
+                            D[j + i * ldd] = dist;
+                    } else {
+                        D[i * ldd + j] = dist;
+                        if (mirror)
+                            D[j * ldd + i] = dist;
+                    }
+                }
+            }
+        }
+    }
+
+    if (threading_error)
+        return da_status_memory_error; // LCOV_EXCL_LINE
+    return da_status_success;
+}
+
+} // namespace pairwise_distances
+} // namespace da_metrics
+} // namespace ARCH
+
+#endif
@@ -29,7 +29,7 @@
 #include "aoclda_types.h"
 #include "da_cblas.hh"
 #include "da_error.hpp"
-#include "da_std.hpp"
+#include "lp_distance_kernels.hpp"
 #include "pairwise_distances.hpp"
 
 namespace ARCH {
@@ -39,44 +39,7 @@ namespace pairwise_distances {
 template <typename T>
 da_status manhattan(da_order order, da_int m, da_int n, da_int k, const T *X, da_int ldx,
                     const T *Y, da_int ldy, T *D, da_int ldd) {
-    da_status status = da_status_success;
-    const T *Y_new = Y;
-    // We want to compute the distance of X to itself
-    // The sizes are copies so it's safe to update them
-    if (Y == nullptr) {
-        n = m;
-        ldy = ldx;
-        Y_new = X;
-    }
-    if (order == column_major) {
-        // Go through the columns of D
-        for (da_int j = 0; j < n; j++) {
-            // Fill the column Dj with zeros
-            da_std::fill(D + j * ldd, D + j * ldd + m, 0.0);
-            // Go through the columns of both X and Y
-            for (da_int l = 0; l < k; l++) {
-                // Go through the rows of X (also updating the rows of D)
-                for (da_int i = 0; i < m; i++) {
-                    D[i + j * ldd] += std::abs(X[i + l * ldx] - Y_new[j + l * ldy]);
-                }
-            }
-        }
-    } else {
-        // Go through the rows of D
-        for (da_int i = 0; i < m; i++) {
-            // Fill the row Di with zeros
-            da_std::fill(D + i * ldd, D + i * ldd + n, 0.0);
-            // Go through the columns of both X and Y
-            for (da_int l = 0; l < k; l++) {
-                // Go through the columns of X (also updating the columns of D)
-                for (da_int j = 0; j < n; j++) {
-                    D[i * ldd + j] += std::abs(X[i * ldx + l] - Y_new[j * ldy + l]);
-                }
-            }
-        }
-    }
-
-    return status;
+    return lp_distance<lp_1>(order, m, n, k, X, ldx, Y, ldy, D, ldd, (T)1.0);
 }
 
 template da_status manhattan<float>(da_order order, da_int m, da_int n, da_int k,
@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "hnsw.hpp"
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "da_omp.hpp"
+#include "da_utils.hpp"
+#include "macros.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+
+namespace ARCH {
+
+namespace da_knn {
+
+// Scale x[0:d] to unit norm, zero vectors are left unchanged
+template <typename T> inline void normalize(da_int d, T *x) {
+    T norm = 0;
+    for (da_int j = 0; j < d; j++)
+        norm += x[j] * x[j];
+    if (norm > 0) {
+        norm = 1 / std::sqrt(norm);
+        for (da_int j = 0; j < d; j++)
+            x[j] *= norm;
+    }
+}
+
+template <typename T> T hnsw<T>::distance(const T *x, const T *y) const {
+    T dist = 0;
+    if (cosine) {
+#pragma omp simd reduction(+ : dist)
+        for (da_int j = 0; j < d; j++)
+            dist += x[j] * y[j];
+        return 1 - dist;
+    }
+#pragma omp simd reduction(+ : dist)
+    for (da_int j = 0; j < d; j++) {
+        T diff = x[j] - y[j];
+        dist += diff * diff;
+    }
+    return dist;
+}
+
+template <typename T>
+template <bool locked>
+void hnsw<T>::greedy_search(const T *q, da_int &ep, T &d_ep, da_int layer,
+                            std::vector<omp_lock_t> &locks) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        da_int current = ep;
+        if constexpr (locked)
+            omp_set_lock(&locks[current]);
+        const da_int *nb = links(current, layer);
+        for (da_int j = 1; j <= nb[0]; j++) {
+            T dist = distance(q, &points[nb[j] * d]);
+            if (dist < d_ep) {
+                d_ep = dist;
+                ep = nb[j];
+                changed = true;
+            }
+        }
+        if constexpr (locked)
+            omp_unset_lock(&locks[current]);
+    }
+}
+
+template <typename T>
+template <bool locked>
+void hnsw<T>::search_layer(const T *q, da_int ep, T d_ep, da_int ef, da_int layer,
+                           visited_list &vl, std::vector<candidate> &result,
+                           std::vector<omp_lock_t> &locks) {
+    // Candidates still to be expanded, as a min-heap on the distance
+    std::vector<candidate> frontier;
+    auto closer = std::greater<candidate>();
+    vl.next();
+    vl.visited[ep] = vl.tag;
+    frontier.push_back({d_ep, ep});
+    result.clear();
+    result.push_back({d_ep, ep});
+    while (!frontier.empty()) {
+        std::pop_heap(frontier.begin(), frontier.end(), closer);
+        candidate c = frontier.back();
+        frontier.pop_back();
+        // All the remaining candidates are further away than the current results
+        if ((da_int)result.size() >= ef && c.first > result.front().first)
+            break;
+        if constexpr (locked)
+            omp_set_lock(&locks[c.second]);
+        const da_int *nb = links(c.second, layer);
+        for (da_int j = 1; j <= nb[0]; j++) {
+            da_int id = nb[j];
+            if (vl.visited[id] == vl.tag)
+                continue;
+            vl.visited[id] = vl.tag;
+            T dist = distance(q, &points[id * d]);
+            if ((da_int)result.size() < ef || dist < result.front().first) {
+                frontier.push_back({dist, id});
+                std::push_heap(frontier.begin(), frontier.end(), closer);
+                result.push_back({dist, id});
+                std::push_heap(result.begin(), result.end());
+                if ((da_int)result.size() > ef) {
+                    std::pop_heap(result.begin(), result.end());
+                    result.pop_back();
+                }
+            }
+        }
+        if constexpr (locked)
+            omp_unset_lock(&locks[c.second]);
+    }
+}
+
+template <typename T>
+void hnsw<T>::select_neighbors(std::vector<candidate> &candidates, da_int m) {
+    if ((da_int)candidates.size() <= m)
+        return;
+    std::sort(candidates.begin(), candidates.end());
+    std::vector<candidate> selected;
+    selected.reserve(m);
+    for (auto &c : candidates) {
+        if ((da_int)selected.size() == m)
+            break;
+        bool keep = true;
+        for (auto &s : selected) {
+            if (distance(&points[c.second * d], &points[s.second * d]) < c.first) {
+                keep = false;
+                break;
+            }
+        }
+        if (keep)
+            selected.push_back(c);
+    }
+    candidates = std::move(selected);
+}
+
+/* Insert point i in the graph. The links of each point are protected by locks[i], and
+ * entry_lock protects the entry point of the graph. It is held during the whole insertion
+ * of the rare points that create a new top layer.
+ */
+template <typename T>
+void hnsw<T>::insert(da_int i, visited_list &vl, std::vector<omp_lock_t> &locks,
+                     omp_lock_t &entry_lock) {
+    const T *q = &points[i * d];
+    da_int level = levels[i];
+    omp_set_lock(&entry_lock);
+    da_int ep = entry_point, top = max_level;
+    bool new_top = level > top;
+    if (!new_top)
+        omp_unset_lock(&entry_lock);
+    if (ep < 0) {
+        entry_point = i;
+        max_level = level;
+        omp_unset_lock(&entry_lock);
+        return;
+    }
+
+    T d_ep = distance(q, &points[ep * d]);
+    for (da_int layer = top; layer > level; layer--)
+        greedy_search<true>(q, ep, d_ep, layer, locks);
+
+    std::vector<candidate> result, neighbors;
+    for (da_int layer = std::min(level, top); layer >= 0; layer--) {
+        search_layer<true>(q, ep, d_ep, ef_construction, layer, vl, result, locks);
+        // The next layer is searched from the closest point found
+        candidate closest = *std::min_element(result.begin(), result.end());
+        select_neighbors(result, M);
+
+        omp_set_lock(&locks[i]);
+        da_int *li = links(i, layer);
+        li[0] = (da_int)result.size();
+        for (da_int j = 0; j < li[0]; j++)
+            li[j + 1] = result[j].second;
+        omp_unset_lock(&locks[i]);
+
+        // Add the reverse links, pruning the lists of neighbors that are full
+        da_int cap = capacity(layer);
+        for (auto &c : result) {
+            da_int nb = c.second;
+            const T *x_nb = &points[nb * d];
+            omp_set_lock(&locks[nb]);
+            da_int *ln = links(nb, layer);
+            if (ln[0] < cap) {
+                ln[0]++;
+                ln[ln[0]] = i;
+            } else {
+                neighbors.resize(cap + 1);
+                neighbors[0] = {c.first, i};
+                for (da_int j = 1; j <= cap; j++)
+                    neighbors[j] = {distance(x_nb, &points[ln[j] * d]), ln[j]};
+                select_neighbors(neighbors, cap);
+                ln[0] = (da_int)neighbors.size();
+                for (da_int j = 0; j < ln[0]; j++)
+                    ln[j + 1] = neighbors[j].second;
+            }
+            omp_unset_lock(&locks[nb]);
+        }
+        ep = closest.second;
+        d_ep = closest.first;
+    }
+
+    if (new_top) {
+        entry_point = i;
+        max_level = level;
+        omp_unset_lock(&entry_lock);
+    }
+}
+
+template <typename T>
+da_status hnsw<T>::build(da_int n, da_int d, const T *X, da_int ldx) {
+    this->n = 0;
+    this->d = d;
+    entry_point = -1;
+    max_level = -1;
+    std::mt19937_64 mt_gen;
+    da_int seed_val = seed;
+    if (seed_val == -1) {
+        std::random_device r;
+        seed_val = std::abs((da_int)r());
+    }
+    mt_gen.seed(seed_val);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    // Levels follow a geometric distribution of ratio 1/M
+    double level_mult = 1.0 / std::log((double)M);
+    std::vector<omp_lock_t> locks;
+    try {
+        points.resize(n * d);
+        levels.resize(n);
+        links0.assign(n * (2 * M + 1), 0);
+        links_upper.assign(n, std::vector<da_int>());
+        for (da_int i = 0; i < n; i++) {
+            levels[i] = (da_int)(-std::log(1.0 - uniform(mt_gen)) * level_mult);
+            links_upper[i].assign(levels[i] * (M + 1), 0);
+        }
+        locks.resize(n);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    for (da_int j = 0; j < d; j++)
+        for (da_int i = 0; i < n; i++)
+            points[i * d + j] = X[i + j * ldx];
+    if (cosine)
+        for (da_int i = 0; i < n; i++)
+            normalize(d, &points[i * d]);
+    this->n = n;
+
+    omp_lock_t entry_lock;
+    omp_init_lock(&entry_lock);
+    for (auto &lock : locks)
+        omp_init_lock(&lock);
+    da_int threading_error = 0;
+    da_int n_threads = da_utils::get_n_threads_loop(n);
+#pragma omp parallel default(none) shared(n, locks, entry_lock, threading_error)        \
+    num_threads(n_threads)
+    {
+        visited_list vl;
+        try {
+            vl.visited.assign(n, 0);
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+        // The first point must be in the graph before the others can be linked to it
+#pragma omp single
+        if (!vl.visited.empty())
+            insert(0, vl, locks, entry_lock);
+#pragma omp for schedule(dynamic, 16)
+        for (da_int i = 1; i < n; i++) {
+            if (vl.visited.empty())
+                continue;
+            try {
+                insert(i, vl, locks, entry_lock);
+            } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+                threading_error = 1; // LCOV_EXCL_LINE
+            }
+        }
+    }
+    for (auto &lock : locks)
+        omp_destroy_lock(&lock);
+    omp_destroy_lock(&entry_lock);
+
+    if (threading_error == 1 || entry_point < 0) {
+        this->n = 0;
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    return da_status_success;
+}
+
+template <typename T>
+da_status hnsw<T>::query(da_int n_queries, const T *X_test, da_int ldx_test, da_int k,
+                         da_int ef, da_int *n_ind, T *n_dist) {
+    if (empty())
+        return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "The HNSW graph has not been built.");
+    ef = std::max(ef, k);
+    da_int threading_error = 0;
+    std::vector<omp_lock_t> no_locks;
+    da_int n_threads = da_utils::get_n_threads_loop(n_queries);
+#pragma omp parallel default(none)                                                       \
+    shared(n_queries, X_test, ldx_test, k, ef, n_ind, n_dist, threading_error, no_locks) \
+    num_threads(n_threads)
+    {
+        visited_list vl;
+        std::vector<T> q;
+        std::vector<candidate> result;
+        bool allocated = true;
+        try {
+            vl.visited.assign(n, 0);
+            q.resize(d);
+            result.reserve(ef + 1);
+        } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+            allocated = false;
+#pragma omp atomic write
+            threading_error = 1; // LCOV_EXCL_LINE
+        }
+#pragma omp for schedule(dynamic, 8)
+        for (da_int iq = 0; iq < n_queries; iq++) {
+            if (!allocated)
+                continue;
+            for (da_int j = 0; j < d; j++)
+                q[j] = X_test[iq + j * ldx_test];
+            if (cosine)
+                normalize(d, q.data());
+            da_int ep = entry_point;
+            T d_ep = distance(q.data(), &points[ep * d]);
+            for (da_int layer = max_level; layer > 0; layer--)
+                greedy_search<false>(q.data(), ep, d_ep, layer, no_locks);
+            search_layer<false>(q.data(), ep, d_ep, ef, 0, vl, result, no_locks);
+            if ((da_int)result.size() < k) {
+                // The search got trapped in a part of the graph with fewer than k points,
+                // fall back to an exhaustive search for this query
+                try {
+                    result.resize(n);
+                } catch (std::bad_alloc const &) { // LCOV_EXCL_LINE
+#pragma omp atomic write
+                    threading_error = 1; // LCOV_EXCL_LINE
+                    continue;
+                }
+                for (da_int i = 0; i < n; i++)
+                    result[i] = {distance(q.data(), &points[i * d]), i};
+            }
+            // Ties are resolved in favour of the smallest indices
+            std::partial_sort(result.begin(), result.begin() + k, result.end());
+            for (da_int j = 0; j < k; j++) {
+                n_ind[iq * k + j] = result[j].second;
+                if (n_dist)
+                    n_dist[iq * k + j] = result[j].first;
+            }
+        }
+    }
+    if (threading_error == 1)
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    return da_status_success;
+}
+
+/* Layout of a serialized index: the header fields below as 64-bit integers, then the
+ * points, the levels, the links of layer 0 and the links of the upper layers of each point.
+ */
+namespace {
+const int64_t hnsw_magic = 0x57534e48;
+const int64_t hnsw_version = 1;
+enum hnsw_header_field {
+    hdr_magic = 0,
+    hdr_version,
+    hdr_real_size,
+    hdr_int_size,
+    hdr_n,
+    hdr_d,
+    hdr_M,
+    hdr_ef_construction,
+    hdr_seed,
+    hdr_cosine,
+    hdr_entry_point,
+    hdr_max_level,
+    hdr_size
+};
+
+template <typename U>
+void append(std::vector<char> &buffer, const U *data, size_t count) {
+    size_t bytes = count * sizeof(U);
+    size_t pos = buffer.size();
+    buffer.resize(pos + bytes);
+    if (bytes > 0)
+        std::memcpy(&buffer[pos], data, bytes);
+}
+
+template <typename U>
+bool read(const char *buffer, size_t size, size_t &pos, U *data, size_t count) {
+    size_t bytes = count * sizeof(U);
+    if (size - pos < bytes)
+        return false;
+    if (bytes > 0)
+        std::memcpy(data, buffer + pos, bytes);
+    pos += bytes;
+    return true;
+}
+} // namespace
+
+template <typename T> da_status hnsw<T>::serialize(std::vector<char> &buffer) const {
+    int64_t header[hdr_size];
+    header[hdr_magic] = hnsw_magic;
+    header[hdr_version] = hnsw_version;
+    header[hdr_real_size] = sizeof(T);
+    header[hdr_int_size] = sizeof(da_int);
+    header[hdr_n] = n;
+    header[hdr_d] = d;
+    header[hdr_M] = M;
+    header[hdr_ef_construction] = ef_construction;
+    header[hdr_seed] = seed;
+    header[hdr_cosine] = cosine;
+    header[hdr_entry_point] = entry_point;
+    header[hdr_max_level] = max_level;
+    try {
+        buffer.clear();
+        append(buffer, header, hdr_size);
+        append(buffer, points.data(), points.size());
+        append(buffer, levels.data(), levels.size());
+        append(buffer, links0.data(), links0.size());
+        for (auto &links_i : links_upper)
+            append(buffer, links_i.data(), links_i.size());
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    return da_status_success;
+}
+
+template <typename T>
+da_status hnsw<T>::deserialize(const char *buffer, size_t size) {
+    int64_t header[hdr_size];
+    size_t pos = 0;
+    std::string invalid = "The buffer does not contain a valid HNSW index.";
+    if (!buffer || !read(buffer, size, pos, header, hdr_size) ||
+        header[hdr_magic] != hnsw_magic)
+        return da_error(err, da_status_invalid_input, invalid);
+    if (header[hdr_version] != hnsw_version || header[hdr_real_size] != sizeof(T) ||
+        header[hdr_int_size] != sizeof(da_int))
+        return da_error(
+            err, da_status_invalid_input,
+            "The HNSW index was saved with a different version or precision.");
+    da_int new_n = (da_int)header[hdr_n], new_d = (da_int)header[hdr_d],
+           new_M = (da_int)header[hdr_M];
+    if (new_n < 1 || new_d < 1 || new_M < 2 || header[hdr_entry_point] < 0 ||
+        header[hdr_entry_point] >= new_n)
+        return da_error(err, da_status_invalid_input, invalid);
+
+    this->n = 0;
+    M = new_M;
+    d = new_d;
+    ef_construction = (da_int)header[hdr_ef_construction];
+    seed = (da_int)header[hdr_seed];
+    cosine = header[hdr_cosine] != 0;
+    entry_point = (da_int)header[hdr_entry_point];
+    max_level = (da_int)header[hdr_max_level];
+    try {
+        points.resize(new_n * d);
+        levels.resize(new_n);
+        links0.resize(new_n * (2 * M + 1));
+        links_upper.assign(new_n, std::vector<da_int>());
+        bool valid = read(buffer, size, pos, points.data(), points.size()) &&
+                     read(buffer, size, pos, levels.data(), levels.size()) &&
+                     read(buffer, size, pos, links0.data(), links0.size());
+        for (da_int i = 0; valid && i < new_n; i++) {
+            valid = levels[i] >= 0 && levels[i] <= max_level;
+            if (valid) {
+                links_upper[i].resize(levels[i] * (M + 1));
+                valid = read(buffer, size, pos, links_upper[i].data(),
+                             links_upper[i].size());
+            }
+        }
+        // Check the links so that queries cannot access memory out of bounds
+        auto valid_links = [&](const da_int *l, da_int cap, da_int layer) {
+            if (l[0] < 0 || l[0] > cap)
+                return false;
+            for (da_int j = 1; j <= l[0]; j++)
+                if (l[j] < 0 || l[j] >= new_n || levels[l[j]] < layer)
+                    return false;
+            return true;
+        };
+        for (da_int i = 0; valid && i < new_n; i++) {
+            valid = valid_links(&links0[i * (2 * M + 1)], 2 * M, 0);
+            for (da_int layer = 1; valid && layer <= levels[i]; layer++)
+                valid = valid_links(&links_upper[i][(layer - 1) * (M + 1)], M, layer);
+        }
+        if (!valid || pos != size || levels[entry_point] != max_level)
+            return da_error(err, da_status_invalid_input, invalid);
+    } catch (std::bad_alloc const &) {
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    this->n = new_n;
+    return da_status_success;
+}
+
+template class hnsw<double>;
+template class hnsw<float>;
+
+} // namespace da_knn
+
+} // namespace ARCH
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "da_omp.hpp"
+#include "macros.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ARCH {
+
+namespace da_knn {
+
+/* Hierarchical navigable small world (HNSW) graph, see Malkov and Yashunin (2018),
+ * indexing the rows of a data matrix for approximate nearest neighbor queries.
+ *
+ * Layer 0 contains all the points and each upper layer a random subset of the layer below,
+ * exponentially smaller. Each point is linked to at most 2M points on layer 0 and M points on
+ * the upper layers. A query descends greedily from the single point of the top layer and
+ * runs a best-first search of width ef on layer 0.
+ *
+ * Distances are squared euclidean distances, or 1 - cosine similarity if the index is built
+ * for the cosine metric, in which case the points are normalized once on input.
+ */
+template <typename T> class hnsw {
+  public:
+    // Build parameters
+    da_int M = 16, ef_construction = 200, seed = 0;
+    bool cosine = false;
+
+    hnsw(da_errors::da_error_t &err) : err(&err) {}
+
+    bool empty() const { return n == 0; }
+
+    // Build the index for the n x d column-major matrix X. Points are inserted in parallel.
+    da_status build(da_int n, da_int d, const T *X, da_int ldx);
+
+    // Compute the k nearest neighbors of the n_queries x d column-major matrix X_test,
+    // exploring lists of at least ef candidates. For each query, the k indices and
+    // distances are written contiguously in n_ind and, if not null, n_dist, sorted by
+    // increasing distance.
+    da_status query(da_int n_queries, const T *X_test, da_int ldx_test, da_int k,
+                    da_int ef, da_int *n_ind, T *n_dist);
+
+    // Write the index to buffer or rebuild it from the output of serialize
+    da_status serialize(std::vector<char> &buffer) const;
+    da_status deserialize(const char *buffer, size_t size);
+
+  private:
+    da_errors::da_error_t *err = nullptr;
+
+    da_int n = 0, d = 0;
+    // Points stored row by row, normalized for the cosine metric
+    std::vector<T> points;
+    // Top layer of each point
+    std::vector<da_int> levels;
+    // Links on layer 0: for each point, the number of neighbors then 2M slots
+    std::vector<da_int> links0;
+    // Links on the upper layers 1..levels[i] of point i, each stored as in links0 with M slots
+    std::vector<std::vector<da_int>> links_upper;
+    da_int entry_point = -1, max_level = -1;
+
+    // Per-thread list of visited points: point i is visited if visited[i] == tag
+    struct visited_list {
+        std::vector<da_int> visited;
+        da_int tag = 0;
+        void next() { tag++; }
+    };
+    using candidate = std::pair<T, da_int>;
+
+    da_int capacity(da_int layer) const { return layer == 0 ? 2 * M : M; }
+    da_int *links(da_int i, da_int layer) {
+        return layer == 0 ? &links0[i * (2 * M + 1)]
+                          : &links_upper[i][(layer - 1) * (M + 1)];
+    }
+    T distance(const T *x, const T *y) const;
+
+    // Greedy search for the closest point to q on layer, starting from ep
+    template <bool locked>
+    void greedy_search(const T *q, da_int &ep, T &d_ep, da_int layer,
+                       std::vector<omp_lock_t> &locks);
+    // Best-first search of width ef on layer, starting from ep. On exit, result contains
+    // the closest points found, as a max-heap on the distance
+    template <bool locked>
+    void search_layer(const T *q, da_int ep, T d_ep, da_int ef, da_int layer,
+                      visited_list &vl, std::vector<candidate> &result,
+                      std::vector<omp_lock_t> &locks);
+    // Keep at most m of the candidates, preferring diverse directions (heuristic of
+    // Malkov and Yashunin): a candidate is dropped if it is closer to an already selected
+    // point than to the base point. On entry candidates can be in any order.
+    void select_neighbors(std::vector<candidate> &candidates, da_int m);
+    void insert(da_int i, visited_list &vl, std::vector<omp_lock_t> &locks,
+                omp_lock_t &entry_lock);
+};
+
+} // namespace da_knn
+
+} // namespace ARCH
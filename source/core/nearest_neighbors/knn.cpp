@@ -34,7 +34,11 @@
 #include "knn_options.hpp"
 #include "macros.h"
 #include "pairwise_distances.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <numeric>
+#include <utility>
 
 namespace ARCH {
 
@@ -46,7 +50,8 @@ template <typename T> knn<T>::~knn() {
         delete[] (X_train_temp);
 }
 
-template <typename T> knn<T>::knn(da_errors::da_error_t &err) : basic_handle<T>(err) {
+template <typename T>
+knn<T>::knn(da_errors::da_error_t &err) : basic_handle<T>(err), index(err) {
     // Initialize the options registry
     // Any error is stored err->status[.] and this NEEDS to be checked
     // by the caller.
@@ -54,10 +59,30 @@ template <typename T> knn<T>::knn(da_errors::da_error_t &err) : basic_handle<T>(
 }
 
 template <typename T>
-da_status knn<T>::get_result([[maybe_unused]] da_result query,
-                             [[maybe_unused]] da_int *dim, [[maybe_unused]] T *result) {
-    return da_warn_bypass(this->err, da_status_unknown_query,
-                          "There are no floating-point results available for this API.");
+da_status knn<T>::get_result(da_result query, da_int *dim, T *result) {
+    // Pointers were already tested in the generic get_result
+    switch (query) {
+    case da_result::da_knn_radius_neighbors_distances: {
+        if (rn_offsets.empty())
+            return da_warn_bypass(this->err, da_status_unknown_query,
+                                  "Handle does not contain data relevant to this query. "
+                                  "Radius neighbors need to be computed.");
+        da_int size = (da_int)rn_dist.size();
+        if (*dim < size) {
+            *dim = size;
+            return da_warn_bypass(this->err, da_status_invalid_array_dimension,
+                                  "The array is too small. Please provide an array of at "
+                                  "least size: " +
+                                      std::to_string(size) + ".");
+        }
+        std::copy(rn_dist.begin(), rn_dist.end(), result);
+        break;
+    }
+    default:
+        return da_warn_bypass(this->err, da_status_unknown_query,
+                              "The requested result could not be found.");
+    }
+    return da_status_success;
 }
 
 template <typename T>
@@ -89,6 +114,25 @@ da_status knn<T>::get_result([[maybe_unused]] da_result query,
         result[4] = da_int(n_features);
         result[5] = da_int(n_samples);
         break;
+    case da_result::da_knn_radius_neighbors_offsets:
+    case da_result::da_knn_radius_neighbors_indices: {
+        if (rn_offsets.empty())
+            return da_warn_bypass(this->err, da_status_unknown_query,
+                                  "Handle does not contain data relevant to this query. "
+                                  "Radius neighbors need to be computed.");
+        const std::vector<da_int> &res =
+            query == da_result::da_knn_radius_neighbors_offsets ? rn_offsets : rn_ind;
+        da_int size = (da_int)res.size();
+        if (*dim < size) {
+            *dim = size;
+            return da_warn_bypass(this->err, da_status_invalid_array_dimension,
+                                  "The array is too small. Please provide an array of at "
+                                  "least size: " +
+                                      std::to_string(size) + ".");
+        }
+        std::copy(res.begin(), res.end(), result);
+        break;
+    }
     default:
         return da_warn_bypass(this->err, da_status_unknown_query,
                               "The requested result could not be found.");
@@ -105,12 +149,25 @@ template <typename T> da_status knn<T>::set_params() {
     opt_pass &= this->opts.get("metric", opt_val, metric) == da_status_success;
     opt_pass &= this->opts.get("weights", opt_val, weights) == da_status_success;
     opt_pass &= this->opts.get("minkowski parameter", p) == da_status_success;
+    opt_pass &= this->opts.get("hnsw max connections", hnsw_m) == da_status_success;
+    opt_pass &= this->opts.get("hnsw construction width", hnsw_ef_construction) ==
+                da_status_success;
+    opt_pass &= this->opts.get("hnsw search width", hnsw_ef_search) == da_status_success;
+    opt_pass &= this->opts.get("seed", seed) == da_status_success;
+    opt_pass &= this->opts.get("radius", radius) == da_status_success;
+    opt_pass &= this->opts.get("outlier label", outlier_label) == da_status_success;
 
     if (!opt_pass)
         return da_error_bypass(this->err, da_status_internal_error, // LCOV_EXCL_LINE
                                "Unexpected error while reading the optional parameters.");
     internal_metric = da_metric(metric);
 
+    if (algo == da_hnsw && metric != da_euclidean && metric != da_l2 &&
+        metric != da_sqeuclidean && metric != da_cosine)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The hnsw algorithm only supports the euclidean, l2, sqeuclidean "
+                        "and cosine metrics.");
+
     if (metric == da_euclidean) {
         this->get_squares = true;
         internal_metric = da_sqeuclidean;
@@ -123,6 +180,51 @@ template <typename T>
 da_status knn<T>::set_training_data(da_int n_samples, da_int n_features, const T *X_train,
                                     da_int ldx_train, const da_int *y_train) {
 
+    da_status status = store_training_data(n_samples, n_features, X_train, ldx_train);
+    if (status != da_status_success)
+        return status;
+
+    status = this->check_1D_array(n_samples, y_train, "n_samples", "y_train", 1);
+    if (status != da_status_success)
+        return status;
+
+    // Set internal pointers to user data
+    this->y_train = y_train;
+    this->y_train_reg = nullptr;
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->istrained = true;
+
+    return da_status_success;
+}
+
+template <typename T>
+da_status knn<T>::set_regression_data(da_int n_samples, da_int n_features,
+                                      const T *X_train, da_int ldx_train,
+                                      const T *y_train) {
+
+    da_status status = store_training_data(n_samples, n_features, X_train, ldx_train);
+    if (status != da_status_success)
+        return status;
+
+    status = this->check_1D_array(n_samples, y_train, "n_samples", "y_train", 1);
+    if (status != da_status_success)
+        return status;
+
+    // Set internal pointers to user data
+    this->y_train = nullptr;
+    this->y_train_reg = y_train;
+    this->n_samples = n_samples;
+    this->n_features = n_features;
+    this->istrained = true;
+
+    return da_status_success;
+}
+
+// Store the training data matrix and reset everything computed from the previous one
+template <typename T>
+da_status knn<T>::store_training_data(da_int n_samples, da_int n_features,
+                                      const T *X_train, da_int ldx_train) {
     // Guard against errors due to multiple calls using the same class instantiation
     if (X_train_temp) {
         delete[] (X_train_temp);
@@ -135,44 +237,97 @@ da_status knn<T>::set_training_data(da_int n_samples, da_int n_features, const T
     if (status != da_status_success)
         return status;
 
-    status = this->check_1D_array(n_samples, y_train, "n_samples", "y_train", 1);
+    this->index_built = false;
+    this->classes_computed = false;
+    rn_offsets.clear();
+    return da_status_success;
+}
+
+template <typename T>
+da_status knn<T>::store_queries(da_int n_queries, da_int n_features, const T *X_test,
+                                da_int ldx_test, const T *&X_test_temp,
+                                da_int &ldx_test_temp,
+                                std::unique_ptr<T[]> &X_test_copy) {
+    T *utility_ptr = nullptr;
+    ldx_test_temp = ldx_test;
+    da_status status = this->store_2D_array(n_queries, n_features, X_test, ldx_test,
+                                            &utility_ptr, &X_test_temp, ldx_test_temp,
+                                            "n_queries", "n_features", "X_test",
+                                            "ldx_test");
+    // Row-major test data is copied to a column-major buffer owned by X_test_copy
+    X_test_copy.reset(utility_ptr);
     if (status != da_status_success)
         return status;
+    if (n_features != this->n_features)
+        return da_error_bypass(this->err, da_status_invalid_array_dimension,
+                               "n_features = " + std::to_string(n_features) +
+                                   " doesn't match the expected value " +
+                                   std::to_string(this->n_features) + ".");
+    return da_status_success;
+}
 
-    // Set internal pointers to user data
-    this->y_train = y_train;
-    this->n_samples = n_samples;
-    this->n_features = n_features;
-    this->istrained = true;
+// Bounded max-heaps holding, for one query, the k smallest distances found so far and the
+// indices of the corresponding training points. The root holds the largest of the k
+// distances, so that most candidates are rejected after a single comparison.
+// Entries are ordered by distance, then by index, so that ties are resolved in favour of
+// the training points with the smallest indices.
+template <typename T> inline bool heap_less(T d1, da_int i1, T d2, da_int i2) {
+    return d1 < d2 || (d1 == d2 && i1 < i2);
+}
 
-    return da_status_success;
+// Insert the candidate (dist, ind) in a heap of capacity k currently holding size entries
+template <typename T>
+inline void heap_push(da_int k, da_int &size, T *heap_dist, da_int *heap_ind, T dist,
+                      da_int ind) {
+    da_int pos;
+    if (size < k) {
+        // Sift the new entry up from the first free leaf
+        pos = size++;
+        while (pos > 0) {
+            da_int parent = (pos - 1) / 2;
+            if (!heap_less(heap_dist[parent], heap_ind[parent], dist, ind))
+                break;
+            heap_dist[pos] = heap_dist[parent];
+            heap_ind[pos] = heap_ind[parent];
+            pos = parent;
+        }
+    } else {
+        if (!heap_less(dist, ind, heap_dist[0], heap_ind[0]))
+            return;
+        // Replace the root and sift it down
+        pos = 0;
+        while (2 * pos + 1 < k) {
+            da_int child = 2 * pos + 1;
+            if (child + 1 < k && heap_less(heap_dist[child], heap_ind[child],
+                                           heap_dist[child + 1], heap_ind[child + 1]))
+                child++;
+            if (!heap_less(dist, ind, heap_dist[child], heap_ind[child]))
+                break;
+            heap_dist[pos] = heap_dist[child];
+            heap_ind[pos] = heap_ind[child];
+            pos = child;
+        }
+    }
+    heap_dist[pos] = dist;
+    heap_ind[pos] = ind;
 }
 
-// Given a vector D of length n and an integer k, this function returns in the first k positions
-// of a vector k_dist, the k smaller values of D (unordered) and in the first k positions of a vector
-// k_ind, the corresponding indices of the original vector D, where initial indices are
-// init_index, init_index+1, ...
+// Push the n distances D between a query and the training points first, first+1, ... into
+// the heap of the query
 template <typename T>
-inline void smaller_values_and_indices(da_int n, T *D, da_int k, da_int *k_ind, T *k_dist,
-                                       da_int init_index, bool init = true) {
-    // Initialize the first k values of k_ind with init_index, init_index+1, ..., init_index+k-1
-    if (init)
-        da_std::iota(k_ind, k_ind + k, init_index);
-    // Find the index of the maximum element and the corresponding maximum value.
-    da_int max_index = da_blas::cblas_iamax(k, k_dist, 1);
-    T max_val = k_dist[max_index];
-
-    for (da_int i = k; i < n; i++) {
-        // Check if an element of D is smaller than the maximum value. If it is,
-        // we need to replace it's index in k_ind and replace the corresponding D[i] in k_dist.
-        if (D[i] <= max_val) {
-            // We know D[i] is smaller than Dmax. So we update k_ind[max_index] and D[max_index]
-            // so that they hold the new value.
-            k_ind[max_index] = i;
-            k_dist[max_index] = D[i];
-            // Now we need to find the new maximum so that we compare against that in the next iteration.
-            max_index = da_blas::cblas_iamax(k, k_dist, 1);
-            max_val = k_dist[max_index];
+inline void heap_update(da_int n, const T *D, da_int first, da_int k, da_int &size,
+                        T *heap_dist, da_int *heap_ind) {
+    da_int i = 0;
+    for (; i < n && size < k; i++)
+        heap_push(k, size, heap_dist, heap_ind, D[i], first + i);
+    if (i == n)
+        return;
+    // The indices are increasing, so only strictly smaller distances can enter a full heap
+    T max_dist = heap_dist[0];
+    for (; i < n; i++) {
+        if (D[i] < max_dist) {
+            heap_push(k, size, heap_dist, heap_ind, D[i], first + i);
+            max_dist = heap_dist[0];
         }
     }
 }
@@ -186,8 +341,9 @@ inline void sorted_n_dist_n_ind(da_int n, T *k_dist, da_int *k_ind, T *n_dist,
     // We sort with respect to partial distances and then we use the sorted array to reorder the array of indices.
     da_std::iota(perm_vector, perm_vector + n, 0);
 
-    std::stable_sort(perm_vector, perm_vector + n,
-                     [&](da_int i, da_int j) { return k_dist[i] < k_dist[j]; });
+    std::sort(perm_vector, perm_vector + n, [&](da_int i, da_int j) {
+        return heap_less(k_dist[i], k_ind[i], k_dist[j], k_ind[j]);
+    });
 
     for (da_int i = 0; i < n; i++)
         n_ind[i] = k_ind[perm_vector[i]];
@@ -203,59 +359,51 @@ inline void sorted_n_dist_n_ind(da_int n, T *k_dist, da_int *k_ind, T *n_dist,
     }
 }
 
+// Compute the k-nearest neighbors of a block of queries.
+// The distances are computed for one block of training points at a time, into D, and the
+// heaps of the queries are updated directly from it while it is still in cache, so the
+// full matrix of distances between the queries and the training data is never formed.
 template <typename T>
-template <da_int XTRAIN_BLOCK>
 da_status knn<T>::kneighbors_kernel(da_int xtrain_block_size, da_int n_blocks_train,
                                     da_int block_rem_train, da_int n_queries,
                                     da_int n_features, const T *X_test, da_int ldx_test,
                                     T *D, da_int *n_ind, T *n_dist, da_int n_neigh,
                                     bool return_distance) {
     da_status status = da_status_success;
-    // Set blocking of X_train depending on the block size
-    constexpr bool block_xtrain = XTRAIN_BLOCK != 1;
-    if constexpr (block_xtrain) {
-        da_int xtrain_subblock = xtrain_block_size;
-        for (da_int iblock = 0; iblock < n_blocks_train; iblock++) {
-            if (iblock == n_blocks_train - 1 && block_rem_train > 0)
-                xtrain_subblock = block_rem_train;
-
-            status = da_metrics::pairwise_distances::pairwise_distance_kernel(
-                column_major, xtrain_subblock, n_queries, n_features,
-                X_train + iblock * xtrain_block_size, ldx_train, X_test, ldx_test,
-                D + iblock * xtrain_block_size, n_samples, this->p,
-                this->internal_metric);
-        }
-    } else {
-        status = da_metrics::pairwise_distances::pairwise_distance_kernel(
-            column_major, this->n_samples, n_queries, n_features, this->X_train,
-            this->ldx_train, X_test, ldx_test, D, this->n_samples, this->p,
-            this->internal_metric);
-    }
-    if (status != da_status_success) {
-        return status;
-    }
-    // Get the first n_neigh smaller values of D on k_dist and the correspondind distances on n_dist.
-    // Here we can use D and replace the smaller values in place since D is not used later on.
-    T *k_dist = D;
-    std::vector<da_int> perm_vector;
-    std::vector<da_int> k_ind;
+    std::vector<T> heap_dist;
+    std::vector<da_int> heap_ind, heap_size, perm_vector;
     try {
+        heap_dist.resize(n_queries * n_neigh);
+        heap_ind.resize(n_queries * n_neigh);
+        heap_size.resize(n_queries, 0);
         perm_vector.resize(n_neigh);
-        k_ind.resize(n_queries * n_neigh);
     } catch (std::bad_alloc const &) {
         return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
-    for (da_int k = 0; k < n_queries; k++) {
-        smaller_values_and_indices(this->n_samples, D + k * this->n_samples, n_neigh,
-                                   k_ind.data() + k * n_neigh,
-                                   k_dist + k * this->n_samples, 0);
-        sorted_n_dist_n_ind(n_neigh, k_dist + k * this->n_samples,
-                            k_ind.data() + k * n_neigh, n_dist + k * n_neigh,
-                            n_ind + k * n_neigh, perm_vector.data(), return_distance,
-                            this->get_squares);
+
+    da_int xtrain_subblock = xtrain_block_size;
+    for (da_int iblock = 0; iblock < n_blocks_train; iblock++) {
+        if (iblock == n_blocks_train - 1 && block_rem_train > 0)
+            xtrain_subblock = block_rem_train;
+        da_int first = iblock * xtrain_block_size;
+        status = da_metrics::pairwise_distances::pairwise_distance_kernel(
+            column_major, xtrain_subblock, n_queries, n_features, X_train + first,
+            ldx_train, X_test, ldx_test, D, xtrain_block_size, this->p,
+            this->internal_metric);
+        if (status != da_status_success)
+            return status;
+        for (da_int k = 0; k < n_queries; k++)
+            heap_update(xtrain_subblock, D + k * xtrain_block_size, first, n_neigh,
+                        heap_size[k], &heap_dist[k * n_neigh], &heap_ind[k * n_neigh]);
     }
 
+    // Sort the neighbors of each query by increasing distance
+    for (da_int k = 0; k < n_queries; k++)
+        sorted_n_dist_n_ind(n_neigh, &heap_dist[k * n_neigh], &heap_ind[k * n_neigh],
+                            n_dist + k * n_neigh, n_ind + k * n_neigh, perm_vector.data(),
+                            return_distance, this->get_squares);
+
     return status;
 }
 
@@ -272,17 +420,17 @@ da_status knn<T>::kneighbors_blocked_Xtest(da_int n_queries, da_int n_features,
     da_int n_blocks_test = 0, block_rem_test = 0;
     da_utils::blocking_scheme(n_queries, xtest_block_size, n_blocks_test, block_rem_test);
     da_int n_threads = da_utils::get_n_threads_loop(std::max(n_blocks_test, (da_int)1));
+    da_int xtrain_block_size = std::min(XTRAIN_BLOCK, n_samples);
+    da_int n_blocks_train = 0, block_rem_train = 0;
+    da_utils::blocking_scheme(n_samples, xtrain_block_size, n_blocks_train,
+                              block_rem_train);
     try {
-        D.resize(this->n_samples * xtest_block_size * n_threads);
+        D.resize(xtrain_block_size * xtest_block_size * n_threads);
     } catch (std::bad_alloc const &) {
         return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
     }
     da_int threading_error = 0;
-    da_int xtrain_block_size = std::min(XTRAIN_BLOCK, n_samples);
-    da_int n_blocks_train = 0, block_rem_train = 0;
-    da_utils::blocking_scheme(n_samples, xtrain_block_size, n_blocks_train,
-                              block_rem_train);
     da_status private_status = da_status_success;
     // Iterate through the number of blocks
 #pragma omp parallel default(none)                                                       \
@@ -292,7 +440,7 @@ da_status knn<T>::kneighbors_blocked_Xtest(da_int n_queries, da_int n_features,
                block_rem_train) private(private_status) num_threads(n_threads)
     {
         da_int task_thread = (da_int)omp_get_thread_num();
-        da_int D_index = task_thread * this->n_samples * xtest_block_size;
+        da_int D_index = task_thread * xtrain_block_size * xtest_block_size;
         da_int xtest_subblock = xtest_block_size;
 #pragma omp for schedule(static)
         for (da_int jblock = 0; jblock < n_blocks_test; jblock++) {
@@ -300,7 +448,7 @@ da_status knn<T>::kneighbors_blocked_Xtest(da_int n_queries, da_int n_features,
                 xtest_subblock = block_rem_test;
             // If the remaining numbers of queries is ge than the block size
             // the size of the submatrix we are computing is xtest_block_size
-            private_status = kneighbors_kernel<XTRAIN_BLOCK>(
+            private_status = kneighbors_kernel(
                 xtrain_block_size, n_blocks_train, block_rem_train, xtest_subblock,
                 n_features, X_test + jblock * xtest_block_size, ldx_test, &D[D_index],
                 n_ind + jblock * xtest_block_size * n_neigh,
@@ -347,14 +495,48 @@ da_status knn<T>::kneighbors_compute(da_int n_queries, da_int n_features, const
             da_blas::imatcopy('T', n_neigh, n_queries, 1.0, n_dist, n_neigh, n_queries);
         }
     };
-    bool is_threaded = omp_get_max_threads() != 1;
-    if (is_threaded)
-        return kneighbors_blocked_Xtest<1, 16>(n_queries, n_features, X_test, ldx_test,
-                                               n_ind, n_dist, n_neigh, return_distance);
-    else
-        return kneighbors_blocked_Xtest<2048, 16>(n_queries, n_features, X_test, ldx_test,
-                                                  n_ind, n_dist, n_neigh,
-                                                  return_distance);
+    if (this->algo == da_hnsw)
+        return kneighbors_hnsw(n_queries, X_test, ldx_test, n_ind, n_dist, n_neigh,
+                               return_distance);
+    // The distances to 1024 training points for 16 queries fit in the L2 cache
+    return kneighbors_blocked_Xtest<1024, 16>(n_queries, n_features, X_test, ldx_test,
+                                              n_ind, n_dist, n_neigh, return_distance);
+}
+
+/*
+ * Approximate k-nearest neighbors search in the HNSW graph of the training data.
+ * The graph is built on the first query after the training data or one of its parameters
+ * changed, and reused by the following queries.
+ */
+template <typename T>
+da_status knn<T>::kneighbors_hnsw(da_int n_queries, const T *X_test, da_int ldx_test,
+                                  da_int *n_ind, T *n_dist, da_int n_neigh,
+                                  bool return_distance) {
+    bool cosine = metric == da_cosine;
+    if (!index_built || index.M != hnsw_m ||
+        index.ef_construction != hnsw_ef_construction || index.seed != seed ||
+        index.cosine != cosine) {
+        index.M = hnsw_m;
+        index.ef_construction = hnsw_ef_construction;
+        index.seed = seed;
+        index.cosine = cosine;
+        index_built = false;
+        da_status status = index.build(n_samples, n_features, X_train, ldx_train);
+        if (status != da_status_success)
+            return status;
+        index_built = true;
+    }
+
+    da_status status = index.query(n_queries, X_test, ldx_test, n_neigh, hnsw_ef_search,
+                                   n_ind, return_distance ? n_dist : nullptr);
+    if (status != da_status_success)
+        return status;
+    // The graph works with squared euclidean distances
+    if (return_distance && (metric == da_euclidean || metric == da_l2)) {
+        for (da_int i = 0; i < n_queries * n_neigh; i++)
+            n_dist[i] = std::sqrt(n_dist[i]);
+    }
+    return da_status_success;
 }
 
 /**
@@ -475,12 +657,38 @@ void get_weights(const std::vector<T> &D, da_int weight_desrc, std::vector<T> &w
     }
 }
 
+/*
+ * Weighted average of the targets y of n neighbors, given their indices ind and distances
+ * dist, sorted by increasing distance and stored with stride inc.
+ * With distance weights, the neighbors at zero distance, if any, take all the weight.
+ */
+template <typename T>
+T weighted_target(da_int n, const da_int *ind, const T *dist, da_int inc, const T *y,
+                  da_int weights) {
+    T sum = 0.0, weight_sum = 0.0;
+    bool exact = weights == da_knn_distance && dist[0] <= (T)0;
+    for (da_int j = 0; j < n; j++) {
+        T d = dist[j * inc];
+        if (exact && d > (T)0)
+            break;
+        T w = (weights == da_knn_uniform || exact) ? (T)1 : (T)1 / d;
+        sum += w * y[ind[j * inc]];
+        weight_sum += w;
+    }
+    return sum / weight_sum;
+}
+
 template <typename T> da_status knn<T>::available_classes() {
     // Return if there are no training data
     if (!istrained)
         return da_error_bypass(this->err, da_status_no_data,
                                "No data has been passed to the handle. Please call "
                                "da_knn_set_data_s or da_knn_set_data_d.");
+    if (y_train == nullptr)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No class labels have been passed to the handle. Please "
+                               "call da_knn_set_training_data_s or "
+                               "da_knn_set_training_data_d.");
     // From the input data y_train, find the available classes.
     try {
         std::vector<da_int> temp_classes(y_train, y_train + this->n_samples);
@@ -719,6 +927,364 @@ da_status knn<T>::predict(da_int n_queries, da_int n_features, const T *X_test,
     return status;
 }
 
+/*
+ * Predict the targets y_test for the provided test data, as the average of the targets of
+ * their k-nearest neighbors, weighted according to the weights option.
+ */
+template <typename T>
+da_status knn<T>::predict_regression(da_int n_queries, da_int n_features, const T *X_test,
+                                     da_int ldx_test, T *y_test) {
+    da_status status = da_status_success;
+    if (!istrained)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No data has been passed to the handle. Please call "
+                               "da_knn_set_regression_data_s or "
+                               "da_knn_set_regression_data_d.");
+    if (y_train_reg == nullptr)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No targets for regression have been passed to the "
+                               "handle. Please call da_knn_set_regression_data_s or "
+                               "da_knn_set_regression_data_d.");
+    if (!is_up_to_date)
+        status = knn<T>::set_params();
+    if (status != da_status_success)
+        return status;
+    if (y_test == nullptr)
+        return da_error_bypass(this->err, da_status_invalid_pointer,
+                               "y_test is not a valid pointer.");
+    if (n_queries < 1)
+        return da_error_bypass(this->err, da_status_invalid_array_dimension,
+                               "n_queries must be greater than 0.");
+
+    da_int k = this->n_neighbors;
+    std::vector<da_int> n_ind;
+    std::vector<T> n_dist;
+    try {
+        n_ind.resize(n_queries * k);
+        n_dist.resize(n_queries * k);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    status = kneighbors(n_queries, n_features, X_test, ldx_test, n_ind.data(),
+                        n_dist.data(), k, true);
+    if (status != da_status_success)
+        return da_error_bypass(this->err, status,
+                               "Failed to compute the predicted targets due to an "
+                               "internal error of the k-nearest neighbors computation.");
+
+    // kneighbors() returns the neighbors in the storage order of the handle
+    da_int inc = this->order == column_major ? n_queries : 1;
+    da_int ld = this->order == column_major ? 1 : k;
+    for (da_int i = 0; i < n_queries; i++)
+        y_test[i] = weighted_target(k, &n_ind[i * ld], &n_dist[i * ld], inc,
+                                    y_train_reg, this->weights);
+
+    return da_status_success;
+}
+
+/*
+ * Compute the training points within the given radius of each point of X_test.
+ * If radius <= 0, the radius option is used instead.
+ * The results are kept in compressed sparse row format in rn_offsets, rn_ind and rn_dist,
+ * with the neighbors of each query sorted by increasing distance, and can be retrieved
+ * with get_result().
+ */
+template <typename T>
+da_status knn<T>::radius_neighbors(da_int n_queries, da_int n_features, const T *X_test,
+                                   da_int ldx_test, T radius) {
+    da_status status = da_status_success;
+    if (!istrained)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No data has been passed to the handle. Please call "
+                               "da_knn_set_training_data_s or "
+                               "da_knn_set_training_data_d.");
+    if (!is_up_to_date)
+        status = knn<T>::set_params();
+    if (status != da_status_success)
+        return status;
+    if (radius <= 0)
+        radius = this->radius;
+
+    const T *X_test_temp = nullptr;
+    da_int ldx_test_temp;
+    std::unique_ptr<T[]> X_test_copy;
+    status = store_queries(n_queries, n_features, X_test, ldx_test, X_test_temp,
+                           ldx_test_temp, X_test_copy);
+    if (status != da_status_success)
+        return status;
+
+    rn_offsets.clear();
+    status = radius_neighbors_compute(n_queries, X_test_temp, ldx_test_temp, radius,
+                                      rn_offsets, rn_ind, rn_dist);
+    if (status != da_status_success)
+        rn_offsets.clear();
+    return status;
+}
+
+/*
+ * Radius neighbors of the queries, in compressed sparse row format.
+ * The queries are split into blocks processed in parallel. The distances between a block
+ * of queries and a block of training points are computed at a time, as in the k-nearest
+ * neighbors, and the neighbors found are appended to buffers local to the block of
+ * queries. Once the number of neighbors of each query is known, the buffers are copied to
+ * their place in the output arrays and the neighbors of each query are sorted.
+ */
+template <typename T>
+da_status knn<T>::radius_neighbors_compute(da_int n_queries, const T *X_test,
+                                           da_int ldx_test, T radius,
+                                           std::vector<da_int> &offsets,
+                                           std::vector<da_int> &ind,
+                                           std::vector<T> &dist) {
+    // The distances to 1024 training points for 16 queries fit in the L2 cache
+    da_int xtest_block_size = std::min((da_int)16, n_queries);
+    da_int n_blocks_test = 0, block_rem_test = 0;
+    da_utils::blocking_scheme(n_queries, xtest_block_size, n_blocks_test, block_rem_test);
+    da_int n_threads = da_utils::get_n_threads_loop(std::max(n_blocks_test, (da_int)1));
+    da_int xtrain_block_size = std::min((da_int)1024, n_samples);
+    da_int n_blocks_train = 0, block_rem_train = 0;
+    da_utils::blocking_scheme(n_samples, xtrain_block_size, n_blocks_train,
+                              block_rem_train);
+    // Distances are compared in the internal metric
+    T threshold = this->get_squares ? radius * radius : radius;
+
+    std::vector<T> D;
+    std::vector<std::vector<da_int>> block_ind, block_query;
+    std::vector<std::vector<T>> block_dist;
+    try {
+        D.resize(xtrain_block_size * xtest_block_size * n_threads);
+        block_ind.resize(n_blocks_test);
+        block_query.resize(n_blocks_test);
+        block_dist.resize(n_blocks_test);
+        offsets.assign(n_queries + 1, 0);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+    da_int threading_error = 0;
+#pragma omp parallel default(none)                                                       \
+    shared(xtest_block_size, n_blocks_test, block_rem_test, n_queries, X_test, ldx_test, \
+               D, threading_error, xtrain_block_size, n_blocks_train, block_rem_train,   \
+               threshold, block_ind, block_query, block_dist, offsets)                   \
+    num_threads(n_threads)
+    {
+        da_int D_index =
+            (da_int)omp_get_thread_num() * xtrain_block_size * xtest_block_size;
+#pragma omp for schedule(dynamic)
+        for (da_int jblock = 0; jblock < n_blocks_test; jblock++) {
+            da_int xtest_subblock = xtest_block_size;
+            if (jblock == n_blocks_test - 1 && block_rem_test > 0)
+                xtest_subblock = block_rem_test;
+            da_int first_query = jblock * xtest_block_size;
+            da_int xtrain_subblock = xtrain_block_size;
+            try {
+                for (da_int iblock = 0; iblock < n_blocks_train; iblock++) {
+                    if (iblock == n_blocks_train - 1 && block_rem_train > 0)
+                        xtrain_subblock = block_rem_train;
+                    da_int first = iblock * xtrain_block_size;
+                    if (da_metrics::pairwise_distances::pairwise_distance_kernel(
+                            column_major, xtrain_subblock, xtest_subblock, n_features,
+                            X_train + first, ldx_train, X_test + first_query, ldx_test,
+                            &D[D_index], xtrain_block_size, this->p,
+                            this->internal_metric) != da_status_success) {
+#pragma omp atomic write
+                        threading_error = 1;
+                        break;
+                    }
+                    for (da_int k = 0; k < xtest_subblock; k++) {
+                        const T *Dk = &D[D_index + k * xtrain_block_size];
+                        for (da_int i = 0; i < xtrain_subblock; i++) {
+                            if (Dk[i] <= threshold) {
+                                block_ind[jblock].push_back(first + i);
+                                block_query[jblock].push_back(k);
+                                block_dist[jblock].push_back(Dk[i]);
+                            }
+                        }
+                    }
+                }
+            } catch (std::bad_alloc const &) {  // LCOV_EXCL_LINE
+#pragma omp atomic write
+                threading_error = 1; // LCOV_EXCL_LINE
+            }
+            for (da_int k : block_query[jblock])
+                offsets[first_query + k + 1]++;
+        }
+    }
+    if (threading_error)
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+
+    for (da_int i = 0; i < n_queries; i++)
+        offsets[i + 1] += offsets[i];
+    try {
+        ind.resize(offsets[n_queries]);
+        dist.resize(offsets[n_queries]);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+
+#pragma omp parallel for default(none) schedule(dynamic)                                 \
+    shared(n_blocks_test, xtest_block_size, block_rem_test, block_ind, block_query,      \
+               block_dist, offsets, ind, dist) num_threads(n_threads)
+    for (da_int jblock = 0; jblock < n_blocks_test; jblock++) {
+        da_int first_query = jblock * xtest_block_size;
+        da_int xtest_subblock = xtest_block_size;
+        if (jblock == n_blocks_test - 1 && block_rem_test > 0)
+            xtest_subblock = block_rem_test;
+        // Scatter the neighbors of the block, keeping the training indices increasing
+        std::vector<da_int> &bind = block_ind[jblock], &bquery = block_query[jblock];
+        std::vector<T> &bdist = block_dist[jblock];
+        std::vector<da_int> pos(offsets.begin() + first_query,
+                                offsets.begin() + first_query + xtest_subblock);
+        for (size_t e = 0; e < bind.size(); e++) {
+            da_int p = pos[bquery[e]]++;
+            ind[p] = bind[e];
+            dist[p] = bdist[e];
+        }
+        std::vector<da_int>().swap(bind);
+        std::vector<da_int>().swap(bquery);
+        std::vector<T>().swap(bdist);
+        // Sort the neighbors of each query by increasing distance
+        std::vector<std::pair<T, da_int>> neighbors;
+        for (da_int q = first_query; q < first_query + xtest_subblock; q++) {
+            neighbors.clear();
+            for (da_int p = offsets[q]; p < offsets[q + 1]; p++)
+                neighbors.emplace_back(dist[p], ind[p]);
+            std::sort(neighbors.begin(), neighbors.end());
+            for (da_int p = offsets[q]; p < offsets[q + 1]; p++) {
+                dist[p] = this->get_squares ? std::sqrt(neighbors[p - offsets[q]].first)
+                                            : neighbors[p - offsets[q]].first;
+                ind[p] = neighbors[p - offsets[q]].second;
+            }
+        }
+    }
+
+    return da_status_success;
+}
+
+/*
+ * Predict the labels y_test for the provided test data, from the weighted votes of their
+ * neighbors within the radius option. Queries with no neighbors get the outlier label.
+ */
+template <typename T>
+da_status knn<T>::radius_predict(da_int n_queries, da_int n_features, const T *X_test,
+                                 da_int ldx_test, da_int *y_test) {
+    da_status status = da_status_success;
+    if (!istrained)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No data has been passed to the handle. Please call "
+                               "da_knn_set_training_data_s or "
+                               "da_knn_set_training_data_d.");
+    if (!is_up_to_date)
+        status = knn<T>::set_params();
+    if (status != da_status_success)
+        return status;
+    if (!this->classes_computed)
+        status = knn<T>::available_classes();
+    if (status != da_status_success)
+        return status;
+    if (y_test == nullptr)
+        return da_error_bypass(this->err, da_status_invalid_pointer,
+                               "y_test is not a valid pointer.");
+
+    const T *X_test_temp = nullptr;
+    da_int ldx_test_temp;
+    std::unique_ptr<T[]> X_test_copy;
+    status = store_queries(n_queries, n_features, X_test, ldx_test, X_test_temp,
+                           ldx_test_temp, X_test_copy);
+    if (status != da_status_success)
+        return status;
+
+    std::vector<da_int> offsets, ind;
+    std::vector<T> dist, votes;
+    try {
+        votes.resize(n_classes);
+    } catch (std::bad_alloc const &) {
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation failed.");
+    }
+    status = radius_neighbors_compute(n_queries, X_test_temp, ldx_test_temp, this->radius,
+                                      offsets, ind, dist);
+    if (status != da_status_success)
+        return status;
+
+    for (da_int i = 0; i < n_queries; i++) {
+        da_int n = offsets[i + 1] - offsets[i];
+        if (n == 0) {
+            y_test[i] = outlier_label;
+            continue;
+        }
+        const da_int *nind = &ind[offsets[i]];
+        const T *ndist = &dist[offsets[i]];
+        std::fill(votes.begin(), votes.end(), (T)0);
+        // Neighbors at zero distance take all the weight, as in weighted_target()
+        bool exact = this->weights == da_knn_distance && ndist[0] <= (T)0;
+        for (da_int j = 0; j < n && (!exact || ndist[j] <= (T)0); j++) {
+            da_int c = (da_int)(std::lower_bound(classes.begin(), classes.end(),
+                                                 y_train[nind[j]]) -
+                                classes.begin());
+            votes[c] += (this->weights == da_knn_uniform || exact) ? (T)1
+                                                                   : (T)1 / ndist[j];
+        }
+        // In case of a tie, return the first label
+        y_test[i] = classes[std::max_element(votes.begin(), votes.end()) - votes.begin()];
+    }
+    return da_status_success;
+}
+
+/*
+ * Predict the targets y_test for the provided test data, as the weighted average of the
+ * targets of their neighbors within the radius option. Queries with no neighbors get NaN.
+ */
+template <typename T>
+da_status knn<T>::radius_predict_regression(da_int n_queries, da_int n_features,
+                                            const T *X_test, da_int ldx_test,
+                                            T *y_test) {
+    da_status status = da_status_success;
+    if (!istrained)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No data has been passed to the handle. Please call "
+                               "da_knn_set_regression_data_s or "
+                               "da_knn_set_regression_data_d.");
+    if (y_train_reg == nullptr)
+        return da_error_bypass(this->err, da_status_no_data,
+                               "No targets for regression have been passed to the "
+                               "handle. Please call da_knn_set_regression_data_s or "
+                               "da_knn_set_regression_data_d.");
+    if (!is_up_to_date)
+        status = knn<T>::set_params();
+    if (status != da_status_success)
+        return status;
+    if (y_test == nullptr)
+        return da_error_bypass(this->err, da_status_invalid_pointer,
+                               "y_test is not a valid pointer.");
+
+    const T *X_test_temp = nullptr;
+    da_int ldx_test_temp;
+    std::unique_ptr<T[]> X_test_copy;
+    status = store_queries(n_queries, n_features, X_test, ldx_test, X_test_temp,
+                           ldx_test_temp, X_test_copy);
+    if (status != da_status_success)
+        return status;
+
+    std::vector<da_int> offsets, ind;
+    std::vector<T> dist;
+    status = radius_neighbors_compute(n_queries, X_test_temp, ldx_test_temp, this->radius,
+                                      offsets, ind, dist);
+    if (status != da_status_success)
+        return status;
+
+    for (da_int i = 0; i < n_queries; i++) {
+        da_int n = offsets[i + 1] - offsets[i];
+        y_test[i] = n == 0 ? std::numeric_limits<T>::quiet_NaN()
+                           : weighted_target(n, &ind[offsets[i]], &dist[offsets[i]], 1,
+                                             y_train_reg, this->weights);
+    }
+    return da_status_success;
+}
+
 // Implementing refresh
 template <typename T> void knn<T>::refresh() { is_up_to_date = false; }
 
@@ -28,8 +28,11 @@
 #include "aoclda.h"
 #include "basic_handle.hpp"
 #include "da_error.hpp"
+#include "hnsw.hpp"
 #include "knn_options.hpp"
 #include "macros.h"
+#include <memory>
+#include <vector>
 
 namespace ARCH {
 
@@ -38,6 +41,14 @@ namespace da_knn {
 /* k-nearest neighbors class */
 template <typename T> class knn : public basic_handle<T> {
   private:
+    // Store the training data matrix, shared by set_training_data and set_regression_data
+    da_status store_training_data(da_int n_samples, da_int n_features, const T *X_train,
+                                  da_int ldx_train);
+    // Check the test data and store a column-major version of it in X_test_temp
+    da_status store_queries(da_int n_queries, da_int n_features, const T *X_test,
+                            da_int ldx_test, const T *&X_test_temp, da_int &ldx_test_temp,
+                            std::unique_ptr<T[]> &X_test_copy);
+
     // Set true when initialization is complete by set_params() function
     bool is_up_to_date = false;
     // Set true if training data has been provided via set_training_data()
@@ -60,16 +71,32 @@ template <typename T> class knn : public basic_handle<T> {
     T p = 2.0;
     // Weight function used to compute the k-nearest neighbors
     da_int weights = da_knn_uniform;
+    // Radius of the neighborhoods in radius neighbors queries
+    T radius = 1.0;
+    // Label predicted for the queries with no neighbors within the radius
+    da_int outlier_label = -1;
+    // Parameters of the HNSW graph (algorithm = hnsw)
+    da_int hnsw_m = 16, hnsw_ef_construction = 200, hnsw_ef_search = 50, seed = 0;
+    // HNSW graph of the training data, built on the first query
+    hnsw<T> index;
+    // Set true when index holds the graph of the current training data
+    bool index_built = false;
     // User's data
     da_int n_samples = 0, n_features = 0, ldx_train = 0;
     const T *X_train = nullptr /*n_samples-by-n_features*/;
     const da_int *y_train = nullptr /*n_samples*/;
+    // Targets for regression, set instead of y_train by set_regression_data()
+    const T *y_train_reg = nullptr /*n_samples*/;
     //Utility pointer to column major allocated copy of user's data
     T *X_train_temp = nullptr;
 
   public:
     std::vector<da_int> classes;
     da_int n_classes = -1;
+    // Radius neighbors computed by the last call to radius_neighbors(), in compressed
+    // sparse row format: the neighbors of query i are rn_ind[rn_offsets[i]:rn_offsets[i+1]]
+    std::vector<da_int> rn_offsets, rn_ind;
+    std::vector<T> rn_dist;
 
     ~knn();
 
@@ -84,6 +111,9 @@ template <typename T> class knn : public basic_handle<T> {
     // Set the training data
     da_status set_training_data(da_int n_samples, da_int n_features, const T *X_train,
                                 da_int ldx_train, const da_int *y_train);
+    // Set the training data with real targets for regression
+    da_status set_regression_data(da_int n_samples, da_int n_features, const T *X_train,
+                                  da_int ldx_train, const T *y_train);
     // Compute the k-nearest neighbors and optionally the corresponding distances
     // Includes the appropriate checks for input arguments
     da_status kneighbors(da_int n_queries, da_int n_features, const T *X_test,
@@ -99,18 +129,39 @@ template <typename T> class knn : public basic_handle<T> {
     da_status kneighbors_blocked_Xtest(da_int n_queries, da_int n_features,
                                        const T *X_test, da_int ldx_test, da_int *n_ind,
                                        T *n_dist, da_int n_neigh, bool return_distance);
-    // Compute the k-nearest neighbors and optionally the corresponding distances
-    template <da_int XTRAIN_BLOCK>
+    // Compute the k-nearest neighbors and optionally the corresponding distances, for one
+    // block of queries, keeping only one block of distances to the training data in memory
     da_status kneighbors_kernel(da_int xtrain_block_size, da_int n_blocks_train,
                                 da_int block_rem_train, da_int n_queries,
                                 da_int n_features, const T *X_test, da_int ldx_test, T *D,
                                 da_int *n_ind, T *n_dist, da_int k, bool return_distance);
+    // Compute the approximate k-nearest neighbors with the HNSW graph, building it if needed
+    da_status kneighbors_hnsw(da_int n_queries, const T *X_test, da_int ldx_test,
+                              da_int *n_ind, T *n_dist, da_int n_neigh,
+                              bool return_distance);
     // Compute probability estimates for provided test data
     da_status predict_proba(da_int n_queries, da_int n_features, const T *X_test,
                             da_int ldx_test, T *proba);
     // Predict the labels for provided test data
     da_status predict(da_int n_queries, da_int n_features, const T *X_test,
                       da_int ldx_test, da_int *y_test);
+    // Predict the targets for provided test data, from their k-nearest neighbors
+    da_status predict_regression(da_int n_queries, da_int n_features, const T *X_test,
+                                 da_int ldx_test, T *y_test);
+    // Compute the training points within the given radius of each point of X_test, and
+    // store them in rn_offsets, rn_ind and rn_dist
+    da_status radius_neighbors(da_int n_queries, da_int n_features, const T *X_test,
+                               da_int ldx_test, T radius = 0);
+    // Computational kernel of the radius neighbors, with column-major X_test
+    da_status radius_neighbors_compute(da_int n_queries, const T *X_test, da_int ldx_test,
+                                       T radius, std::vector<da_int> &offsets,
+                                       std::vector<da_int> &ind, std::vector<T> &dist);
+    // Predict the labels for provided test data, from their neighbors within the radius
+    da_status radius_predict(da_int n_queries, da_int n_features, const T *X_test,
+                             da_int ldx_test, da_int *y_test);
+    // Predict the targets for provided test data, from their neighbors within the radius
+    da_status radius_predict_regression(da_int n_queries, da_int n_features,
+                                        const T *X_test, da_int ldx_test, T *y_test);
     // Internal function used to compute the std::vector that holds the available classes
     da_status available_classes();
 
@@ -49,6 +49,40 @@ inline da_status register_knn_options(da_options::OptionRegistry &opts,
             "Number of neighbors considered for k-nearest neighbors.", 1,
             da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf, 5));
         opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "hnsw max connections",
+            "Maximum number of links of each point in the upper layers of the HNSW "
+            "graph, twice as many are kept in the bottom layer.",
+            2, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            16));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "hnsw construction width",
+            "Number of candidate neighbors explored when inserting a point in the HNSW "
+            "graph.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            200));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "hnsw search width",
+            "Number of candidate neighbors explored when querying the HNSW graph; the "
+            "number of requested neighbors is used if it is larger.",
+            1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            50));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "seed",
+            "Seed for random number generation in the construction of the HNSW graph; "
+            "set to -1 for non-deterministic results.",
+            -1, da_options::lbound_t::greaterequal, imax, da_options::ubound_t::p_inf,
+            0));
+        opts.register_opt(oi);
+        oi = std::make_shared<OptionNumeric<da_int>>(OptionNumeric<da_int>(
+            "outlier label",
+            "Label predicted for the queries with no training point within the radius "
+            "in radius neighbors classification.",
+            -imax, da_options::lbound_t::m_inf, imax, da_options::ubound_t::p_inf, -1));
+        opts.register_opt(oi);
         // fp options
         std::shared_ptr<OptionNumeric<T>> ofp;
         ofp = std::make_shared<OptionNumeric<T>>(
@@ -58,11 +92,15 @@ inline da_status register_knn_options(da_options::OptionRegistry &opts,
                              0.0, da_options::lbound_t::greaterthan, fpmax,
                              da_options::ubound_t::p_inf, 2.0));
         opts.register_opt(ofp);
+        ofp = std::make_shared<OptionNumeric<T>>(OptionNumeric<T>(
+            "radius", "Radius of the neighborhoods used in radius neighbors queries.", 0.0,
+            da_options::lbound_t::greaterthan, fpmax, da_options::ubound_t::p_inf, 1.0));
+        opts.register_opt(ofp);
         // String options
         std::shared_ptr<OptionString> os;
         os = std::make_shared<OptionString>(OptionString(
             "algorithm", "Algorithm used to compute the k-nearest neighbors.",
-            {{"brute", da_brute_force}}, "brute"));
+            {{"brute", da_brute_force}, {"hnsw", da_hnsw}}, "brute"));
         opts.register_opt(os);
         os = std::make_shared<OptionString>(
             OptionString("metric", "Metric used to compute the pairwise distance matrix.",
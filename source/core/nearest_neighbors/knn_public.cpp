@@ -28,6 +28,7 @@
 #include "knn_public.hpp"
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_store_data.hpp"
 #include "dynamic_dispatch.hpp"
 
 using namespace knn_public;
@@ -62,6 +63,106 @@ da_status da_knn_set_training_data_s(da_handle handle, da_int n_samples,
                    handle, n_samples, n_features, X_train, ldx_train, y_train)));
 }
 
+da_status da_knn_set_training_data_from_store_d(da_handle handle, da_datastore store,
+                                                const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double, da_int>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx,
+                 const da_int *y) {
+            return da_knn_set_training_data_d(handle, n_samples, n_features, X, ldx, y);
+        });
+}
+
+da_status da_knn_set_training_data_from_store_s(da_handle handle, da_datastore store,
+                                                const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float, da_int>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx,
+                 const da_int *y) {
+            return da_knn_set_training_data_s(handle, n_samples, n_features, X, ldx, y);
+        });
+}
+
+da_status da_knn_set_regression_data_d(da_handle handle, da_int n_samples,
+                                       da_int n_features, const double *X_train,
+                                       da_int ldx_train, const double *y_train) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (knn_set_regression_data<da_knn::knn<double>, double>(
+                   handle, n_samples, n_features, X_train, ldx_train, y_train)));
+}
+
+da_status da_knn_set_regression_data_s(da_handle handle, da_int n_samples,
+                                       da_int n_features, const float *X_train,
+                                       da_int ldx_train, const float *y_train) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (knn_set_regression_data<da_knn::knn<float>, float>(
+                   handle, n_samples, n_features, X_train, ldx_train, y_train)));
+}
+
+da_status da_knn_set_regression_data_from_store_d(da_handle handle, da_datastore store,
+                                                  const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double, double>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx,
+                 const double *y) {
+            return da_knn_set_regression_data_d(handle, n_samples, n_features, X, ldx,
+                                                 y);
+        });
+}
+
+da_status da_knn_set_regression_data_from_store_s(da_handle handle, da_datastore store,
+                                                  const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float, float>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx,
+                 const float *y) {
+            return da_knn_set_regression_data_s(handle, n_samples, n_features, X, ldx,
+                                                 y);
+        });
+}
+
 da_status da_knn_kneighbors_d(da_handle handle, da_int n_queries, da_int n_features,
                               const double *X_test, da_int ldx_test, da_int *n_ind,
                               double *n_dist, da_int k, da_int return_distance) {
@@ -169,3 +270,120 @@ da_status da_knn_predict_s(da_handle handle, da_int n_queries, da_int n_features
                return (knn_predict<da_knn::knn<float>, float>(
                    handle, n_queries, n_features, X_test, ldx_test, y_test)));
 }
+
+da_status da_knn_predict_regression_d(da_handle handle, da_int n_queries,
+                                      da_int n_features, const double *X_test,
+                                      da_int ldx_test, double *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (knn_predict_regression<da_knn::knn<double>, double>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
+
+da_status da_knn_predict_regression_s(da_handle handle, da_int n_queries,
+                                      da_int n_features, const float *X_test,
+                                      da_int ldx_test, float *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (knn_predict_regression<da_knn::knn<float>, float>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
+
+da_status da_knn_radius_neighbors_d(da_handle handle, da_int n_queries, da_int n_features,
+                                    const double *X_test, da_int ldx_test,
+                                    double radius) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (knn_radius_neighbors<da_knn::knn<double>, double>(
+                   handle, n_queries, n_features, X_test, ldx_test, radius)));
+}
+
+da_status da_knn_radius_neighbors_s(da_handle handle, da_int n_queries, da_int n_features,
+                                    const float *X_test, da_int ldx_test, float radius) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (knn_radius_neighbors<da_knn::knn<float>, float>(
+                   handle, n_queries, n_features, X_test, ldx_test, radius)));
+}
+
+da_status da_knn_radius_predict_d(da_handle handle, da_int n_queries, da_int n_features,
+                                  const double *X_test, da_int ldx_test, da_int *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (knn_radius_predict<da_knn::knn<double>, double>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
+
+da_status da_knn_radius_predict_s(da_handle handle, da_int n_queries, da_int n_features,
+                                  const float *X_test, da_int ldx_test, da_int *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (knn_radius_predict<da_knn::knn<float>, float>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
+
+da_status da_knn_radius_predict_regression_d(da_handle handle, da_int n_queries,
+                                             da_int n_features, const double *X_test,
+                                             da_int ldx_test, double *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    DISPATCHER(handle->err,
+               return (knn_radius_predict_regression<da_knn::knn<double>, double>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
+
+da_status da_knn_radius_predict_regression_s(da_handle handle, da_int n_queries,
+                                             da_int n_features, const float *X_test,
+                                             da_int ldx_test, float *y_test) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // Clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    DISPATCHER(handle->err,
+               return (knn_radius_predict_regression<da_knn::knn<float>, float>(
+                   handle, n_queries, n_features, X_test, ldx_test, y_test)));
+}
@@ -100,4 +100,66 @@ da_status knn_predict(da_handle handle, da_int n_queries, da_int n_features,
     return knn->predict(n_queries, n_features, X_test, ldx_test, y_test);
 }
 
+template <typename knn_class, typename T>
+da_status knn_set_regression_data(da_handle handle, da_int n_samples, da_int n_features,
+                                  const T *X_train, da_int ldx_train, const T *y_train) {
+    knn_class *knn = dynamic_cast<knn_class *>(handle->get_alg_handle<T>());
+    if (knn == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_knn or "
+                        "handle is invalid.");
+
+    return knn->set_regression_data(n_samples, n_features, X_train, ldx_train, y_train);
+}
+
+template <typename knn_class, typename T>
+da_status knn_predict_regression(da_handle handle, da_int n_queries, da_int n_features,
+                                 const T *X_test, da_int ldx_test, T *y_test) {
+    knn_class *knn = dynamic_cast<knn_class *>(handle->get_alg_handle<T>());
+    if (knn == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_knn or "
+                        "handle is invalid.");
+
+    return knn->predict_regression(n_queries, n_features, X_test, ldx_test, y_test);
+}
+
+template <typename knn_class, typename T>
+da_status knn_radius_neighbors(da_handle handle, da_int n_queries, da_int n_features,
+                               const T *X_test, da_int ldx_test, T radius) {
+    knn_class *knn = dynamic_cast<knn_class *>(handle->get_alg_handle<T>());
+    if (knn == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_knn or "
+                        "handle is invalid.");
+
+    return knn->radius_neighbors(n_queries, n_features, X_test, ldx_test, radius);
+}
+
+template <typename knn_class, typename T>
+da_status knn_radius_predict(da_handle handle, da_int n_queries, da_int n_features,
+                             const T *X_test, da_int ldx_test, da_int *y_test) {
+    knn_class *knn = dynamic_cast<knn_class *>(handle->get_alg_handle<T>());
+    if (knn == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_knn or "
+                        "handle is invalid.");
+
+    return knn->radius_predict(n_queries, n_features, X_test, ldx_test, y_test);
+}
+
+template <typename knn_class, typename T>
+da_status knn_radius_predict_regression(da_handle handle, da_int n_queries,
+                                        da_int n_features, const T *X_test,
+                                        da_int ldx_test, T *y_test) {
+    knn_class *knn = dynamic_cast<knn_class *>(handle->get_alg_handle<T>());
+    if (knn == nullptr)
+        return da_error(handle->err, da_status_invalid_handle_type,
+                        "handle was not initialized with handle_type=da_handle_knn or "
+                        "handle is invalid.");
+
+    return knn->radius_predict_regression(n_queries, n_features, X_test, ldx_test,
+                                          y_test);
+}
+
 } // namespace knn_public
\ No newline at end of file
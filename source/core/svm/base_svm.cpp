@@ -119,6 +119,7 @@ template <typename T> da_status base_svm<T>::compute() {
     // Define them in this scope since they are large matrices and do not need to be in the class scope
     std::vector<T> kernel_matrix, local_kernel_matrix;
     std::vector<T> X_temp; // Contain relevant slices of X for kernel computation
+    err->clear();
 
     if (mod == da_svm_model::svr || mod == da_svm_model::nusvr)
         actual_size = n * 2;
@@ -167,6 +168,15 @@ template <typename T> da_status base_svm<T>::compute() {
         y = (T *)yusr;
         ldx_2 = ldx;
     }
+    w.clear();
+    if (use_dual_cd) {
+        status = dual_coordinate_descent();
+        if (ismulticlass) {
+            delete[] X;
+            delete[] y;
+        }
+        return status;
+    }
     compute_ws_size(ws_size);
     try {
         // Outer WSS
@@ -276,6 +286,12 @@ da_status base_svm<T>::decision_function(da_int nsamples, da_int nfeat, const T
     // Initialise decision values to constant (bias)
     for (da_int i = 0; i < nsamples; i++)
         decision_values[i] = bias;
+    // Linear kernel solved in the primal weights: decision_values = X_test * w + bias
+    if (!w.empty()) {
+        da_blas::cblas_gemv(CblasColMajor, CblasNoTrans, nsamples, nfeat, (T)1.0, X_test,
+                            ldx_test, w.data(), 1, (T)1.0, decision_values, 1);
+        return status;
+    }
     // Stop early if there are no support vectors
     if (n_support == 0)
         return status;
@@ -456,6 +472,11 @@ void base_svm<T>::wssj(std::vector<bool> &I_low, std::vector<T> &gradient, da_in
     j = max_grad_idx;
 };
 
+template <typename T> da_status base_svm<T>::dual_coordinate_descent() {
+    return da_error(err, da_status_internal_error, // LCOV_EXCL_LINE
+                    "Dual coordinate descent is only available for SVC and SVR.");
+}
+
 template class base_svm<float>;
 template class base_svm<double>;
 
@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Deal with some Windows compilation issues regarding max/min macros
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "macros.h"
+#include "svm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+/*
+ * Dual coordinate descent solvers for SVC and SVR with the linear kernel, following
+ * LIBLINEAR (Hsieh et al., "A dual coordinate descent method for large-scale linear SVM",
+ * ICML 2008, and Ho and Lin, "Large-scale linear support vector regression", JMLR 2012).
+ *
+ * With the linear kernel, the gradient of the dual objective with respect to alpha_i only
+ * depends on the primal weights w = sum_j alpha_j y_j x_j. The solvers update one dual
+ * variable at a time and keep w up to date, so that each update costs O(n_features) and
+ * each pass over the data O(n_samples * n_features), instead of the kernel blocks of SMO.
+ * Variables that stay at their bounds are shrunk from the active set, which is restored
+ * once the remaining ones have converged.
+ *
+ * The intercept is handled as in LIBLINEAR, as the weight of an additional constant
+ * feature equal to 1. It is therefore regularized, and the problem solved differs
+ * slightly from the one of SMO, where the intercept is free.
+ */
+
+namespace ARCH {
+
+namespace da_svm {
+
+using namespace da_svm_types;
+
+// Dot product and axpy on contiguous rows, short enough that calling BLAS for each update
+// would dominate the cost of the solvers
+template <typename T> static inline T row_dot(da_int p, const T *x, const T *w) {
+    T sum = 0;
+#pragma omp simd reduction(+ : sum)
+    for (da_int k = 0; k < p; k++)
+        sum += x[k] * w[k];
+    return sum;
+}
+
+template <typename T> static inline void row_axpy(da_int p, T a, const T *x, T *w) {
+#pragma omp simd
+    for (da_int k = 0; k < p; k++)
+        w[k] += a * x[k];
+}
+
+/* Copy the samples into contiguous rows, compute the diagonal of the kernel matrix of the
+ * augmented data and initialise the primal weights and the active set
+ */
+template <typename T>
+da_status base_svm<T>::dual_cd_init(std::vector<T> &X_rows, std::vector<T> &QD,
+                                    std::vector<da_int> &index) {
+    try {
+        X_rows.resize(n * p);
+        QD.resize(n);
+        index.resize(n);
+        // The last weight is the intercept
+        w.assign(p + 1, T(0));
+        n_support_per_class.assign(2, 0);
+    } catch (std::bad_alloc &) {                     // LCOV_EXCL_LINE
+        return da_error(err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n; i++)
+            X_rows[i * p + j] = X[i + j * ldx_2];
+    for (da_int i = 0; i < n; i++)
+        QD[i] = row_dot(p, &X_rows[i * p], &X_rows[i * p]) + T(1);
+    std::iota(index.begin(), index.end(), 0);
+    return da_status_success;
+}
+
+/* Random permutation of the active set, reproducible across platforms */
+static inline void shuffle_active_set(std::vector<da_int> &index, da_int active_size,
+                                      std::mt19937 &gen) {
+    for (da_int s = 0; s < active_size; s++)
+        std::swap(index[s], index[s + (da_int)(gen() % (active_size - s))]);
+}
+
+/* Dual of the hinge loss SVC:
+ *   min 1/2 alpha' Q alpha - sum(alpha), 0 <= alpha_i <= C, Q_ij = y_i y_j (x_i'x_j + 1)
+ * The active set stops shrinking when the range of the projected gradient is below tol.
+ */
+template <typename T> da_status svc<T>::dual_coordinate_descent() {
+    std::vector<T> X_rows, QD;
+    std::vector<da_int> index;
+    da_int n = this->n, p = this->p;
+    try {
+        this->alpha.assign(n, T(0));
+        this->response.resize(n);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    da_status status = this->dual_cd_init(X_rows, QD, index);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    for (da_int i = 0; i < n; i++)
+        this->response[i] = this->y[i] == 0 ? T(-1) : T(1);
+
+    T *alpha = this->alpha.data(), *w = this->w.data();
+    const T *response = this->response.data();
+    T C = this->C;
+    T inf = std::numeric_limits<T>::infinity();
+    T PG_max_old = inf, PG_min_old = -inf;
+    da_int active_size = n;
+    std::mt19937 gen(0);
+
+    this->iter = 0;
+    while (this->iter < this->max_iter) {
+        T PG_max_new = -inf, PG_min_new = inf;
+        shuffle_active_set(index, active_size, gen);
+        for (da_int s = 0; s < active_size; s++) {
+            da_int i = index[s];
+            const T *xi = &X_rows[i * p];
+            T G = response[i] * (row_dot(p, xi, w) + w[p]) - T(1);
+            // Projected gradient, shrinking the variables at a bound whose gradient
+            // points outside of the feasible region by more than the last violation
+            T PG = 0;
+            if (alpha[i] == 0) {
+                if (G > PG_max_old) {
+                    std::swap(index[s--], index[--active_size]);
+                    continue;
+                }
+                PG = std::min(G, T(0));
+            } else if (alpha[i] == C) {
+                if (G < PG_min_old) {
+                    std::swap(index[s--], index[--active_size]);
+                    continue;
+                }
+                PG = std::max(G, T(0));
+            } else {
+                PG = G;
+            }
+            PG_max_new = std::max(PG_max_new, PG);
+            PG_min_new = std::min(PG_min_new, PG);
+            if (std::abs(PG) > T(1.0e-12)) {
+                T alpha_old = alpha[i];
+                alpha[i] = std::min(std::max(alpha[i] - G / QD[i], T(0)), C);
+                T d = (alpha[i] - alpha_old) * response[i];
+                row_axpy(p, d, xi, w);
+                w[p] += d;
+            }
+        }
+        this->iter++;
+        if (PG_max_new - PG_min_new <= this->tol) {
+            // Converged on the active set, check the shrunk variables with a full pass
+            if (active_size == n)
+                break;
+            active_size = n;
+            PG_max_old = inf;
+            PG_min_old = -inf;
+            continue;
+        }
+        PG_max_old = PG_max_new <= 0 ? inf : PG_max_new;
+        PG_min_old = PG_min_new >= 0 ? -inf : PG_min_new;
+    }
+
+    this->bias = w[p];
+    this->w.resize(p);
+    return this->set_sv(this->alpha, this->n_support);
+}
+
+/* Dual of the epsilon-insensitive loss SVR, in beta = alpha^+ - alpha^-:
+ *   min 1/2 beta' Q beta - y' beta + eps |beta|_1, -C <= beta_i <= C,
+ * with Q_ij = x_i'x_j + 1. Each update is the exact minimiser of the one dimensional
+ * problem. The solver stops when the sum of the violations falls below tol times its
+ * value on the first pass.
+ */
+template <typename T> da_status svr<T>::dual_coordinate_descent() {
+    std::vector<T> X_rows, QD, beta;
+    std::vector<da_int> index;
+    da_int n = this->n, p = this->p;
+    try {
+        beta.assign(n, T(0));
+        this->alpha.resize(2 * n);
+        this->response.resize(2 * n);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    da_status status = this->dual_cd_init(X_rows, QD, index);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+
+    T *w = this->w.data();
+    const T *y = this->y;
+    T C = this->C, eps = this->eps;
+    T inf = std::numeric_limits<T>::infinity();
+    T G_max_old = inf, G_norm1_init = -1;
+    da_int active_size = n;
+    std::mt19937 gen(0);
+
+    this->iter = 0;
+    while (this->iter < this->max_iter) {
+        T G_max_new = 0, G_norm1_new = 0;
+        shuffle_active_set(index, active_size, gen);
+        for (da_int s = 0; s < active_size; s++) {
+            da_int i = index[s];
+            const T *xi = &X_rows[i * p];
+            T G = row_dot(p, xi, w) + w[p] - y[i];
+            // Derivatives on the positive and negative sides of beta_i
+            T Gp = G + eps, Gn = G - eps;
+            T H = QD[i];
+            T violation = 0;
+            if (beta[i] == 0) {
+                if (Gp < 0)
+                    violation = -Gp;
+                else if (Gn > 0)
+                    violation = Gn;
+                else if (Gp > G_max_old && Gn < -G_max_old) {
+                    std::swap(index[s--], index[--active_size]);
+                    continue;
+                }
+            } else if (beta[i] >= C) {
+                if (Gp > 0)
+                    violation = Gp;
+                else if (Gp < -G_max_old) {
+                    std::swap(index[s--], index[--active_size]);
+                    continue;
+                }
+            } else if (beta[i] <= -C) {
+                if (Gn < 0)
+                    violation = -Gn;
+                else if (Gn > G_max_old) {
+                    std::swap(index[s--], index[--active_size]);
+                    continue;
+                }
+            } else if (beta[i] > 0) {
+                violation = std::abs(Gp);
+            } else {
+                violation = std::abs(Gn);
+            }
+            G_max_new = std::max(G_max_new, violation);
+            G_norm1_new += violation;
+
+            // Newton direction of the piecewise quadratic in beta_i
+            T d;
+            if (Gp < H * beta[i])
+                d = -Gp / H;
+            else if (Gn > H * beta[i])
+                d = -Gn / H;
+            else
+                d = -beta[i];
+            if (std::abs(d) < T(1.0e-12))
+                continue;
+            T beta_old = beta[i];
+            beta[i] = std::min(std::max(beta[i] + d, -C), C);
+            d = beta[i] - beta_old;
+            if (d != 0) {
+                row_axpy(p, d, xi, w);
+                w[p] += d;
+            }
+        }
+        if (this->iter == 0)
+            G_norm1_init = G_norm1_new;
+        this->iter++;
+        if (G_norm1_new <= this->tol * G_norm1_init) {
+            if (active_size == n)
+                break;
+            active_size = n;
+            G_max_old = inf;
+            continue;
+        }
+        G_max_old = G_max_new;
+    }
+
+    // Split beta into the two halves of alpha expected by set_sv()
+    for (da_int i = 0; i < n; i++) {
+        this->alpha[i] = std::max(beta[i], T(0));
+        this->alpha[i + n] = std::max(-beta[i], T(0));
+        this->response[i] = 1;
+        this->response[i + n] = -1;
+    }
+    this->bias = w[p];
+    this->w.resize(p);
+    return this->set_sv(this->alpha, this->n_support);
+}
+
+template da_status base_svm<float>::dual_cd_init(std::vector<float> &X_rows,
+                                                 std::vector<float> &QD,
+                                                 std::vector<da_int> &index);
+template da_status base_svm<double>::dual_cd_init(std::vector<double> &X_rows,
+                                                  std::vector<double> &QD,
+                                                  std::vector<da_int> &index);
+template da_status svc<float>::dual_coordinate_descent();
+template da_status svc<double>::dual_coordinate_descent();
+template da_status svr<float>::dual_coordinate_descent();
+template da_status svr<double>::dual_coordinate_descent();
+
+} // namespace da_svm
+
+} // namespace ARCH
@@ -28,8 +28,11 @@
 #include "svm.hpp"
 #include "aoclda.h"
 #include "basic_statistics.hpp"
+#include "da_cblas.hh"
 #include "da_error.hpp"
+#include "da_omp.hpp"
 #include "da_std.hpp"
+#include "da_utils.hpp"
 #include "macros.h"
 #include "options.hpp"
 #include "svm_options.hpp"
@@ -420,7 +423,18 @@ template <typename T> da_status svm<T>::compute() {
     this->opts.get("max_iter", max_iter);
     this->opts.get("tau", tau);
 
-    // Compute each created classifier in the order 0v1, 0v2, ..., 0v(k-1), 1v2, 1v3, ... etc.
+    // Dual coordinate descent only applies to the C problems with the linear kernel
+    std::string solver_string;
+    da_int solver_enum;
+    this->opts.get("solver", solver_string, solver_enum);
+    bool dual_cd_applies = kernel_enum == linear &&
+                           (mod == da_svm_model::svc || mod == da_svm_model::svr);
+    if (solver_enum == solver_dual_cd && !dual_cd_applies)
+        return da_error(this->err, da_status_incompatible_options,
+                        "The dual coordinate descent solver can only be used for SVC and "
+                        "SVR with the linear kernel.");
+    bool use_dual_cd = dual_cd_applies && solver_enum != solver_smo;
+
     for (da_int i = 0; i < n_classifiers; i++) {
         classifiers[i]->C = C;
         classifiers[i]->eps = epsilon;
@@ -432,11 +446,47 @@ template <typename T> da_status svm<T>::compute() {
         classifiers[i]->tau = tau;
         classifiers[i]->gamma = gamma_temp;
         classifiers[i]->kernel_function = kernel_enum;
+        classifiers[i]->use_dual_cd = use_dual_cd;
+    }
 
-        status = classifiers[i]->compute();
+    // The one-vs-one sub-problems are independent and are solved concurrently. They are
+    // dispatched from the largest to the smallest: the cost of the solvers grows faster
+    // than linearly with the number of samples, so the cheapest sub-problems come last
+    // and fill the gaps left by the expensive ones. When there are fewer sub-problems
+    // than threads, the remaining threads are shared between the BLAS calls and kernel
+    // evaluations of each sub-problem, if nested parallelism is enabled.
+    std::vector<da_int> schedule;
+    std::vector<da_status> statuses;
+    try {
+        schedule.resize(n_classifiers);
+        statuses.resize(n_classifiers, da_status_success);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    std::iota(schedule.begin(), schedule.end(), 0);
+    std::stable_sort(schedule.begin(), schedule.end(), [this](da_int a, da_int b) {
+        return classifiers[a]->n > classifiers[b]->n;
+    });
+    da_int n_threads = da_utils::get_n_threads_loop(n_classifiers);
+    da_int n_threads_inner = 1;
+    if (omp_get_max_active_levels() > omp_get_level() + 1)
+        n_threads_inner = std::max((da_int)omp_get_max_threads() / n_threads, (da_int)1);
+#pragma omp parallel for if (n_threads > 1) num_threads(n_threads) schedule(dynamic, 1) \
+    default(none) shared(schedule, statuses, n_threads, n_threads_inner)
+    for (da_int l = 0; l < n_classifiers; l++) {
+        if (n_threads > 1)
+            omp_set_num_threads((int)n_threads_inner);
+        da_int i = schedule[l];
+        statuses[i] = classifiers[i]->compute();
+    }
 
-        if (status != da_status_success)
-            return status; // Error message already loaded
+    // Gather the results in the order 0v1, 0v2, ..., 0v(k-1), 1v2, 1v3, ... etc.
+    status = da_status_success;
+    for (da_int i = 0; i < n_classifiers; i++) {
+        if (statuses[i] != da_status_success)
+            return da_error_trace(this->err, statuses[i],
+                                  classifiers[i]->err->get_mesg());
 
         bias[i] = classifiers[i]->bias;
         n_iteration[i] = classifiers[i]->iter;
@@ -539,6 +589,102 @@ template <typename T> da_status svm<T>::compute() {
     return status;
 }
 
+/* Decision values of the one-vs-one classifiers, stored column by column in the nsamples
+ * by n_classifiers matrix decision_values_ovo.
+ * Each support vector of a multiclass problem takes part in the n_class - 1 classifiers
+ * of its class, so the kernel between the support vectors and the test data is evaluated
+ * once and shared by all of them. With the LIBSVM layout of the coefficients, classifier
+ * i v j uses row j - 1 of the coefficients of the support vectors of class i and row i of
+ * those of class j. The contributions of the support vectors of class c to all of its
+ * classifiers are therefore accumulated by a single gemm per block of support vectors.
+ */
+template <typename T>
+da_status svm<T>::ovo_decision_function(da_int nsamples, da_int nfeat, const T *X_test,
+                                        da_int ldx_test,
+                                        std::vector<T> &decision_values_ovo) {
+    da_status status = da_status_success;
+    try {
+        decision_values_ovo.resize(nsamples * n_classifiers);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    // Binary problems, and linear classifiers which are applied through their primal
+    // weights, do not need the kernel
+    if (!ismulticlass || !classifiers[0]->w.empty() || n_sv == 0) {
+        for (da_int i = 0; i < n_classifiers; i++) {
+            status = classifiers[i]->decision_function(nsamples, nfeat, X_test, ldx_test,
+                                                       decision_values_ovo.data() +
+                                                           i * nsamples);
+            if (status != da_status_success)
+                return status;
+        }
+        return status;
+    }
+
+    // partial holds, for each class c, the (n_class - 1) by nsamples contributions of the
+    // support vectors of class c to the classifiers it takes part in
+    da_int n_coef = n_class - 1;
+    da_int block_size = std::min(n_sv, SVM_MAX_BLOCK_SIZE);
+    std::vector<T> partial, x_aux, y_aux, kernel_matrix, block_support_vectors;
+    std::vector<da_int> class_start;
+    try {
+        partial.resize(n_class * n_coef * nsamples, (T)0);
+        x_aux.resize(block_size);
+        y_aux.resize(nsamples);
+        kernel_matrix.resize(block_size * nsamples);
+        block_support_vectors.resize(block_size * nfeat);
+        class_start.resize(n_class + 1, 0);
+    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
+        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    // The support vectors are sorted by class, those of class c are in positions
+    // class_start[c] to class_start[c + 1] - 1
+    std::partial_sum(n_sv_per_class.begin(), n_sv_per_class.end(),
+                     class_start.begin() + 1);
+
+    const base_svm<T> &clf = *classifiers[0];
+    for (da_int offset = 0; offset < n_sv; offset += block_size) {
+        da_int current_block_size = std::min(block_size, n_sv - offset);
+        for (da_int j = 0; j < current_block_size; j++) {
+            da_int current_idx = support_indexes[offset + j];
+            for (da_int k = 0; k < nfeat; k++)
+                block_support_vectors[j + k * current_block_size] =
+                    X[current_idx + k * ldx_train];
+        }
+        clf.kernel_f(column_major, current_block_size, nsamples, nfeat,
+                     block_support_vectors.data(), x_aux.data(), current_block_size,
+                     X_test, y_aux.data(), ldx_test, kernel_matrix.data(),
+                     current_block_size, clf.gamma, clf.degree, clf.coef0, false);
+        for (da_int c = 0; c < n_class; c++) {
+            da_int first = std::max(offset, class_start[c]);
+            da_int last = std::min(offset + current_block_size, class_start[c + 1]);
+            if (first >= last)
+                continue;
+            da_blas::cblas_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n_coef,
+                                nsamples, last - first, (T)1.0,
+                                support_coefficients.data() + first * n_coef, n_coef,
+                                kernel_matrix.data() + (first - offset),
+                                current_block_size, (T)1.0,
+                                partial.data() + c * n_coef * nsamples, n_coef);
+        }
+    }
+
+    da_int k = 0;
+    for (da_int i = 0; i < n_class; i++) {
+        for (da_int j = i + 1; j < n_class; j++) {
+            const T *partial_i = partial.data() + i * n_coef * nsamples + (j - 1);
+            const T *partial_j = partial.data() + j * n_coef * nsamples + i;
+            T *dv = decision_values_ovo.data() + k * nsamples;
+            for (da_int l = 0; l < nsamples; l++)
+                dv[l] = partial_i[l * n_coef] + partial_j[l * n_coef] + bias[k];
+            k++;
+        }
+    }
+    return status;
+}
+
 /* Predict SVM */
 template <typename T>
 da_status svm<T>::predict(da_int nsamples, da_int nfeat, const T *X_test, da_int ldx_test,
@@ -571,28 +717,22 @@ da_status svm<T>::predict(da_int nsamples, da_int nfeat, const T *X_test, da_int
 
     if (ismulticlass) {
         std::vector<da_int> votes_array;
+        std::vector<T> decision_values_ovo;
         try {
             votes_array.resize(n_class * nsamples);
         } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
             return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
                             "Memory allocation error");
         }
+        status = ovo_decision_function(nsamples, nfeat, X_test_temp, ldx_test_temp,
+                                       decision_values_ovo);
+        if (status != da_status_success)
+            return status;
         for (da_int i = 0; i < n_classifiers; i++) {
-            std::vector<T> votes_temp; // this can technically be int
-            try {
-                votes_temp.resize(nsamples);
-            } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
-                return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
-                                "Memory allocation error");
-            }
-            status = classifiers[i]->predict(nsamples, nfeat, X_test_temp, ldx_test_temp,
-                                             votes_temp.data());
-            if (status != da_status_success)
-                return status;
             da_int pos_class = classifiers[i]->pos_class,
                    neg_class = classifiers[i]->neg_class;
             for (da_int j = 0; j < nsamples; j++) {
-                if (votes_temp[j] == 1)
+                if (decision_values_ovo[i * nsamples + j] > 0)
                     votes_array[j * n_class + pos_class]++;
                 else
                     votes_array[j * n_class + neg_class]++;
@@ -662,21 +802,12 @@ da_status svm<T>::decision_function(da_int nsamples, da_int nfeat, const T *X_te
     if (status != da_status_success)
         return status;
 
-    std::vector<T> decision_values_ovo;
-    try {
-        decision_values_ovo.resize(nsamples * n_classifiers);
-    } catch (std::bad_alloc &) {                           // LCOV_EXCL_LINE
-        return da_error(this->err, da_status_memory_error, // LCOV_EXCL_LINE
-                        "Memory allocation error");
-    }
     // Obtain OVO decision function values
-    for (da_int i = 0; i < n_classifiers; i++) {
-        status =
-            classifiers[i]->decision_function(nsamples, nfeat, X_test_temp, ldx_test_temp,
-                                              decision_values_ovo.data() + i * nsamples);
-        if (status != da_status_success)
-            return status;
-    }
+    std::vector<T> decision_values_ovo;
+    status = ovo_decision_function(nsamples, nfeat, X_test_temp, ldx_test_temp,
+                                   decision_values_ovo);
+    if (status != da_status_success)
+        return status;
 
     // Path where decision values are 1D - binary classification (have to be OVO)
     if (!ismulticlass) {
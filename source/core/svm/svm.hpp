@@ -151,8 +151,11 @@ template <typename T> class base_svm {
     // Variable is being set at the contructors of spiecialised classes
     da_svm_model mod = svm_undefined;
 
+    // Error trace of this sub-problem, kept separate from the one of the handle since the
+    // sub-problems are solved concurrently (see svm::compute())
+    da_errors::da_error_t sub_err{da_errors::action_t::DA_RECORD};
     // Pointer to error trace
-    da_errors::da_error_t *err = nullptr;
+    da_errors::da_error_t *err = &sub_err;
 
     // Variables for result handling
     std::vector<T> gradient, alpha, response;
@@ -174,6 +177,12 @@ template <typename T> class base_svm {
     std::vector<da_int> ws_indexes, index_aux;
     std::vector<bool> ws_indicator;
 
+    // Linear kernel solved by dual coordinate descent (set in svm.cpp compute())
+    bool use_dual_cd = false;
+    // Primal weights, only filled by the dual coordinate descent solver and then used in
+    // decision_function() instead of the support vectors
+    std::vector<T> w;
+
   public:
     // This friend is here to allow following "svm" class to set protected members of "base_svm" class, such as kernel_function, X or y.
     friend class svm<T>;
@@ -198,6 +207,11 @@ template <typename T> class base_svm {
     void wssj(std::vector<bool> &I_low, std::vector<T> &gradient, da_int &i, T &min_grad,
               da_int &j, T &max_grad, std::vector<T> &kernel_matrix, T &delta,
               T &max_fun);
+    da_status dual_cd_init(std::vector<T> &X_rows, std::vector<T> &QD,
+                           std::vector<da_int> &index);
+
+    // Dual coordinate descent for the linear kernel, only specialised for SVC and SVR
+    virtual da_status dual_coordinate_descent();
 
     // Functions that need specialisation
     virtual da_status initialisation(da_int &size, std::vector<T> &gradient,
@@ -251,6 +265,10 @@ template <typename T> class svm : public basic_handle<T> {
     std::vector<T> support_coefficients, support_vectors, bias;
     std::vector<da_int> support_indexes, n_sv_per_class, n_iteration;
 
+    // Decision values of all the one-vs-one classifiers (nsamples by n_classifiers)
+    da_status ovo_decision_function(da_int nsamples, da_int nfeat, const T *X_test,
+                                    da_int ldx_test, std::vector<T> &decision_values_ovo);
+
   public:
     svm(da_errors::da_error_t &err);
     ~svm();
@@ -309,6 +327,7 @@ template <typename T> class svc : public csvm<T> {
     da_status initialisation(da_int &size, std::vector<T> &gradient,
                              std::vector<T> &response, std::vector<T> &alpha);
     da_status set_sv(std::vector<T> &alpha, da_int &n_support);
+    da_status dual_coordinate_descent();
 };
 
 template <typename T> class svr : public csvm<T> {
@@ -320,6 +339,7 @@ template <typename T> class svr : public csvm<T> {
     da_status initialisation(da_int &size, std::vector<T> &gradient,
                              std::vector<T> &response, std::vector<T> &alpha);
     da_status set_sv(std::vector<T> &alpha, da_int &n_support);
+    da_status dual_coordinate_descent();
 };
 
 template <typename T> class nusvm : public base_svm<T> {
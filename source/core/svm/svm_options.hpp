@@ -133,6 +133,18 @@ inline da_status register_svm_options(da_options::OptionRegistry &opts,
                          "rbf"));
         opts.register_opt(os);
 
+        os = std::make_shared<OptionString>(OptionString(
+            "solver",
+            "Algorithm used to solve the dual problem: SMO, or dual coordinate descent "
+            "on the primal weights for SVC and SVR with the linear kernel. 'auto' "
+            "selects dual coordinate descent whenever it applies.",
+            {{"auto", svm_solver::solver_auto},
+             {"smo", svm_solver::solver_smo},
+             {"dual coordinate descent", svm_solver::solver_dual_cd},
+             {"dcd", svm_solver::solver_dual_cd}},
+            "auto"));
+        opts.register_opt(os);
+
     } catch (std::bad_alloc &) {
         return da_error(&err, da_status_memory_error, // LCOV_EXCL_LINE
                         "Memory allocation failed.");
@@ -24,6 +24,7 @@
 #include "svm_public.hpp"
 #include "aoclda.h"
 #include "da_handle.hpp"
+#include "da_store_data.hpp"
 #include "dynamic_dispatch.hpp"
 #include "macros.h"
 
@@ -79,6 +80,40 @@ da_status da_svm_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
                                 handle, n_samples, n_features, X, ldx_train, y)));
 }
 
+da_status da_svm_set_data_from_store_d(da_handle handle, da_datastore store,
+                                       const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+    if (handle->precision != da_double)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than double.");
+    return da_data::set_data_from_store<double, double>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const double *X, da_int ldx,
+                 const double *y) {
+            return da_svm_set_data_d(handle, n_samples, n_features, X, ldx, y);
+        });
+}
+
+da_status da_svm_set_data_from_store_s(da_handle handle, da_datastore store,
+                                       const char *key_X, const char *key_y) {
+    if (!handle)
+        return da_status_handle_not_initialized;
+    handle->clear(); // clean up handle logs
+    if (handle->precision != da_single)
+        return da_error(
+            handle->err, da_status_wrong_type,
+            "The handle was initialized with a different precision type than single.");
+    return da_data::set_data_from_store<float, float>(
+        handle, store, key_X, key_y,
+        [handle](da_int n_samples, da_int n_features, const float *X, da_int ldx,
+                 const float *y) {
+            return da_svm_set_data_s(handle, n_samples, n_features, X, ldx, y);
+        });
+}
+
 da_status da_svm_compute_d(da_handle handle) {
     if (!handle)
         return da_status_handle_not_initialized;
@@ -32,6 +32,8 @@ namespace da_svm_types {
 
 enum svm_kernel { rbf = 0, linear, polynomial, sigmoid };
 
+enum svm_solver { solver_auto = 0, solver_smo, solver_dual_cd };
+
 template <typename T> struct meta_kernel_f {
     using type =
         std::function<void(da_order order, da_int m, da_int n, da_int k, const T *X,
@@ -96,6 +96,19 @@ template <> da_status da_dbscan_compute<double>(da_handle handle) {
 template <> da_status da_dbscan_compute<float>(da_handle handle) {
     return da_dbscan_compute_s(handle);
 }
+template <> da_status da_hdbscan_compute<double>(da_handle handle) {
+    return da_hdbscan_compute_d(handle);
+}
+template <> da_status da_hdbscan_compute<float>(da_handle handle) {
+    return da_hdbscan_compute_s(handle);
+}
+
+template <> da_status da_kernel_approx_compute<double>(da_handle handle) {
+    return da_kernel_approx_compute_d(handle);
+}
+template <> da_status da_kernel_approx_compute<float>(da_handle handle) {
+    return da_kernel_approx_compute_s(handle);
+}
 
 template <> da_status da_svm_select_model<double>(da_handle handle, da_svm_model mod) {
     return da_svm_select_model_d(handle, mod);
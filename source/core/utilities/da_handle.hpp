@@ -28,9 +28,11 @@
 #ifndef DA_HANDLE_HPP
 #define DA_HANDLE_HPP
 
+#include <memory>
 #include <new>
 #include <stdio.h>
 #include <string.h>
+#include <vector>
 
 #include "aoclda.h"
 #include "basic_handle.hpp"
@@ -55,6 +57,11 @@ struct _da_handle {
     basic_handle<double> *alg_handle_d = nullptr;
     basic_handle<float> *alg_handle_s = nullptr;
 
+    // Copies of the datastore selections passed by the *_set_data_from_store functions,
+    // when they could not be used in place. The algorithms only keep pointers to their
+    // data, so the copies are owned by the handle.
+    std::vector<std::shared_ptr<void>> store_data;
+
     // Clear telemetry, for now it only clears the error stack.
     // vector<>.clear() is linear in cost wrt the number of elements to erase.
     void clear(void) {
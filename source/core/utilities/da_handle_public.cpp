@@ -90,6 +90,26 @@ da_status da_handle_init_d(da_handle *handle, da_handle_type handle_type) {
                 return status;
             }
             break;
+        case da_handle_hdbscan:
+            DISPATCHER((*handle)->err,
+                       (*handle)->alg_handle_d =
+                           new da_hdbscan::hdbscan<double>(*(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                (*handle)->alg_handle_d = nullptr;
+                return status;
+            }
+            break;
+        case da_handle_kernel_approx:
+            DISPATCHER((*handle)->err,
+                       (*handle)->alg_handle_d =
+                           new da_kernel_approx::kernel_approx<double>(*(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                (*handle)->alg_handle_d = nullptr;
+                return status;
+            }
+            break;
         case da_handle_decision_tree:
             DISPATCHER((*handle)->err, (*handle)->alg_handle_d =
                                            new da_decision_forest::decision_tree<double>(
@@ -204,6 +224,26 @@ da_status da_handle_init_s(da_handle *handle, da_handle_type handle_type) {
                 return status;
             }
             break;
+        case da_handle_hdbscan:
+            DISPATCHER((*handle)->err,
+                       (*handle)->alg_handle_s =
+                           new da_hdbscan::hdbscan<float>(*(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                (*handle)->alg_handle_s = nullptr;
+                return status;
+            }
+            break;
+        case da_handle_kernel_approx:
+            DISPATCHER((*handle)->err,
+                       (*handle)->alg_handle_s =
+                           new da_kernel_approx::kernel_approx<float>(*(*handle)->err));
+            status = (*handle)->err->get_status();
+            if (status != da_status_success) {
+                (*handle)->alg_handle_s = nullptr;
+                return status;
+            }
+            break;
 
         case da_handle_decision_tree:
             DISPATCHER((*handle)->err,
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DA_STORE_DATA_HPP
+#define DA_STORE_DATA_HPP
+
+#include "aoclda.h"
+#include "da_datastore.hpp"
+#include "da_error.hpp"
+#include "da_handle.hpp"
+#include "options.hpp"
+#include <memory>
+#include <new>
+#include <string>
+
+/* Helpers for the *_set_data_from_store functions, passing the selections of a
+ * da_datastore to the algorithms of a da_handle without going through user buffers.
+ */
+namespace da_data {
+
+/* Dense matrix holding the data of a datastore selection.
+ * data either points directly into the store or into buffer, if the selection had to be
+ * extracted.
+ */
+template <class T> struct store_selection {
+    const T *data = nullptr;
+    da_int n_rows = 0, n_cols = 0, ld = 0;
+    std::shared_ptr<T> buffer = nullptr;
+};
+
+/* Get the selection key of store as a dense matrix in the storage order of handle.
+ * If the handle expects column-major data and the selection maps onto a single
+ * column-major block of the store (see data_store::selection_view), the data is used in
+ * place. Otherwise, the selection is extracted once into a new buffer.
+ * If packed is true, the leading dimension must match the dimension of the matrix, so
+ * that views of part of a block cannot be used.
+ */
+template <class T>
+da_status get_store_selection(da_handle handle, da_datastore store, const char *key,
+                              store_selection<T> &sel, bool packed = false) {
+    if (!store)
+        return da_error(handle->err, da_status_store_not_initialized,
+                        "The datastore has not been initialized.");
+    store->clear(); // Clean up store logs
+    if (store->store == nullptr)
+        return da_error(handle->err, da_status_internal_error, // LCOV_EXCL_LINE
+                        "store seems to be invalid?");         // LCOV_EXCL_LINE
+    if (!key)
+        return da_error(handle->err, da_status_invalid_input,
+                        "The selection key has to be defined.");
+
+    da_options::OptionRegistry *opts;
+    da_status status = handle->get_current_opts(&opts);
+    if (status != da_status_success)
+        return status; // LCOV_EXCL_LINE
+    std::string opt_order;
+    da_int order = column_major;
+    opts->get("storage order", opt_order, order);
+
+    std::string key_str(key);
+    std::string msg = "Could not get the selection " + key_str +
+                      " from the datastore. Use da_datastore_print_error_message for "
+                      "more details.";
+    if (order == column_major) {
+        T *view;
+        status = store->store->selection_view(key_str, view, sel.n_rows, sel.n_cols,
+                                              sel.ld);
+        if (status == da_status_success && (!packed || sel.ld == sel.n_rows)) {
+            sel.data = view;
+            return da_status_success;
+        }
+        if (status == da_status_missing_block)
+            return da_error(handle->err, status, msg);
+        // The selection cannot be used in place, extract it
+        store->clear();
+    }
+
+    status = store->store->selection_size(key_str, sel.n_rows, sel.n_cols);
+    if (status != da_status_success)
+        return da_error(handle->err, status, msg);
+    sel.ld = order == column_major ? sel.n_rows : sel.n_cols;
+    try {
+        sel.buffer = std::shared_ptr<T>(new T[(size_t)sel.n_rows * (size_t)sel.n_cols],
+                                        std::default_delete<T[]>());
+    } catch (std::bad_alloc const &) {                       // LCOV_EXCL_LINE
+        return da_error(handle->err, da_status_memory_error, // LCOV_EXCL_LINE
+                        "Memory allocation error");
+    }
+    status = store->store->extract_selection(key_str, (da_order)order,
+                                             std::max(sel.ld, (da_int)1),
+                                             sel.buffer.get());
+    if (status != da_status_success && status != da_status_full_extraction)
+        return da_error(handle->err, status, msg);
+    store->clear();
+    sel.data = sel.buffer.get();
+    return da_status_success;
+}
+
+/* Once the data of a set_data_from_store call has been passed to the algorithm with the
+ * given exit status, keep its buffers alive in the handle. They replace the ones of the
+ * previous call, unless the algorithm rejected the new data.
+ */
+template <class... Sel>
+void keep_store_selections(da_handle handle, da_status status, Sel &...sel) {
+    if (status != da_status_success && handle->err->get_severity() == DA_ERROR)
+        return;
+    handle->store_data = {sel.buffer...};
+}
+
+/* Pass the selection key of store to an algorithm through
+ * set_data(n_samples, n_features, X, ldx)
+ */
+template <class T, class SetData>
+da_status set_data_from_store(da_handle handle, da_datastore store, const char *key,
+                              SetData set_data, bool packed = false) {
+    store_selection<T> X;
+    da_status status = get_store_selection(handle, store, key, X, packed);
+    if (status != da_status_success)
+        return status;
+    status = set_data(X.n_rows, X.n_cols, X.data, X.ld);
+    keep_store_selections(handle, status, X);
+    return status;
+}
+
+/* Pass the features key_X and the single column of responses key_y of store to an
+ * algorithm through set_data(n_samples, n_features, X, ldx, y)
+ */
+template <class T, class U, class SetData>
+da_status set_data_from_store(da_handle handle, da_datastore store, const char *key_X,
+                              const char *key_y, SetData set_data, bool packed = false) {
+    store_selection<T> X;
+    store_selection<U> y;
+    da_status status = get_store_selection(handle, store, key_X, X, packed);
+    if (status != da_status_success)
+        return status;
+    status = get_store_selection(handle, store, key_y, y);
+    if (status != da_status_success)
+        return status;
+    if (y.n_cols != 1)
+        return da_error(handle->err, da_status_invalid_input,
+                        "The selection " + std::string(key_y) +
+                            " must contain a single column, it contains " +
+                            std::to_string(y.n_cols) + ".");
+    if (y.n_rows != X.n_rows)
+        return da_error(handle->err, da_status_invalid_input,
+                        "The selections " + std::string(key_X) + " and " +
+                            std::string(key_y) +
+                            " must contain the same number of rows.");
+    status = set_data(X.n_rows, X.n_cols, X.data, X.ld, y.data);
+    keep_store_selections(handle, status, X, y);
+    return status;
+}
+
+} // namespace da_data
+
+#endif
@@ -86,10 +86,10 @@ template <typename T> class da_vector {
         _data[_size++] = val;
     }
 
-    // Append the values of vec onto the end of the vector
-    void append(const da_vector<T> &vec) {
-        if (_size + vec.size() > _capacity) {
-            while (_size + vec.size() > _capacity)
+    // Append the n values starting at vec onto the end of the vector
+    void append(const T *vec, size_t n) {
+        if (_size + n > _capacity) {
+            while (_size + n > _capacity)
                 _capacity <<= 1;
             T *new_data = (T *)malloc(_capacity * sizeof(T));
             if (!new_data) {
@@ -99,25 +99,17 @@ template <typename T> class da_vector {
             free(_data);
             _data = new_data;
         }
-        memcpy(_data + _size, vec.data(), vec.size() * sizeof(T));
-        _size += vec.size();
+        memcpy(_data + _size, vec, n * sizeof(T));
+        _size += n;
     }
 
-    void append(const std::vector<T> &vec) {
-        if (_size + vec.size() > _capacity) {
-            while (_size + vec.size() > _capacity)
-                _capacity <<= 1;
-            T *new_data = (T *)malloc(_capacity * sizeof(T));
-            if (!new_data) {
-                throw std::bad_alloc(); // LCOV_EXCL_LINE
-            }
-            memcpy(new_data, _data, _size * sizeof(T));
-            free(_data);
-            _data = new_data;
-        }
-        memcpy(_data + _size, vec.data(), vec.size() * sizeof(T));
-        _size += vec.size();
-    }
+    // Append the values of vec onto the end of the vector
+    void append(const da_vector<T> &vec) { append(vec.data(), vec.size()); }
+
+    void append(const std::vector<T> &vec) { append(vec.data(), vec.size()); }
+
+    // Remove all the values, keeping the allocated memory
+    void clear() { _size = 0; }
 
   private:
     T *_data;
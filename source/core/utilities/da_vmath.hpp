@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DA_VMATH_HPP
+#define DA_VMATH_HPP
+
+#include "aoclda.h"
+#include "da_omp.hpp"
+#include "macros.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ARCH {
+
+/* Elementwise exponential and hyperbolic tangent written to be vectorized.
+ *
+ * The functions are branch-free and only use arithmetic, rounding and integer operations,
+ * so that loops over them marked with omp simd are vectorized for the instruction set of
+ * each zen architecture the library is compiled for (AVX2 or AVX-512), instead of calling
+ * the scalar libm routines element by element.
+ *
+ * exp: x = n ln(2) + r with |r| <= ln(2)/2, and exp(x) = 2^n exp(r), with exp(r) evaluated
+ * by its Taylor polynomial, whose truncation error is below 0.05 ulp. The result is within
+ * 2 ulp of the exact value over the whole range of double, subnormal results included.
+ * tanh: tanh(x) = -expm1(-2|x|) / (2 + expm1(-2|x|)), with the sign of x, where expm1 uses
+ * the same reduction so that small arguments do not lose accuracy. The result is within
+ * 3 ulp of the exact value.
+ * The single precision versions are evaluated in double precision and rounded once, which
+ * keeps them within 1 ulp, as the scalar libm routines they replace. The solvers using the
+ * kernels in single precision are sensitive to the last bits of the kernel matrices.
+ * NaNs are propagated and infinite arguments give the limits of the functions.
+ */
+namespace da_vmath {
+
+template <typename T> struct vmath_consts;
+
+template <> struct vmath_consts<double> {
+    using uint_t = uint64_t;
+    static constexpr int mantissa_bits = 52;
+    static constexpr int32_t exponent_bias = 1023;
+    // The arguments are clamped to [-x_bound, x_bound], outside of which exp is 0 or inf
+    static constexpr double x_bound = 746.0;
+    static constexpr double log2e = 1.44269504088896338700e+00;
+    // ln(2) = ln2_hi + ln2_lo, with n * ln2_hi exact for the values of n used
+    static constexpr double ln2_hi = 6.93147180369123816490e-01;
+    static constexpr double ln2_lo = 1.90821492927058770002e-10;
+    // Taylor polynomial of exp(r) - 1 - r, 1 / k! for k = 2, ..., 13
+    static constexpr int n_coeffs = 12;
+    static constexpr double coeffs[n_coeffs] = {
+        5.00000000000000000000e-01, 1.66666666666666657415e-01,
+        4.16666666666666643537e-02, 8.33333333333333321769e-03,
+        1.38888888888888894189e-03, 1.98412698412698412526e-04,
+        2.48015873015873015658e-05, 2.75573192239858925110e-06,
+        2.75573192239858882758e-07, 2.50521083854417202239e-08,
+        2.08767569878681001866e-09, 1.60590438368216133409e-10};
+};
+
+/* Horner evaluation of coeffs[k] + r * (coeffs[k + 1] + r * (...)), unrolled at compile
+ * time so that the coefficients become constants of the vectorized loops
+ */
+template <typename T, int k = 0> inline T horner(T r) {
+    using C = vmath_consts<T>;
+    if constexpr (k == C::n_coeffs - 1)
+        return C::coeffs[k];
+    else
+        return C::coeffs[k] + r * horner<T, k + 1>(r);
+}
+
+/* 2^n as a floating point number, for the exponents of normal numbers */
+template <typename T> inline T pow2(int32_t n) {
+    using C = vmath_consts<T>;
+    typename C::uint_t bits = (typename C::uint_t)(n + C::exponent_bias)
+                              << C::mantissa_bits;
+    T s;
+    std::memcpy(&s, &bits, sizeof(T));
+    return s;
+}
+
+/* Reduce x to n and r such that x = n ln(2) + r with |r| <= ln(2) / 2, and return
+ * exp(r) - 1 computed without cancellation
+ */
+template <typename T> inline T expm1_reduced(T x, int32_t &n) {
+    using C = vmath_consts<T>;
+    // |x| is clamped rather than x, and with a comparison rather than fmin, so that the
+    // loops using these functions can be vectorized. NaNs fail the comparison and are
+    // propagated to the result without any further test
+    T ax = std::fabs(x);
+    x = std::copysign(ax > C::x_bound ? C::x_bound : ax, x);
+    T nt = std::rint(x * C::log2e);
+    n = (int32_t)nt;
+    T r = (x - nt * C::ln2_hi) - nt * C::ln2_lo;
+    return r + r * r * horner(r);
+}
+
+template <typename T> inline T exp(T x) {
+    if constexpr (std::is_same_v<T, float>) {
+        return (float)da_vmath::exp((double)x);
+    } else {
+        int32_t n;
+        T em1 = expm1_reduced(x, n);
+        // 2^n is applied in two steps, so that neither factor overflows nor underflows when
+        // the result is close to the limits of the range of T
+        int32_t n1 = n >> 1;
+        return ((T)1 + em1) * pow2<T>(n1) * pow2<T>(n - n1);
+    }
+}
+
+template <typename T> inline T tanh(T x) {
+    if constexpr (std::is_same_v<T, float>) {
+        return (float)da_vmath::tanh((double)x);
+    } else {
+        int32_t n;
+        T em1 = expm1_reduced((T)-2 * std::fabs(x), n);
+        // expm1(-2|x|) = 2^n (1 + em1) - 1, with 2^n applied in two steps as in exp
+        int32_t n1 = n >> 1;
+        T s = pow2<T>(n1) * pow2<T>(n - n1);
+        em1 = (s - (T)1) + s * em1;
+        return std::copysign(-em1 / ((T)2 + em1), x);
+    }
+}
+
+/* In place y_i = exp(alpha * y_i) for i = 0, ..., n - 1 */
+template <typename T> inline void scaled_exp(da_int n, T alpha, T *y) {
+#pragma omp simd
+    for (da_int i = 0; i < n; i++)
+        y[i] = da_vmath::exp(alpha * y[i]);
+}
+
+/* In place y_i = tanh(y_i + beta) for i = 0, ..., n - 1 */
+template <typename T> inline void shifted_tanh(da_int n, T beta, T *y) {
+#pragma omp simd
+    for (da_int i = 0; i < n; i++)
+        y[i] = da_vmath::tanh(y[i] + beta);
+}
+
+} // namespace da_vmath
+} // namespace ARCH
+
+#endif
@@ -39,6 +39,8 @@ extern "C" {
 #include "aoclda_decision_forest.h"
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
+#include "aoclda_hdbscan.h"
+#include "aoclda_kernel_approx.h"
 #include "aoclda_kernel_functions.h"
 #include "aoclda_kmeans.h"
 #include "aoclda_knn.h"
@@ -326,6 +326,60 @@ inline da_status da_data_extract_selection(da_datastore store, const char *key,
                                            da_order order, uint8_t *data, da_int lddata) {
     return da_data_extract_selection_uint8(store, key, order, data, lddata);
 }
+inline da_status da_data_get_selection_view(da_datastore store, const char *key,
+                                            da_int **data, da_int *n_rows,
+                                            da_int *n_cols, da_int *lddata) {
+    return da_data_get_selection_view_int(store, key, data, n_rows, n_cols, lddata);
+}
+inline da_status da_data_get_selection_view(da_datastore store, const char *key,
+                                            float **data, da_int *n_rows,
+                                            da_int *n_cols, da_int *lddata) {
+    return da_data_get_selection_view_real_s(store, key, data, n_rows, n_cols, lddata);
+}
+inline da_status da_data_get_selection_view(da_datastore store, const char *key,
+                                            double **data, da_int *n_rows,
+                                            da_int *n_cols, da_int *lddata) {
+    return da_data_get_selection_view_real_d(store, key, data, n_rows, n_cols, lddata);
+}
+inline da_status da_data_get_selection_view(da_datastore store, const char *key,
+                                            uint8_t **data, da_int *n_rows,
+                                            da_int *n_cols, da_int *lddata) {
+    return da_data_get_selection_view_uint8(store, key, data, n_rows, n_cols, lddata);
+}
+inline da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                                      da_data_compare op, da_int value,
+                                      da_data_combine combine) {
+    return da_data_select_where_int(store, key, col_idx, op, value, combine);
+}
+inline da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                                      da_data_compare op, double value,
+                                      da_data_combine combine) {
+    return da_data_select_where_real_d(store, key, col_idx, op, value, combine);
+}
+inline da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                                      da_data_compare op, float value,
+                                      da_data_combine combine) {
+    return da_data_select_where_real_s(store, key, col_idx, op, value, combine);
+}
+inline da_status da_data_select_where(da_datastore store, const char *key, da_int col_idx,
+                                      da_data_compare op, uint8_t value,
+                                      da_data_combine combine) {
+    return da_data_select_where_uint8(store, key, col_idx, op, value, combine);
+}
+inline da_status da_data_group_by(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, double *sums, double *means,
+                                  double *mins, double *maxs) {
+    return da_data_group_by_real_d(store, key, key_col, value_col, n_groups, group_keys,
+                                   counts, sums, means, mins, maxs);
+}
+inline da_status da_data_group_by(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, float *sums, float *means, float *mins,
+                                  float *maxs) {
+    return da_data_group_by_real_s(store, key, key_col, value_col, n_groups, group_keys,
+                                   counts, sums, means, mins, maxs);
+}
 
 /* PCA overloaded functions */
 inline da_status da_pca_set_data(da_handle handle, da_int n_samples, da_int n_features,
@@ -430,6 +484,29 @@ inline da_status da_dbscan_set_data(da_handle handle, da_int n_samples, da_int n
 
 template <class T> da_status da_dbscan_compute(da_handle handle);
 
+/* HDBSCAN overloaded functions */
+inline da_status da_hdbscan_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                                     const double *A, da_int lda) {
+    return da_hdbscan_set_data_d(handle, n_samples, n_features, A, lda);
+}
+
+inline da_status da_hdbscan_set_data(da_handle handle, da_int n_samples, da_int n_features,
+                                     const float *A, da_int lda) {
+    return da_hdbscan_set_data_s(handle, n_samples, n_features, A, lda);
+}
+
+template <class T> da_status da_hdbscan_compute(da_handle handle);
+
+inline da_status da_hdbscan_dbscan_labels(da_handle handle, double eps, da_int n_samples,
+                                          da_int *labels) {
+    return da_hdbscan_dbscan_labels_d(handle, eps, n_samples, labels);
+}
+
+inline da_status da_hdbscan_dbscan_labels(da_handle handle, float eps, da_int n_samples,
+                                          da_int *labels) {
+    return da_hdbscan_dbscan_labels_s(handle, eps, n_samples, labels);
+}
+
 /* Decision Forest overloaded functions */
 /* Decision tree */
 inline da_status da_tree_set_training_data(da_handle handle, da_int n_samples,
@@ -497,6 +574,45 @@ inline da_status da_tree_score(da_handle handle, da_int n_samples, da_int n_feat
                            mean_accuracy);
 }
 
+inline da_status da_tree_set_regression_data(da_handle handle, da_int n_samples,
+                                             da_int n_features, const double *X,
+                                             da_int ldx, const double *y) {
+    return da_tree_set_regression_data_d(handle, n_samples, n_features, X, ldx, y);
+}
+inline da_status da_tree_set_regression_data(da_handle handle, da_int n_samples,
+                                             da_int n_features, const float *X,
+                                             da_int ldx, const float *y) {
+    return da_tree_set_regression_data_s(handle, n_samples, n_features, X, ldx, y);
+}
+
+inline da_status da_tree_predict_regression(da_handle handle, da_int n_samples,
+                                            da_int n_features, const double *X_test,
+                                            da_int ldx_test, double *y_pred) {
+    return da_tree_predict_regression_d(handle, n_samples, n_features, X_test, ldx_test,
+                                        y_pred);
+}
+inline da_status da_tree_predict_regression(da_handle handle, da_int n_samples,
+                                            da_int n_features, const float *X_test,
+                                            da_int ldx_test, float *y_pred) {
+    return da_tree_predict_regression_s(handle, n_samples, n_features, X_test, ldx_test,
+                                        y_pred);
+}
+
+inline da_status da_tree_score_regression(da_handle handle, da_int n_samples,
+                                          da_int n_features, const double *X_test,
+                                          da_int ldx_test, const double *y_test,
+                                          double *score) {
+    return da_tree_score_regression_d(handle, n_samples, n_features, X_test, ldx_test,
+                                      y_test, score);
+}
+inline da_status da_tree_score_regression(da_handle handle, da_int n_samples,
+                                          da_int n_features, const float *X_test,
+                                          da_int ldx_test, const float *y_test,
+                                          float *score) {
+    return da_tree_score_regression_s(handle, n_samples, n_features, X_test, ldx_test,
+                                      y_test, score);
+}
+
 /* Random forest */
 inline da_status da_forest_set_training_data(da_handle handle, da_int n_samples,
                                              da_int n_features, da_int n_class,
@@ -570,6 +686,45 @@ inline da_status da_forest_score(da_handle handle, da_int n_samples, da_int n_fe
                              mean_accuracy);
 }
 
+inline da_status da_forest_set_regression_data(da_handle handle, da_int n_samples,
+                                               da_int n_features, const double *X,
+                                               da_int ldx, const double *y) {
+    return da_forest_set_regression_data_d(handle, n_samples, n_features, X, ldx, y);
+}
+inline da_status da_forest_set_regression_data(da_handle handle, da_int n_samples,
+                                               da_int n_features, const float *X,
+                                               da_int ldx, const float *y) {
+    return da_forest_set_regression_data_s(handle, n_samples, n_features, X, ldx, y);
+}
+
+inline da_status da_forest_predict_regression(da_handle handle, da_int n_samples,
+                                              da_int n_features, const double *X_test,
+                                              da_int ldx_test, double *y_pred) {
+    return da_forest_predict_regression_d(handle, n_samples, n_features, X_test, ldx_test,
+                                          y_pred);
+}
+inline da_status da_forest_predict_regression(da_handle handle, da_int n_samples,
+                                              da_int n_features, const float *X_test,
+                                              da_int ldx_test, float *y_pred) {
+    return da_forest_predict_regression_s(handle, n_samples, n_features, X_test, ldx_test,
+                                          y_pred);
+}
+
+inline da_status da_forest_score_regression(da_handle handle, da_int n_samples,
+                                            da_int n_features, const double *X_test,
+                                            da_int ldx_test, const double *y_test,
+                                            double *score) {
+    return da_forest_score_regression_d(handle, n_samples, n_features, X_test, ldx_test,
+                                        y_test, score);
+}
+inline da_status da_forest_score_regression(da_handle handle, da_int n_samples,
+                                            da_int n_features, const float *X_test,
+                                            da_int ldx_test, const float *y_test,
+                                            float *score) {
+    return da_forest_score_regression_s(handle, n_samples, n_features, X_test, ldx_test,
+                                        y_test, score);
+}
+
 inline da_status da_nlls_define_residuals(da_handle handle, da_int n_coef, da_int n_res,
                                           da_resfun_t_d *resfun, da_resgrd_t_d *resgrd,
                                           da_reshes_t_d *reshes, da_reshp_t_d *reshp) {
@@ -679,6 +834,77 @@ inline da_status da_knn_predict(da_handle handle, da_int n_queries, da_int n_fea
     return da_knn_predict_s(handle, n_queries, n_features, X_test, ldx_test, y_test);
 }
 
+/* k-NN for regression and radius neighbors functions */
+inline da_status da_knn_set_regression_data(da_handle handle, da_int n_samples,
+                                            da_int n_features, const double *X_train,
+                                            da_int ldx_train, const double *y_train) {
+    return da_knn_set_regression_data_d(handle, n_samples, n_features, X_train, ldx_train,
+                                        y_train);
+}
+
+inline da_status da_knn_set_regression_data(da_handle handle, da_int n_samples,
+                                            da_int n_features, const float *X_train,
+                                            da_int ldx_train, const float *y_train) {
+    return da_knn_set_regression_data_s(handle, n_samples, n_features, X_train, ldx_train,
+                                        y_train);
+}
+
+inline da_status da_knn_predict_regression(da_handle handle, da_int n_queries,
+                                           da_int n_features, const double *X_test,
+                                           da_int ldx_test, double *y_test) {
+    return da_knn_predict_regression_d(handle, n_queries, n_features, X_test, ldx_test,
+                                       y_test);
+}
+
+inline da_status da_knn_predict_regression(da_handle handle, da_int n_queries,
+                                           da_int n_features, const float *X_test,
+                                           da_int ldx_test, float *y_test) {
+    return da_knn_predict_regression_s(handle, n_queries, n_features, X_test, ldx_test,
+                                       y_test);
+}
+
+inline da_status da_knn_radius_neighbors(da_handle handle, da_int n_queries,
+                                         da_int n_features, const double *X_test,
+                                         da_int ldx_test, double radius) {
+    return da_knn_radius_neighbors_d(handle, n_queries, n_features, X_test, ldx_test,
+                                     radius);
+}
+
+inline da_status da_knn_radius_neighbors(da_handle handle, da_int n_queries,
+                                         da_int n_features, const float *X_test,
+                                         da_int ldx_test, float radius) {
+    return da_knn_radius_neighbors_s(handle, n_queries, n_features, X_test, ldx_test,
+                                     radius);
+}
+
+inline da_status da_knn_radius_predict(da_handle handle, da_int n_queries,
+                                       da_int n_features, const double *X_test,
+                                       da_int ldx_test, da_int *y_test) {
+    return da_knn_radius_predict_d(handle, n_queries, n_features, X_test, ldx_test,
+                                   y_test);
+}
+
+inline da_status da_knn_radius_predict(da_handle handle, da_int n_queries,
+                                       da_int n_features, const float *X_test,
+                                       da_int ldx_test, da_int *y_test) {
+    return da_knn_radius_predict_s(handle, n_queries, n_features, X_test, ldx_test,
+                                   y_test);
+}
+
+inline da_status da_knn_radius_predict_regression(da_handle handle, da_int n_queries,
+                                                  da_int n_features, const double *X_test,
+                                                  da_int ldx_test, double *y_test) {
+    return da_knn_radius_predict_regression_d(handle, n_queries, n_features, X_test,
+                                              ldx_test, y_test);
+}
+
+inline da_status da_knn_radius_predict_regression(da_handle handle, da_int n_queries,
+                                                  da_int n_features, const float *X_test,
+                                                  da_int ldx_test, float *y_test) {
+    return da_knn_radius_predict_regression_s(handle, n_queries, n_features, X_test,
+                                              ldx_test, y_test);
+}
+
 /* Utility overloaded functions */
 inline da_status da_check_data(da_order order, da_int n_rows, da_int n_cols,
                                const double *X, da_int ldx) {
@@ -757,6 +983,36 @@ inline da_status da_sigmoid_kernel(da_order order, da_int m, da_int n, da_int k,
     return da_sigmoid_kernel_s(order, m, n, k, X, ldx, Y, ldy, D, ldd, gamma, coef0);
 }
 
+/* Kernel approximation overloaded functions */
+inline da_status da_kernel_approx_set_data(da_handle handle, da_int n_samples,
+                                           da_int n_features, const double *A,
+                                           da_int lda) {
+    return da_kernel_approx_set_data_d(handle, n_samples, n_features, A, lda);
+}
+
+inline da_status da_kernel_approx_set_data(da_handle handle, da_int n_samples,
+                                           da_int n_features, const float *A,
+                                           da_int lda) {
+    return da_kernel_approx_set_data_s(handle, n_samples, n_features, A, lda);
+}
+
+template <class T> da_status da_kernel_approx_compute(da_handle handle);
+
+inline da_status da_kernel_approx_transform(da_handle handle, da_int m_samples,
+                                            da_int m_features, const double *X,
+                                            da_int ldx, double *X_transform,
+                                            da_int ldx_transform) {
+    return da_kernel_approx_transform_d(handle, m_samples, m_features, X, ldx,
+                                        X_transform, ldx_transform);
+}
+
+inline da_status da_kernel_approx_transform(da_handle handle, da_int m_samples,
+                                            da_int m_features, const float *X, da_int ldx,
+                                            float *X_transform, da_int ldx_transform) {
+    return da_kernel_approx_transform_s(handle, m_samples, m_features, X, ldx,
+                                        X_transform, ldx_transform);
+}
+
 /* SVM functions */
 template <class T> da_status da_svm_select_model(da_handle handle, da_svm_model mod);
 
@@ -42,6 +42,53 @@
  */
 typedef struct _da_datastore *da_datastore;
 
+/*
+ * Structures of the Apache Arrow C data interface (https://arrow.apache.org/docs/format/CDataInterface.html).
+ * They are ABI-stable and defined here so that Arrow data can be passed to the library without
+ * any dependency on an external Arrow implementation.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
 /**
  * @brief Initialize an empty @ref da_datastore.
  *
@@ -246,6 +293,52 @@ da_status da_data_load_row_str(da_datastore store, da_int n_rows, da_int n_cols,
                                const char **block, da_order order);
 /** \} */
 
+/**
+ * @brief Load new columns into a @ref da_datastore from Apache Arrow data.
+ *
+ * @rst
+ * The data is passed through the `Arrow C data interface <https://arrow.apache.org/docs/format/CDataInterface.html>`_
+ * structures ``ArrowArray`` and ``ArrowSchema``. @p array can either be a struct array (format ``"+s"``,
+ * e.g., an exported record batch), in which case each of its children is added as a new column to the right of the store,
+ * or a single primitive array that is added as one column.
+ * @endrst
+ *
+ * The supported formats are
+ * - <tt>"g"</tt> (double) and <tt>"f"</tt> (float),
+ * - <tt>"i"</tt> (int32) for LP64 builds or <tt>"l"</tt> (int64) for ILP64 builds,
+ * - <tt>"C"</tt> (uint8),
+ * - <tt>"b"</tt> (boolean), stored as uint8 data,
+ * - <tt>"u"</tt> and <tt>"U"</tt> (UTF-8 strings).
+ *
+ * Fixed-width numerical buffers are not copied: the store keeps pointers to the Arrow buffers.
+ * Boolean and string columns are converted and therefore copied.
+ * Validity bitmaps are mapped onto the missing data handling of the store: null entries
+ * are treated as missing by @ref da_data_select_non_missing and are extracted as NaN for floating point data
+ * or as the maximum value of the type for integer data. Null strings are extracted as empty strings.
+ *
+ * If successful, the store takes ownership of @p array, following the move semantics of the Arrow C data interface:
+ * on output, @p array is marked as released and its release callback will be called by the store
+ * when the data is no longer needed, at the latest in @ref da_datastore_destroy.
+ * @p schema is only read and remains owned by the caller.
+ * If the schema contains field names, they are used to label the new columns.
+ *
+ * If data was already loaded in the store, the number of rows of @p array must match
+ * the number of rows already present.
+ *
+ * @param[inout] store the main structure.
+ * @param[inout] array the Arrow array to import.
+ * @param[in] schema the Arrow schema describing @p array.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct or contains unsupported types.
+ *        Use @ref da_handle_print_error_message to get more details. In this case @p array is not modified.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_invalid_pointer - the store was not correctly initialized.
+ * - @ref da_status_memory_error - internal memory allocation encountered a problem.
+ */
+da_status da_data_load_col_arrow(da_datastore store, struct ArrowArray *array,
+                                 struct ArrowSchema *schema);
+
 /**
  * @brief Read data from a CSV file into a @ref da_datastore object. The data type of each column will be automatically detected.
  *
@@ -362,6 +455,75 @@ da_status da_data_select_slice(da_datastore store, const char *key, da_int row_l
 da_status da_data_select_non_missing(da_datastore store, const char *key,
                                      uint8_t full_rows);
 
+/**
+ * @brief Comparison operators used by the da_data_select_where_? functions to filter rows.
+ */
+enum da_data_compare_ {
+    da_compare_lt = 0, ///< The column is less than the value.
+    da_compare_le,     ///< The column is less than or equal to the value.
+    da_compare_gt,     ///< The column is greater than the value.
+    da_compare_ge,     ///< The column is greater than or equal to the value.
+    da_compare_eq,     ///< The column is equal to the value.
+    da_compare_ne,     ///< The column is not equal to the value.
+};
+
+/** @brief Alias for the \ref da_data_compare_ enum. */
+typedef enum da_data_compare_ da_data_compare;
+
+/**
+ * @brief Defines how the rows filtered by the da_data_select_where_? functions are combined with the rows already in a selection.
+ */
+enum da_data_combine_ {
+    da_combine_and = 0, ///< Keep the rows of the selection that satisfy the predicate.
+    da_combine_or,      ///< Add the rows that satisfy the predicate to the selection.
+};
+
+/** @brief Alias for the \ref da_data_combine_ enum. */
+typedef enum da_data_combine_ da_data_combine;
+
+/** \{ */
+/**
+ * @brief Filter the rows of the selection labeled by @p key with a predicate on the column @p col_idx.
+ * The last suffix of the function name marks the type of the column.
+ *
+ * A row @p i satisfies the predicate if the element (@p i, @p col_idx) of the store compares to @p value
+ * as defined by @p op. Rows with a missing element in the column never satisfy it.
+ * If @p combine is @ref da_combine_and, only the rows of the selection satisfying the predicate are kept;
+ * if it is @ref da_combine_or, the rows satisfying the predicate are added to the selection. Complex
+ * filters can be built by successive calls.
+ *
+ * If @p key does not exist or has no rows selected, its rows are set to the ones satisfying the predicate,
+ * whatever the value of @p combine. The columns of the selection are not modified. If no row satisfies
+ * the predicate, the selection contains no rows.
+ *
+ * @param[inout] store the main data structure.
+ * @param[in] key label of the selection.
+ * @param[in] col_idx index of the column the predicate is evaluated on.
+ * @param[in] op a @ref da_data_compare enumerated type, the comparison operator.
+ * @param[in] value the value the column is compared with.
+ * @param[in] combine a @ref da_data_combine enumerated type, how the predicate is combined with the current rows of the selection.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_handle_print_error_message to get more details.
+ * - @ref da_status_invalid_pointer - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - internal memory allocation failed.
+ */
+da_status da_data_select_where_int(da_datastore store, const char *key, da_int col_idx,
+                                   da_data_compare op, da_int value,
+                                   da_data_combine combine);
+da_status da_data_select_where_real_d(da_datastore store, const char *key,
+                                      da_int col_idx, da_data_compare op, double value,
+                                      da_data_combine combine);
+da_status da_data_select_where_real_s(da_datastore store, const char *key,
+                                      da_int col_idx, da_data_compare op, float value,
+                                      da_data_combine combine);
+da_status da_data_select_where_uint8(da_datastore store, const char *key, da_int col_idx,
+                                     da_data_compare op, uint8_t value,
+                                     da_data_combine combine);
+/** \} */
+
 /**
  * @brief Remove the columns indexed by the values between @p lbound and @p ubound from an existing
  * selection.
@@ -470,6 +632,98 @@ da_status da_data_extract_selection_real_s(da_datastore store, const char *key,
                                            da_order order, float *data, da_int lddata);
 da_status da_data_extract_selection_uint8(da_datastore store, const char *key,
                                           da_order order, uint8_t *data, da_int lddata);
+/**
+ * @brief Get direct access to the data of the selection labeled by @p key, without copying it.
+ * The last suffix of the function name marks the type of the data to be accessed.
+ *
+ * If the selection maps onto a contiguous part of a single column-major block of the store,
+ * a pointer to its first element is returned in @p data and no data is copied.
+ * This requires the columns and the rows of the selection to each form a single contiguous
+ * range of indices, stored in the same block, and that the block contains no Arrow
+ * validity mask (see @ref da_data_load_col_arrow).
+ * If no selection is defined, the whole store is considered. When the selection cannot be
+ * accessed in place, @ref da_status_invalid_input is returned and
+ * the da_data_extract_selection_? functions can be used instead.
+ *
+ * The selection is a column-major matrix of size @p n_rows x @p n_cols with leading
+ * dimension @p lddata. The memory is owned by the store: the pointer should not be
+ * freed, and is invalidated by any subsequent operation modifying the store.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection.
+ * @param[out] data pointer to the first element of the selection.
+ * @param[out] n_rows number of rows in the selection.
+ * @param[out] n_cols number of columns in the selection.
+ * @param[out] lddata leading dimension of @p data.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct, or the selection
+ *        cannot be accessed without a copy.
+ *        Use @ref da_handle_print_error_message to get more details.
+ * - @ref da_status_invalid_pointer - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ */
+da_status da_data_get_selection_view_int(da_datastore store, const char *key,
+                                         da_int **data, da_int *n_rows, da_int *n_cols,
+                                         da_int *lddata);
+da_status da_data_get_selection_view_real_d(da_datastore store, const char *key,
+                                            double **data, da_int *n_rows,
+                                            da_int *n_cols, da_int *lddata);
+da_status da_data_get_selection_view_real_s(da_datastore store, const char *key,
+                                            float **data, da_int *n_rows, da_int *n_cols,
+                                            da_int *lddata);
+da_status da_data_get_selection_view_uint8(da_datastore store, const char *key,
+                                           uint8_t **data, da_int *n_rows,
+                                           da_int *n_cols, da_int *lddata);
+/** \} */
+
+/* ************************************ aggregation ********************************** */
+/* *********************************************************************************** */
+/** \{ */
+/**
+ * @brief Compute per-group statistics of a column, grouping the rows by the values of an integer column.
+ * The last suffix of the function name marks the type of the column to aggregate.
+ *
+ * The rows of the selection labeled by @p key are grouped by the distinct values of the integer column
+ * @p key_col and, for each group, the number of rows and the sum, mean, minimum and maximum of the
+ * column @p value_col are computed. Rows with a missing element in either column are ignored. The
+ * groups are returned sorted by increasing key.
+ *
+ * Only the rows of the selection are considered, its columns are ignored. If @p key is NULL or if the
+ * selection has no rows selected, all the rows of the store are aggregated.
+ *
+ * The output arrays must be of size at least the number of groups. If @p n_groups is too small,
+ * it is overwritten with the number of groups and @ref da_status_invalid_array_dimension is returned.
+ * Any of the output arrays can be NULL if the corresponding statistic is not needed.
+ *
+ * @param[in] store main data structure.
+ * @param[in] key label of the selection, or NULL.
+ * @param[in] key_col index of the integer column defining the groups.
+ * @param[in] value_col index of the column to aggregate.
+ * @param[inout] n_groups on input, the size of the output arrays. On output, the number of groups.
+ * @param[out] group_keys the key of each group.
+ * @param[out] counts the number of rows in each group.
+ * @param[out] sums the sum of the values in each group.
+ * @param[out] means the mean of the values in each group.
+ * @param[out] mins the minimum value in each group.
+ * @param[out] maxs the maximum value in each group.
+ * @return @ref da_status. The function returns:
+ * - @ref da_status_success - the operation was successful.
+ * - @ref da_status_invalid_input - some of the input data was not correct.
+ *        Use @ref da_handle_print_error_message to get more details.
+ * - @ref da_status_invalid_array_dimension - @p n_groups is too small. On output it contains the number of groups.
+ * - @ref da_status_invalid_pointer - the store was not correctly initialized.
+ * - @ref da_status_missing_block - the store contains incomplete row blocks.
+ * - @ref da_status_memory_error - internal memory allocation failed.
+ */
+da_status da_data_group_by_real_d(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, double *sums, double *means,
+                                  double *mins, double *maxs);
+da_status da_data_group_by_real_s(da_datastore store, const char *key, da_int key_col,
+                                  da_int value_col, da_int *n_groups, da_int *group_keys,
+                                  da_int *counts, float *sums, float *means, float *mins,
+                                  float *maxs);
 /** \} */
 
 /* ************************************* headings ************************************ */
@@ -24,6 +24,7 @@
 #ifndef AOCLDA_DBSCAN
 #define AOCLDA_DBSCAN
 
+#include "aoclda_datastore.h"
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
 #include "aoclda_types.h"
@@ -59,6 +60,32 @@ da_status da_dbscan_set_data_s(da_handle handle, da_int n_samples, da_int n_feat
                                const float *A, da_int lda);
 /** \} */
 
+/** \{
+ * \brief Pass a selection of a \ref da_datastore to the \ref da_handle object in preparation for DBSCAN clustering.
+ *
+ * This is equivalent to calling \ref da_dbscan_set_data_s "da_dbscan_set_data_?" with the matrix that \ref da_data_extract_selection_real_s "da_data_extract_selection_real_?" would return for the selection \p key.
+ * If the selection is contiguous and stored in a single column-major block of \p store, the data is used in place and is not copied.
+ * Otherwise, it is extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_dbscan.
+ * \param[in] store a \ref da_datastore object holding the data, which must be of the same floating point type as \p handle.
+ * \param[in] key the name of the selection of \p store to use as the data matrix. If no selection is defined in \p store, all of its data is used.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - \p key is not a valid selection of \p store, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_dbscan_set_data_s "da_dbscan_set_data_?".
+ */
+da_status da_dbscan_set_data_from_store_d(da_handle handle, da_datastore store,
+                                          const char *key);
+da_status da_dbscan_set_data_from_store_s(da_handle handle, da_datastore store,
+                                          const char *key);
+/** \} */
+
 /** \{
  * \brief Compute DBSCAN clustering
  *
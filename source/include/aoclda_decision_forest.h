@@ -28,6 +28,7 @@
 #ifndef AOCLDA_DF
 #define AOCLDA_DF
 
+#include "aoclda_datastore.h"
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
 #include "aoclda_types.h"
@@ -63,6 +64,36 @@ da_status da_tree_set_training_data_s(da_handle handle, da_int n_samples,
                                       da_int ldx, const da_int *y);
 /** \} */
 
+/** \{
+ * @brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for fitting a decision tree.
+ *
+ * This is equivalent to calling \ref da_tree_set_training_data_s "da_tree_set_training_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * Each selection that is contiguous and stored in a single column-major block of \p store is used in place and is not copied.
+ * The other ones are extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * @param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_decision_tree.
+ * @param[in] store a \ref da_datastore object holding the data.
+ * @param[in] n_class number of distinct classes in the labels. Will be computed automatically if \p n_class is set to 0.
+ * @param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * @param[in] key_y the name of the selection of \p store containing the labels. It must contain a single integer column with the same number of rows as \p key_X.
+ * @return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - the selections are not valid or have incompatible types or dimensions, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_tree_set_training_data_s "da_tree_set_training_data_?".
+ */
+da_status da_tree_set_training_data_from_store_d(da_handle handle, da_datastore store,
+                                                 da_int n_class, const char *key_X,
+                                                 const char *key_y);
+da_status da_tree_set_training_data_from_store_s(da_handle handle, da_datastore store,
+                                                 da_int n_class, const char *key_X,
+                                                 const char *key_y);
+/** \} */
+
 /** \{
  * @brief Pass a data matrix and a label array to the \ref da_handle object
  * in preparation for fitting a decision forest.
@@ -89,6 +120,136 @@ da_status da_forest_set_training_data_s(da_handle handle, da_int n_samples,
                                         da_int ldx, const da_int *y);
 /** \} */
 
+/** \{
+ * @brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for fitting a decision forest.
+ *
+ * This is equivalent to calling \ref da_forest_set_training_data_s "da_forest_set_training_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * Each selection that is contiguous and stored in a single column-major block of \p store is used in place and is not copied.
+ * The other ones are extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * @param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_decision_forest.
+ * @param[in] store a \ref da_datastore object holding the data.
+ * @param[in] n_class number of distinct classes in the labels. Will be computed automatically if \p n_class is set to 0.
+ * @param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * @param[in] key_y the name of the selection of \p store containing the labels. It must contain a single integer column with the same number of rows as \p key_X.
+ * @return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - the selections are not valid or have incompatible types or dimensions, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_forest_set_training_data_s "da_forest_set_training_data_?".
+ */
+da_status da_forest_set_training_data_from_store_d(da_handle handle, da_datastore store,
+                                                   da_int n_class, const char *key_X,
+                                                   const char *key_y);
+da_status da_forest_set_training_data_from_store_s(da_handle handle, da_datastore store,
+                                                   da_int n_class, const char *key_X,
+                                                   const char *key_y);
+/** \} */
+
+/** \{
+ * @brief Pass a data matrix and an array of real targets to the \ref da_handle object
+ * in preparation for fitting a regression decision tree.
+ *
+ * The decision tree is then fitted with \ref da_tree_fit_s "da_tree_fit_?" and used with \ref da_tree_predict_regression_s "da_tree_predict_regression_?"
+ * and \ref da_tree_score_regression_s "da_tree_score_regression_?". The classification APIs require the labels passed by
+ * \ref da_tree_set_training_data_s "da_tree_set_training_data_?" instead.
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_tree.
+ * @param[in] n_samples number of observations in \p X.
+ * @param[in] n_features number of features in \p X.
+ * @param[in] X array containing \p n_samples  @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * @param[in] ldx leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p n_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_features if \p X is stored in row-major order.
+ * @param[in] y array containing the \p n_samples targets.
+ * @return @ref da_status.  The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ * - @ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+*/
+da_status da_tree_set_regression_data_d(da_handle handle, da_int n_samples,
+                                        da_int n_features, const double *X, da_int ldx,
+                                        const double *y);
+da_status da_tree_set_regression_data_s(da_handle handle, da_int n_samples,
+                                        da_int n_features, const float *X, da_int ldx,
+                                        const float *y);
+/** \} */
+
+/** \{
+ * @brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for fitting a regression decision tree.
+ *
+ * This is equivalent to calling \ref da_tree_set_regression_data_s "da_tree_set_regression_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * As in \ref da_tree_set_training_data_from_store_s "da_tree_set_training_data_from_store_?", contiguous column-major selections are used in place, so \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * @param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_decision_tree.
+ * @param[in] store a \ref da_datastore object holding the data.
+ * @param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * @param[in] key_y the name of the selection of \p store containing the targets. It must contain a single column of the same floating point type as \p handle, with the same number of rows as \p key_X.
+ * @return \ref da_status. The function returns the same statuses as \ref da_tree_set_training_data_from_store_s "da_tree_set_training_data_from_store_?".
+ */
+da_status da_tree_set_regression_data_from_store_d(da_handle handle, da_datastore store,
+                                                   const char *key_X,
+                                                   const char *key_y);
+da_status da_tree_set_regression_data_from_store_s(da_handle handle, da_datastore store,
+                                                   const char *key_X,
+                                                   const char *key_y);
+/** \} */
+
+/** \{
+ * @brief Pass a data matrix and an array of real targets to the \ref da_handle object
+ * in preparation for fitting a regression decision forest.
+ *
+ * The decision forest is then fitted with \ref da_forest_fit_s "da_forest_fit_?" and used with \ref da_forest_predict_regression_s "da_forest_predict_regression_?"
+ * and \ref da_forest_score_regression_s "da_forest_score_regression_?". The classification APIs require the labels passed by
+ * \ref da_forest_set_training_data_s "da_forest_set_training_data_?" instead.
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_forest.
+ * @param[in] n_samples number of observations in \p X.
+ * @param[in] n_features number of features in \p X.
+ * @param[in] X array containing \p n_samples  @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * @param[in] ldx leading dimension of \p X. Constraint: \p ldx @f$\ge@f$ \p n_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p n_features if \p X is stored in row-major order.
+ * @param[in] y array containing the \p n_samples targets.
+ * @return @ref da_status.  The function returns:
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using @ref da_handle_print_error_message.
+ * - @ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx was violated.
+*/
+da_status da_forest_set_regression_data_d(da_handle handle, da_int n_samples,
+                                          da_int n_features, const double *X, da_int ldx,
+                                          const double *y);
+da_status da_forest_set_regression_data_s(da_handle handle, da_int n_samples,
+                                          da_int n_features, const float *X, da_int ldx,
+                                          const float *y);
+/** \} */
+
+/** \{
+ * @brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for fitting a regression decision forest.
+ *
+ * This is equivalent to calling \ref da_forest_set_regression_data_s "da_forest_set_regression_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * As in \ref da_forest_set_training_data_from_store_s "da_forest_set_training_data_from_store_?", contiguous column-major selections are used in place, so \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * @param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_decision_forest.
+ * @param[in] store a \ref da_datastore object holding the data.
+ * @param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * @param[in] key_y the name of the selection of \p store containing the targets. It must contain a single column of the same floating point type as \p handle, with the same number of rows as \p key_X.
+ * @return \ref da_status. The function returns the same statuses as \ref da_forest_set_training_data_from_store_s "da_forest_set_training_data_from_store_?".
+ */
+da_status da_forest_set_regression_data_from_store_d(da_handle handle, da_datastore store,
+                                                     const char *key_X,
+                                                   const char *key_y);
+da_status da_forest_set_regression_data_from_store_s(da_handle handle, da_datastore store,
+                                                     const char *key_X,
+                                                   const char *key_y);
+/** \} */
+
 /** \{
  * @brief Fit the decision tree defined in the @p handle.
  *
@@ -447,4 +608,145 @@ da_status da_forest_score_s(da_handle handle, da_int n_samples, da_int n_feature
 
 /** \} */
 
+/** \{
+ * @brief Predict the targets of a new set of data @p X_test using a fitted regression decision tree.
+ *
+ * @rst
+ * After a model has been fitted to targets passed by :ref:`da_tree_set_regression_data_? <da_tree_set_regression_data>`, it can be used to predict
+ * the targets of new data. The prediction of each observation is the mean of the training targets in the leaf it falls in.
+ * @endrst
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_tree.
+ * @param[in] n_samples - number of observations in \p X_test.
+ * @param[in] n_features - number of features in \p X_test.
+ * @param[in] X_test array containing \p n_samples  @f$\times@f$ \p n_features data matrix, in the same storage format used to fit the model.
+ * @param[in] ldx_test leading dimension of \p X_test. Constraint: \p ldx_test @f$\ge@f$ \p n_samples if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * @param[out] y_pred - array of size at least \p n_samples. On output, will contain the predicted targets.
+ * @return da_status
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle
+ *   initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using
+ *   @ref da_handle_print_error_message.
+ * - @ref da_status_out_of_date - the model has not been trained yet.
+ * - @ref da_status_no_data - the model was fitted to class labels rather than regression targets.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+ */
+da_status da_tree_predict_regression_d(da_handle handle, da_int n_samples,
+                                       da_int n_features, const double *X_test,
+                                       da_int ldx_test, double *y_pred);
+da_status da_tree_predict_regression_s(da_handle handle, da_int n_samples,
+                                       da_int n_features, const float *X_test,
+                                       da_int ldx_test, float *y_pred);
+/** \} */
+
+/** \{
+ * @brief Calculate the coefficient of determination @f$R^2@f$ of the predictions of a regression decision tree on a new set of data @p X_test.
+ *
+ * @rst
+ * To be used after a model has been fitted to targets passed by :ref:`da_tree_set_regression_data_? <da_tree_set_regression_data>`.
+ * The score is :math:`1 - \sum_i (y_i - \hat{y}_i)^2 / \sum_i (y_i - \bar{y})^2`, where :math:`\hat{y}_i` are the predicted targets and
+ * :math:`\bar{y}` is the mean of ``y_test``.
+ * @endrst
+ *
+ * @param[inout] handle - a @ref da_handle object, initialized with type @ref da_handle_decision_tree.
+ * @param[in] n_samples - number of observations in \p X_test.
+ * @param[in] n_features - number of features in \p X_test. It must match the number of features from
+ *                         the training data set.
+ * @param[in] X_test - array containing \p n_samples  @f$\times@f$ \p n_features data matrix, in the same storage format used to fit the model.
+ * @param[in] ldx_test - leading dimension of \p X_test. Constraint: \p ldx_test @f$\ge@f$ \p n_samples if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * @param[in] y_test - actual targets.
+ * @param[out] score - coefficient of determination of the predictions.
+ * @return da_status
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle
+ *   initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using
+ *   @ref da_handle_print_error_message.
+ * - @ref da_status_out_of_date - the model has not been trained yet.
+ * - @ref da_status_no_data - the model was fitted to class labels rather than regression targets.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+ */
+da_status da_tree_score_regression_d(da_handle handle, da_int n_samples,
+                                     da_int n_features, const double *X_test,
+                                     da_int ldx_test, const double *y_test,
+                                     double *score);
+da_status da_tree_score_regression_s(da_handle handle, da_int n_samples,
+                                     da_int n_features, const float *X_test,
+                                     da_int ldx_test, const float *y_test, float *score);
+/** \} */
+
+/** \{
+ * @brief Predict the targets of a new set of data @p X_test using a fitted regression decision forest.
+ *
+ * @rst
+ * After a model has been fitted to targets passed by :ref:`da_forest_set_regression_data_? <da_forest_set_regression_data>`, it can be used to predict
+ * the targets of new data. The prediction of each observation is the average of the predictions of all the trees of the forest.
+ * @endrst
+ *
+ * @param[inout] handle a @ref da_handle object, initialized with type @ref da_handle_decision_forest.
+ * @param[in] n_samples - number of observations in \p X_test.
+ * @param[in] n_features - number of features in \p X_test.
+ * @param[in] X_test array containing \p n_samples  @f$\times@f$ \p n_features data matrix, in the same storage format used to fit the model.
+ * @param[in] ldx_test leading dimension of \p X_test. Constraint: \p ldx_test @f$\ge@f$ \p n_samples if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * @param[out] y_pred - array of size at least \p n_samples. On output, will contain the predicted targets.
+ * @return da_status
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle
+ *   initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using
+ *   @ref da_handle_print_error_message.
+ * - @ref da_status_out_of_date - the model has not been trained yet.
+ * - @ref da_status_no_data - the model was fitted to class labels rather than regression targets.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+ */
+da_status da_forest_predict_regression_d(da_handle handle, da_int n_samples,
+                                         da_int n_features, const double *X_test,
+                                         da_int ldx_test, double *y_pred);
+da_status da_forest_predict_regression_s(da_handle handle, da_int n_samples,
+                                         da_int n_features, const float *X_test,
+                                         da_int ldx_test, float *y_pred);
+/** \} */
+
+/** \{
+ * @brief Calculate the coefficient of determination @f$R^2@f$ of the predictions of a regression decision forest on a new set of data @p X_test.
+ *
+ * @rst
+ * To be used after a model has been fitted to targets passed by :ref:`da_forest_set_regression_data_? <da_forest_set_regression_data>`.
+ * The score is :math:`1 - \sum_i (y_i - \hat{y}_i)^2 / \sum_i (y_i - \bar{y})^2`, where :math:`\hat{y}_i` are the predicted targets and
+ * :math:`\bar{y}` is the mean of ``y_test``.
+ * @endrst
+ *
+ * @param[inout] handle - a @ref da_handle object, initialized with type @ref da_handle_decision_forest.
+ * @param[in] n_samples - number of observations in \p X_test.
+ * @param[in] n_features - number of features in \p X_test. It must match the number of features from
+ *                         the training data set.
+ * @param[in] X_test - array containing \p n_samples  @f$\times@f$ \p n_features data matrix, in the same storage format used to fit the model.
+ * @param[in] ldx_test - leading dimension of \p X_test. Constraint: \p ldx_test @f$\ge@f$ \p n_samples if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * @param[in] y_test - actual targets.
+ * @param[out] score - coefficient of determination of the predictions.
+ * @return da_status
+ * - @ref da_status_success - the operation was successfully completed.
+ * - @ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle
+ *   initialization.
+ * - @ref da_status_invalid_pointer - the @p handle has not been correctly initialized.
+ * - @ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using
+ *   @ref da_handle_print_error_message.
+ * - @ref da_status_out_of_date - the model has not been trained yet.
+ * - @ref da_status_no_data - the model was fitted to class labels rather than regression targets.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+ */
+da_status da_forest_score_regression_d(da_handle handle, da_int n_samples,
+                                       da_int n_features, const double *X_test,
+                                       da_int ldx_test, const double *y_test,
+                                       double *score);
+da_status da_forest_score_regression_s(da_handle handle, da_int n_samples,
+                                       da_int n_features, const float *X_test,
+                                       da_int ldx_test, const float *y_test,
+                                       float *score);
+/** \} */
+
 #endif
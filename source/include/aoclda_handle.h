@@ -71,6 +71,12 @@ enum da_handle_type_ {
     da_handle_svm ,  ///< @rst
                      ///< the handle is to be used with functions for computing the :ref:`svm <chapter_svm>`.
                      ///< @endrst
+    da_handle_hdbscan, ///< @rst
+                       ///< the handle is to be used with functions for computing :ref:`HDBSCAN clustering <hdbscan_intro>`.
+                       ///< @endrst
+    da_handle_kernel_approx, ///< @rst
+                             ///< the handle is to be used with functions for computing :ref:`kernel approximations <kernel_approx_intro>`.
+                             ///< @endrst
 };
 // clang-format on
 
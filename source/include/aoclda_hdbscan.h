@@ -0,0 +1,153 @@
+/* ************************************************************************
+ * Copyright (c) 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef AOCLDA_HDBSCAN
+#define AOCLDA_HDBSCAN
+
+#include "aoclda_datastore.h"
+#include "aoclda_error.h"
+#include "aoclda_handle.h"
+#include "aoclda_types.h"
+
+/**
+ * \file
+ */
+
+/** \{
+ * \brief Pass a data matrix to the \ref da_handle object in preparation for HDBSCAN clustering.
+ *
+ * The data itself is not copied; a pointer to the data matrix is stored instead.
+ * @rst
+ * After calling this function you may use the option setting APIs to set :ref:`options <hdbscan_options>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_hdbscan.
+ * \param[in] n_samples the number of rows of the data matrix, \p A. Constraint: \p n_samples @f$\ge@f$ 1.
+ * \param[in] n_features the number of columns of the data matrix, \p A. Constraint: \p n_features @f$\ge@f$ 1.
+ * \param[in] A the \p n_samples @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] lda the leading dimension of the data matrix. Constraint: \p lda @f$\ge@f$ \p n_samples if \p A is stored in column-major order, or \p lda @f$\ge@f$ \p n_features if \p A is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p A is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p lda was violated.
+ */
+da_status da_hdbscan_set_data_d(da_handle handle, da_int n_samples, da_int n_features,
+                                const double *A, da_int lda);
+
+da_status da_hdbscan_set_data_s(da_handle handle, da_int n_samples, da_int n_features,
+                                const float *A, da_int lda);
+/** \} */
+
+/** \{
+ * \brief Pass a selection of a \ref da_datastore to the \ref da_handle object in preparation for HDBSCAN clustering.
+ *
+ * This is equivalent to calling \ref da_hdbscan_set_data_s "da_hdbscan_set_data_?" with the matrix that \ref da_data_extract_selection_real_s "da_data_extract_selection_real_?" would return for the selection \p key.
+ * If the selection is contiguous and stored in a single column-major block of \p store, the data is used in place and is not copied.
+ * Otherwise, it is extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_hdbscan.
+ * \param[in] store a \ref da_datastore object holding the data, which must be of the same floating point type as \p handle.
+ * \param[in] key the name of the selection of \p store to use as the data matrix. If no selection is defined in \p store, all of its data is used.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - \p key is not a valid selection of \p store, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_hdbscan_set_data_s "da_hdbscan_set_data_?".
+ */
+da_status da_hdbscan_set_data_from_store_d(da_handle handle, da_datastore store,
+                                           const char *key);
+da_status da_hdbscan_set_data_from_store_s(da_handle handle, da_datastore store,
+                                           const char *key);
+/** \} */
+
+/** \{
+ * \brief Compute HDBSCAN clustering
+ *
+ * @rst
+ * Computes HDBSCAN clustering on the data matrix previously passed into the handle using :ref:`da_hdbscan_set_data_? <da_hdbscan_set_data>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized
+ *  with type \ref da_handle_hdbscan and with data passed in via \ref da_hdbscan_set_data_s "da_hdbscan_set_data_?".
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized.
+ * - \ref da_status_no_data - \ref da_hdbscan_set_data_s "da_hdbscan_set_data_?" has not been called prior to this function call.
+ * - \ref da_status_incompatible_options - the <em>min samples</em> option is larger than \p n_samples.
+ * - \ref da_status_internal_error - this can occur if your data contains undefined values.
+ * - \ref da_status_memory_error - memory allocation failed.
+ *
+ * \post
+ * \parblock
+ * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with the following enums for floating-point output:
+ * - \p da_rinfo - return an array of size 6 containing the values of \p n_samples, \p n_features, \p lda, \p min_samples, \p min_cluster_size and \p n_clusters.
+ * - \p da_hdbscan_probabilities - return an array of size \p n_samples containing the strength, between 0 and 1, with which each sample belongs to its cluster. Noise samples have a probability of 0.
+ * - \p da_hdbscan_core_distances - return an array of size \p n_samples containing the core distance of each sample, that is the distance to its (\p min_samples - 1)-th nearest neighbor.
+ * - \p da_hdbscan_single_linkage_tree - return an array of size 4(\p n_samples - 1) containing the (\p n_samples - 1) @f$\times@f$ 4 single linkage tree of the mutual reachability graph, in column-major order. Row @f$k@f$ merges the nodes in columns 1 and 2 (samples are numbered from 0 to \p n_samples - 1 and row @f$k@f$ creates node \p n_samples + @f$k@f$) at the mutual reachability distance in column 3, into a cluster of the number of samples in column 4.
+ *
+ * In addition \ref da_handle_get_result_int can be queried with the following enums:
+ * - \p da_hdbscan_n_clusters - return the number of clusters found.
+ * - \p da_hdbscan_labels - return an array of size \p n_samples containing the label (i.e. which cluster it is in) of each sample point. A label of -1 indicates that the point has been classified as noise and has not been assigned to a cluster.
+ * \endparblock
+ */
+da_status da_hdbscan_compute_d(da_handle handle);
+
+da_status da_hdbscan_compute_s(da_handle handle);
+/** \} */
+
+/** \{
+ * \brief Extract the DBSCAN clustering for a given \p eps from a computed HDBSCAN clustering
+ *
+ * @rst
+ * Labels the samples according to the DBSCAN* clustering (DBSCAN without border points) with radius ``eps`` and the same ``min samples`` option, using the hierarchy previously computed with :ref:`da_hdbscan_compute_? <da_hdbscan_compute>`.
+ * No distances are recomputed, so that this function can be called for many values of ``eps`` at a small cost.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_hdbscan and on which \ref da_hdbscan_compute_s "da_hdbscan_compute_?" has been called.
+ * \param[in] eps the maximum distance for two samples to be considered in each other's neighborhood. Constraint: \p eps @f$\ge@f$ 0.
+ * \param[in] n_samples the size of the array \p labels. Constraint: \p n_samples must be at least the number of samples used to compute the clustering.
+ * \param[out] labels array of size \p n_samples. On output, contains the cluster label of each sample point, starting from 0 in order of first appearance. A label of -1 indicates that the point is noise, that is, it is not a core sample for this value of \p eps.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p labels is null.
+ * - \ref da_status_no_data - \ref da_hdbscan_compute_s "da_hdbscan_compute_?" has not been called prior to this function call.
+ * - \ref da_status_invalid_array_dimension - \p n_samples is too small.
+ * - \ref da_status_invalid_input - \p eps is negative.
+ */
+da_status da_hdbscan_dbscan_labels_d(da_handle handle, double eps, da_int n_samples,
+                                     da_int *labels);
+
+da_status da_hdbscan_dbscan_labels_s(da_handle handle, float eps, da_int n_samples,
+                                     da_int *labels);
+/** \} */
+
+#endif
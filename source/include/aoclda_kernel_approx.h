@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef AOCLDA_KERNEL_APPROX
+#define AOCLDA_KERNEL_APPROX
+
+#include "aoclda_datastore.h"
+#include "aoclda_error.h"
+#include "aoclda_handle.h"
+#include "aoclda_types.h"
+
+/**
+ * \file
+ */
+
+/** \{
+ * \brief Pass a data matrix to the \ref da_handle object in preparation for computing a kernel approximation.
+ *
+ * The data itself is not copied; a pointer to the data matrix is stored instead.
+ * @rst
+ * After calling this function you may use the option setting APIs to set :ref:`options <kernel_approx_options>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_kernel_approx.
+ * \param[in] n_samples the number of rows of the data matrix, \p A. Constraint: \p n_samples @f$\ge@f$ 1.
+ * \param[in] n_features the number of columns of the data matrix, \p A. Constraint: \p n_features @f$\ge@f$ 1.
+ * \param[in] A the \p n_samples @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] lda the leading dimension of the data matrix. Constraint: \p lda @f$\ge@f$ \p n_samples if \p A is stored in column-major order, or \p lda @f$\ge@f$ \p n_features if \p A is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or \p A is null.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p lda was violated.
+ */
+da_status da_kernel_approx_set_data_d(da_handle handle, da_int n_samples,
+                                      da_int n_features, const double *A, da_int lda);
+
+da_status da_kernel_approx_set_data_s(da_handle handle, da_int n_samples,
+                                      da_int n_features, const float *A, da_int lda);
+/** \} */
+
+/** \{
+ * \brief Pass a selection of a \ref da_datastore to the \ref da_handle object in preparation for computing a kernel approximation.
+ *
+ * This is equivalent to calling \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?" with the matrix that \ref da_data_extract_selection_real_s "da_data_extract_selection_real_?" would return for the selection \p key.
+ * If the selection is contiguous and stored in a single column-major block of \p store, the data is used in place and is not copied.
+ * Otherwise, it is extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_kernel_approx.
+ * \param[in] store a \ref da_datastore object holding the data, which must be of the same floating point type as \p handle.
+ * \param[in] key the name of the selection of \p store to use as the data matrix. If no selection is defined in \p store, all of its data is used.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - \p key is not a valid selection of \p store, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?".
+ */
+da_status da_kernel_approx_set_data_from_store_d(da_handle handle, da_datastore store,
+                                                 const char *key);
+da_status da_kernel_approx_set_data_from_store_s(da_handle handle, da_datastore store,
+                                                 const char *key);
+/** \} */
+
+/** \{
+ * \brief Compute a kernel approximation
+ *
+ * @rst
+ * Computes an explicit feature map approximating the kernel selected with the :ref:`options <kernel_approx_options>`, using either the Nyström method or random Fourier features, from the data matrix previously passed into the handle using :ref:`da_kernel_approx_set_data_? <da_kernel_approx_set_data>`.
+ * The data can then be mapped to the new feature space with :ref:`da_kernel_approx_transform_? <da_kernel_approx_transform>`.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized
+ *  with type \ref da_handle_kernel_approx and with data passed in via \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?".
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized.
+ * - \ref da_status_no_data - \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?" has not been called prior to this function call.
+ * - \ref da_status_incompatible_options - random Fourier features were requested for a kernel other than <em>rbf</em>, or the <em>n components</em> option is larger than \p n_samples with the Nyström method.
+ * - \ref da_status_invalid_input - the <em>gamma</em> option is negative and the variance of the data is zero.
+ * - \ref da_status_internal_error - this can occur if your data contains undefined values.
+ * - \ref da_status_memory_error - memory allocation failed.
+ *
+ * \post
+ * \parblock
+ * After successful execution, \ref da_handle_get_result_s "da_handle_get_result_?" can be queried with the following enums for floating-point output:
+ * - \p da_rinfo - return an array of size 5 containing the values of \p n_samples, \p n_features, \p n_components, the value of \p gamma used and the rank of the feature map, that is the number of eigenvalues of the landmark kernel matrix kept in the Nyström normalization (\p n_components for random Fourier features).
+ * - \p da_kernel_approx_components - return an array of size \p n_components @f$\times@f$ \p n_features containing the landmarks (Nyström) or the random frequencies (random Fourier features), in the same storage order as the input data.
+ * - \p da_kernel_approx_normalization - return an array of size \p n_components @f$\times@f$ \p n_components containing the symmetric matrix @f$K_{mm}^{-1/2}@f$, where @f$K_{mm}@f$ is the kernel matrix of the landmarks (Nyström only).
+ * - \p da_kernel_approx_offsets - return an array of size \p n_components containing the random offsets (random Fourier features only).
+ *
+ * In addition \ref da_handle_get_result_int can be queried with the following enum:
+ * - \p da_kernel_approx_landmarks - return an array of size \p n_components containing the indices of the landmarks in the data matrix (Nyström only).
+ * \endparblock
+ */
+da_status da_kernel_approx_compute_d(da_handle handle);
+
+da_status da_kernel_approx_compute_s(da_handle handle);
+/** \} */
+
+/** \{
+ * \brief Map a data matrix to the approximate kernel feature space
+ *
+ * Transforms a data matrix \p X into the \p n_components features computed in \ref da_kernel_approx_compute_s "da_kernel_approx_compute_?", whose inner products approximate the kernel between the rows of \p X.
+ * Linear models trained on the transformed data then approximate the corresponding kernel methods.
+ *
+ * \param[inout] handle a \ref da_handle object, with a kernel approximation previously computed via \ref da_kernel_approx_compute_s "da_kernel_approx_compute_?".
+ * \param[in] m_samples the number of rows of the data matrix, \p X. Constraint: \p m_samples @f$\ge@f$ 1.
+ * \param[in] m_features the number of columns of the data matrix, \p X. Constraint: \p m_features @f$=@f$ \p n_features, the number of features in the data matrix originally supplied to \ref da_kernel_approx_set_data_s "da_kernel_approx_set_data_?".
+ * \param[in] X the \p m_samples @f$\times@f$ \p m_features data matrix, in the same storage format used to compute the approximation.
+ * \param[in] ldx the leading dimension of the data matrix. Constraint: \p ldx @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx @f$\ge@f$ \p m_features if \p X is stored in row-major order.
+ * \param[out] X_transform an array of size at least \p m_samples @f$\times@f$ \p n_components, in which the transformed data will be stored (in the same storage format used to compute the approximation).
+ * \param[in] ldx_transform the leading dimension of \p X_transform.  Constraint: \p ldx_transform @f$\ge@f$ \p m_samples if \p X is stored in column-major order, or \p ldx_transform @f$\ge@f$ \p n_components if \p X is stored in row-major order.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized using the wrong precision.
+ * - \ref da_status_invalid_pointer - the handle has not been initialized, or one of the arrays is null.
+ * - \ref da_status_no_data - the kernel approximation has not been computed prior to this function call.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_invalid_leading_dimension - one of the constraints on \p ldx or \p ldx_transform was violated.
+ * - \ref da_status_memory_error - memory allocation failed.
+ */
+da_status da_kernel_approx_transform_d(da_handle handle, da_int m_samples,
+                                       da_int m_features, const double *X, da_int ldx,
+                                       double *X_transform, da_int ldx_transform);
+
+da_status da_kernel_approx_transform_s(da_handle handle, da_int m_samples,
+                                       da_int m_features, const float *X, da_int ldx,
+                                       float *X_transform, da_int ldx_transform);
+/** \} */
+
+#endif
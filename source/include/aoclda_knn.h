@@ -28,6 +28,7 @@
 #ifndef AOCLDA_kNN
 #define AOCLDA_kNN
 
+#include "aoclda_datastore.h"
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
 #include "aoclda_types.h"
@@ -43,7 +44,8 @@ extern "C" {
  * \brief Defines which algorithm is used to compute the <i>k</i>-nearest neighbors.
  **/
 enum da_knn_algorithm_ {
-    da_brute_force ///< Use Brute Force.
+    da_brute_force, ///< Use Brute Force.
+    da_hnsw ///< Use a hierarchical navigable small world graph to compute approximate nearest neighbors.
 };
 
 /** @brief Alias for the \ref da_knn_algorithm_ enum. */
@@ -91,6 +93,82 @@ da_status da_knn_set_training_data_s(da_handle handle, da_int n_samples,
                                      da_int ldx_train, const da_int *y_train);
 /** \} */
 
+/** \{
+ * \brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for computing a <i>k</i>-NN.
+ *
+ * This is equivalent to calling \ref da_knn_set_training_data_s "da_knn_set_training_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * Each selection that is contiguous and stored in a single column-major block of \p store is used in place and is not copied.
+ * The other ones are extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] store a \ref da_datastore object holding the data.
+ * \param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * \param[in] key_y the name of the selection of \p store containing the labels. It must contain a single integer column with the same number of rows as \p key_X.
+ * \return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - the selections are not valid or have incompatible types or dimensions, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_knn_set_training_data_s "da_knn_set_training_data_?".
+ */
+da_status da_knn_set_training_data_from_store_d(da_handle handle, da_datastore store,
+                                                const char *key_X, const char *key_y);
+da_status da_knn_set_training_data_from_store_s(da_handle handle, da_datastore store,
+                                                const char *key_X, const char *key_y);
+/** \} */
+
+/** \{
+ * \brief Pass a data matrix and an array of real targets to the \ref da_handle object
+ * in preparation for <i>k</i>-NN regression.
+ *
+ * The data itself is not copied; pointers to the data matrix and the targets are stored instead.
+ * The handle can then be used to compute neighbors and to predict targets with \ref da_knn_predict_regression_s "da_knn_predict_regression_?"
+ * or \ref da_knn_radius_predict_regression_s "da_knn_radius_predict_regression_?". The classification APIs require the labels passed by
+ * \ref da_knn_set_training_data_s "da_knn_set_training_data_?" instead.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] n_samples number of observations in \p X_train.
+ * \param[in] n_features number of features in \p X_train.
+ * \param[in] X_train array containing \p n_samples  @f$\times@f$ \p n_features data matrix. By default, it should be stored in column-major order, unless you have set the <em>storage order</em> option to <em>row-major</em>.
+ * \param[in] ldx_train leading dimension of \p X_train. Constraint: \p ldx_train @f$\ge@f$ \p n_samples if \p X_train is stored in column-major order, or \p ldx_train @f$\ge@f$ \p n_features if \p X_train is stored in row-major order.
+ * \param[in] y_train array containing the \p n_samples targets.
+ * \return \ref da_status.  The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - \ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p X_train or \p y_train are invalid.
+ * - \ref da_status_invalid_input - one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message.
+ * - \ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_train was violated.
+*/
+da_status da_knn_set_regression_data_d(da_handle handle, da_int n_samples,
+                                       da_int n_features, const double *X_train,
+                                       da_int ldx_train, const double *y_train);
+da_status da_knn_set_regression_data_s(da_handle handle, da_int n_samples,
+                                       da_int n_features, const float *X_train,
+                                       da_int ldx_train, const float *y_train);
+/** \} */
+
+/** \{
+ * \brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for <i>k</i>-NN regression.
+ *
+ * This is equivalent to calling \ref da_knn_set_regression_data_s "da_knn_set_regression_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * As in \ref da_knn_set_training_data_from_store_s "da_knn_set_training_data_from_store_?", contiguous column-major selections are used in place, so \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] store a \ref da_datastore object holding the data.
+ * \param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * \param[in] key_y the name of the selection of \p store containing the targets. It must contain a single column of the same floating point type as \p handle, with the same number of rows as \p key_X.
+ * \return \ref da_status. The function returns the same statuses as \ref da_knn_set_training_data_from_store_s "da_knn_set_training_data_from_store_?".
+ */
+da_status da_knn_set_regression_data_from_store_d(da_handle handle, da_datastore store,
+                                                  const char *key_X, const char *key_y);
+da_status da_knn_set_regression_data_from_store_s(da_handle handle, da_datastore store,
+                                                  const char *key_X, const char *key_y);
+/** \} */
+
 /** \{
  * \brief Compute <i>k</i>-Nearest Neighbors (<i>k</i>-NN)
  *
@@ -202,6 +280,131 @@ da_status da_knn_predict_s(da_handle handle, da_int n_queries, da_int n_features
                            const float *X_test, da_int ldx_test, da_int *y_test);
 /** \} */
 
+/** \{
+ * \brief Compute estimated targets of a data set using <i>k</i>-Nearest Neighbors regression
+ *
+ * @rst
+ * Compute the estimated targets of the test data :math:`X_{test}` as the average of the targets of their *k*-NN in the data matrix
+ * previously passed into the handle using :ref:`da_knn_set_regression_data_? <da_knn_set_regression_data>`. The average is weighted according to the ``weights`` option.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] n_queries number of observations in \p X_test.
+ * \param[in] n_features number of features in \p X_test. Constraint: \p n_features @f$=@f$ the number of features in the training data matrix.
+ * \param[in] X_test array containing \p n_queries  @f$\times@f$ \p n_features data matrix, in the same storage format used to set the training data.
+ * \param[in] ldx_test leading dimension of \p X_test.  Constraint: \p ldx_test @f$\ge@f$ \p n_queries if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * \param[out] y_test array of size \p n_queries containing the estimated target of each query.
+ * \return \ref da_status.  The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - \ref da_status_no_data - no training data with regression targets has been passed to the @p handle.
+ * - \ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p X_test or \p y_test is invalid.
+ * - \ref da_status_invalid_array_dimension - \p n_queries or \p n_features has an invalid value.
+ * - \ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+*/
+da_status da_knn_predict_regression_d(da_handle handle, da_int n_queries,
+                                      da_int n_features, const double *X_test,
+                                      da_int ldx_test, double *y_test);
+da_status da_knn_predict_regression_s(da_handle handle, da_int n_queries,
+                                      da_int n_features, const float *X_test,
+                                      da_int ldx_test, float *y_test);
+/** \} */
+
+/** \{
+ * \brief Compute the radius neighbors of a data set
+ *
+ * @rst
+ * For each point of a test data :math:`X_{test}`, compute the points of the data matrix previously passed into the handle which are within a given radius, using the ``metric`` option.
+ * Since the number of neighbors differs between the queries, the results are stored in the handle in compressed sparse row format, and can be retrieved using :ref:`da_handle_get_result_? <da_handle_get_result>` with
+ * the queries ``da_knn_radius_neighbors_offsets``, ``da_knn_radius_neighbors_indices`` and ``da_knn_radius_neighbors_distances``.
+ * The neighbors of query :math:`i` are stored in positions :math:`offsets[i]` to :math:`offsets[i+1]-1` of the indices and distances arrays, sorted by increasing distance.
+ * The radius neighbors are always computed by brute force, whatever the ``algorithm`` option.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] n_queries number of observations in \p X_test.
+ * \param[in] n_features number of features in \p X_test. Constraint: \p n_features @f$=@f$ the number of features in the training data matrix.
+ * \param[in] X_test array containing \p n_queries  @f$\times@f$ \p n_features data matrix, in the same storage format used to set the training data.
+ * \param[in] ldx_test leading dimension of \p X_test.  Constraint: \p ldx_test @f$\ge@f$ \p n_queries if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * \param[in] radius the radius of the neighborhoods. If \p radius @f$\le@f$ 0, the value of the <em>radius</em> option is used instead.
+ * \return \ref da_status.  The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - \ref da_status_no_data - no training data has been passed to the @p handle.
+ * - \ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p X_test is invalid.
+ * - \ref da_status_invalid_array_dimension - \p n_queries or \p n_features has an invalid value.
+ * - \ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+*/
+da_status da_knn_radius_neighbors_d(da_handle handle, da_int n_queries, da_int n_features,
+                                    const double *X_test, da_int ldx_test, double radius);
+da_status da_knn_radius_neighbors_s(da_handle handle, da_int n_queries, da_int n_features,
+                                    const float *X_test, da_int ldx_test, float radius);
+/** \} */
+
+/** \{
+ * \brief Compute estimated labels of a data set using radius neighbors classification
+ *
+ * @rst
+ * Compute the estimated labels of the test data :math:`X_{test}` from the votes of the points of the data matrix previously passed into the handle using
+ * :ref:`da_knn_set_training_data_? <da_knn_set_training_data>` which are within the distance given by the ``radius`` option. The votes are weighted according to the ``weights`` option.
+ * In case of a tie, the first class label is returned. The queries with no training point within the radius are labeled with the ``outlier label`` option.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] n_queries number of observations in \p X_test.
+ * \param[in] n_features number of features in \p X_test. Constraint: \p n_features @f$=@f$ the number of features in the training data matrix.
+ * \param[in] X_test array containing \p n_queries  @f$\times@f$ \p n_features data matrix, in the same storage format used to set the training data.
+ * \param[in] ldx_test leading dimension of \p X_test.  Constraint: \p ldx_test @f$\ge@f$ \p n_queries if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * \param[out] y_test array of size \p n_queries containing the estimated label for each query.
+ * \return \ref da_status.  The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - \ref da_status_no_data - no training data with class labels has been passed to the @p handle.
+ * - \ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p X_test or \p y_test is invalid.
+ * - \ref da_status_invalid_array_dimension - \p n_queries or \p n_features has an invalid value.
+ * - \ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+*/
+da_status da_knn_radius_predict_d(da_handle handle, da_int n_queries, da_int n_features,
+                                  const double *X_test, da_int ldx_test, da_int *y_test);
+da_status da_knn_radius_predict_s(da_handle handle, da_int n_queries, da_int n_features,
+                                  const float *X_test, da_int ldx_test, da_int *y_test);
+/** \} */
+
+/** \{
+ * \brief Compute estimated targets of a data set using radius neighbors regression
+ *
+ * @rst
+ * Compute the estimated targets of the test data :math:`X_{test}` as the average of the targets of the points of the data matrix previously passed into the handle using
+ * :ref:`da_knn_set_regression_data_? <da_knn_set_regression_data>` which are within the distance given by the ``radius`` option. The average is weighted according to the ``weights`` option.
+ * The queries with no training point within the radius get a NaN target.
+ * @endrst
+ *
+ * \param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_knn.
+ * \param[in] n_queries number of observations in \p X_test.
+ * \param[in] n_features number of features in \p X_test. Constraint: \p n_features @f$=@f$ the number of features in the training data matrix.
+ * \param[in] X_test array containing \p n_queries  @f$\times@f$ \p n_features data matrix, in the same storage format used to set the training data.
+ * \param[in] ldx_test leading dimension of \p X_test.  Constraint: \p ldx_test @f$\ge@f$ \p n_queries if \p X_test is stored in column-major order, or \p ldx_test @f$\ge@f$ \p n_features if \p X_test is stored in row-major order.
+ * \param[out] y_test array of size \p n_queries containing the estimated target of each query.
+ * \return \ref da_status.  The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the floating point precision of the arguments is incompatible with the @p handle initialization.
+ * - \ref da_status_no_data - no training data with regression targets has been passed to the @p handle.
+ * - \ref da_status_invalid_pointer - the @p handle has not been correctly initialized, or \p X_test or \p y_test is invalid.
+ * - \ref da_status_invalid_array_dimension - \p n_queries or \p n_features has an invalid value.
+ * - \ref da_status_memory_error - internal memory allocation encountered a problem.
+ * - \ref da_status_invalid_leading_dimension - the constraint on \p ldx_test was violated.
+*/
+da_status da_knn_radius_predict_regression_d(da_handle handle, da_int n_queries,
+                                             da_int n_features, const double *X_test,
+                                             da_int ldx_test, double *y_test);
+da_status da_knn_radius_predict_regression_s(da_handle handle, da_int n_queries,
+                                             da_int n_features, const float *X_test,
+                                             da_int ldx_test, float *y_test);
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
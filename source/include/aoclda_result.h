@@ -67,9 +67,17 @@ enum da_result_ {
     da_dbscan_n_clusters,     ///< The number of clusters found in DBSCAN clustering.
     da_dbscan_n_core_samples, ///< The number of core samples found in DBSCAN clustering.
     da_dbscan_core_sample_indices, ///< Indices of core samples in the data matrix used to compute DBSCAN clustering.
+    da_hdbscan_labels, ///< Labels of samples in the data matrix used to compute HDBSCAN clustering.
+    da_hdbscan_n_clusters, ///< The number of clusters found in HDBSCAN clustering.
+    da_hdbscan_probabilities, ///< Strength of the membership of each sample to its HDBSCAN cluster.
+    da_hdbscan_core_distances, ///< Core distance of each sample, used to compute HDBSCAN clustering.
+    da_hdbscan_single_linkage_tree, ///< Single linkage tree of the mutual reachability graph computed in HDBSCAN clustering.
     // KNN 601..700
     da_knn_model_params =
         601, ///< Model parameters for the trained and fitted k-nearest neighbors.
+    da_knn_radius_neighbors_offsets, ///< Offsets of the neighbors of each query in the compressed sparse row arrays of radius neighbors: the neighbors of query @f$i@f$ are stored in positions @f$offsets[i]@f$ to @f$offsets[i+1]-1@f$.
+    da_knn_radius_neighbors_indices, ///< Indices of the training points within the radius of each query, sorted by increasing distance.
+    da_knn_radius_neighbors_distances, ///< Distances between each query and the training points in \ref da_knn_radius_neighbors_indices.
     // SVM 701..800
     da_svm_n_support_vectors = 701,     ///< Overall number of support vectors
     da_svm_n_support_vectors_per_class, ///< Number of support vectors per each class
@@ -78,6 +86,12 @@ enum da_result_ {
     da_svm_support_vectors, ///< Support vectors
     da_svm_bias,            ///< Constant in decision function
     da_svm_dual_coef, ///< Weights assigned to each support vector, reflecting their importance in defining the optimal decision boundary.
+    // Kernel approximation 801..900
+    da_kernel_approx_components =
+        801, ///< Landmarks (Nyström) or random frequencies (random Fourier features) defining a kernel approximation.
+    da_kernel_approx_normalization, ///< Inverse square root of the kernel matrix of the landmarks of a Nyström kernel approximation.
+    da_kernel_approx_offsets, ///< Random offsets of a random Fourier features kernel approximation.
+    da_kernel_approx_landmarks, ///< Indices of the landmarks of a Nyström kernel approximation in the data matrix.
     // ...
 };
 
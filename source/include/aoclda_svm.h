@@ -32,6 +32,7 @@
  * \file
  */
 
+#include "aoclda_datastore.h"
 #include "aoclda_error.h"
 #include "aoclda_handle.h"
 #include "aoclda_types.h"
@@ -101,6 +102,33 @@ da_status da_svm_set_data_s(da_handle handle, da_int n_samples, da_int n_feature
                             const float *X, da_int ldx, const float *y);
 /** \} */
 
+/** \{
+ * @brief Pass selections of a \ref da_datastore to the \ref da_handle object in preparation for training an SVM model.
+ *
+ * This is equivalent to calling \ref da_svm_set_data_s "da_svm_set_data_?" with the matrices that \ref da_data_extract_selection_real_s "da_data_extract_selection_?" would return for the selections \p key_X and \p key_y.
+ * Each selection that is contiguous and stored in a single column-major block of \p store is used in place and is not copied.
+ * The other ones are extracted once into memory owned by \p handle.
+ * In both cases, \p store must not be modified or destroyed while \p handle uses the data.
+ *
+ * @param[inout] handle a \ref da_handle object, initialized with type \ref da_handle_svm.
+ * @param[in] store a \ref da_datastore object holding the data.
+ * @param[in] key_X the name of the selection of \p store to use as the data matrix. Its columns must be of the same floating point type as \p handle.
+ * @param[in] key_y the name of the selection of \p store containing the responses. It must contain a single column of the same floating point type as \p handle, with the same number of rows as \p key_X.
+ * @return \ref da_status. The function returns:
+ * - \ref da_status_success - the operation was successfully completed.
+ * - \ref da_status_wrong_type - the handle may have been initialized with the wrong precision.
+ * - \ref da_status_store_not_initialized - \p store has not been initialized.
+ * - \ref da_status_invalid_input - the selections are not valid or have incompatible types or dimensions, or one of the arguments had an invalid value. You can obtain further information using \ref da_handle_print_error_message and \ref da_datastore_print_error_message.
+ * - \ref da_status_missing_block - \p store contains incomplete row blocks.
+ * - \ref da_status_memory_error - memory allocation failed.
+ * - the other statuses returned by \ref da_svm_set_data_s "da_svm_set_data_?".
+ */
+da_status da_svm_set_data_from_store_d(da_handle handle, da_datastore store,
+                                       const char *key_X, const char *key_y);
+da_status da_svm_set_data_from_store_s(da_handle handle, da_datastore store,
+                                       const char *key_X, const char *key_y);
+/** \} */
+
 /** \{
  * @brief Fit the SVM model defined in the @p handle.
  *
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include <iostream>
+
+/*
+ * Basic HDBSCAN example
+ *
+ * This example computes HDBSCAN clustering for a small data matrix, then extracts the
+ * DBSCAN clusterings for several values of eps from the same computation.
+ */
+
+int main() {
+
+    // Initialize the handle
+    da_handle handle = nullptr;
+
+    std::cout << "-----------------------------------------------------------------------"
+              << std::endl;
+    std::cout << "Basic HDBSCAN" << std::endl;
+    std::cout << "HDBSCAN clustering for a small data matrix" << std::endl << std::endl;
+    std::cout << std::fixed;
+    std::cout.precision(5);
+
+    int exit_code = 0;
+    bool pass = true;
+
+    // Input data: two groups of 5 points and an outlier
+    double A[22] = {0.0, 0.1, -0.1, 0.2, 0.0,  5.0, 5.1,  4.9, 5.2, 5.0, 20.0,
+                    0.0, 0.1, 0.1,  0.0, -0.2, 5.0, 4.9,  5.1, 5.0, 5.2, 20.0};
+
+    da_int n_samples = 11, n_features = 2, lda = 11, min_samples = 3,
+           min_cluster_size = 3;
+
+    // Create the handle and pass it the data matrix
+    pass = pass && (da_handle_init_d(&handle, da_handle_hdbscan) == da_status_success);
+    pass = pass && (da_hdbscan_set_data_d(handle, n_samples, n_features, A, lda) ==
+                    da_status_success);
+
+    // Set options
+    pass = pass &&
+           (da_options_set_int(handle, "min samples", min_samples) == da_status_success);
+    pass = pass && (da_options_set_int(handle, "min cluster size", min_cluster_size) ==
+                    da_status_success);
+
+    // Compute the clusters
+    pass = pass && (da_hdbscan_compute_d(handle) == da_status_success);
+
+    // Extract results from the handle
+    da_int n_clusters = 0, dim = 1;
+
+    pass = pass && (da_handle_get_result_int(handle, da_hdbscan_n_clusters, &dim,
+                                             &n_clusters) == da_status_success);
+
+    da_int *labels = new da_int[n_samples];
+    double *probabilities = new double[n_samples];
+
+    pass = pass && (da_handle_get_result_int(handle, da_hdbscan_labels, &n_samples,
+                                             labels) == da_status_success);
+    pass = pass && (da_handle_get_result_d(handle, da_hdbscan_probabilities, &n_samples,
+                                           probabilities) == da_status_success);
+
+    // Check status (we could do this after every function call)
+    if (pass) {
+        std::cout << "HDBSCAN clustering computed successfully" << std::endl << std::endl;
+
+        std::cout << "Number of clusters: " << n_clusters << std::endl;
+        std::cout << "Labels:" << std::endl;
+        for (da_int i = 0; i < n_samples; i++) {
+            std::cout << labels[i] << "  ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "Probabilities:" << std::endl;
+        for (da_int i = 0; i < n_samples; i++) {
+            std::cout << probabilities[i] << "  ";
+        }
+        std::cout << std::endl;
+
+        // Check against expected results: the two groups are clusters, the outlier is noise
+        bool incorrect_results = n_clusters != 2 || labels[0] < 0 || labels[5] < 0 ||
+                                 labels[0] == labels[5] || labels[10] != -1;
+        for (da_int i = 1; i < 5; i++) {
+            if (labels[i] != labels[0] || labels[i + 5] != labels[5]) {
+                incorrect_results = true;
+                break;
+            }
+        }
+
+        // DBSCAN clusterings for several values of eps, without recomputing distances
+        double eps[3] = {0.1, 1.0, 10.0};
+        for (da_int k = 0; k < 3; k++) {
+            pass = pass && (da_hdbscan_dbscan_labels_d(handle, eps[k], n_samples,
+                                                       labels) == da_status_success);
+            std::cout << "DBSCAN labels for eps = " << eps[k] << ":" << std::endl;
+            for (da_int i = 0; i < n_samples; i++) {
+                std::cout << labels[i] << "  ";
+            }
+            std::cout << std::endl;
+        }
+        // For eps = 10, the two groups are merged
+        for (da_int i = 0; i < 10; i++) {
+            if (labels[i] != 0)
+                incorrect_results = true;
+        }
+        if (!pass || labels[10] != -1)
+            incorrect_results = true;
+
+        if (incorrect_results) {
+            std::cout << "The expected solution was not obtained." << std::endl;
+            exit_code = 1;
+        }
+    } else {
+        exit_code = 1;
+    }
+
+    // Clean up
+    da_handle_destroy(&handle);
+    delete[] labels;
+    delete[] probabilities;
+
+    std::cout << "-----------------------------------------------------------------------"
+              << std::endl;
+
+    return exit_code;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "aoclda.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/*
+ * Kernel approximation example
+ *
+ * This example fits a nonlinear function of two variables with a linear regression,
+ * first on the original features and then on Nystroem features approximating the rbf
+ * kernel, which turns the linear model into an approximate kernel ridge regression.
+ */
+
+/* Fit a regularized linear model of y on the n_samples x n_features matrix X and return
+   its mean squared error on the training data, or -1 if the fit failed */
+double fit_linear_model(da_int n_samples, da_int n_features, std::vector<double> &X,
+                        std::vector<double> &y) {
+    da_handle handle = nullptr;
+    std::vector<double> predictions(n_samples);
+    bool pass = true;
+    pass = pass && da_handle_init_d(&handle, da_handle_linmod) == da_status_success;
+    pass = pass &&
+           da_linmod_select_model_d(handle, linmod_model_mse) == da_status_success;
+    pass = pass && da_options_set_int(handle, "intercept", 1) == da_status_success;
+    pass = pass && da_options_set_real_d(handle, "lambda", 1.0e-6) == da_status_success;
+    pass = pass && da_linmod_define_features_d(handle, n_samples, n_features, X.data(),
+                                               y.data()) == da_status_success;
+    pass = pass && da_linmod_fit_d(handle) == da_status_success;
+    pass = pass && da_linmod_evaluate_model_d(handle, n_samples, n_features, X.data(),
+                                              predictions.data(), nullptr,
+                                              nullptr) == da_status_success;
+    da_handle_destroy(&handle);
+    if (!pass)
+        return -1;
+    double mse = 0;
+    for (da_int i = 0; i < n_samples; i++)
+        mse += (predictions[i] - y[i]) * (predictions[i] - y[i]);
+    return mse / n_samples;
+}
+
+int main() {
+
+    std::cout << "-----------------------------------------------------------------------"
+              << std::endl;
+    std::cout << "Kernel approximation" << std::endl;
+    std::cout << "Linear regression on Nystroem features" << std::endl << std::endl;
+    std::cout << std::fixed;
+    std::cout.precision(5);
+
+    // Samples on a 20 x 20 grid of [-2, 2]^2, with responses y = sin(x1) cos(x2)
+    da_int n_grid = 20, n_samples = n_grid * n_grid, n_features = 2, n_components = 100;
+    std::vector<double> A(n_samples * n_features), y(n_samples);
+    for (da_int i = 0; i < n_grid; i++) {
+        for (da_int j = 0; j < n_grid; j++) {
+            double x1 = -2.0 + 4.0 * i / (n_grid - 1), x2 = -2.0 + 4.0 * j / (n_grid - 1);
+            A[i * n_grid + j] = x1;
+            A[i * n_grid + j + n_samples] = x2;
+            y[i * n_grid + j] = std::sin(x1) * std::cos(x2);
+        }
+    }
+
+    double mse_linear = fit_linear_model(n_samples, n_features, A, y);
+
+    // Compute the Nystroem approximation of the rbf kernel and transform the data
+    da_handle handle = nullptr;
+    std::vector<double> Z(n_samples * n_components);
+    bool pass = true;
+    pass = pass &&
+           da_handle_init_d(&handle, da_handle_kernel_approx) == da_status_success;
+    pass = pass && da_options_set_string(handle, "approximation method", "nystroem") ==
+                       da_status_success;
+    pass = pass && da_options_set_string(handle, "kernel", "rbf") == da_status_success;
+    pass = pass && da_options_set_real_d(handle, "gamma", 1.0) == da_status_success;
+    pass = pass &&
+           da_options_set_int(handle, "n components", n_components) == da_status_success;
+    pass = pass && da_kernel_approx_set_data_d(handle, n_samples, n_features, A.data(),
+                                               n_samples) == da_status_success;
+    pass = pass && da_kernel_approx_compute_d(handle) == da_status_success;
+    pass = pass && da_kernel_approx_transform_d(handle, n_samples, n_features, A.data(),
+                                                n_samples, Z.data(),
+                                                n_samples) == da_status_success;
+    da_handle_destroy(&handle);
+    if (!pass) {
+        std::cout << "Something unexpected happened in the kernel approximation\n";
+        return 1;
+    }
+
+    double mse_kernel = fit_linear_model(n_samples, n_components, Z, y);
+    if (mse_linear < 0 || mse_kernel < 0) {
+        std::cout << "Something unexpected happened in the linear regression\n";
+        return 1;
+    }
+
+    std::cout << "Mean squared error of the linear model on the original features: "
+              << mse_linear << std::endl;
+    std::cout << "Mean squared error of the linear model on " << n_components
+              << " Nystroem features: " << mse_kernel << std::endl;
+
+    std::cout << "-----------------------------------------------------------------------"
+              << std::endl;
+
+    return mse_kernel < 0.01 * mse_linear ? 0 : 1;
+}
@@ -107,4 +107,21 @@ TYPED_TEST(da_vector_internal_test, append_std_vec) {
     for (da_int i = 0; i < size_vec1 + size_vec3; i++) {
         EXPECT_EQ(vec1[i], (TypeParam)i);
     }
-}
\ No newline at end of file
+}
+
+TYPED_TEST(da_vector_internal_test, clear) {
+    da_vector::da_vector<TypeParam> vec;
+    da_int test_size = 123;
+    for (da_int i = 0; i < test_size; i++) {
+        vec.push_back((TypeParam)i);
+    }
+    size_t capacity = vec.capacity();
+
+    vec.clear();
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.capacity(), capacity);
+
+    vec.push_back((TypeParam)7);
+    EXPECT_EQ(vec.size(), 1);
+    EXPECT_EQ(vec[0], (TypeParam)7);
+}
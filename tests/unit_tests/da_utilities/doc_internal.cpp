@@ -51,11 +51,13 @@ const static std::map<da_handle_type, std::string> htypes{
     {da_handle_linmod, "Linear Models"},
     {da_handle_kmeans, "k-means Clustering"},
     {da_handle_dbscan, "DBSCAN clustering"},
+    {da_handle_hdbscan, "HDBSCAN clustering"},
     {da_handle_decision_tree, "Decision Trees"},
     {da_handle_decision_forest, "Decision Forests"},
     {da_handle_knn, "k-Nearest Neighbors"},
     {da_handle_nlls, "Nonlinear Least Squares"},
     {da_handle_svm, "Support Vector Machines"},
+    {da_handle_kernel_approx, "Kernel Approximation"},
 };
 
 void options_print(da_handle_type htype) {
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "da_vmath.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <limits>
+#include <list>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+template <typename T> class vmath_internal_test : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(vmath_internal_test, Types);
+
+/* Distance between computed and the exact value ref, in units of the last place of the
+ * correctly rounded result
+ */
+template <typename T> long double ulp_error(T computed, long double ref) {
+    T rounded = (T)ref;
+    T ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<T>::infinity()) -
+            std::fabs(rounded);
+    ulp = std::max(ulp, std::numeric_limits<T>::denorm_min());
+    return std::fabs((long double)computed - ref) / (long double)ulp;
+}
+
+/* Evaluate f on n_points random points of [lo, hi], and return the largest error in ulp
+ * compared with the long double function f_ref
+ */
+template <typename T, class F, class F_ref>
+long double max_ulp_error(T lo, T hi, F f, F_ref f_ref, da_int n_points = 100000) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<T> d(lo, hi);
+    std::vector<T> x(n_points), y(n_points);
+    for (auto &v : x)
+        v = d(gen);
+    y = x;
+    f(n_points, y.data());
+    long double max_err = 0;
+    for (da_int i = 0; i < n_points; i++) {
+        long double ref = f_ref((long double)x[i]);
+        // Results out of the range of T must be exact
+        if (std::isinf((T)ref) || (T)ref == 0)
+            max_err = std::max(max_err, y[i] == (T)ref ? 0.0L : (long double)INFINITY);
+        else
+            max_err = std::max(max_err, ulp_error(y[i], ref));
+    }
+    return max_err;
+}
+
+// Single precision is evaluated in double precision and rounded once
+template <typename T> long double max_ulp(long double max_ulp_double) {
+    return std::is_same_v<T, float> ? 1.0L : max_ulp_double;
+}
+
+TYPED_TEST(vmath_internal_test, exp_accuracy) {
+    auto f = [](da_int n, TypeParam *y) {
+        TEST_ARCH::da_vmath::scaled_exp(n, (TypeParam)1, y);
+    };
+    auto f_ref = [](long double x) { return std::exp(x); };
+    long double tol = max_ulp<TypeParam>(2.0L);
+    // The whole range of T, including overflow and subnormal results
+    TypeParam x_max = std::log(std::numeric_limits<TypeParam>::max());
+    TypeParam x_min = std::log(std::numeric_limits<TypeParam>::denorm_min());
+    EXPECT_LE(max_ulp_error(x_min - 1, x_max + 1, f, f_ref), tol);
+    EXPECT_LE(max_ulp_error((TypeParam)-1, (TypeParam)1, f, f_ref), tol);
+    EXPECT_LE(max_ulp_error((TypeParam)-1e-3, (TypeParam)1e-3, f, f_ref), tol);
+}
+
+TYPED_TEST(vmath_internal_test, tanh_accuracy) {
+    auto f = [](da_int n, TypeParam *y) {
+        TEST_ARCH::da_vmath::shifted_tanh(n, (TypeParam)0, y);
+    };
+    auto f_ref = [](long double x) { return std::tanh(x); };
+    long double tol = max_ulp<TypeParam>(3.0L);
+    EXPECT_LE(max_ulp_error((TypeParam)-30, (TypeParam)30, f, f_ref), tol);
+    EXPECT_LE(max_ulp_error((TypeParam)-1, (TypeParam)1, f, f_ref), tol);
+    EXPECT_LE(max_ulp_error((TypeParam)-1e-3, (TypeParam)1e-3, f, f_ref), tol);
+}
+
+TYPED_TEST(vmath_internal_test, special_values) {
+    TypeParam inf = std::numeric_limits<TypeParam>::infinity();
+    TypeParam nan = std::numeric_limits<TypeParam>::quiet_NaN();
+    std::vector<TypeParam> x{nan, inf, -inf, (TypeParam)0, -(TypeParam)0};
+    std::vector<TypeParam> y_exp = x, y_tanh = x;
+    TEST_ARCH::da_vmath::scaled_exp((da_int)x.size(), (TypeParam)1, y_exp.data());
+    TEST_ARCH::da_vmath::shifted_tanh((da_int)x.size(), (TypeParam)0, y_tanh.data());
+
+    EXPECT_TRUE(std::isnan(y_exp[0]));
+    EXPECT_EQ(y_exp[1], inf);
+    EXPECT_EQ(y_exp[2], (TypeParam)0);
+    EXPECT_EQ(y_exp[3], (TypeParam)1);
+    EXPECT_EQ(y_exp[4], (TypeParam)1);
+
+    EXPECT_TRUE(std::isnan(y_tanh[0]));
+    EXPECT_EQ(y_tanh[1], (TypeParam)1);
+    EXPECT_EQ(y_tanh[2], (TypeParam)-1);
+    EXPECT_EQ(y_tanh[3], (TypeParam)0);
+    EXPECT_EQ(y_tanh[4], (TypeParam)0);
+}
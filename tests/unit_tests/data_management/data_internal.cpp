@@ -31,6 +31,8 @@
 #include "interval_map.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
 
 using namespace da_data;
 
@@ -234,7 +236,7 @@ TEST(block, copySlice) {
 }
 
 TEST(block, missingValues) {
-    std::vector<bool> valid_rows(10, true);
+    std::vector<uint8_t> valid_rows(10, 1);
     da_errors::da_error_t err(da_errors::DA_RECORD);
     da_int m = 5;
     da_int n = 4;
@@ -248,13 +250,13 @@ TEST(block, missingValues) {
     cols = {0, n - 1};
     rows = {0, m - 1};
     EXPECT_EQ(b1.missing_rows(valid_rows, 0, rows, cols), da_status_success);
-    std::vector<bool> exp_valid_rows = {true, false, true, true, false};
+    std::vector<uint8_t> exp_valid_rows = {1, 0, 1, 1, 0};
     EXPECT_ARR_EQ(5, valid_rows, exp_valid_rows, 1, 1, 0, 0);
-    std::fill(valid_rows.begin(), valid_rows.end(), true);
+    std::fill(valid_rows.begin(), valid_rows.end(), 1);
     cols = {1, 3};
     rows = {1, 3};
     EXPECT_EQ(b1.missing_rows(valid_rows, 5, rows, cols), da_status_success);
-    exp_valid_rows = {false, true, true};
+    exp_valid_rows = {0, 1, 1};
     EXPECT_ARR_EQ(3, valid_rows, exp_valid_rows, 1, 1, 5, 0);
 
     /* row major ordering */
@@ -265,15 +267,15 @@ TEST(block, missingValues) {
     block_dense<da_int> b2(m, n, bl_row.data(), err, row_major);
     cols = {0, n - 1};
     rows = {0, m - 1};
-    std::fill(valid_rows.begin(), valid_rows.end(), true);
+    std::fill(valid_rows.begin(), valid_rows.end(), 1);
     EXPECT_EQ(b2.missing_rows(valid_rows, 0, rows, cols), da_status_success);
-    exp_valid_rows = {true, false, true, false};
+    exp_valid_rows = {1, 0, 1, 0};
     EXPECT_ARR_EQ(4, valid_rows, exp_valid_rows, 1, 1, 0, 0);
-    std::fill(valid_rows.begin(), valid_rows.end(), true);
+    std::fill(valid_rows.begin(), valid_rows.end(), 1);
     cols = {1, 3};
     rows = {0, 2};
     EXPECT_EQ(b2.missing_rows(valid_rows, 5, rows, cols), da_status_success);
-    exp_valid_rows = {true, false, true};
+    exp_valid_rows = {1, 0, 1};
     EXPECT_ARR_EQ(3, valid_rows, exp_valid_rows, 1, 1, 5, 0);
 
     /* try with a type that does not have a missing value defined */
@@ -287,10 +289,10 @@ TEST(block, missingValues) {
     cols = {0, n - 1};
     rows = {0, m - 1};
     block_dense<missing_not_def> b3(m, n, bl_not_missing.data(), err, row_major);
-    std::fill(valid_rows.begin(), valid_rows.end(), true);
+    std::fill(valid_rows.begin(), valid_rows.end(), 1);
     EXPECT_EQ(b3.missing_rows(valid_rows, 5, rows, cols), da_status_success);
     exp_valid_rows.resize(5);
-    std::fill(exp_valid_rows.begin(), exp_valid_rows.end(), true);
+    std::fill(exp_valid_rows.begin(), exp_valid_rows.end(), 1);
     EXPECT_ARR_EQ(5, valid_rows, exp_valid_rows, 1, 1, 5, 0);
 
     /* input errors */
@@ -883,6 +885,363 @@ TEST(dataStore, extractSelection) {
     EXPECT_ARR_EQ(7, islice, expected_slice, 1, 1, 0, 0);
 }
 
+TEST(dataStore, extractSelectionLarge) {
+    // Selections large enough to be split in several extraction tasks
+    using namespace da_data;
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    data_store ds = data_store(err);
+    da_int m1 = 30000, m2 = 20000, m = m1 + m2;
+    auto val = [](da_int i, da_int j) { return (double)i + 100000.0 * (double)j; };
+
+    // 2 vertical row blocks, each split in a column-major and a row-major block
+    std::vector<double> b11(m1 * 3), b12(m1 * 2), b21(m2 * 3), b22(m2 * 2);
+    for (da_int i = 0; i < m1; i++) {
+        for (da_int j = 0; j < 3; j++)
+            b11[i + j * m1] = val(i, j);
+        for (da_int j = 0; j < 2; j++)
+            b12[2 * i + j] = val(i, j + 3);
+    }
+    for (da_int i = 0; i < m2; i++) {
+        for (da_int j = 0; j < 3; j++)
+            b21[i + j * m2] = val(i + m1, j);
+        for (da_int j = 0; j < 2; j++)
+            b22[2 * i + j] = val(i + m1, j + 3);
+    }
+    EXPECT_EQ(ds.concatenate_columns(m1, 3, b11.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_columns(m1, 2, b12.data(), row_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 3, b21.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 2, b22.data(), row_major), da_status_success);
+
+    std::vector<interval> rows = {{5, 29999}, {30005, 40000}, {45000, m - 1}};
+    std::vector<interval> cols = {{0, 1}, {3, 4}};
+    for (auto &r : rows)
+        EXPECT_EQ(ds.select_rows("sel", r), da_status_success);
+    for (auto &c : cols)
+        EXPECT_EQ(ds.select_columns("sel", c), da_status_success);
+    std::vector<da_int> row_idx, col_idx;
+    for (auto &r : rows)
+        for (da_int i = r.lower; i <= r.upper; i++)
+            row_idx.push_back(i);
+    for (auto &c : cols)
+        for (da_int j = c.lower; j <= c.upper; j++)
+            col_idx.push_back(j);
+    da_int nr = (da_int)row_idx.size(), nc = (da_int)col_idx.size();
+
+    // Column major with padding
+    da_int ld = nr + 3;
+    std::vector<double> sel(ld * nc, -1.0);
+    EXPECT_EQ(ds.extract_selection("sel", column_major, ld, sel.data()),
+              da_status_success);
+    da_int n_wrong = 0;
+    for (da_int j = 0; j < nc; j++) {
+        for (da_int i = 0; i < nr; i++)
+            n_wrong += sel[i + j * ld] != val(row_idx[i], col_idx[j]);
+        for (da_int i = nr; i < ld; i++)
+            n_wrong += sel[i + j * ld] != -1.0;
+    }
+    EXPECT_EQ(n_wrong, 0);
+
+    // Row major with padding
+    ld = nc + 1;
+    sel.assign(ld * nr, -1.0);
+    EXPECT_EQ(ds.extract_selection("sel", row_major, ld, sel.data()), da_status_success);
+    n_wrong = 0;
+    for (da_int i = 0; i < nr; i++) {
+        for (da_int j = 0; j < nc; j++)
+            n_wrong += sel[j + i * ld] != val(row_idx[i], col_idx[j]);
+        n_wrong += sel[nc + i * ld] != -1.0;
+    }
+    EXPECT_EQ(n_wrong, 0);
+
+    // Leading dimensions too small
+    EXPECT_EQ(ds.extract_selection("sel", column_major, nr - 1, sel.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.extract_selection("sel", row_major, nc - 1, sel.data()),
+              da_status_invalid_input);
+
+    // Wrong type
+    std::vector<float> fsel(nr * nc);
+    EXPECT_EQ(ds.extract_selection("sel", column_major, nr, fsel.data()),
+              da_status_invalid_input);
+}
+
+TEST(dataStore, selectionView) {
+    using namespace da_data;
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    data_store ds = data_store(err);
+    da_int m1 = 6, m2 = 4;
+    std::vector<double> b11(m1 * 3), b12(m1 * 2), b21(m2 * 3), b22(m2 * 2);
+    std::iota(b11.begin(), b11.end(), 0.0);
+    std::iota(b12.begin(), b12.end(), 100.0);
+    std::iota(b21.begin(), b21.end(), 200.0);
+    std::iota(b22.begin(), b22.end(), 300.0);
+    double *view = nullptr;
+    da_int nr, nc, ld;
+
+    // Only one column major block in the store
+    EXPECT_EQ(ds.concatenate_columns(m1, 3, b11.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.selection_view("", view, nr, nc, ld), da_status_success);
+    EXPECT_EQ(view, b11.data());
+    EXPECT_EQ(nr, m1);
+    EXPECT_EQ(nc, 3);
+    EXPECT_EQ(ld, m1);
+
+    EXPECT_EQ(ds.concatenate_columns(m1, 2, b12.data(), row_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 3, b21.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 2, b22.data(), row_major), da_status_success);
+
+    // Contiguous selection inside the first block, defined by adjacent intervals
+    EXPECT_EQ(ds.select_rows("A", {1, 2}), da_status_success);
+    EXPECT_EQ(ds.select_rows("A", {3, 4}), da_status_success);
+    EXPECT_EQ(ds.select_columns("A", {1, 2}), da_status_success);
+    EXPECT_EQ(ds.selection_view("A", view, nr, nc, ld), da_status_success);
+    EXPECT_EQ(view, &b11[1 + m1]);
+    EXPECT_EQ(nr, 4);
+    EXPECT_EQ(nc, 2);
+    EXPECT_EQ(ld, m1);
+
+    // Rows only, inside the second row block
+    EXPECT_EQ(ds.select_rows("B", {m1 + 1, m1 + 2}), da_status_success);
+    EXPECT_EQ(ds.select_columns("B", {0, 2}), da_status_success);
+    EXPECT_EQ(ds.selection_view("B", view, nr, nc, ld), da_status_success);
+    EXPECT_EQ(view, &b21[1]);
+    EXPECT_EQ(nr, 2);
+    EXPECT_EQ(nc, 3);
+    EXPECT_EQ(ld, m2);
+
+    // Selections that need a copy
+    EXPECT_EQ(ds.select_rows("rows across blocks", {m1 - 1, m1}), da_status_success);
+    EXPECT_EQ(ds.select_columns("rows across blocks", {0, 0}), da_status_success);
+    EXPECT_EQ(ds.selection_view("rows across blocks", view, nr, nc, ld),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.select_columns("cols across blocks", {2, 3}), da_status_success);
+    EXPECT_EQ(ds.selection_view("cols across blocks", view, nr, nc, ld),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.select_rows("row major", {0, 1}), da_status_success);
+    EXPECT_EQ(ds.select_columns("row major", {3, 4}), da_status_success);
+    EXPECT_EQ(ds.selection_view("row major", view, nr, nc, ld), da_status_invalid_input);
+    EXPECT_EQ(ds.select_columns("not contiguous", {0, 0}), da_status_success);
+    EXPECT_EQ(ds.select_columns("not contiguous", {2, 2}), da_status_success);
+    EXPECT_EQ(ds.selection_view("not contiguous", view, nr, nc, ld),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.selection_view("unknown", view, nr, nc, ld), da_status_invalid_input);
+    float *fview = nullptr;
+    EXPECT_EQ(ds.selection_view("A", fview, nr, nc, ld), da_status_invalid_input);
+}
+
+TEST(datastore, missingDataScattered) {
+    // Scattered missing values: the selection is stored as a bitmap
+    using namespace da_data;
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    data_store ds = data_store(err);
+    da_int m1 = 70000, m2 = 30000, m = m1 + m2;
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    auto val = [](da_int i, da_int j) { return (double)i + 1000000.0 * (double)j; };
+    auto missing = [](da_int i, da_int j) {
+        return (j == 0 && i % 7 == 3) || (j == 2 && i % 11 == 5);
+    };
+
+    // 2 row blocks: a column-major block and a row-major one
+    std::vector<double> b1(m1 * 3), b2(m2 * 3);
+    for (da_int i = 0; i < m1; i++)
+        for (da_int j = 0; j < 3; j++)
+            b1[i + j * m1] = missing(i, j) ? nan : val(i, j);
+    for (da_int i = 0; i < m2; i++)
+        for (da_int j = 0; j < 3; j++)
+            b2[3 * i + j] = missing(i + m1, j) ? nan : val(i + m1, j);
+    EXPECT_EQ(ds.concatenate_columns(m1, 3, b1.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 3, b2.data(), row_major), da_status_success);
+
+    // Rows [10, m - 10] without missing values in the columns 0 and 1
+    EXPECT_EQ(ds.select_rows("sel", {10, m - 10}), da_status_success);
+    EXPECT_EQ(ds.select_columns("sel", {0, 1}), da_status_success);
+    EXPECT_EQ(ds.select_non_missing("sel", false), da_status_success);
+    std::vector<da_int> rows;
+    for (da_int i = 10; i <= m - 10; i++)
+        if (!missing(i, 0))
+            rows.push_back(i);
+    auto check_extraction = [&](std::vector<da_int> &rows) {
+        da_int nr = (da_int)rows.size();
+        std::vector<double> sel(2 * nr);
+        EXPECT_EQ(ds.extract_selection("sel", column_major, nr, sel.data()),
+                  da_status_success);
+        da_int n_wrong = 0;
+        for (da_int j = 0; j < 2; j++)
+            for (da_int i = 0; i < nr; i++)
+                n_wrong += sel[i + j * nr] != val(rows[i], j);
+        EXPECT_EQ(n_wrong, 0);
+        EXPECT_EQ(ds.extract_selection("sel", row_major, 2, sel.data()),
+                  da_status_success);
+        n_wrong = 0;
+        for (da_int j = 0; j < 2; j++)
+            for (da_int i = 0; i < nr; i++)
+                n_wrong += sel[2 * i + j] != val(rows[i], j);
+        EXPECT_EQ(n_wrong, 0);
+    };
+    check_extraction(rows);
+
+    // Update the rows of the bitmap selection
+    EXPECT_EQ(ds.remove_rows_from_selection("sel", {0, m1 - 1}), da_status_success);
+    EXPECT_EQ(ds.select_rows("sel", {4, 5}), da_status_success);
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [&](da_int i) { return i < m1; }),
+               rows.end());
+    rows.insert(rows.begin(), {4, 5});
+    check_extraction(rows);
+
+    // Check the full rows: the column 2 is now considered
+    EXPECT_EQ(ds.select_non_missing("sel", true), da_status_success);
+    rows.erase(std::remove_if(rows.begin(), rows.end(),
+                              [&](da_int i) { return missing(i, 2); }),
+               rows.end());
+    check_extraction(rows);
+    double *view;
+    da_int nr, nc, ld;
+    EXPECT_EQ(ds.selection_view("sel", view, nr, nc, ld), da_status_invalid_input);
+
+    // Few intervals left: the selection can still be viewed in place
+    EXPECT_EQ(ds.select_rows("contiguous", {100, 105}), da_status_success);
+    EXPECT_EQ(ds.select_columns("contiguous", {1, 1}), da_status_success);
+    EXPECT_EQ(ds.select_non_missing("contiguous", false), da_status_success);
+    EXPECT_EQ(ds.selection_view("contiguous", view, nr, nc, ld), da_status_success);
+    EXPECT_EQ(view, &b1[m1 + 100]);
+    EXPECT_EQ(nr, 6);
+}
+
+TEST(datastore, selectWhereGroupBy) {
+    using namespace da_data;
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    data_store ds = data_store(err);
+    // Column 0: integer keys, column 1: values. 2 row blocks, the second one is row-major
+    da_int m1 = 50000, m2 = 20000, m = m1 + m2, n_keys = 13;
+    auto key = [&](da_int i) { return (i * 7) % n_keys; };
+    auto val = [](da_int i) { return i % 5 == 1 ? std::nan("") : 0.5 * (double)(i % 101); };
+    std::vector<da_int> k1(m1), k2(m2);
+    std::vector<double> v1(m1), v2(m2);
+    for (da_int i = 0; i < m; i++) {
+        (i < m1 ? k1[i] : k2[i - m1]) = key(i);
+        (i < m1 ? v1[i] : v2[i - m1]) = val(i);
+    }
+    k1[17] = std::numeric_limits<da_int>::max();
+    EXPECT_EQ(ds.concatenate_columns(m1, 1, k1.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_columns(m1, 1, v1.data(), column_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 1, k2.data(), row_major), da_status_success);
+    EXPECT_EQ(ds.concatenate_rows(m2, 1, v2.data(), row_major), da_status_success);
+
+    // Invalid inputs
+    EXPECT_EQ(ds.select_where<double>("A", 2, da_compare_lt, 1.0, da_combine_and),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.select_where<double>("A", 0, da_compare_lt, 1.0, da_combine_and),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.select_where<double>("A", 1, (da_data_compare)10, 1.0, da_combine_and),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.select_where<double>("A", 1, da_compare_lt, 1.0, (da_data_combine)3),
+              da_status_invalid_input);
+
+    // (v < 10 and k != 3) or k == 5: scattered rows, stored as a bitmap
+    auto pred = [&](da_int i) {
+        return (val(i) < 10.0 && key(i) != 3 && i != 17) || (key(i) == 5 && i != 17);
+    };
+    EXPECT_EQ(ds.select_where<double>("A", 1, da_compare_lt, 10.0, da_combine_or),
+              da_status_success);
+    EXPECT_EQ(ds.select_where<da_int>("A", 0, da_compare_ne, 3, da_combine_and),
+              da_status_success);
+    EXPECT_EQ(ds.select_where<da_int>("A", 0, da_compare_eq, 5, da_combine_or),
+              da_status_success);
+    std::vector<da_int> rows;
+    for (da_int i = 0; i < m; i++)
+        if (pred(i))
+            rows.push_back(i);
+    da_int nr = (da_int)rows.size();
+    std::vector<double> sel(nr);
+    EXPECT_EQ(ds.select_columns("A", {1, 1}), da_status_success);
+    EXPECT_EQ(ds.extract_selection("A", column_major, nr, sel.data()), da_status_success);
+    da_int n_wrong = 0;
+    for (da_int i = 0; i < nr; i++)
+        n_wrong += !(sel[i] == val(rows[i]) || (std::isnan(sel[i]) && key(rows[i]) == 5));
+    EXPECT_EQ(n_wrong, 0);
+
+    // Contiguous rows are kept as intervals
+    EXPECT_EQ(ds.select_rows("B", {100, 200}), da_status_success);
+    EXPECT_EQ(ds.select_where<da_int>("B", 0, da_compare_ge, 0, da_combine_and),
+              da_status_success);
+    double *view;
+    da_int nc, ld;
+    EXPECT_EQ(ds.select_columns("B", {1, 1}), da_status_success);
+    EXPECT_EQ(ds.selection_view("B", view, nr, nc, ld), da_status_success);
+    EXPECT_EQ(nr, 101);
+
+    // Empty result
+    EXPECT_EQ(ds.select_where<double>("C", 1, da_compare_gt, 1000.0, da_combine_and),
+              da_status_success);
+    EXPECT_EQ(ds.select_columns("C", {1, 1}), da_status_success);
+    EXPECT_EQ(ds.extract_selection("C", column_major, 1, sel.data()), da_status_success);
+    da_int n_groups = 0;
+    EXPECT_EQ(ds.group_by<double>("C", 0, 1, n_groups, nullptr, nullptr, nullptr, nullptr,
+                                  nullptr, nullptr),
+              da_status_success);
+    EXPECT_EQ(n_groups, 0);
+
+    // Group by on all the rows
+    std::vector<da_int> count_exp(n_keys, 0);
+    std::vector<double> sum_exp(n_keys, 0), min_exp(n_keys, 1e10), max_exp(n_keys, -1e10);
+    for (da_int i = 0; i < m; i++) {
+        if (i == 17 || std::isnan(val(i)))
+            continue;
+        da_int k = key(i);
+        count_exp[k]++;
+        sum_exp[k] += val(i);
+        min_exp[k] = std::min(min_exp[k], val(i));
+        max_exp[k] = std::max(max_exp[k], val(i));
+    }
+    n_groups = 2;
+    EXPECT_EQ(ds.group_by<double>("", 0, 1, n_groups, nullptr, nullptr, nullptr, nullptr,
+                                  nullptr, nullptr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(n_groups, n_keys);
+    std::vector<da_int> keys(n_keys), counts(n_keys);
+    std::vector<double> sums(n_keys), means(n_keys), mins(n_keys), maxs(n_keys);
+    EXPECT_EQ(ds.group_by("", 0, 1, n_groups, keys.data(), counts.data(), sums.data(),
+                          means.data(), mins.data(), maxs.data()),
+              da_status_success);
+    for (da_int k = 0; k < n_keys; k++) {
+        EXPECT_EQ(keys[k], k);
+        EXPECT_EQ(counts[k], count_exp[k]);
+        EXPECT_NEAR(sums[k], sum_exp[k], 1e-8 * sum_exp[k]);
+        EXPECT_NEAR(means[k], sum_exp[k] / count_exp[k], 1e-10 * sum_exp[k]);
+        EXPECT_EQ(mins[k], min_exp[k]);
+        EXPECT_EQ(maxs[k], max_exp[k]);
+    }
+
+    // Group by on the selection B
+    n_groups = n_keys;
+    EXPECT_EQ(ds.group_by<double>("B", 0, 1, n_groups, keys.data(), counts.data(),
+                                  nullptr, nullptr, nullptr, nullptr),
+              da_status_success);
+    EXPECT_EQ(n_groups, n_keys);
+    da_int total = 0;
+    for (da_int k = 0; k < n_groups; k++)
+        total += counts[k];
+    da_int total_exp = 0;
+    for (da_int i = 100; i <= 200; i++)
+        total_exp += !std::isnan(val(i));
+    EXPECT_EQ(total, total_exp);
+
+    // Invalid inputs
+    EXPECT_EQ(ds.group_by("D", 0, 1, n_groups, keys.data(), counts.data(), sums.data(),
+                          means.data(), mins.data(), maxs.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.group_by("", 1, 1, n_groups, keys.data(), counts.data(), sums.data(),
+                          means.data(), mins.data(), maxs.data()),
+              da_status_invalid_input);
+    EXPECT_EQ(ds.group_by("", 0, 2, n_groups, keys.data(), counts.data(), sums.data(),
+                          means.data(), mins.data(), maxs.data()),
+              da_status_invalid_input);
+    std::vector<float> fsums(n_keys);
+    EXPECT_EQ(ds.group_by<float>("", 0, 1, n_groups, nullptr, nullptr, fsums.data(),
+                                 nullptr, nullptr, nullptr),
+              da_status_invalid_input);
+}
+
 TEST(datastore, missingData) {
 
     using namespace da_data;
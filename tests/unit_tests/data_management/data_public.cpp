@@ -623,6 +623,62 @@ TEST(dataStore, extractSelPub) {
     da_datastore_destroy(&store);
 }
 
+TEST(dataStore, selectionViewPub) {
+    da_datastore store = nullptr;
+    double *dview = nullptr;
+    float *sview = nullptr;
+    da_int *iview = nullptr;
+    uint8_t *uiview = nullptr;
+    da_int nr, nc, ld;
+
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, "A", &dview, &nr, &nc, &ld),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // 3x3 double block, copied in the store
+    std::vector<double> dblock = {1., 2., 3., 4., 5., 6., 7., 8., 9.};
+    EXPECT_EQ(da_data_load_col_real_d(store, 3, 3, dblock.data(), column_major, true),
+              da_status_success);
+    EXPECT_EQ(da_data_select_slice(store, "A", 1, 2, 1, 2), da_status_success);
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, "A", &dview, &nr, &nc, &ld),
+              da_status_success);
+    EXPECT_EQ(nr, 2);
+    EXPECT_EQ(nc, 2);
+    EXPECT_EQ(ld, 3);
+    std::vector<double> dexp = {5., 6., 8., 9.};
+    for (da_int j = 0; j < nc; j++)
+        for (da_int i = 0; i < nr; i++)
+            EXPECT_EQ(dview[i + j * ld], dexp[i + j * nr]);
+
+    // Wrong types and invalid arguments
+    EXPECT_EQ(da_data_get_selection_view_real_s(store, "A", &sview, &nr, &nc, &ld),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_selection_view_int(store, "A", &iview, &nr, &nc, &ld),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_selection_view_uint8(store, "A", &uiview, &nr, &nc, &ld),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, nullptr, &dview, &nr, &nc, &ld),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, "A", nullptr, &nr, &nc, &ld),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, "A", &dview, &nr, &nc, nullptr),
+              da_status_invalid_input);
+
+    // Non-contiguous selection: the data needs to be extracted
+    EXPECT_EQ(da_data_select_columns(store, "B", 0, 0), da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "B", 2, 2), da_status_success);
+    EXPECT_EQ(da_data_get_selection_view_real_d(store, "B", &dview, &nr, &nc, &ld),
+              da_status_invalid_input);
+    std::vector<double> dsel(6);
+    EXPECT_EQ(
+        da_data_extract_selection_real_d(store, "B", column_major, dsel.data(), 3),
+        da_status_success);
+    dexp = {1., 2., 3., 7., 8., 9.};
+    EXPECT_ARR_EQ(6, dsel, dexp, 1, 1, 0, 0);
+
+    da_datastore_destroy(&store);
+}
+
 TEST(dataStore, missingDataPub) {
     da_datastore store = nullptr;
 
@@ -667,6 +723,97 @@ TEST(dataStore, missingDataPub) {
     da_datastore_destroy(&store);
 }
 
+TEST(dataStore, selectWherePub) {
+    da_datastore store = nullptr;
+    da_int n_groups = 3;
+    EXPECT_EQ(da_data_select_where_real_d(store, "A", 0, da_compare_lt, 1.0,
+                                          da_combine_and),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 0, 1, &n_groups, nullptr, nullptr,
+                                      nullptr, nullptr, nullptr, nullptr),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+
+    // Integer keys and float values
+    std::vector<da_int> ikeys = {2, 1, 2, 3, 1, 2};
+    std::vector<float> fvals = {1.0f, 4.0f, 3.0f, 7.0f, -2.0f, 5.0f};
+    EXPECT_EQ(da_data_load_col_int(store, 6, 1, ikeys.data(), column_major, true),
+              da_status_success);
+    EXPECT_EQ(da_data_load_col_real_s(store, 6, 1, fvals.data(), column_major, true),
+              da_status_success);
+
+    // Rows with key 2 and value > 2, or with value < 0
+    EXPECT_EQ(da_data_select_where_int(store, "A", 0, da_compare_eq, 2, da_combine_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_real_s(store, "A", 1, da_compare_gt, 2.0f,
+                                          da_combine_and),
+              da_status_success);
+    EXPECT_EQ(da_data_select_where_real_s(store, "A", 1, da_compare_lt, 0.0f,
+                                          da_combine_or),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "A", 1, 1), da_status_success);
+    std::vector<float> fsel(3);
+    EXPECT_EQ(da_data_extract_selection_real_s(store, "A", column_major, fsel.data(), 3),
+              da_status_success);
+    std::vector<float> fexp = {3.0f, -2.0f, 5.0f};
+    EXPECT_ARR_EQ(3, fsel, fexp, 1, 1, 0, 0);
+
+    // Group by over the selection A and over all the rows
+    std::vector<da_int> keys(3), counts(3);
+    std::vector<float> sums(3), means(3), mins(3), maxs(3);
+    EXPECT_EQ(da_data_group_by_real_s(store, "A", 0, 1, &n_groups, keys.data(),
+                                      counts.data(), sums.data(), means.data(),
+                                      mins.data(), maxs.data()),
+              da_status_success);
+    EXPECT_EQ(n_groups, 2);
+    std::vector<da_int> kexp = {1, 2}, cexp = {1, 2};
+    EXPECT_ARR_EQ(2, keys, kexp, 1, 1, 0, 0);
+    EXPECT_ARR_EQ(2, counts, cexp, 1, 1, 0, 0);
+    fexp = {-2.0f, 8.0f};
+    EXPECT_ARR_EQ(2, sums, fexp, 1, 1, 0, 0);
+    n_groups = 3;
+    EXPECT_EQ(da_data_group_by_real_s(store, nullptr, 0, 1, &n_groups, keys.data(),
+                                      counts.data(), sums.data(), means.data(),
+                                      mins.data(), maxs.data()),
+              da_status_success);
+    EXPECT_EQ(n_groups, 3);
+    kexp = {1, 2, 3};
+    cexp = {2, 3, 1};
+    EXPECT_ARR_EQ(3, keys, kexp, 1, 1, 0, 0);
+    EXPECT_ARR_EQ(3, counts, cexp, 1, 1, 0, 0);
+    fexp = {2.0f, 9.0f, 7.0f};
+    EXPECT_ARR_EQ(3, sums, fexp, 1, 1, 0, 0);
+    fexp = {1.0f, 3.0f, 7.0f};
+    EXPECT_ARR_EQ(3, means, fexp, 1, 1, 0, 0);
+    fexp = {-2.0f, 1.0f, 7.0f};
+    EXPECT_ARR_EQ(3, mins, fexp, 1, 1, 0, 0);
+    fexp = {4.0f, 5.0f, 7.0f};
+    EXPECT_ARR_EQ(3, maxs, fexp, 1, 1, 0, 0);
+
+    // Invalid arguments
+    n_groups = 1;
+    EXPECT_EQ(da_data_group_by_real_s(store, nullptr, 0, 1, &n_groups, keys.data(),
+                                      nullptr, nullptr, nullptr, nullptr, nullptr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(n_groups, 3);
+    EXPECT_EQ(da_data_group_by_real_s(store, nullptr, 0, 1, nullptr, nullptr, nullptr,
+                                      nullptr, nullptr, nullptr, nullptr),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_group_by_real_d(store, nullptr, 0, 1, &n_groups, nullptr, nullptr,
+                                      nullptr, nullptr, nullptr, nullptr),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_real_d(store, "A", 1, da_compare_lt, 1.0,
+                                          da_combine_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_uint8(store, "A", 0, da_compare_lt, 1, da_combine_and),
+              da_status_invalid_input);
+    EXPECT_EQ(da_data_select_where_int(store, nullptr, 0, da_compare_lt, 1,
+                                       da_combine_and),
+              da_status_invalid_input);
+
+    da_datastore_destroy(&store);
+}
+
 TEST(dataStore, heading) {
     char filepath[256] = DATA_DIR;
     strcat(filepath, "csv_data/");
@@ -842,3 +989,168 @@ TEST(datastore, selectInvalid) {
 
     da_datastore_destroy(&store);
 }
+
+/* Minimal Arrow producer used to test the C data interface import */
+static da_int arrow_releases = 0;
+static void release_test_array(ArrowArray *array) {
+    arrow_releases++;
+    array->release = nullptr;
+}
+static void init_test_array(ArrowArray &array, int64_t length, int64_t null_count,
+                            int64_t n_buffers, const void **buffers) {
+    array.length = length;
+    array.null_count = null_count;
+    array.offset = 0;
+    array.n_buffers = n_buffers;
+    array.n_children = 0;
+    array.buffers = buffers;
+    array.children = nullptr;
+    array.dictionary = nullptr;
+    array.release = release_test_array;
+    array.private_data = nullptr;
+}
+static void init_test_schema(ArrowSchema &schema, const char *format, const char *name) {
+    schema.format = format;
+    schema.name = name;
+    schema.metadata = nullptr;
+    schema.flags = ARROW_FLAG_NULLABLE;
+    schema.n_children = 0;
+    schema.children = nullptr;
+    schema.dictionary = nullptr;
+    schema.release = nullptr;
+    schema.private_data = nullptr;
+}
+
+TEST(dataStore, arrowImport) {
+    /* Record batch with 5 rows and 4 columns:
+     * x (double, row 1 is null), id (integer), flag (boolean), name (utf8)
+     */
+    std::vector<double> x = {1., 2., 3., 4., 5.};
+    uint8_t x_valid = 0x1D;
+    std::vector<da_int> id = {10, 11, 12, 13, 14};
+    uint8_t flag = 0x0D;
+    std::vector<int32_t> name_offsets = {0, 1, 3, 3, 6, 7};
+    const char *name_chars = "abbcccd";
+    const char *int_format = sizeof(da_int) == 4 ? "i" : "l";
+
+    const void *x_buf[2] = {&x_valid, x.data()};
+    const void *id_buf[2] = {nullptr, id.data()};
+    const void *flag_buf[2] = {nullptr, &flag};
+    const void *name_buf[3] = {nullptr, name_offsets.data(), name_chars};
+    const void *batch_buf[1] = {nullptr};
+    ArrowArray cols[4], batch;
+    init_test_array(cols[0], 5, 1, 2, x_buf);
+    init_test_array(cols[1], 5, 0, 2, id_buf);
+    init_test_array(cols[2], 5, 0, 2, flag_buf);
+    init_test_array(cols[3], 5, 0, 3, name_buf);
+    ArrowArray *children[4] = {&cols[0], &cols[1], &cols[2], &cols[3]};
+    init_test_array(batch, 5, 0, 1, batch_buf);
+    batch.n_children = 4;
+    batch.children = children;
+
+    ArrowSchema col_schemas[4], batch_schema;
+    init_test_schema(col_schemas[0], "g", "x");
+    init_test_schema(col_schemas[1], int_format, "id");
+    init_test_schema(col_schemas[2], "b", "flag");
+    init_test_schema(col_schemas[3], "u", "name");
+    ArrowSchema *schema_children[4] = {&col_schemas[0], &col_schemas[1],
+                                       &col_schemas[2], &col_schemas[3]};
+    init_test_schema(batch_schema, "+s", "");
+    batch_schema.n_children = 4;
+    batch_schema.children = schema_children;
+
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    arrow_releases = 0;
+    EXPECT_EQ(da_data_load_col_arrow(store, &batch, &batch_schema), da_status_success);
+    // The store now owns the array
+    EXPECT_EQ(batch.release, nullptr);
+    EXPECT_EQ(arrow_releases, 0);
+
+    da_int n_rows, n_cols, idx;
+    EXPECT_EQ(da_data_get_n_rows(store, &n_rows), da_status_success);
+    EXPECT_EQ(da_data_get_n_cols(store, &n_cols), da_status_success);
+    EXPECT_EQ(n_rows, 5);
+    EXPECT_EQ(n_cols, 4);
+    EXPECT_EQ(da_data_get_col_idx(store, "flag", &idx), da_status_success);
+    EXPECT_EQ(idx, 2);
+
+    // Null entries are extracted as missing values
+    std::vector<double> xcol(5);
+    EXPECT_EQ(da_data_extract_column_real_d(store, 0, 5, xcol.data()), da_status_success);
+    EXPECT_TRUE(std::isnan(xcol[1]));
+    EXPECT_EQ(xcol[4], 5.);
+    std::vector<da_int> idcol(5);
+    EXPECT_EQ(da_data_extract_column_int(store, 1, 5, idcol.data()), da_status_success);
+    EXPECT_ARR_EQ(5, idcol, id, 1, 1, 0, 0);
+    std::vector<uint8_t> flagcol(5), flag_exp = {1, 0, 1, 1, 0};
+    EXPECT_EQ(da_data_extract_column_uint8(store, 2, 5, flagcol.data()),
+              da_status_success);
+    EXPECT_ARR_EQ(5, flagcol, flag_exp, 1, 1, 0, 0);
+
+    // The numerical buffers are not copied
+    x[3] = 40.;
+    double elem;
+    EXPECT_EQ(da_data_get_element_real_d(store, 3, 0, &elem), da_status_success);
+    EXPECT_EQ(elem, 40.);
+    EXPECT_EQ(da_data_get_element_real_d(store, 1, 0, &elem), da_status_success);
+    EXPECT_TRUE(std::isnan(elem));
+
+    // Rows with null entries are removed by select_non_missing
+    EXPECT_EQ(da_data_select_non_missing(store, "valid", true), da_status_success);
+    EXPECT_EQ(da_data_select_columns(store, "valid", 0, 0), da_status_success);
+    std::vector<double> xsel(4), xsel_exp = {1., 3., 40., 5.};
+    EXPECT_EQ(da_data_extract_selection_real_d(store, "valid", column_major, xsel.data(), 4),
+              da_status_success);
+    EXPECT_ARR_EQ(4, xsel, xsel_exp, 1, 1, 0, 0);
+
+    // Setting a null entry makes it valid
+    EXPECT_EQ(da_data_set_element_real_d(store, 1, 0, 20.), da_status_success);
+    EXPECT_EQ(da_data_get_element_real_d(store, 1, 0, &elem), da_status_success);
+    EXPECT_EQ(elem, 20.);
+
+    da_datastore_destroy(&store);
+    EXPECT_EQ(arrow_releases, 1);
+}
+
+TEST(dataStore, arrowImportInvalid) {
+    std::vector<double> x = {1., 2., 3., 4., 5.};
+    std::vector<int16_t> s = {1, 2, 3, 4, 5};
+    const void *x_buf[2] = {nullptr, x.data()};
+    const void *s_buf[2] = {nullptr, s.data()};
+    ArrowArray xarr, sarr;
+    ArrowSchema xsch, ssch;
+    init_test_array(xarr, 5, 0, 2, x_buf);
+    init_test_array(sarr, 5, 0, 2, s_buf);
+    init_test_schema(xsch, "g", nullptr);
+    init_test_schema(ssch, "s", nullptr);
+
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_data_load_col_arrow(store, &xarr, &xsch),
+              da_status_store_not_initialized);
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    EXPECT_EQ(da_data_load_col_arrow(store, nullptr, &xsch), da_status_invalid_input);
+    EXPECT_EQ(da_data_load_col_arrow(store, &xarr, nullptr), da_status_invalid_input);
+
+    // Unsupported types are rejected and the array is left untouched
+    EXPECT_EQ(da_data_load_col_arrow(store, &sarr, &ssch), da_status_invalid_input);
+    EXPECT_NE(sarr.release, nullptr);
+
+    // Single primitive array with an offset
+    arrow_releases = 0;
+    xarr.offset = 2;
+    xarr.length = 3;
+    EXPECT_EQ(da_data_load_col_arrow(store, &xarr, &xsch), da_status_success);
+    std::vector<double> xcol(3), xexp = {3., 4., 5.};
+    EXPECT_EQ(da_data_extract_column_real_d(store, 0, 3, xcol.data()), da_status_success);
+    EXPECT_ARR_EQ(3, xcol, xexp, 1, 1, 0, 0);
+
+    // Already released array and mismatching number of rows
+    EXPECT_EQ(da_data_load_col_arrow(store, &xarr, &xsch), da_status_invalid_input);
+    init_test_array(xarr, 5, 0, 2, x_buf);
+    EXPECT_EQ(da_data_load_col_arrow(store, &xarr, &xsch), da_status_invalid_input);
+    EXPECT_NE(xarr.release, nullptr);
+
+    da_datastore_destroy(&store);
+    EXPECT_EQ(arrow_releases, 1);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "interval.hpp"
+#include "row_bitmap.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace da_interval;
+
+namespace {
+std::vector<interval> get_runs(row_bitmap &bm) {
+    std::vector<interval> runs;
+    bm.for_each_run([&](da_int lo, da_int hi) { runs.push_back({lo, hi}); });
+    return runs;
+}
+
+void expect_runs(row_bitmap &bm, std::vector<interval> expected) {
+    std::vector<interval> runs = get_runs(bm);
+    ASSERT_EQ(runs.size(), expected.size());
+    for (size_t i = 0; i < runs.size(); i++) {
+        EXPECT_EQ(runs[i].lower, expected[i].lower);
+        EXPECT_EQ(runs[i].upper, expected[i].upper);
+    }
+}
+} // namespace
+
+TEST(rowBitmap, invalidInput) {
+    row_bitmap bm;
+    EXPECT_EQ(bm.insert({3, 2}), da_status_invalid_input);
+    EXPECT_EQ(bm.insert({-1, 2}), da_status_invalid_input);
+    EXPECT_EQ(bm.erase({3, 2}), da_status_invalid_input);
+    EXPECT_TRUE(bm.empty());
+    EXPECT_FALSE(bm.contains(-1));
+}
+
+TEST(rowBitmap, insertErase) {
+    row_bitmap bm;
+    EXPECT_EQ(bm.insert({2, 5}), da_status_success);
+    EXPECT_EQ(bm.insert({10, 10}), da_status_success);
+    EXPECT_EQ(bm.insert({6, 7}), da_status_success);
+    expect_runs(bm, {{2, 7}, {10, 10}});
+    EXPECT_EQ(bm.cardinality(), 7);
+    EXPECT_TRUE(bm.contains(6));
+    EXPECT_FALSE(bm.contains(8));
+
+    // Ranges crossing chunk boundaries, large enough to use bitset containers
+    da_int cs = row_bitmap::chunk_size;
+    EXPECT_EQ(bm.insert({cs - 10, 2 * cs + 5}), da_status_success);
+    EXPECT_EQ(bm.n_chunks(), 3);
+    EXPECT_EQ(bm.cardinality(), 7 + cs + 16);
+    expect_runs(bm, {{2, 7}, {10, 10}, {cs - 10, 2 * cs + 5}});
+    EXPECT_EQ(bm.n_runs(), 3);
+
+    // Punch holes
+    EXPECT_EQ(bm.erase({cs, cs + 3}), da_status_success);
+    EXPECT_EQ(bm.erase({cs + 100, cs + 100}), da_status_success);
+    expect_runs(bm, {{2, 7},
+                     {10, 10},
+                     {cs - 10, cs - 1},
+                     {cs + 4, cs + 99},
+                     {cs + 101, 2 * cs + 5}});
+    EXPECT_FALSE(bm.contains(cs + 100));
+    EXPECT_TRUE(bm.contains(cs + 101));
+
+    // Shrink a bitset container back to an array, remove empty chunks
+    EXPECT_EQ(bm.erase({cs + 10, 2 * cs - 1}), da_status_success);
+    expect_runs(
+        bm, {{2, 7}, {10, 10}, {cs - 10, cs - 1}, {cs + 4, cs + 9}, {2 * cs, 2 * cs + 5}});
+    EXPECT_EQ(bm.erase({0, 2 * cs - 1}), da_status_success);
+    EXPECT_EQ(bm.n_chunks(), 1);
+    EXPECT_EQ(bm.chunk_first_row(0), 2 * cs);
+    EXPECT_EQ(bm.chunk_cardinality(0), 6);
+    bm.clear();
+    EXPECT_TRUE(bm.empty());
+    EXPECT_EQ(bm.cardinality(), 0);
+}
+
+TEST(rowBitmap, mask) {
+    // Every third row, over 3 chunks: the first ones are stored as bitsets
+    da_int n = 2 * row_bitmap::chunk_size + 1000;
+    std::vector<uint8_t> mask(n, 0);
+    for (da_int i = 0; i < n; i += 3)
+        mask[i] = 1;
+    row_bitmap bm;
+    bm.assign_mask(n, mask.data());
+    EXPECT_EQ(bm.n_chunks(), 3);
+    EXPECT_EQ(bm.cardinality(), (n + 2) / 3);
+    EXPECT_EQ(bm.n_runs(), (n + 2) / 3);
+    std::vector<uint8_t> mask_out(n, 0);
+    bm.fill_mask(n, mask_out.data());
+    EXPECT_EQ(mask, mask_out);
+
+    da_int n_wrong = 0, k = 0, prev = -1;
+    for (da_int c = 0; c < bm.n_chunks(); c++) {
+        bm.for_each_run(c, [&](da_int lo, da_int hi) {
+            n_wrong += lo != hi || lo != 3 * k || lo <= prev;
+            prev = hi;
+            k++;
+        });
+    }
+    EXPECT_EQ(n_wrong, 0);
+    EXPECT_EQ(k, bm.cardinality());
+
+    // Fill the gaps
+    for (da_int i = 0; i < n - 3; i += 3)
+        EXPECT_EQ(bm.insert({i + 1, i + 2}), da_status_success);
+    expect_runs(bm, {{0, n - 3}});
+}
@@ -35,7 +35,6 @@
 #include "../utest_utils.hpp"
 #include "aoclda.h"
 #include "da_error.hpp"
-#include "da_vector.hpp"
 #include "radius_neighbors.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -50,6 +49,21 @@ template <typename T> class DBSCANTest : public testing::Test {
 using FloatTypes = ::testing::Types<float, double>;
 TYPED_TEST_SUITE(DBSCANTest, FloatTypes);
 
+// Check the CSR radius neighbors against the expected (sorted) neighbors of each sample
+void check_neighbors(std::vector<da_int> &offsets, std::vector<da_int> &indices,
+                     std::vector<std::vector<da_int>> &neighbors_exp) {
+    da_int n_samples = (da_int)neighbors_exp.size();
+    ASSERT_EQ((da_int)offsets.size(), n_samples + 1);
+    EXPECT_EQ(offsets[0], 0);
+    EXPECT_EQ((da_int)indices.size(), offsets[n_samples]);
+    for (da_int i = 0; i < n_samples; i++) {
+        ASSERT_EQ(offsets[i + 1] - offsets[i], (da_int)neighbors_exp[i].size());
+        for (da_int j = 0; j < (da_int)neighbors_exp[i].size(); j++) {
+            EXPECT_EQ(indices[offsets[i] + j], neighbors_exp[i][j]);
+        }
+    }
+}
+
 TYPED_TEST(DBSCANTest, radius_neighbors_small) {
 
     da_int n_samples = 10;
@@ -62,34 +76,26 @@ TYPED_TEST(DBSCANTest, radius_neighbors_small) {
 
     std::vector<TypeParam> A = convert_vector<double, TypeParam>(A_double);
 
-    std::vector<da_vector::da_vector<da_int>> neighbors(n_samples);
+    std::vector<da_int> offsets, indices;
 
-    std::vector<da_vector::da_vector<da_int>> neighbors_exp(n_samples);
-    neighbors_exp[0].append(std::vector<da_int>{3, 4, 6, 7});
-    neighbors_exp[1].append(std::vector<da_int>{2, 8, 9});
-    neighbors_exp[2].append(std::vector<da_int>{1, 8, 9});
-    neighbors_exp[3].append(std::vector<da_int>{0, 4, 6, 7});
-    neighbors_exp[4].append(std::vector<da_int>{0, 3, 6, 7});
-    neighbors_exp[6].append(std::vector<da_int>{0, 3, 4, 7});
-    neighbors_exp[7].append(std::vector<da_int>{0, 3, 4, 6});
-    neighbors_exp[8].append(std::vector<da_int>{1, 2, 9});
-    neighbors_exp[9].append(std::vector<da_int>{1, 2, 8});
+    std::vector<std::vector<da_int>> neighbors_exp(n_samples);
+    neighbors_exp[0] = {3, 4, 6, 7};
+    neighbors_exp[1] = {2, 8, 9};
+    neighbors_exp[2] = {1, 8, 9};
+    neighbors_exp[3] = {0, 4, 6, 7};
+    neighbors_exp[4] = {0, 3, 6, 7};
+    neighbors_exp[6] = {0, 3, 4, 7};
+    neighbors_exp[7] = {0, 3, 4, 6};
+    neighbors_exp[8] = {1, 2, 9};
+    neighbors_exp[9] = {1, 2, 8};
 
     da_errors::da_error_t *err =
         new da_errors::da_error_t(da_errors::action_t::DA_RECORD);
 
     EXPECT_EQ(TEST_ARCH::da_radius_neighbors::radius_neighbors(
-                  n_samples, n_features, A.data(), lda, eps, neighbors, err),
+                  n_samples, n_features, A.data(), lda, eps, 0, offsets, indices, err),
               da_status_success);
-
-    // In-place sort to allow for different ordering of stored indices in neighbors
-    for (da_int i = 0; i < n_samples; i++) {
-        std::sort(neighbors[i].data(), neighbors[i].data() + neighbors[i].size());
-        EXPECT_EQ(neighbors[i].size(), neighbors_exp[i].size());
-        for (da_int j = 0; j < (da_int)neighbors[i].size(); j++) {
-            EXPECT_EQ((neighbors[i])[j], (neighbors_exp[i])[j]);
-        }
-    }
+    check_neighbors(offsets, indices, neighbors_exp);
 
     delete err;
 }
@@ -104,29 +110,24 @@ TYPED_TEST(DBSCANTest, radius_neighbors_large) {
     std::vector<TypeParam> A(n_samples);
     std::iota(A.begin(), A.end(), 0);
 
-    std::vector<da_vector::da_vector<da_int>> neighbors(n_samples);
-
-    std::vector<da_vector::da_vector<da_int>> neighbors_exp(n_samples);
+    std::vector<std::vector<da_int>> neighbors_exp(n_samples);
     for (da_int i = 1; i < n_samples - 1; i++) {
-        neighbors_exp[i].append(std::vector<da_int>{i - 1, i + 1});
+        neighbors_exp[i] = {i - 1, i + 1};
     }
-    neighbors_exp[0].push_back(1);
-    neighbors_exp[n_samples - 1].push_back(n_samples - 2);
+    neighbors_exp[0] = {1};
+    neighbors_exp[n_samples - 1] = {n_samples - 2};
 
     da_errors::da_error_t *err =
         new da_errors::da_error_t(da_errors::action_t::DA_RECORD);
 
-    EXPECT_EQ(TEST_ARCH::da_radius_neighbors::radius_neighbors(
-                  n_samples, n_features, A.data(), lda, eps, neighbors, err),
-              da_status_success);
-
-    // In-place sort to allow for different ordering of stored indices in neighbors
-    for (da_int i = 0; i < n_samples; i++) {
-        std::sort(neighbors[i].data(), neighbors[i].data() + neighbors[i].size());
-        EXPECT_EQ(neighbors[i].size(), neighbors_exp[i].size());
-        for (da_int j = 0; j < (da_int)neighbors[i].size(); j++) {
-            EXPECT_EQ((neighbors[i])[j], (neighbors_exp[i])[j]);
-        }
+    // Default tiles, then tiles bounded by the max memory argument
+    for (da_int max_memory : {0, 1}) {
+        std::vector<da_int> offsets, indices;
+        EXPECT_EQ(TEST_ARCH::da_radius_neighbors::radius_neighbors(
+                      n_samples, n_features, A.data(), lda, eps, max_memory, offsets,
+                      indices, err),
+                  da_status_success);
+        check_neighbors(offsets, indices, neighbors_exp);
     }
 
     delete err;
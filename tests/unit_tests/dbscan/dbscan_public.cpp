@@ -30,6 +30,7 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <random>
 #include <stdio.h>
 #include <string.h>
 
@@ -173,7 +174,70 @@ TYPED_TEST(DBSCANTest, DBSCANFunctionality) {
     }
 }
 
-TYPED_TEST(DBSCANTest, MultipleCalls) {}
+TYPED_TEST(DBSCANTest, MultipleCalls) {
+    // Compute the clusters of the same data repeatedly, alternating between the parallel and
+    // the serial labelling: core samples must be labelled identically, since both number the
+    // clusters by their smallest core sample, and a border sample may join any neighboring
+    // cluster but never becomes noise
+    da_int n_samples = 500, n_features = 2;
+    std::vector<TypeParam> A(n_samples * n_features);
+    std::mt19937 gen(42);
+    std::normal_distribution<TypeParam> d(0, 1);
+    for (da_int i = 0; i < n_samples; i++) {
+        TypeParam centre = (TypeParam)(4 * (i % 5));
+        A[i] = centre + d(gen);
+        A[i + n_samples] = d(gen);
+    }
+
+    da_handle handle = nullptr;
+    ASSERT_EQ(da_handle_init<TypeParam>(&handle, da_handle_dbscan), da_status_success);
+    EXPECT_EQ(da_options_set(handle, "eps", (TypeParam)0.3), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "min samples", 6), da_status_success);
+    EXPECT_EQ(da_dbscan_set_data(handle, n_samples, n_features, A.data(), n_samples),
+              da_status_success);
+
+    std::vector<std::vector<da_int>> labels(4, std::vector<da_int>(n_samples)),
+        core_samples(4);
+    std::vector<da_int> n_clusters(4);
+    const char *algorithms[4] = {"brute", "brute serial", "brute", "brute serial"};
+    da_int one = 1;
+    for (da_int k = 0; k < 4; k++) {
+        EXPECT_EQ(da_options_set_string(handle, "algorithm", algorithms[k]),
+                  da_status_success);
+        EXPECT_EQ(da_dbscan_compute<TypeParam>(handle), da_status_success);
+        EXPECT_EQ(da_handle_get_result(handle, da_dbscan_n_clusters, &one, &n_clusters[k]),
+                  da_status_success);
+        EXPECT_EQ(da_handle_get_result(handle, da_dbscan_labels, &n_samples,
+                                       labels[k].data()),
+                  da_status_success);
+        da_int n_core_samples = 0;
+        EXPECT_EQ(
+            da_handle_get_result(handle, da_dbscan_n_core_samples, &one, &n_core_samples),
+            da_status_success);
+        core_samples[k].resize(n_core_samples);
+        if (n_core_samples > 0) {
+            EXPECT_EQ(da_handle_get_result(handle, da_dbscan_core_sample_indices,
+                                           &n_core_samples, core_samples[k].data()),
+                      da_status_success);
+        }
+    }
+    da_handle_destroy(&handle);
+
+    EXPECT_GT(n_clusters[0], 1);
+    for (da_int k = 1; k < 4; k++) {
+        EXPECT_EQ(n_clusters[k], n_clusters[0]);
+        EXPECT_EQ(core_samples[k], core_samples[0]);
+        for (da_int i = 0; i < n_samples; i++) {
+            bool is_core = std::binary_search(core_samples[0].begin(),
+                                              core_samples[0].end(), i);
+            if (is_core || labels[0][i] == -1) {
+                EXPECT_EQ(labels[k][i], labels[0][i]);
+            } else {
+                EXPECT_GE(labels[k][i], 0);
+            }
+        }
+    }
+}
 
 TYPED_TEST(DBSCANTest, ErrorExits) {
 
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Check that two labellings define the same partition of the samples, with the same
+   noise samples */
+void expect_same_partition(std::vector<da_int> &labels1, std::vector<da_int> &labels2) {
+    ASSERT_EQ(labels1.size(), labels2.size());
+    std::map<da_int, da_int> map12, map21;
+    for (size_t i = 0; i < labels1.size(); i++) {
+        ASSERT_EQ(labels1[i] == -1, labels2[i] == -1) << "at sample " << i;
+        if (labels1[i] == -1)
+            continue;
+        auto it12 = map12.emplace(labels1[i], labels2[i]).first;
+        auto it21 = map21.emplace(labels2[i], labels1[i]).first;
+        EXPECT_EQ(it12->second, labels2[i]) << "at sample " << i;
+        EXPECT_EQ(it21->second, labels1[i]) << "at sample " << i;
+    }
+}
+
+/* n_blobs well separated Gaussian blobs of n_per_blob samples, followed by n_outliers
+   samples far from all the blobs, stored in column-major order */
+template <typename T>
+void make_blobs(da_int n_blobs, da_int n_per_blob, da_int n_outliers, da_int n_features,
+                std::vector<T> &A) {
+    da_int n_samples = n_blobs * n_per_blob + n_outliers;
+    A.resize(n_samples * n_features);
+    std::mt19937 gen(42);
+    std::normal_distribution<double> normal(0.0, 0.5);
+    for (da_int b = 0; b < n_blobs; b++) {
+        for (da_int i = b * n_per_blob; i < (b + 1) * n_per_blob; i++) {
+            for (da_int j = 0; j < n_features; j++)
+                A[i + j * n_samples] = (T)(10.0 * b * (j == 0) + normal(gen));
+        }
+    }
+    for (da_int i = n_blobs * n_per_blob; i < n_samples; i++) {
+        for (da_int j = 0; j < n_features; j++)
+            A[i + j * n_samples] = (T)(100.0 + 50.0 * (i - n_blobs * n_per_blob));
+    }
+}
+
+template <typename T> class HDBSCANTest : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(HDBSCANTest, FloatTypes);
+
+TYPED_TEST(HDBSCANTest, Blobs) {
+    da_int n_blobs = 3, n_per_blob = 60, n_outliers = 4, n_features = 2;
+    da_int n_samples = n_blobs * n_per_blob + n_outliers;
+    std::vector<TypeParam> A;
+    make_blobs(n_blobs, n_per_blob, n_outliers, n_features, A);
+
+    for (std::string method : {"eom", "leaf"}) {
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_hdbscan),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "min cluster size", 10), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "min samples", 5), da_status_success);
+        EXPECT_EQ(
+            da_options_set_string(handle, "cluster selection method", method.c_str()),
+            da_status_success);
+        EXPECT_EQ(da_hdbscan_set_data(handle, n_samples, n_features, A.data(), n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_success);
+
+        da_int n_clusters, one = 1;
+        EXPECT_EQ(da_handle_get_result(handle, da_hdbscan_n_clusters, &one, &n_clusters),
+                  da_status_success);
+        EXPECT_EQ(n_clusters, n_blobs) << "method " << method;
+
+        std::vector<da_int> labels(n_samples), labels_exp(n_samples);
+        EXPECT_EQ(
+            da_handle_get_result(handle, da_hdbscan_labels, &n_samples, labels.data()),
+            da_status_success);
+        for (da_int i = 0; i < n_samples; i++)
+            labels_exp[i] = i < n_blobs * n_per_blob ? i / n_per_blob : -1;
+        if (method == "eom") {
+            expect_same_partition(labels, labels_exp);
+        } else {
+            // Leaf clusters may leave the sparse edges of the blobs as noise
+            for (da_int i = n_blobs * n_per_blob; i < n_samples; i++)
+                EXPECT_EQ(labels[i], -1);
+        }
+
+        std::vector<TypeParam> probabilities(n_samples);
+        EXPECT_EQ(da_handle_get_result(handle, da_hdbscan_probabilities, &n_samples,
+                                       probabilities.data()),
+                  da_status_success);
+        for (da_int i = 0; i < n_samples; i++) {
+            EXPECT_GE(probabilities[i], (TypeParam)0);
+            EXPECT_LE(probabilities[i], (TypeParam)1);
+            if (labels[i] == -1) {
+                EXPECT_EQ(probabilities[i], (TypeParam)0);
+            }
+        }
+
+        da_int dim = 6;
+        std::vector<TypeParam> rinfo(dim);
+        EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+                  da_status_success);
+        EXPECT_EQ(rinfo[0], (TypeParam)n_samples);
+        EXPECT_EQ(rinfo[1], (TypeParam)n_features);
+        EXPECT_EQ(rinfo[3], (TypeParam)5);
+        EXPECT_EQ(rinfo[4], (TypeParam)10);
+        EXPECT_EQ(rinfo[5], (TypeParam)n_clusters);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(HDBSCANTest, SpanningTree) {
+    // Random data: check the core distances and the minimum spanning tree against a
+    // brute-force computation with Prim's algorithm
+    da_int n_samples = 150, n_features = 3, min_samples = 4;
+    std::vector<TypeParam> A(n_samples * n_features);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (auto &a : A)
+        a = (TypeParam)uniform(gen);
+
+    std::vector<double> dist(n_samples * n_samples), core(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        for (da_int j = 0; j < n_samples; j++) {
+            double d = 0;
+            for (da_int k = 0; k < n_features; k++) {
+                double diff = (double)A[i + k * n_samples] - (double)A[j + k * n_samples];
+                d += diff * diff;
+            }
+            dist[i + j * n_samples] = std::sqrt(d);
+        }
+    }
+    for (da_int i = 0; i < n_samples; i++) {
+        std::vector<double> row(dist.begin() + i * n_samples,
+                                dist.begin() + (i + 1) * n_samples);
+        std::sort(row.begin(), row.end());
+        core[i] = row[min_samples - 1];
+    }
+    double mst_weight = 0;
+    std::vector<double> key(n_samples, std::numeric_limits<double>::infinity());
+    std::vector<bool> in_tree(n_samples, false);
+    key[0] = 0;
+    for (da_int it = 0; it < n_samples; it++) {
+        da_int u = -1;
+        for (da_int i = 0; i < n_samples; i++) {
+            if (!in_tree[i] && (u < 0 || key[i] < key[u]))
+                u = i;
+        }
+        in_tree[u] = true;
+        mst_weight += key[u];
+        for (da_int v = 0; v < n_samples; v++) {
+            double w = std::max({dist[u + v * n_samples], core[u], core[v]});
+            if (!in_tree[v] && w < key[v])
+                key[v] = w;
+        }
+    }
+
+    TypeParam tol = 100 * std::sqrt(std::numeric_limits<TypeParam>::epsilon());
+    std::vector<TypeParam> slt_ref;
+    // Default tiles, then small tiles bounded by the max memory option
+    for (da_int max_memory : {0, 1}) {
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_hdbscan),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "min samples", min_samples),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "max memory", max_memory),
+                  da_status_success);
+        EXPECT_EQ(da_hdbscan_set_data(handle, n_samples, n_features, A.data(), n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_success);
+
+        std::vector<TypeParam> core_distances(n_samples);
+        EXPECT_EQ(da_handle_get_result(handle, da_hdbscan_core_distances, &n_samples,
+                                       core_distances.data()),
+                  da_status_success);
+        for (da_int i = 0; i < n_samples; i++)
+            EXPECT_NEAR(core_distances[i], core[i], tol);
+
+        da_int dim = 4 * (n_samples - 1);
+        std::vector<TypeParam> slt(dim);
+        EXPECT_EQ(da_handle_get_result(handle, da_hdbscan_single_linkage_tree, &dim,
+                                       slt.data()),
+                  da_status_success);
+        da_int n_merges = n_samples - 1;
+        double weight = 0;
+        for (da_int k = 0; k < n_merges; k++) {
+            weight += slt[k + 2 * n_merges];
+            if (k > 0) {
+                EXPECT_LE(slt[k - 1 + 2 * n_merges], slt[k + 2 * n_merges]);
+            }
+            // Merged nodes must already exist
+            EXPECT_LT(slt[k], (TypeParam)(n_samples + k));
+            EXPECT_LT(slt[k + n_merges], (TypeParam)(n_samples + k));
+        }
+        EXPECT_EQ(slt[n_merges - 1 + 3 * n_merges], (TypeParam)n_samples);
+        EXPECT_NEAR(weight, mst_weight, n_samples * tol);
+        if (max_memory == 0) {
+            slt_ref = slt;
+        } else {
+            EXPECT_ARR_NEAR(dim, slt, slt_ref, tol);
+        }
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(HDBSCANTest, DBSCANLabels) {
+    // The DBSCAN* labels extracted for several values of eps must match the core samples
+    // of DBSCAN runs on the same data
+    da_int n_blobs = 3, n_per_blob = 40, n_outliers = 3, n_features = 2, min_samples = 6;
+    da_int n_samples = n_blobs * n_per_blob + n_outliers;
+    std::vector<TypeParam> A;
+    make_blobs(n_blobs, n_per_blob, n_outliers, n_features, A);
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_hdbscan), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "min samples", min_samples), da_status_success);
+    EXPECT_EQ(da_hdbscan_set_data(handle, n_samples, n_features, A.data(), n_samples),
+              da_status_success);
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_success);
+
+    for (TypeParam eps : {0.2, 0.35, 0.5, 1.0, 3.0, 20.0}) {
+        std::vector<da_int> labels(n_samples);
+        EXPECT_EQ(da_hdbscan_dbscan_labels(handle, eps, n_samples, labels.data()),
+                  da_status_success);
+
+        da_handle handle_dbscan = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle_dbscan, da_handle_dbscan),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(handle_dbscan, "min samples", min_samples),
+                  da_status_success);
+        EXPECT_EQ(da_options_set(handle_dbscan, "eps", eps), da_status_success);
+        EXPECT_EQ(da_dbscan_set_data(handle_dbscan, n_samples, n_features, A.data(),
+                                     n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_dbscan_compute<TypeParam>(handle_dbscan), da_status_success);
+        da_int n_core, one = 1;
+        EXPECT_EQ(
+            da_handle_get_result(handle_dbscan, da_dbscan_n_core_samples, &one, &n_core),
+            da_status_success);
+        std::vector<da_int> labels_dbscan(n_samples), core_indices(std::max(n_core, 1));
+        EXPECT_EQ(da_handle_get_result(handle_dbscan, da_dbscan_labels, &n_samples,
+                                       labels_dbscan.data()),
+                  da_status_success);
+        if (n_core > 0) {
+            EXPECT_EQ(da_handle_get_result(handle_dbscan, da_dbscan_core_sample_indices,
+                                           &n_core, core_indices.data()),
+                      da_status_success);
+        }
+
+        // Border samples of DBSCAN are noise in DBSCAN*
+        std::vector<da_int> labels_core(n_samples, -1);
+        for (da_int i = 0; i < n_core; i++)
+            labels_core[core_indices[i]] = labels_dbscan[core_indices[i]];
+        expect_same_partition(labels, labels_core);
+        da_handle_destroy(&handle_dbscan);
+    }
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(HDBSCANTest, ErrorExits) {
+
+    da_handle handle = nullptr;
+    std::vector<TypeParam> A{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    da_int n_samples = 4, n_features = 3, lda = 4;
+    da_int results_arr_int[4];
+    TypeParam results_arr[1];
+    da_int dim = 1;
+
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_hdbscan), da_status_success);
+
+    // error exits to do with routines called in the wrong order
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_no_data);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, results_arr),
+              da_status_no_data);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_hdbscan_labels, &dim, results_arr_int),
+              da_status_no_data);
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, (TypeParam)1, n_samples, results_arr_int),
+              da_status_no_data);
+
+    // compute error exits
+    EXPECT_EQ(da_hdbscan_set_data(handle, n_samples, n_features, A.data(), lda),
+              da_status_success);
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_int(handle, "min samples", 2), da_status_success);
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_success);
+
+    // dbscan labels error exits
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, (TypeParam)1, n_samples, nullptr),
+              da_status_invalid_pointer);
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, (TypeParam)1, 3, results_arr_int),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, (TypeParam)-1, n_samples, results_arr_int),
+              da_status_invalid_input);
+
+    // get results error exits
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_linmod_coef, &dim, results_arr),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_rinfo, &dim, results_arr_int),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 6);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_hdbscan_single_linkage_tree, &dim,
+                                   results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 12);
+    dim = 0;
+    EXPECT_EQ(da_handle_get_result_int(handle, da_hdbscan_labels, &dim, results_arr_int),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 4);
+
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(HDBSCANTest, BadHandleTests) {
+
+    // handle not initialized
+    da_handle handle = nullptr;
+    TypeParam A = 1;
+    da_int label;
+
+    EXPECT_EQ(da_hdbscan_set_data(handle, 1, 1, &A, 1), da_status_handle_not_initialized);
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_handle_not_initialized);
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, A, 1, &label),
+              da_status_handle_not_initialized);
+
+    // Incorrect handle type
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_dbscan), da_status_success);
+
+    EXPECT_EQ(da_hdbscan_set_data(handle, 1, 1, &A, 1), da_status_invalid_handle_type);
+    EXPECT_EQ(da_hdbscan_compute<TypeParam>(handle), da_status_invalid_handle_type);
+    EXPECT_EQ(da_hdbscan_dbscan_labels(handle, A, 1, &label),
+              da_status_invalid_handle_type);
+
+    da_handle_destroy(&handle);
+}
+
+TEST(HDBSCANTest, IncorrectHandlePrecision) {
+    da_handle handle_d = nullptr;
+    da_handle handle_s = nullptr;
+
+    EXPECT_EQ(da_handle_init_d(&handle_d, da_handle_hdbscan), da_status_success);
+    EXPECT_EQ(da_handle_init_s(&handle_s, da_handle_hdbscan), da_status_success);
+
+    double Ad = 0.0;
+    float As = 0.0f;
+    da_int label;
+
+    EXPECT_EQ(da_hdbscan_set_data_d(handle_s, 1, 1, &Ad, 1), da_status_wrong_type);
+    EXPECT_EQ(da_hdbscan_set_data_s(handle_d, 1, 1, &As, 1), da_status_wrong_type);
+
+    EXPECT_EQ(da_hdbscan_compute_d(handle_s), da_status_wrong_type);
+    EXPECT_EQ(da_hdbscan_compute_s(handle_d), da_status_wrong_type);
+
+    EXPECT_EQ(da_hdbscan_dbscan_labels_d(handle_s, 1.0, 1, &label), da_status_wrong_type);
+    EXPECT_EQ(da_hdbscan_dbscan_labels_s(handle_d, 1.0f, 1, &label),
+              da_status_wrong_type);
+
+    da_handle_destroy(&handle_d);
+    da_handle_destroy(&handle_s);
+}
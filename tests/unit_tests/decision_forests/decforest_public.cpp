@@ -559,3 +559,223 @@ TEST(forest, row_major) {
     EXPECT_NEAR(mean_accuracy, mean_accuracy_row,
                 10 * std::numeric_limits<float>::epsilon());
 }
+
+TEST(forest, training_data_from_store) {
+
+    std::string input_data_fname =
+        std::string(DATA_DIR) + "/df_data/gen_200x10_3class_data.csv";
+    da_datastore csv_store = nullptr;
+    EXPECT_EQ(da_datastore_init(&csv_store), da_status_success);
+    EXPECT_EQ(da_data_load_from_csv(csv_store, input_data_fname.c_str()),
+              da_status_success);
+    da_int ncols, nrows;
+    EXPECT_EQ(da_data_get_n_cols(csv_store, &ncols), da_status_success);
+    EXPECT_EQ(da_data_get_n_rows(csv_store, &nrows), da_status_success);
+    da_int n_features = ncols - 1, n_samples = nrows;
+    EXPECT_EQ(da_data_select_columns(csv_store, "features", 0, ncols - 2),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(csv_store, "response", ncols - 1, ncols - 1),
+              da_status_success);
+    std::vector<double> X(n_features * n_samples);
+    std::vector<da_int> y(n_samples);
+    EXPECT_EQ(da_data_extract_selection(csv_store, "features", column_major, X.data(),
+                                        n_samples),
+              da_status_success);
+    EXPECT_EQ(da_data_extract_selection(csv_store, "response", column_major, y.data(),
+                                        n_samples),
+              da_status_success);
+
+    // Fit the same forest from the extracted data and directly from the store
+    std::vector<da_int> y_pred(n_samples), y_pred_store(n_samples);
+    for (bool from_store : {false, true}) {
+        da_handle forest_handle = nullptr;
+        EXPECT_EQ(da_handle_init<double>(&forest_handle, da_handle_decision_forest),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(forest_handle, "maximum depth", 5),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(forest_handle, "seed", 77), da_status_success);
+        if (from_store)
+            EXPECT_EQ(da_forest_set_training_data_from_store_d(forest_handle, csv_store, 0,
+                                                               "features", "response"),
+                      da_status_success);
+        else
+            EXPECT_EQ(da_forest_set_training_data(forest_handle, n_samples, n_features, 0,
+                                                  X.data(), n_samples, y.data()),
+                      da_status_success);
+        EXPECT_EQ(da_forest_fit<double>(forest_handle), da_status_success);
+        EXPECT_EQ(da_forest_predict(forest_handle, n_samples, n_features, X.data(),
+                                    n_samples, from_store ? y_pred_store.data()
+                                                          : y_pred.data()),
+                  da_status_success);
+
+        if (from_store) {
+            // The labels must be given as a single integer column
+            EXPECT_EQ(da_forest_set_training_data_from_store_d(forest_handle, csv_store, 0,
+                                                               "features", "features"),
+                      da_status_invalid_input);
+            EXPECT_EQ(da_forest_set_training_data_from_store_d(forest_handle, csv_store, 0,
+                                                               "features", "labels"),
+                      da_status_invalid_input);
+            EXPECT_EQ(da_forest_set_training_data_from_store_s(forest_handle, csv_store, 0,
+                                                               "features", "response"),
+                      da_status_wrong_type);
+        }
+        da_handle_destroy(&forest_handle);
+    }
+    EXPECT_ARR_EQ(n_samples, y_pred, y_pred_store, 1, 1, 0, 0);
+    da_datastore_destroy(&csv_store);
+}
+
+template <typename T> void test_forest_regression(std::string criterion) {
+    // Step function of the first feature, the second feature is noise
+    da_int n_samples = 60, n_features = 2;
+    std::vector<T> X(n_samples * n_features), y(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        X[i] = (T)i;
+        X[n_samples + i] = (T)((11 * i) % 17);
+        y[i] = i < 20 ? (T)-1.0 : (i < 40 ? (T)3.0 : (T)0.5);
+    }
+    std::vector<T> y_pred(n_samples);
+    T score, tol = 10 * std::numeric_limits<T>::epsilon();
+
+    // Without bootstrapping and with all the features, every tree fits the data exactly
+    da_handle forest_handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&forest_handle, da_handle_decision_forest),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(forest_handle, "seed", 5), da_status_success);
+    EXPECT_EQ(da_options_set_int(forest_handle, "number of trees", 8), da_status_success);
+    EXPECT_EQ(da_options_set_string(forest_handle, "bootstrap", "no"), da_status_success);
+    EXPECT_EQ(da_options_set_string(forest_handle, "features selection", "all"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(forest_handle, "scoring function", criterion.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_forest_set_regression_data(forest_handle, n_samples, n_features,
+                                            X.data(), n_samples, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_forest_fit<T>(forest_handle), da_status_success);
+    EXPECT_EQ(da_forest_predict_regression(forest_handle, n_samples, n_features,
+                                           X.data(), n_samples, y_pred.data()),
+              da_status_success);
+    T *yp = y_pred.data(), *yt = y.data();
+    EXPECT_ARR_NEAR(n_samples, yp, yt, tol);
+    EXPECT_EQ(da_forest_score_regression(forest_handle, n_samples, n_features, X.data(),
+                                         n_samples, y.data(), &score),
+              da_status_success);
+    EXPECT_NEAR(score, (T)1.0, tol);
+
+    // Randomized forest: the average of the trees still explains most of the variance
+    EXPECT_EQ(da_options_set_string(forest_handle, "bootstrap", "yes"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(forest_handle, "features selection", "sqrt"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(forest_handle, "number of trees", 50),
+              da_status_success);
+    EXPECT_EQ(da_forest_fit<T>(forest_handle), da_status_success);
+    EXPECT_EQ(da_forest_score_regression(forest_handle, n_samples, n_features, X.data(),
+                                         n_samples, y.data(), &score),
+              da_status_success);
+    EXPECT_GT(score, (T)0.9);
+
+    // The classification APIs are not available for a regression model
+    std::vector<da_int> y_class(n_samples);
+    EXPECT_EQ(da_forest_predict(forest_handle, n_samples, n_features, X.data(),
+                                n_samples, y_class.data()),
+              da_status_no_data);
+    da_handle_destroy(&forest_handle);
+}
+
+TEST(forest, regression) {
+    test_forest_regression<double>("squared-error");
+    test_forest_regression<double>("absolute-error");
+    test_forest_regression<float>("mse");
+    test_forest_regression<float>("mae");
+}
+
+TEST(forest, regression_invalid) {
+    da_int n_samples = 6, n_features = 1, n_class = 2;
+    std::vector<float> X = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    std::vector<float> y = {0.5f, 0.5f, 0.5f, 2.0f, 2.0f, 2.0f};
+    std::vector<da_int> labels = {0, 0, 0, 1, 1, 1};
+    std::vector<float> y_pred(n_samples);
+    float score;
+
+    da_handle forest_handle = nullptr;
+    EXPECT_EQ(da_handle_init<float>(&forest_handle, da_handle_decision_forest),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(forest_handle, "scoring function", "mae"),
+              da_status_success);
+    EXPECT_EQ(da_forest_set_training_data(forest_handle, n_samples, n_features, n_class,
+                                          X.data(), n_samples, labels.data()),
+              da_status_success);
+    EXPECT_EQ(da_forest_fit<float>(forest_handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(forest_handle, "scoring function", "gini"),
+              da_status_success);
+    EXPECT_EQ(da_forest_fit<float>(forest_handle), da_status_success);
+    EXPECT_EQ(da_forest_predict_regression(forest_handle, n_samples, n_features,
+                                           X.data(), n_samples, y_pred.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_forest_score_regression(forest_handle, n_samples, n_features, X.data(),
+                                         n_samples, y.data(), &score),
+              da_status_no_data);
+    da_handle_destroy(&forest_handle);
+}
+
+TEST(forest, regression_data_from_store) {
+    std::string input_data_fname =
+        std::string(DATA_DIR) + "/df_data/gen_200x10_3class_data.csv";
+    da_datastore csv_store = nullptr;
+    EXPECT_EQ(da_datastore_init(&csv_store), da_status_success);
+    EXPECT_EQ(da_data_load_from_csv(csv_store, input_data_fname.c_str()),
+              da_status_success);
+    da_int ncols, nrows;
+    EXPECT_EQ(da_data_get_n_cols(csv_store, &ncols), da_status_success);
+    EXPECT_EQ(da_data_get_n_rows(csv_store, &nrows), da_status_success);
+    // Regress the last feature on the other ones
+    da_int n_features = ncols - 2, n_samples = nrows;
+    EXPECT_EQ(da_data_select_columns(csv_store, "features", 0, ncols - 3),
+              da_status_success);
+    EXPECT_EQ(da_data_select_columns(csv_store, "target", ncols - 2, ncols - 2),
+              da_status_success);
+    std::vector<double> X(n_features * n_samples), y(n_samples);
+    EXPECT_EQ(da_data_extract_selection(csv_store, "features", column_major, X.data(),
+                                        n_samples),
+              da_status_success);
+    EXPECT_EQ(da_data_extract_selection(csv_store, "target", column_major, y.data(),
+                                        n_samples),
+              da_status_success);
+
+    std::vector<double> y_pred(n_samples), y_pred_store(n_samples);
+    for (bool from_store : {false, true}) {
+        da_handle forest_handle = nullptr;
+        EXPECT_EQ(da_handle_init<double>(&forest_handle, da_handle_decision_forest),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_int(forest_handle, "seed", 77), da_status_success);
+        if (from_store)
+            EXPECT_EQ(da_forest_set_regression_data_from_store_d(forest_handle, csv_store,
+                                                                 "features", "target"),
+                      da_status_success);
+        else
+            EXPECT_EQ(da_forest_set_regression_data(forest_handle, n_samples, n_features,
+                                                    X.data(), n_samples, y.data()),
+                      da_status_success);
+        EXPECT_EQ(da_forest_fit<double>(forest_handle), da_status_success);
+        EXPECT_EQ(da_forest_predict_regression(forest_handle, n_samples, n_features,
+                                               X.data(), n_samples,
+                                               from_store ? y_pred_store.data()
+                                                          : y_pred.data()),
+                  da_status_success);
+        if (from_store) {
+            // The target must be a single column
+            EXPECT_EQ(da_forest_set_regression_data_from_store_d(forest_handle, csv_store,
+                                                                 "features", "features"),
+                      da_status_invalid_input);
+            EXPECT_EQ(da_forest_set_regression_data_from_store_s(forest_handle, csv_store,
+                                                                 "features", "target"),
+                      da_status_wrong_type);
+        }
+        da_handle_destroy(&forest_handle);
+    }
+    double *yp = y_pred.data(), *yps = y_pred_store.data();
+    EXPECT_ARR_NEAR(n_samples, yp, yps, 1.0e-12);
+    da_datastore_destroy(&csv_store);
+}
@@ -31,6 +31,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <list>
+#include <random>
 
 using namespace TEST_ARCH::da_decision_forest;
 
@@ -272,3 +273,47 @@ TYPED_TEST(dectree_internal_test, multiple_solve) {
               da_status_success);
     EXPECT_NEAR(accuracy, 1.0, 1.0e-05);
 }
+
+TYPED_TEST(dectree_internal_test, threads_independent) {
+    // Large enough data set for the split searches to be spread over several threads
+    da_int nsamples = 8000, nfeat = 10, nclass = 3;
+    std::vector<TypeParam> X(nsamples * nfeat);
+    std::vector<da_int> y(nsamples);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    for (auto &x : X)
+        x = (TypeParam)unif(gen);
+    for (da_int i = 0; i < nsamples; i++) {
+        double f = X[i] + 2.0 * X[i + nsamples] - X[i + 2 * nsamples] + 0.3 * unif(gen);
+        y[i] = f < 0.5 ? 0 : (f < 1.2 ? 1 : 2);
+    }
+
+    int max_threads = omp_get_max_threads();
+    for (std::string order : {"depth first", "breadth first"}) {
+        std::vector<std::vector<node<TypeParam>>> trees;
+        for (int n_threads : {1, 4}) {
+            omp_set_num_threads(n_threads);
+            da_errors::da_error_t err(da_errors::DA_RECORD);
+            decision_tree<TypeParam> tree(err);
+            EXPECT_EQ(tree.opts.set("tree building order", order), da_status_success);
+            EXPECT_EQ(tree.opts.set("maximum features", (da_int)5), da_status_success);
+            EXPECT_EQ(tree.opts.set("seed", (da_int)7), da_status_success);
+            EXPECT_EQ(tree.set_training_data(nsamples, nfeat, X.data(), nsamples,
+                                             y.data(), nclass),
+                      da_status_success);
+            EXPECT_EQ(tree.fit(), da_status_success);
+            trees.push_back(tree.get_tree());
+        }
+        ASSERT_EQ(trees[0].size(), trees[1].size());
+        for (size_t i = 0; i < trees[0].size(); i++) {
+            EXPECT_EQ(trees[0][i].is_leaf, trees[1][i].is_leaf);
+            EXPECT_EQ(trees[0][i].feature, trees[1][i].feature);
+            EXPECT_EQ(trees[0][i].x_threshold, trees[1][i].x_threshold);
+            EXPECT_EQ(trees[0][i].left_child_idx, trees[1][i].left_child_idx);
+            EXPECT_EQ(trees[0][i].right_child_idx, trees[1][i].right_child_idx);
+            EXPECT_EQ(trees[0][i].n_samples, trees[1][i].n_samples);
+            EXPECT_EQ(trees[0][i].y_pred, trees[1][i].y_pred);
+        }
+    }
+    omp_set_num_threads(max_threads);
+}
@@ -515,3 +515,107 @@ TEST(decision_tree, row_major) {
     EXPECT_NEAR(mean_accuracy, mean_accuracy_row,
                 10 * std::numeric_limits<float>::epsilon());
 }
+
+template <typename T> void test_tree_regression(std::string criterion) {
+    // Two features: the first one determines the target through a step function, the
+    // second one is noise that should never be used for splitting
+    da_int n_samples = 40, n_features = 2;
+    std::vector<T> X(n_samples * n_features), y(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        X[i] = (T)i;
+        X[n_samples + i] = (T)((7 * i) % 13);
+        y[i] = i < 10 ? (T)1.0 : (i < 25 ? (T)-2.0 : (T)4.5);
+    }
+
+    da_handle tree_handle = nullptr;
+    EXPECT_EQ(da_handle_init<T>(&tree_handle, da_handle_decision_tree),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(tree_handle, "seed", 42), da_status_success);
+    EXPECT_EQ(da_options_set_string(tree_handle, "scoring function", criterion.c_str()),
+              da_status_success);
+    EXPECT_EQ(da_tree_set_regression_data(tree_handle, n_samples, n_features, X.data(),
+                                          n_samples, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit<T>(tree_handle), da_status_success);
+
+    std::vector<T> y_pred(n_samples);
+    EXPECT_EQ(da_tree_predict_regression(tree_handle, n_samples, n_features, X.data(),
+                                         n_samples, y_pred.data()),
+              da_status_success);
+    T tol = 10 * std::numeric_limits<T>::epsilon();
+    T *yp = y_pred.data(), *yt = y.data();
+    EXPECT_ARR_NEAR(n_samples, yp, yt, tol);
+    T score;
+    EXPECT_EQ(da_tree_score_regression(tree_handle, n_samples, n_features, X.data(),
+                                       n_samples, y.data(), &score),
+              da_status_success);
+    EXPECT_NEAR(score, (T)1.0, tol);
+
+    // Points between the training observations take the value of their leaf
+    std::vector<T> X_test = {(T)-3.0, (T)4.2, (T)17.5, (T)100.0, 0, 0, 0, 0};
+    std::vector<T> y_test = {(T)1.0, (T)1.0, (T)-2.0, (T)4.5};
+    EXPECT_EQ(da_tree_predict_regression(tree_handle, 4, n_features, X_test.data(), 4,
+                                         y_pred.data()),
+              da_status_success);
+    yt = y_test.data();
+    EXPECT_ARR_NEAR(4, yp, yt, tol);
+
+    // The classification APIs are not available for a regression model
+    std::vector<da_int> y_class(n_samples);
+    EXPECT_EQ(da_tree_predict(tree_handle, n_samples, n_features, X.data(), n_samples,
+                              y_class.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_tree_score(tree_handle, n_samples, n_features, X.data(), n_samples,
+                            y_class.data(), &score),
+              da_status_no_data);
+    da_handle_destroy(&tree_handle);
+}
+
+TEST(decision_tree, regression) {
+    test_tree_regression<double>("squared-error");
+    test_tree_regression<double>("absolute-error");
+    test_tree_regression<float>("mse");
+    test_tree_regression<float>("mae");
+}
+
+TEST(decision_tree, regression_invalid) {
+    da_int n_samples = 6, n_features = 1, n_class = 2;
+    std::vector<double> X = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    std::vector<double> y = {0.5, 0.5, 0.5, 2.0, 2.0, 2.0};
+    std::vector<da_int> labels = {0, 0, 0, 1, 1, 1};
+    std::vector<double> y_pred(n_samples);
+    double score;
+
+    // A regression criterion cannot be used with class labels
+    da_handle tree_handle = nullptr;
+    EXPECT_EQ(da_handle_init<double>(&tree_handle, da_handle_decision_tree),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(tree_handle, "scoring function", "mse"),
+              da_status_success);
+    EXPECT_EQ(da_tree_set_training_data(tree_handle, n_samples, n_features, n_class,
+                                        X.data(), n_samples, labels.data()),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit<double>(tree_handle), da_status_incompatible_options);
+
+    // The regression APIs are not available for a classification model
+    EXPECT_EQ(da_options_set_string(tree_handle, "scoring function", "gini"),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit<double>(tree_handle), da_status_success);
+    EXPECT_EQ(da_tree_predict_regression(tree_handle, n_samples, n_features, X.data(),
+                                         n_samples, y_pred.data()),
+              da_status_no_data);
+    EXPECT_EQ(da_tree_score_regression(tree_handle, n_samples, n_features, X.data(),
+                                       n_samples, y.data(), &score),
+              da_status_no_data);
+
+    // Classification criteria fall back to the squared error on regression data
+    EXPECT_EQ(da_tree_set_regression_data(tree_handle, n_samples, n_features, X.data(),
+                                          n_samples, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_tree_fit<double>(tree_handle), da_status_success);
+    EXPECT_EQ(da_tree_score_regression(tree_handle, n_samples, n_features, X.data(),
+                                       n_samples, y.data(), &score),
+              da_status_success);
+    EXPECT_NEAR(score, 1.0, 1.0e-12);
+    da_handle_destroy(&tree_handle);
+}
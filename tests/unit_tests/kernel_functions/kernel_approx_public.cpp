@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+template <typename T> class KernelApproxTest : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(KernelApproxTest, FloatTypes);
+
+/* n_samples x n_features random data in column-major order */
+template <typename T>
+void random_data(da_int n_samples, da_int n_features, std::vector<T> &A) {
+    A.resize(n_samples * n_features);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (auto &a : A)
+        a = (T)uniform(gen);
+}
+
+/* Largest entry of |Z Z^T - K|, for the m x n_components column-major feature matrix Z
+   and the m x m kernel matrix K */
+template <typename T>
+T max_kernel_error(da_int m, da_int n_components, std::vector<T> &Z, std::vector<T> &K) {
+    T err = 0;
+    for (da_int i = 0; i < m; i++) {
+        for (da_int j = 0; j < m; j++) {
+            T zz = 0;
+            for (da_int c = 0; c < n_components; c++)
+                zz += Z[i + c * m] * Z[j + c * m];
+            err = std::max(err, std::abs(zz - K[i + j * m]));
+        }
+    }
+    return err;
+}
+
+TYPED_TEST(KernelApproxTest, NystroemExact) {
+    // With every sample as a landmark, the Nystroem features reproduce the kernel matrix
+    // of the training data
+    da_int n_samples = 30, n_features = 4;
+    std::vector<TypeParam> A, K(n_samples * n_samples), Z(n_samples * n_samples);
+    random_data(n_samples, n_features, A);
+    TypeParam gamma = 0.5, coef0 = 1.0;
+    da_int degree = 2;
+    TypeParam tol = 100 * std::sqrt(std::numeric_limits<TypeParam>::epsilon());
+
+    for (std::string kernel : {"rbf", "linear", "polynomial"}) {
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "kernel", kernel.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_options_set(handle, "gamma", gamma), da_status_success);
+        EXPECT_EQ(da_options_set(handle, "coef0", coef0), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "degree", degree), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "n components", n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_kernel_approx_set_data(handle, n_samples, n_features, A.data(),
+                                            n_samples),
+                  da_status_success);
+        EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+        EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(),
+                                             n_samples, Z.data(), n_samples),
+                  da_status_success);
+
+        if (kernel == "rbf")
+            da_rbf_kernel(column_major, n_samples, n_samples, n_features, A.data(),
+                          n_samples, (TypeParam *)nullptr, n_samples, K.data(), n_samples,
+                          gamma);
+        else if (kernel == "linear")
+            da_linear_kernel(column_major, n_samples, n_samples, n_features, A.data(),
+                             n_samples, (TypeParam *)nullptr, n_samples, K.data(),
+                             n_samples);
+        else
+            da_polynomial_kernel(column_major, n_samples, n_samples, n_features,
+                                 A.data(), n_samples, (TypeParam *)nullptr, n_samples,
+                                 K.data(), n_samples, gamma, degree, coef0);
+        EXPECT_LT(max_kernel_error(n_samples, n_samples, Z, K), tol) << kernel;
+
+        // The linear kernel matrix has rank n_features
+        da_int dim = 5;
+        std::vector<TypeParam> rinfo(dim);
+        EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+                  da_status_success);
+        EXPECT_EQ(rinfo[0], (TypeParam)n_samples);
+        EXPECT_EQ(rinfo[1], (TypeParam)n_features);
+        EXPECT_EQ(rinfo[2], (TypeParam)n_samples);
+        if (kernel == "linear")
+            EXPECT_EQ(rinfo[4], (TypeParam)n_features);
+        else
+            EXPECT_EQ(rinfo[3], gamma);
+
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(KernelApproxTest, NystroemLandmarks) {
+    da_int n_samples = 50, n_features = 3, n_components = 10;
+    std::vector<TypeParam> A, A_row;
+    random_data(n_samples, n_features, A);
+    A_row.resize(A.size());
+    for (da_int i = 0; i < n_samples; i++)
+        for (da_int j = 0; j < n_features; j++)
+            A_row[i * n_features + j] = A[i + j * n_samples];
+
+    da_handle handle = nullptr, handle_row = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+              da_status_success);
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle_row, da_handle_kernel_approx),
+              da_status_success);
+    for (auto h : {handle, handle_row}) {
+        EXPECT_EQ(da_options_set_int(h, "n components", n_components), da_status_success);
+        EXPECT_EQ(da_options_set_int(h, "seed", 7), da_status_success);
+    }
+    EXPECT_EQ(da_options_set_string(handle_row, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(
+        da_kernel_approx_set_data(handle, n_samples, n_features, A.data(), n_samples),
+        da_status_success);
+    EXPECT_EQ(da_kernel_approx_set_data(handle_row, n_samples, n_features, A_row.data(),
+                                        n_features),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle_row), da_status_success);
+
+    // The landmarks are distinct samples, identical for both storage orders
+    std::vector<da_int> landmarks(n_components), landmarks_row(n_components);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_approx_landmarks, &n_components,
+                                       landmarks.data()),
+              da_status_success);
+    EXPECT_EQ(da_handle_get_result_int(handle_row, da_kernel_approx_landmarks,
+                                       &n_components, landmarks_row.data()),
+              da_status_success);
+    EXPECT_EQ(landmarks, landmarks_row);
+    std::set<da_int> unique(landmarks.begin(), landmarks.end());
+    EXPECT_EQ((da_int)unique.size(), n_components);
+    for (auto l : landmarks) {
+        EXPECT_GE(l, 0);
+        EXPECT_LT(l, n_samples);
+    }
+
+    da_int dim = n_components * n_features;
+    std::vector<TypeParam> components(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim,
+                                   components.data()),
+              da_status_success);
+    for (da_int i = 0; i < n_components; i++)
+        for (da_int j = 0; j < n_features; j++)
+            EXPECT_EQ(components[i + j * n_components], A[landmarks[i] + j * n_samples]);
+
+    // The features of the landmarks reproduce their kernel matrix exactly, and the
+    // kernel between any sample and a landmark
+    std::vector<TypeParam> Z(n_samples * n_components), Z_row(n_samples * n_components);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(),
+                                         n_samples, Z.data(), n_samples),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_transform(handle_row, n_samples, n_features, A_row.data(),
+                                         n_features, Z_row.data(), n_components),
+              da_status_success);
+    TypeParam tol = 100 * std::sqrt(std::numeric_limits<TypeParam>::epsilon());
+    for (da_int i = 0; i < n_samples; i++)
+        for (da_int c = 0; c < n_components; c++)
+            EXPECT_NEAR(Z[i + c * n_samples], Z_row[i * n_components + c], tol);
+
+    std::vector<TypeParam> K(n_samples * n_samples);
+    dim = 5;
+    std::vector<TypeParam> rinfo(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, rinfo.data()),
+              da_status_success);
+    da_rbf_kernel(column_major, n_samples, n_samples, n_features, A.data(), n_samples,
+                  (TypeParam *)nullptr, n_samples, K.data(), n_samples, rinfo[3]);
+    for (da_int i = 0; i < n_samples; i++) {
+        for (auto l : landmarks) {
+            TypeParam zz = 0;
+            for (da_int c = 0; c < n_components; c++)
+                zz += Z[i + c * n_samples] * Z[l + c * n_samples];
+            EXPECT_NEAR(zz, K[i + l * n_samples], tol);
+        }
+    }
+
+    // Default gamma is 1 / (n_features * Var(A))
+    TypeParam mean = 0, var = 0;
+    for (auto a : A)
+        mean += a;
+    mean /= A.size();
+    for (auto a : A)
+        var += (a - mean) * (a - mean);
+    var /= A.size();
+    EXPECT_NEAR(rinfo[3], 1 / (n_features * var), tol);
+
+    da_handle_destroy(&handle);
+    da_handle_destroy(&handle_row);
+}
+
+TYPED_TEST(KernelApproxTest, RandomFourierFeatures) {
+    da_int n_samples = 20, n_features = 3, n_components = 20000;
+    std::vector<TypeParam> A, K(n_samples * n_samples), Z(n_samples * n_components),
+        Z2(n_samples * n_components);
+    random_data(n_samples, n_features, A);
+    TypeParam gamma = 0.8;
+
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "approximation method", "rff"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n components", n_components),
+              da_status_success);
+    EXPECT_EQ(da_options_set(handle, "gamma", gamma), da_status_success);
+    EXPECT_EQ(
+        da_kernel_approx_set_data(handle, n_samples, n_features, A.data(), n_samples),
+        da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(),
+                                         n_samples, Z.data(), n_samples),
+              da_status_success);
+
+    // Monte Carlo estimate of the kernel, with an error of order 1 / sqrt(n_components)
+    da_rbf_kernel(column_major, n_samples, n_samples, n_features, A.data(), n_samples,
+                  (TypeParam *)nullptr, n_samples, K.data(), n_samples, gamma);
+    EXPECT_LT(max_kernel_error(n_samples, n_components, Z, K), (TypeParam)0.05);
+
+    // The same seed gives the same features
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(),
+                                         n_samples, Z2.data(), n_samples),
+              da_status_success);
+    EXPECT_EQ(Z, Z2);
+
+    da_int dim = n_components;
+    std::vector<TypeParam> offsets(dim);
+    EXPECT_EQ(
+        da_handle_get_result(handle, da_kernel_approx_offsets, &dim, offsets.data()),
+        da_status_success);
+    for (auto b : offsets) {
+        EXPECT_GE(b, (TypeParam)0);
+        EXPECT_LE(b, (TypeParam)(2 * 3.14159265358979));
+    }
+    dim = n_components * n_features;
+    std::vector<TypeParam> components(dim);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim,
+                                   components.data()),
+              da_status_success);
+    // The frequencies have variance 2 gamma
+    TypeParam var = 0;
+    for (auto w : components)
+        var += w * w;
+    var /= dim;
+    EXPECT_NEAR(var, 2 * gamma, (TypeParam)0.05);
+
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(KernelApproxTest, ErrorExits) {
+
+    da_handle handle = nullptr;
+    std::vector<TypeParam> A{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    da_int n_samples = 4, n_features = 3, lda = 4;
+    std::vector<TypeParam> X_transform(16);
+    da_int results_arr_int[4];
+    TypeParam results_arr[1];
+    da_int dim = 1;
+
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_kernel_approx),
+              da_status_success);
+
+    // error exits to do with routines called in the wrong order
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_no_data);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(), lda,
+                                         X_transform.data(), n_samples),
+              da_status_no_data);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, results_arr),
+              da_status_no_data);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_approx_landmarks, &dim,
+                                       results_arr_int),
+              da_status_no_data);
+
+    // compute error exits
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n_samples, n_features, A.data(), lda),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_int(handle, "n components", 4), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "approximation method", "rff"),
+              da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", "linear"), da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_incompatible_options);
+    EXPECT_EQ(da_options_set_string(handle, "kernel", "rbf"), da_status_success);
+    std::vector<TypeParam> A_const(12, 1);
+    EXPECT_EQ(
+        da_kernel_approx_set_data(handle, n_samples, n_features, A_const.data(), lda),
+        da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_invalid_input);
+    EXPECT_EQ(da_kernel_approx_set_data(handle, n_samples, n_features, A.data(), lda),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+
+    // transform error exits
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, 2, A.data(), lda,
+                                         X_transform.data(), n_samples),
+              da_status_invalid_input);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(), 1,
+                                         X_transform.data(), n_samples),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(), lda,
+                                         X_transform.data(), 1),
+              da_status_invalid_leading_dimension);
+    EXPECT_EQ(da_kernel_approx_transform(handle, n_samples, n_features, A.data(), lda,
+                                         (TypeParam *)nullptr, n_samples),
+              da_status_invalid_pointer);
+
+    // get results error exits
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_linmod_coef, &dim, results_arr),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_normalization, &dim,
+                                   results_arr),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_approx_landmarks, &dim,
+                                       results_arr_int),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result_int(handle, da_rinfo, &dim, results_arr_int),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_rinfo, &dim, results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 5);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_components, &dim,
+                                   results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 12);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_offsets, &dim, results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 4);
+
+    EXPECT_EQ(da_options_set_string(handle, "approximation method", "nystroem"),
+              da_status_success);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_success);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_offsets, &dim, results_arr),
+              da_status_unknown_query);
+    EXPECT_EQ(da_handle_get_result(handle, da_kernel_approx_normalization, &dim,
+                                   results_arr),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 16);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result_int(handle, da_kernel_approx_landmarks, &dim,
+                                       results_arr_int),
+              da_status_invalid_array_dimension);
+    EXPECT_EQ(dim, 4);
+
+    da_handle_destroy(&handle);
+}
+
+TYPED_TEST(KernelApproxTest, BadHandleTests) {
+
+    // handle not initialized
+    da_handle handle = nullptr;
+    TypeParam A = 1, Z = 1;
+
+    EXPECT_EQ(da_kernel_approx_set_data(handle, 1, 1, &A, 1),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle),
+              da_status_handle_not_initialized);
+    EXPECT_EQ(da_kernel_approx_transform(handle, 1, 1, &A, 1, &Z, 1),
+              da_status_handle_not_initialized);
+
+    // Incorrect handle type
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_pca), da_status_success);
+
+    EXPECT_EQ(da_kernel_approx_set_data(handle, 1, 1, &A, 1),
+              da_status_invalid_handle_type);
+    EXPECT_EQ(da_kernel_approx_compute<TypeParam>(handle), da_status_invalid_handle_type);
+    EXPECT_EQ(da_kernel_approx_transform(handle, 1, 1, &A, 1, &Z, 1),
+              da_status_invalid_handle_type);
+
+    da_handle_destroy(&handle);
+}
+
+TEST(KernelApproxTest, IncorrectHandlePrecision) {
+    da_handle handle_d = nullptr;
+    da_handle handle_s = nullptr;
+
+    EXPECT_EQ(da_handle_init_d(&handle_d, da_handle_kernel_approx), da_status_success);
+    EXPECT_EQ(da_handle_init_s(&handle_s, da_handle_kernel_approx), da_status_success);
+
+    double Ad = 0.0, Zd = 0.0;
+    float As = 0.0f, Zs = 0.0f;
+
+    EXPECT_EQ(da_kernel_approx_set_data_d(handle_s, 1, 1, &Ad, 1), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_set_data_s(handle_d, 1, 1, &As, 1), da_status_wrong_type);
+
+    EXPECT_EQ(da_kernel_approx_compute_d(handle_s), da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_compute_s(handle_d), da_status_wrong_type);
+
+    EXPECT_EQ(da_kernel_approx_transform_d(handle_s, 1, 1, &Ad, 1, &Zd, 1),
+              da_status_wrong_type);
+    EXPECT_EQ(da_kernel_approx_transform_s(handle_d, 1, 1, &As, 1, &Zs, 1),
+              da_status_wrong_type);
+
+    da_handle_destroy(&handle_d);
+    da_handle_destroy(&handle_s);
+}
@@ -25,11 +25,13 @@
  *
  */
 
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <list>
 #include <stdio.h>
 #include <string.h>
+#include <vector>
 
 #include "../utest_utils.hpp"
 #include "aoclda.h"
@@ -485,4 +487,104 @@ TEST(KMeansTest, IncorrectHandlePrecision) {
 
     da_handle_destroy(&handle_d);
     da_handle_destroy(&handle_s);
-}
\ No newline at end of file
+}
+namespace {
+// Compute the cluster centres of 2 clusters, with the data passed either by fill_data or
+// directly through da_kmeans_set_data_d
+da_status kmeans_from(std::function<da_status(da_handle)> fill_data, da_int n_samples,
+                      da_int n_features, const double *A, da_int lda,
+                      std::vector<double> &centres, bool row_major = false) {
+    da_handle handle = nullptr;
+    EXPECT_EQ(da_handle_init_d(&handle, da_handle_kmeans), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_clusters", 2), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "n_init", 1), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "seed", 42), da_status_success);
+    if (row_major)
+        EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                  da_status_success);
+    da_status status = fill_data
+                           ? fill_data(handle)
+                           : da_kmeans_set_data_d(handle, n_samples, n_features, A, lda);
+    if (status == da_status_success) {
+        EXPECT_EQ(da_kmeans_compute_d(handle), da_status_success);
+        da_int dim = 2 * n_features;
+        centres.resize(dim);
+        EXPECT_EQ(da_handle_get_result_d(handle, da_kmeans_cluster_centres, &dim,
+                                         centres.data()),
+                  da_status_success);
+    }
+    da_handle_destroy(&handle);
+    return status;
+}
+} // namespace
+
+TEST(KMeansTest, SetDataFromStore) {
+    // 10 x 2 column-major data with 2 well separated clusters
+    da_int n_samples = 10, n_features = 2;
+    std::vector<double> A = {1.0, 1.1, 0.9, 1.2, 5.0, 5.1, 4.9, 5.2, 1.0, 5.0,
+                             2.0, 2.1, 1.9, 2.2, 7.0, 7.1, 6.9, 7.2, 2.1, 7.1};
+    da_datastore store = nullptr;
+    EXPECT_EQ(da_datastore_init(&store), da_status_success);
+    EXPECT_EQ(da_data_load_col_real_d(store, n_samples, n_features, A.data(),
+                                      column_major, 1),
+              da_status_success);
+    std::vector<double> centres_ref, centres;
+
+    // No selection defined: the whole store is used in place
+    EXPECT_EQ(kmeans_from(nullptr, n_samples, n_features, A.data(), n_samples,
+                          centres_ref),
+              da_status_success);
+    auto from_store = [&](da_handle handle) {
+        return da_kmeans_set_data_from_store_d(handle, store, "A");
+    };
+    EXPECT_EQ(kmeans_from(from_store, 0, n_features, nullptr, 0, centres),
+              da_status_success);
+    EXPECT_ARR_EQ(2 * n_features, centres, centres_ref, 1, 1, 0, 0);
+
+    // The same data in a row-major handle is extracted
+    std::vector<double> A_row(n_samples * n_features);
+    for (da_int i = 0; i < n_samples; i++)
+        for (da_int j = 0; j < n_features; j++)
+            A_row[i * n_features + j] = A[i + j * n_samples];
+    EXPECT_EQ(kmeans_from(nullptr, n_samples, n_features, A_row.data(), n_features,
+                          centres_ref, true),
+              da_status_success);
+    EXPECT_EQ(kmeans_from(from_store, 0, n_features, nullptr, 0, centres, true),
+              da_status_success);
+    EXPECT_ARR_EQ(2 * n_features, centres, centres_ref, 1, 1, 0, 0);
+
+    // Non-contiguous selection of rows: 0-3 and 6-9
+    EXPECT_EQ(da_data_select_rows(store, "A", 0, 3), da_status_success);
+    EXPECT_EQ(da_data_select_rows(store, "A", 6, 9), da_status_success);
+    std::vector<double> A_sub;
+    for (da_int j = 0; j < n_features; j++)
+        for (da_int i = 0; i < n_samples; i++)
+            if (i < 4 || i > 5)
+                A_sub.push_back(A[i + j * n_samples]);
+    EXPECT_EQ(kmeans_from(nullptr, 8, n_features, A_sub.data(), 8, centres_ref),
+              da_status_success);
+    EXPECT_EQ(kmeans_from(from_store, 0, n_features, nullptr, 0, centres),
+              da_status_success);
+    EXPECT_ARR_EQ(2 * n_features, centres, centres_ref, 1, 1, 0, 0);
+
+    // Error exits
+    auto no_store = [](da_handle handle) {
+        return da_kmeans_set_data_from_store_d(handle, nullptr, "A");
+    };
+    EXPECT_EQ(kmeans_from(no_store, 0, n_features, nullptr, 0, centres),
+              da_status_store_not_initialized);
+    auto bad_key = [&](da_handle handle) {
+        return da_kmeans_set_data_from_store_d(handle, store, "B");
+    };
+    EXPECT_EQ(kmeans_from(bad_key, 0, n_features, nullptr, 0, centres),
+              da_status_invalid_input);
+    auto wrong_type = [&](da_handle handle) {
+        return da_kmeans_set_data_from_store_s(handle, store, "A");
+    };
+    EXPECT_EQ(kmeans_from(wrong_type, 0, n_features, nullptr, 0, centres),
+              da_status_wrong_type);
+    EXPECT_EQ(da_kmeans_set_data_from_store_d(nullptr, store, "A"),
+              da_status_handle_not_initialized);
+
+    da_datastore_destroy(&store);
+}
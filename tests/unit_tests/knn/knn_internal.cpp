@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../utest_utils.hpp"
+#include "aoclda.h"
+#include "da_error.hpp"
+#include "hnsw.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+template <typename T> class hnswTest : public testing::Test {
+  public:
+    using List = std::list<T>;
+    static T shared_;
+    T value_;
+};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(hnswTest, FloatTypes);
+
+namespace {
+
+// Column-major n x d matrix of points drawn around n_centres random centres
+template <typename T>
+std::vector<T> clustered_data(da_int n, da_int d, da_int n_centres, std::mt19937 &gen) {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> centres(n_centres * d);
+    for (auto &c : centres)
+        c = 5.0 * normal(gen);
+    std::vector<T> X(n * d);
+    for (da_int i = 0; i < n; i++) {
+        da_int c = i % n_centres;
+        for (da_int j = 0; j < d; j++)
+            X[i + j * n] = (T)(centres[c * d + j] + normal(gen));
+    }
+    return X;
+}
+
+// Exact k nearest neighbors of the queries, for the squared euclidean or cosine distance
+template <typename T>
+std::vector<da_int> exact_neighbors(da_int n, da_int d, const std::vector<T> &X,
+                                    da_int n_queries, const std::vector<T> &X_test,
+                                    da_int k, bool cosine) {
+    std::vector<da_int> ind(n_queries * k), perm(n);
+    std::vector<double> dist(n);
+    for (da_int q = 0; q < n_queries; q++) {
+        for (da_int i = 0; i < n; i++) {
+            double dot = 0, nx = 0, ny = 0, sq = 0;
+            for (da_int j = 0; j < d; j++) {
+                double x = X[i + j * n], y = X_test[q + j * n_queries];
+                dot += x * y;
+                nx += x * x;
+                ny += y * y;
+                sq += (x - y) * (x - y);
+            }
+            dist[i] = cosine ? 1 - dot / std::sqrt(nx * ny) : sq;
+        }
+        std::iota(perm.begin(), perm.end(), 0);
+        std::partial_sort(perm.begin(), perm.begin() + k, perm.end(),
+                          [&](da_int a, da_int b) { return dist[a] < dist[b]; });
+        std::copy(perm.begin(), perm.begin() + k, ind.begin() + q * k);
+    }
+    return ind;
+}
+
+double recall(da_int n_queries, da_int k, const std::vector<da_int> &ind,
+              const std::vector<da_int> &ind_exact) {
+    da_int found = 0;
+    for (da_int q = 0; q < n_queries; q++)
+        for (da_int j = 0; j < k; j++)
+            found += std::count(ind_exact.begin() + q * k,
+                                ind_exact.begin() + (q + 1) * k, ind[q * k + j]);
+    return (double)found / (double)(n_queries * k);
+}
+
+} // namespace
+
+TYPED_TEST(hnswTest, recall) {
+    da_int n = 3000, d = 16, n_queries = 100, k = 10;
+    std::mt19937 gen(42);
+    std::vector<TypeParam> X = clustered_data<TypeParam>(n, d, 20, gen);
+    std::vector<TypeParam> X_test = clustered_data<TypeParam>(n_queries, d, 20, gen);
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+
+    for (bool cosine : {false, true}) {
+        std::cout << "Recall test, metric = " << (cosine ? "cosine" : "sqeuclidean")
+                  << std::endl;
+        TEST_ARCH::da_knn::hnsw<TypeParam> index(err);
+        index.cosine = cosine;
+        EXPECT_EQ(index.build(n, d, X.data(), n), da_status_success);
+        std::vector<da_int> ind(n_queries * k);
+        std::vector<TypeParam> dist(n_queries * k);
+        EXPECT_EQ(index.query(n_queries, X_test.data(), n_queries, k, 64, ind.data(),
+                              dist.data()),
+                  da_status_success);
+        std::vector<da_int> ind_exact =
+            exact_neighbors(n, d, X, n_queries, X_test, k, cosine);
+        EXPECT_GE(recall(n_queries, k, ind, ind_exact), 0.95);
+        // Distances are sorted in increasing order
+        for (da_int q = 0; q < n_queries; q++)
+            EXPECT_TRUE(std::is_sorted(dist.begin() + q * k, dist.begin() + (q + 1) * k));
+    }
+}
+
+TYPED_TEST(hnswTest, small_sets) {
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+    TEST_ARCH::da_knn::hnsw<TypeParam> index(err);
+
+    // A single point
+    std::vector<TypeParam> X{1.0, 2.0};
+    EXPECT_EQ(index.build(1, 2, X.data(), 1), da_status_success);
+    da_int ind = -1;
+    TypeParam dist = -1;
+    EXPECT_EQ(index.query(1, X.data(), 1, 1, 10, &ind, &dist), da_status_success);
+    EXPECT_EQ(ind, 0);
+    EXPECT_EQ(dist, 0);
+
+    // Identical points, all the neighbors are at distance zero
+    da_int n = 50, k = 20;
+    std::vector<TypeParam> Y(n * 2, 1.0), dists(k);
+    std::vector<da_int> inds(k);
+    index.M = 2;
+    EXPECT_EQ(index.build(n, 2, Y.data(), n), da_status_success);
+    EXPECT_EQ(index.query(1, Y.data(), n, k, 1, inds.data(), dists.data()),
+              da_status_success);
+    std::sort(inds.begin(), inds.end());
+    EXPECT_TRUE(std::adjacent_find(inds.begin(), inds.end()) == inds.end());
+    for (da_int j = 0; j < k; j++)
+        EXPECT_EQ(dists[j], 0);
+}
+
+TYPED_TEST(hnswTest, serialization) {
+    da_int n = 1000, d = 8, n_queries = 50, k = 5;
+    std::mt19937 gen(7);
+    std::vector<TypeParam> X = clustered_data<TypeParam>(n, d, 10, gen);
+    std::vector<TypeParam> X_test = clustered_data<TypeParam>(n_queries, d, 10, gen);
+    da_errors::da_error_t err(da_errors::action_t::DA_RECORD);
+
+    TEST_ARCH::da_knn::hnsw<TypeParam> index(err), loaded(err);
+    index.M = 8;
+    index.cosine = true;
+    EXPECT_EQ(index.build(n, d, X.data(), n), da_status_success);
+    std::vector<char> buffer;
+    EXPECT_EQ(index.serialize(buffer), da_status_success);
+    EXPECT_EQ(loaded.deserialize(buffer.data(), buffer.size()), da_status_success);
+    EXPECT_EQ(loaded.M, 8);
+    EXPECT_TRUE(loaded.cosine);
+
+    // The restored graph gives the same results
+    std::vector<da_int> ind(n_queries * k), ind_loaded(n_queries * k);
+    std::vector<TypeParam> dist(n_queries * k), dist_loaded(n_queries * k);
+    EXPECT_EQ(index.query(n_queries, X_test.data(), n_queries, k, 20, ind.data(),
+                          dist.data()),
+              da_status_success);
+    EXPECT_EQ(loaded.query(n_queries, X_test.data(), n_queries, k, 20, ind_loaded.data(),
+                           dist_loaded.data()),
+              da_status_success);
+    EXPECT_ARR_EQ(n_queries * k, ind, ind_loaded, 1, 1, 0, 0);
+    EXPECT_ARR_EQ(n_queries * k, dist, dist_loaded, 1, 1, 0, 0);
+
+    // Invalid buffers
+    EXPECT_EQ(loaded.deserialize(nullptr, 0), da_status_invalid_input);
+    EXPECT_EQ(loaded.deserialize(buffer.data(), buffer.size() - 1),
+              da_status_invalid_input);
+    std::vector<char> corrupted(buffer);
+    corrupted[0] = 0;
+    EXPECT_EQ(loaded.deserialize(corrupted.data(), corrupted.size()),
+              da_status_invalid_input);
+    using other_type =
+        std::conditional_t<std::is_same_v<TypeParam, float>, double, float>;
+    TEST_ARCH::da_knn::hnsw<other_type> other(err);
+    EXPECT_EQ(other.deserialize(buffer.data(), buffer.size()), da_status_invalid_input);
+}
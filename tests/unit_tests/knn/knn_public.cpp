@@ -25,9 +25,14 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <list>
+#include <numeric>
+#include <random>
 #include <stdio.h>
 #include <string.h>
 
@@ -146,6 +151,391 @@ TYPED_TEST(knnTest, AccuracyTestingZeroData) {
     da_handle_destroy(&handle);
 }
 
+// Many neighbors and a training set spanning several blocks, with repeated distances.
+// Ties must be resolved in favour of the training points with the smallest indices.
+TYPED_TEST(knnTest, LargeK) {
+    da_handle handle = nullptr;
+    da_int n_samples = 2500, n_features = 5, n_queries = 37, k = 100;
+    std::vector<TypeParam> X_train(n_samples * n_features);
+    std::vector<TypeParam> X_test(n_queries * n_features);
+    std::vector<da_int> y_train(n_samples);
+    for (da_int i = 0; i < n_samples; i++) {
+        y_train[i] = i % 3;
+        for (da_int j = 0; j < n_features; j++)
+            X_train[i + j * n_samples] = (TypeParam)((7 * i + 13 * j) % 11);
+    }
+    for (da_int i = 0; i < n_queries; i++)
+        for (da_int j = 0; j < n_features; j++)
+            X_test[i + j * n_queries] = (TypeParam)((5 * i + 3 * j) % 7);
+
+    // Reference neighbors from a full sort of the distances
+    std::vector<da_int> expected_kind(n_queries * k), perm(n_samples);
+    std::vector<TypeParam> expected_kdist(n_queries * k), dist(n_samples);
+    for (da_int q = 0; q < n_queries; q++) {
+        for (da_int i = 0; i < n_samples; i++) {
+            dist[i] = 0;
+            for (da_int j = 0; j < n_features; j++) {
+                TypeParam diff = X_train[i + j * n_samples] - X_test[q + j * n_queries];
+                dist[i] += diff * diff;
+            }
+        }
+        std::iota(perm.begin(), perm.end(), 0);
+        std::stable_sort(perm.begin(), perm.end(),
+                         [&](da_int i, da_int j) { return dist[i] < dist[j]; });
+        for (da_int j = 0; j < k; j++) {
+            expected_kind[q + j * n_queries] = perm[j];
+            expected_kdist[q + j * n_queries] = std::sqrt(dist[perm[j]]);
+        }
+    }
+
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_knn), da_status_success);
+    EXPECT_EQ(da_options_set_int(handle, "number of neighbors", k), da_status_success);
+    EXPECT_EQ(da_knn_set_training_data(handle, n_samples, n_features, X_train.data(),
+                                       n_samples, y_train.data()),
+              da_status_success);
+    std::vector<TypeParam> kdist(n_queries * k);
+    std::vector<da_int> kind(n_queries * k);
+    EXPECT_EQ(da_knn_kneighbors(handle, n_queries, n_features, X_test.data(), n_queries,
+                                kind.data(), kdist.data(), k, 1),
+              da_status_success);
+    TypeParam tol = 100 * std::numeric_limits<TypeParam>::epsilon();
+    EXPECT_ARR_NEAR(n_queries * k, kdist.data(), expected_kdist.data(), tol);
+    EXPECT_ARR_EQ(n_queries * k, kind.data(), expected_kind.data(), 1, 1, 0, 0);
+    da_handle_destroy(&handle);
+}
+
+// Approximate neighbors from the HNSW graph compared with the exact ones, on clustered
+// data. The recall and the timings of both algorithms are reported.
+TYPED_TEST(knnTest, HNSWRecall) {
+    da_int n_samples = 5000, n_features = 32, n_queries = 200, k = 10, n_centres = 25;
+    std::mt19937 gen(17);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> centres(n_centres * n_features);
+    for (auto &c : centres)
+        c = 4.0 * normal(gen);
+    auto sample = [&](da_int n, std::vector<TypeParam> &X) {
+        X.resize(n * n_features);
+        for (da_int i = 0; i < n; i++)
+            for (da_int j = 0; j < n_features; j++)
+                X[i + j * n] =
+                    (TypeParam)(centres[(i % n_centres) * n_features + j] + normal(gen));
+    };
+    std::vector<TypeParam> X_train, X_test;
+    sample(n_samples, X_train);
+    sample(n_queries, X_test);
+    std::vector<da_int> y_train(n_samples);
+    for (da_int i = 0; i < n_samples; i++)
+        y_train[i] = i % n_centres;
+
+    for (std::string metric : {"euclidean", "cosine"}) {
+        std::vector<da_int> kind(n_queries * k), kind_exact(n_queries * k);
+        std::vector<TypeParam> kdist(n_queries * k);
+        double elapsed[2];
+        for (std::string algo : {"brute", "hnsw"}) {
+            da_handle handle = nullptr;
+            bool hnsw = algo == "hnsw";
+            EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_knn),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_int(handle, "number of neighbors", k),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "metric", metric.c_str()),
+                      da_status_success);
+            EXPECT_EQ(da_options_set_string(handle, "algorithm", algo.c_str()),
+                      da_status_success);
+            EXPECT_EQ(da_knn_set_training_data(handle, n_samples, n_features,
+                                               X_train.data(), n_samples, y_train.data()),
+                      da_status_success);
+            // The first call also builds the graph, time the queries on the second one
+            EXPECT_EQ(da_knn_kneighbors(handle, n_queries, n_features, X_test.data(),
+                                        n_queries, hnsw ? kind.data() : kind_exact.data(),
+                                        kdist.data(), k, 1),
+                      da_status_success);
+            auto start = std::chrono::steady_clock::now();
+            EXPECT_EQ(da_knn_kneighbors(handle, n_queries, n_features, X_test.data(),
+                                        n_queries, hnsw ? kind.data() : kind_exact.data(),
+                                        kdist.data(), k, 1),
+                      da_status_success);
+            elapsed[hnsw] = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+            std::vector<da_int> y_test(n_queries);
+            EXPECT_EQ(da_knn_predict(handle, n_queries, n_features, X_test.data(),
+                                     n_queries, y_test.data()),
+                      da_status_success);
+            for (da_int i = 0; i < n_queries; i++)
+                EXPECT_EQ(y_test[i], i % n_centres);
+            da_handle_destroy(&handle);
+        }
+
+        da_int found = 0;
+        for (da_int q = 0; q < n_queries; q++)
+            for (da_int j = 0; j < k; j++)
+                for (da_int l = 0; l < k; l++)
+                    found += kind[q + j * n_queries] == kind_exact[q + l * n_queries];
+        double recall = (double)found / (double)(n_queries * k);
+        std::cout << "metric = " << metric << ": recall = " << recall
+                  << ", brute force queries " << elapsed[0] << "s, hnsw queries "
+                  << elapsed[1] << "s" << std::endl;
+        EXPECT_GE(recall, 0.9);
+    }
+
+    // Metrics that the graph does not support
+    da_handle handle = nullptr;
+    da_int kind_m[1];
+    TypeParam kdist_m[1];
+    EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_knn), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "algorithm", "hnsw"), da_status_success);
+    EXPECT_EQ(da_options_set_string(handle, "metric", "manhattan"), da_status_success);
+    EXPECT_EQ(da_knn_set_training_data(handle, n_samples, n_features, X_train.data(),
+                                       n_samples, y_train.data()),
+              da_status_success);
+    EXPECT_EQ(da_knn_kneighbors(handle, 1, n_features, X_test.data(), n_queries, kind_m,
+                                kdist_m, 1, 1),
+              da_status_incompatible_options);
+    da_handle_destroy(&handle);
+}
+
+// Euclidean or manhattan distances between the column-major matrices X (n x d) and
+// Xq (nq x d), computed by brute force
+template <typename T>
+std::vector<T> reference_distances(da_int n, da_int nq, da_int d, const std::vector<T> &X,
+                                   const std::vector<T> &Xq, bool manhattan) {
+    std::vector<T> D(n * nq, 0);
+    for (da_int q = 0; q < nq; q++)
+        for (da_int i = 0; i < n; i++) {
+            for (da_int j = 0; j < d; j++) {
+                T diff = X[i + j * n] - Xq[q + j * nq];
+                D[i + q * n] += manhattan ? std::abs(diff) : diff * diff;
+            }
+            if (!manhattan)
+                D[i + q * n] = std::sqrt(D[i + q * n]);
+        }
+    return D;
+}
+
+TYPED_TEST(knnTest, Regression) {
+    da_int n_samples = 300, n_features = 3, n_queries = 20, k = 7;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> unif(-1.0, 1.0);
+    std::vector<TypeParam> X_train(n_samples * n_features), y_train(n_samples);
+    std::vector<TypeParam> X_test(n_queries * n_features);
+    for (auto &x : X_train)
+        x = (TypeParam)unif(gen);
+    for (auto &x : X_test)
+        x = (TypeParam)unif(gen);
+    for (da_int i = 0; i < n_samples; i++)
+        y_train[i] = X_train[i] + 2 * X_train[i + n_samples] - X_train[i + 2 * n_samples];
+    // The first query coincides with a training point
+    for (da_int j = 0; j < n_features; j++)
+        X_test[j * n_queries] = X_train[10 + j * n_samples];
+
+    std::vector<TypeParam> D =
+        reference_distances(n_samples, n_queries, n_features, X_train, X_test, false);
+    std::vector<da_int> perm(n_samples);
+    TypeParam tol = 100 * std::numeric_limits<TypeParam>::epsilon();
+    for (std::string weights : {"uniform", "distance"}) {
+        std::vector<TypeParam> expected(n_queries), y_test(n_queries);
+        for (da_int q = 0; q < n_queries; q++) {
+            const TypeParam *Dq = &D[q * n_samples];
+            std::iota(perm.begin(), perm.end(), 0);
+            std::stable_sort(perm.begin(), perm.end(),
+                             [&](da_int i, da_int j) { return Dq[i] < Dq[j]; });
+            TypeParam sum = 0, wsum = 0;
+            for (da_int j = 0; j < k; j++) {
+                TypeParam w = weights == "uniform" ? 1 : 1 / Dq[perm[j]];
+                sum += w * y_train[perm[j]];
+                wsum += w;
+            }
+            expected[q] = sum / wsum;
+        }
+        // With distance weights, a query on a training point gets its target
+        if (weights == "distance")
+            expected[0] = y_train[10];
+
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_knn), da_status_success);
+        EXPECT_EQ(da_options_set_int(handle, "number of neighbors", k),
+                  da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "weights", weights.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_knn_set_regression_data(handle, n_samples, n_features,
+                                             X_train.data(), n_samples, y_train.data()),
+                  da_status_success);
+        EXPECT_EQ(da_knn_predict_regression(handle, n_queries, n_features, X_test.data(),
+                                            n_queries, y_test.data()),
+                  da_status_success);
+        EXPECT_ARR_NEAR(n_queries, y_test.data(), expected.data(), 10 * tol);
+
+        // Same results with row-major data
+        std::vector<TypeParam> X_train_r(n_samples * n_features),
+            X_test_r(n_queries * n_features);
+        for (da_int i = 0; i < n_samples; i++)
+            for (da_int j = 0; j < n_features; j++)
+                X_train_r[i * n_features + j] = X_train[i + j * n_samples];
+        for (da_int i = 0; i < n_queries; i++)
+            for (da_int j = 0; j < n_features; j++)
+                X_test_r[i * n_features + j] = X_test[i + j * n_queries];
+        EXPECT_EQ(da_options_set_string(handle, "storage order", "row-major"),
+                  da_status_success);
+        EXPECT_EQ(da_knn_set_regression_data(handle, n_samples, n_features,
+                                             X_train_r.data(), n_features,
+                                             y_train.data()),
+                  da_status_success);
+        EXPECT_EQ(da_knn_predict_regression(handle, n_queries, n_features,
+                                            X_test_r.data(), n_features, y_test.data()),
+                  da_status_success);
+        EXPECT_ARR_NEAR(n_queries, y_test.data(), expected.data(), 10 * tol);
+
+        // Classification requires labels
+        std::vector<da_int> labels(n_queries);
+        EXPECT_EQ(da_knn_predict(handle, n_queries, n_features, X_test_r.data(),
+                                 n_features, labels.data()),
+                  da_status_no_data);
+        da_handle_destroy(&handle);
+    }
+}
+
+TYPED_TEST(knnTest, RadiusNeighbors) {
+    da_int n_samples = 1500, n_features = 4, n_queries = 45;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    std::vector<TypeParam> X_train(n_samples * n_features), y_reg(n_samples);
+    std::vector<TypeParam> X_test(n_queries * n_features);
+    std::vector<da_int> y_train(n_samples);
+    for (auto &x : X_train)
+        x = (TypeParam)unif(gen);
+    for (auto &x : X_test)
+        x = (TypeParam)unif(gen);
+    for (da_int i = 0; i < n_samples; i++) {
+        y_train[i] = X_train[i] < 0.5 ? 3 : 7;
+        y_reg[i] = X_train[i];
+    }
+    // The last query is far from all the training points
+    for (da_int j = 0; j < n_features; j++)
+        X_test[n_queries - 1 + j * n_queries] = 10;
+
+    for (std::string metric : {"euclidean", "manhattan"}) {
+        TypeParam radius = metric == "euclidean" ? 0.3 : 0.5;
+        std::vector<TypeParam> D = reference_distances(n_samples, n_queries, n_features,
+                                                       X_train, X_test,
+                                                       metric == "manhattan");
+        // Reference neighbors, sorted by distance
+        std::vector<da_int> expected_offsets(n_queries + 1, 0), expected_ind;
+        std::vector<TypeParam> expected_dist;
+        for (da_int q = 0; q < n_queries; q++) {
+            std::vector<da_int> nb;
+            for (da_int i = 0; i < n_samples; i++)
+                if (D[i + q * n_samples] <= radius)
+                    nb.push_back(i);
+            std::stable_sort(nb.begin(), nb.end(), [&](da_int i, da_int j) {
+                return D[i + q * n_samples] < D[j + q * n_samples];
+            });
+            for (da_int i : nb) {
+                expected_ind.push_back(i);
+                expected_dist.push_back(D[i + q * n_samples]);
+            }
+            expected_offsets[q + 1] = (da_int)expected_ind.size();
+        }
+
+        da_handle handle = nullptr;
+        EXPECT_EQ(da_handle_init<TypeParam>(&handle, da_handle_knn), da_status_success);
+        EXPECT_EQ(da_options_set_string(handle, "metric", metric.c_str()),
+                  da_status_success);
+        EXPECT_EQ(da_knn_set_training_data(handle, n_samples, n_features, X_train.data(),
+                                           n_samples, y_train.data()),
+                  da_status_success);
+        da_int dim = 1;
+        da_int dummy;
+        EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_offsets, &dim,
+                                       &dummy),
+                  da_status_unknown_query);
+
+        // Radius passed as argument, then through the option
+        for (bool use_option : {false, true}) {
+            if (use_option) {
+                EXPECT_EQ(da_options_set(handle, "radius", radius), da_status_success);
+            }
+            EXPECT_EQ(da_knn_radius_neighbors(handle, n_queries, n_features,
+                                              X_test.data(), n_queries,
+                                              use_option ? (TypeParam)0 : radius),
+                      da_status_success);
+            // Query the sizes, then the results
+            da_int nnz = 0;
+            dim = 0;
+            EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_indices, &dim,
+                                           &dummy),
+                      da_status_invalid_array_dimension);
+            nnz = dim;
+            ASSERT_EQ(nnz, expected_offsets[n_queries]);
+            std::vector<da_int> offsets(n_queries + 1), ind(nnz);
+            std::vector<TypeParam> dist(nnz);
+            dim = n_queries + 1;
+            EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_offsets, &dim,
+                                           offsets.data()),
+                      da_status_success);
+            dim = nnz;
+            EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_indices, &dim,
+                                           ind.data()),
+                      da_status_success);
+            EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_distances,
+                                           &dim, dist.data()),
+                      da_status_success);
+            EXPECT_ARR_EQ(n_queries + 1, offsets.data(), expected_offsets.data(), 1, 1, 0,
+                          0);
+            EXPECT_ARR_EQ(nnz, ind.data(), expected_ind.data(), 1, 1, 0, 0);
+            TypeParam tol = 100 * std::numeric_limits<TypeParam>::epsilon();
+            EXPECT_ARR_NEAR(nnz, dist.data(), expected_dist.data(), tol);
+        }
+
+        // Majority vote of the neighbors within the radius, the isolated query gets the
+        // outlier label
+        EXPECT_EQ(da_options_set_int(handle, "outlier label", -5), da_status_success);
+        std::vector<da_int> labels(n_queries);
+        EXPECT_EQ(da_knn_radius_predict(handle, n_queries, n_features, X_test.data(),
+                                        n_queries, labels.data()),
+                  da_status_success);
+        for (da_int q = 0; q < n_queries - 1; q++) {
+            da_int votes3 = 0, n = expected_offsets[q + 1] - expected_offsets[q];
+            for (da_int p = expected_offsets[q]; p < expected_offsets[q + 1]; p++)
+                votes3 += y_train[expected_ind[p]] == 3;
+            if (n > 0) {
+                EXPECT_EQ(labels[q], 2 * votes3 >= n ? 3 : 7);
+            }
+        }
+        EXPECT_EQ(labels[n_queries - 1], -5);
+        std::vector<TypeParam> y_test(n_queries);
+        EXPECT_EQ(da_knn_radius_predict_regression(handle, n_queries, n_features,
+                                                   X_test.data(), n_queries,
+                                                   y_test.data()),
+                  da_status_no_data);
+
+        // Regression, the average of the targets of the neighbors
+        EXPECT_EQ(da_knn_set_regression_data(handle, n_samples, n_features,
+                                             X_train.data(), n_samples, y_reg.data()),
+                  da_status_success);
+        EXPECT_EQ(da_knn_radius_predict_regression(handle, n_queries, n_features,
+                                                   X_test.data(), n_queries,
+                                                   y_test.data()),
+                  da_status_success);
+        for (da_int q = 0; q < n_queries - 1; q++) {
+            da_int n = expected_offsets[q + 1] - expected_offsets[q];
+            if (n == 0)
+                continue;
+            TypeParam sum = 0;
+            for (da_int p = expected_offsets[q]; p < expected_offsets[q + 1]; p++)
+                sum += y_reg[expected_ind[p]];
+            EXPECT_NEAR(y_test[q], sum / n,
+                        1000 * std::numeric_limits<TypeParam>::epsilon());
+        }
+        EXPECT_TRUE(std::isnan(y_test[n_queries - 1]));
+        // New training data invalidate the radius neighbors
+        EXPECT_EQ(da_handle_get_result(handle, da_knn_radius_neighbors_offsets, &dim,
+                                       &dummy),
+                  da_status_unknown_query);
+        da_handle_destroy(&handle);
+    }
+}
+
 std::string ErrorExits_print(std::string param) {
     std::string ss = "Test for invalid value of " + param + " failed.";
     return ss;
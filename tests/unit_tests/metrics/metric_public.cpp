@@ -697,6 +697,66 @@ TYPED_TEST(PairwiseDistanceTest, AccuracyTesting_XX) {
     }
 }
 
+TYPED_TEST(PairwiseDistanceTest, Minkowski_blocked) {
+    // Sizes spanning several tiles of the blocked Manhattan and Minkowski kernels,
+    // with padded leading dimensions
+    da_int m = 150, n = 70, k = 140, ldx = m + 3, ldy = n + 1;
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<TypeParam> distr(TypeParam(-10.0), TypeParam(10.0));
+    std::vector<TypeParam> X(ldx * k), Y(ldy * k), X_row(m * k), Y_row(n * k);
+    for (da_int j = 0; j < k; j++) {
+        for (da_int i = 0; i < m; i++) {
+            X[i + j * ldx] = distr(generator);
+            X_row[i * k + j] = X[i + j * ldx];
+        }
+        for (da_int i = 0; i < n; i++) {
+            Y[i + j * ldy] = distr(generator);
+            Y_row[i * k + j] = Y[i + j * ldy];
+        }
+    }
+    TypeParam tol = 500 * std::numeric_limits<TypeParam>::epsilon();
+
+    for (TypeParam p : {TypeParam(1.0), TypeParam(3.0), TypeParam(1.5)}) {
+        for (bool XX : {false, true}) {
+            da_int n_cols = XX ? m : n;
+            const TypeParam *Yc = XX ? X.data() : Y.data();
+            da_int ldyc = XX ? ldx : ldy;
+            std::vector<TypeParam> D_ref(m * n_cols, 0.0);
+            for (da_int j = 0; j < n_cols; j++) {
+                for (da_int i = 0; i < m; i++) {
+                    TypeParam sum = 0.0;
+                    for (da_int l = 0; l < k; l++)
+                        sum += std::pow(std::abs(X[i + l * ldx] - Yc[j + l * ldyc]), p);
+                    D_ref[i + j * m] = std::pow(sum, 1 / p);
+                }
+            }
+            std::vector<da_metric> metrics = {da_minkowski};
+            if (p == 1.0)
+                metrics.push_back(da_manhattan);
+            for (da_metric metric : metrics) {
+                std::vector<TypeParam> D(m * n_cols, -1.0), D_row(m * n_cols, -1.0);
+                EXPECT_EQ(da_pairwise_distances(column_major, m, n, k, X.data(), ldx,
+                                                XX ? nullptr : Y.data(), ldy, D.data(), m,
+                                                p, metric),
+                          da_status_success);
+                EXPECT_EQ(da_pairwise_distances(row_major, m, n, k, X_row.data(), k,
+                                                XX ? nullptr : Y_row.data(), k,
+                                                D_row.data(), n_cols, p, metric),
+                          da_status_success);
+                da_int n_wrong = 0;
+                for (da_int j = 0; j < n_cols; j++) {
+                    for (da_int i = 0; i < m; i++) {
+                        TypeParam ref = D_ref[i + j * m];
+                        n_wrong += std::abs(D[i + j * m] - ref) > tol * ref;
+                        n_wrong += std::abs(D_row[i * n_cols + j] - ref) > tol * ref;
+                    }
+                }
+                EXPECT_EQ(n_wrong, 0) << "p = " << p << ", XX = " << XX;
+            }
+        }
+    }
+}
+
 std::string ErrorExits_print(std::string param) {
     std::string ss = "Test for invalid value of " + param + " failed.";
     return ss;
@@ -34,7 +34,9 @@
 #include "gtest/gtest.h"
 #include <iostream>
 #include <list>
+#include <random>
 #include <string>
+#include <type_traits>
 
 template <typename T> class svm_public_test : public testing::Test {
   public:
@@ -68,6 +70,8 @@ TYPED_TEST(svm_public_test, ldx_test) {
                   da_status_success);
         EXPECT_EQ(da_options_set(svm_handle, "kernel", data.kernel.c_str()),
                   da_status_success);
+        // The reference values come from LIBSVM, solved with SMO
+        EXPECT_EQ(da_options_set(svm_handle, "solver", "smo"), da_status_success);
         EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, data.model),
                   da_status_success);
         EXPECT_EQ(da_svm_set_data(svm_handle, data.n_samples_train, data.n_feat,
@@ -160,6 +164,8 @@ TYPED_TEST(svm_public_test, get_results_test) {
                   da_status_success);
         EXPECT_EQ(da_options_set(svm_handle, "tolerance", (TypeParam)1e-5),
                   da_status_success);
+        // The reference values come from LIBSVM, solved with SMO
+        EXPECT_EQ(da_options_set(svm_handle, "solver", "smo"), da_status_success);
         EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
 
         ////////// COLUMN MAJOR
@@ -558,6 +564,352 @@ TYPED_TEST(svm_public_test, multiple_calls) {
     da_handle_destroy(&svm_handle);
 }
 
+// Linear problem with n samples and 5 features, with labels 0/1 for classification or
+// noisy linear responses for regression
+template <typename T>
+void linear_svm_data(da_int n, bool classification, std::vector<T> &X,
+                     std::vector<T> &y) {
+    std::vector<T> w_true{1.0, -2.0, 0.5, 1.5, -1.0};
+    da_int p = (da_int)w_true.size();
+    std::mt19937 gen(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    X.resize(n * p);
+    y.resize(n);
+    for (da_int j = 0; j < n * p; j++)
+        X[j] = (T)normal(gen);
+    for (da_int i = 0; i < n; i++) {
+        double f = 0.3 + 0.5 * normal(gen);
+        for (da_int j = 0; j < p; j++)
+            f += w_true[j] * X[i + j * n];
+        y[i] = classification ? (f > 0 ? T(1) : T(0)) : (T)f;
+    }
+}
+
+// Primal weights and intercept of a linear SVM from its support vectors and coefficients
+template <typename T>
+void linear_svm_weights(da_handle svm_handle, da_int p, std::vector<T> &w, T &bias) {
+    da_int n_sv = 0, dim = 1;
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_n_support_vectors, &dim,
+                                   &n_sv),
+              da_status_success);
+    std::vector<T> sv(n_sv * p), coef(n_sv);
+    dim = n_sv * p;
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_support_vectors, &dim,
+                                   sv.data()),
+              da_status_success);
+    dim = n_sv;
+    EXPECT_EQ(
+        da_handle_get_result(svm_handle, da_result::da_svm_dual_coef, &dim, coef.data()),
+        da_status_success);
+    dim = 1;
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_bias, &dim, &bias),
+              da_status_success);
+    w.assign(p, T(0));
+    for (da_int j = 0; j < p; j++)
+        for (da_int i = 0; i < n_sv; i++)
+            w[j] += coef[i] * sv[i + j * n_sv];
+}
+
+TYPED_TEST(svm_public_test, dual_coordinate_descent_svc) {
+    da_int n = 300, p = 5;
+    std::vector<TypeParam> X, y;
+    linear_svm_data(n, true, X, y);
+    TypeParam C = 0.5;
+    TypeParam tol = std::is_same_v<TypeParam, float> ? 1.0e-4 : 1.0e-8;
+    TypeParam check_tol = std::is_same_v<TypeParam, float> ? 1.0e-2 : 1.0e-5;
+
+    da_handle svm_handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&svm_handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, svc), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "kernel", "linear"), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "solver", "dual coordinate descent"),
+              da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "C", C), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "tolerance", tol), da_status_success);
+    EXPECT_EQ(da_svm_set_data(svm_handle, n, p, X.data(), n, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+
+    // The intercept is regularized as the weight of a constant feature, so the dual
+    // coefficients sum to the intercept and lie in [-C, C]
+    std::vector<TypeParam> w;
+    TypeParam bias;
+    linear_svm_weights(svm_handle, p, w, bias);
+    da_int n_sv = 0, dim = 1;
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_n_support_vectors, &dim,
+                                   &n_sv),
+              da_status_success);
+    std::vector<TypeParam> coef(n_sv);
+    std::vector<da_int> sv_idx(n_sv);
+    dim = n_sv;
+    EXPECT_EQ(
+        da_handle_get_result(svm_handle, da_result::da_svm_dual_coef, &dim, coef.data()),
+        da_status_success);
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_idx_support_vectors,
+                                   &dim, sv_idx.data()),
+              da_status_success);
+    TypeParam coef_sum = 0;
+    TypeParam C_max = C * (1 + 10 * std::numeric_limits<TypeParam>::epsilon());
+    std::vector<TypeParam> alpha(n, 0);
+    for (da_int i = 0; i < n_sv; i++) {
+        coef_sum += coef[i];
+        alpha[sv_idx[i]] = std::abs(coef[i]);
+        EXPECT_LE(alpha[sv_idx[i]], C_max);
+    }
+    EXPECT_NEAR(coef_sum, bias, check_tol);
+
+    // Optimality conditions on the margins y_i f(x_i)
+    std::vector<TypeParam> decision(n);
+    EXPECT_EQ(da_svm_decision_function(svm_handle, n, p, X.data(), n, ovo,
+                                       decision.data(), n),
+              da_status_success);
+    for (da_int i = 0; i < n; i++) {
+        TypeParam f = bias;
+        for (da_int j = 0; j < p; j++)
+            f += w[j] * X[i + j * n];
+        EXPECT_NEAR(decision[i], f, check_tol);
+        TypeParam margin = (y[i] > 0 ? 1 : -1) * f;
+        if (alpha[i] == 0)
+            EXPECT_GE(margin, 1 - check_tol);
+        else if (alpha[i] < C * (1 - check_tol))
+            EXPECT_NEAR(margin, 1, check_tol);
+        else
+            EXPECT_LE(margin, 1 + check_tol);
+    }
+
+    // The default solver picks dual coordinate descent for the linear kernel
+    TypeParam score_dcd, score_auto, score_smo;
+    EXPECT_EQ(da_svm_score(svm_handle, n, p, X.data(), n, y.data(), &score_dcd),
+              da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "solver", "auto"), da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+    std::vector<TypeParam> w_auto;
+    TypeParam bias_auto;
+    linear_svm_weights(svm_handle, p, w_auto, bias_auto);
+    EXPECT_ARR_NEAR(p, w_auto, w, 10 * std::numeric_limits<TypeParam>::epsilon());
+    EXPECT_EQ(da_svm_score(svm_handle, n, p, X.data(), n, y.data(), &score_auto),
+              da_status_success);
+    EXPECT_EQ(score_auto, score_dcd);
+
+    // Close to the solution with a free intercept
+    EXPECT_EQ(da_options_set(svm_handle, "solver", "smo"), da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+    EXPECT_EQ(da_svm_score(svm_handle, n, p, X.data(), n, y.data(), &score_smo),
+              da_status_success);
+    EXPECT_GT(score_dcd, 0.8);
+    EXPECT_NEAR(score_dcd, score_smo, 0.02);
+
+    da_handle_destroy(&svm_handle);
+}
+
+TYPED_TEST(svm_public_test, dual_coordinate_descent_svr) {
+    da_int n = 300, p = 5;
+    std::vector<TypeParam> X, y;
+    linear_svm_data(n, false, X, y);
+    TypeParam C = 2.0, eps = 0.2;
+    TypeParam tol = std::is_same_v<TypeParam, float> ? 1.0e-5 : 1.0e-10;
+    TypeParam check_tol = std::is_same_v<TypeParam, float> ? 1.0e-2 : 1.0e-5;
+
+    da_handle svm_handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&svm_handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, svr), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "kernel", "linear"), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "solver", "dcd"), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "C", C), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "epsilon", eps), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "tolerance", tol), da_status_success);
+    EXPECT_EQ(da_svm_set_data(svm_handle, n, p, X.data(), n, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+
+    std::vector<TypeParam> w;
+    TypeParam bias;
+    linear_svm_weights(svm_handle, p, w, bias);
+    da_int n_sv = 0, dim = 1;
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_n_support_vectors, &dim,
+                                   &n_sv),
+              da_status_success);
+    std::vector<TypeParam> coef(n_sv);
+    std::vector<da_int> sv_idx(n_sv);
+    dim = n_sv;
+    EXPECT_EQ(
+        da_handle_get_result(svm_handle, da_result::da_svm_dual_coef, &dim, coef.data()),
+        da_status_success);
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_idx_support_vectors,
+                                   &dim, sv_idx.data()),
+              da_status_success);
+    std::vector<TypeParam> beta(n, 0);
+    TypeParam coef_sum = 0;
+    for (da_int i = 0; i < n_sv; i++) {
+        beta[sv_idx[i]] = coef[i];
+        coef_sum += coef[i];
+    }
+    EXPECT_NEAR(coef_sum, bias, check_tol);
+
+    // Optimality conditions on the residuals f(x_i) - y_i
+    std::vector<TypeParam> pred(n);
+    EXPECT_EQ(da_svm_predict(svm_handle, n, p, X.data(), n, pred.data()),
+              da_status_success);
+    for (da_int i = 0; i < n; i++) {
+        TypeParam f = bias;
+        for (da_int j = 0; j < p; j++)
+            f += w[j] * X[i + j * n];
+        EXPECT_NEAR(pred[i], f, check_tol);
+        TypeParam r = f - y[i];
+        if (beta[i] == 0)
+            EXPECT_LE(std::abs(r), eps + check_tol);
+        else if (beta[i] >= C * (1 - check_tol))
+            EXPECT_LE(r, -eps + check_tol);
+        else if (beta[i] <= -C * (1 - check_tol))
+            EXPECT_GE(r, eps - check_tol);
+        else
+            EXPECT_NEAR(std::abs(r), eps, check_tol);
+    }
+
+    TypeParam score;
+    EXPECT_EQ(da_svm_score(svm_handle, n, p, X.data(), n, y.data(), &score),
+              da_status_success);
+    EXPECT_GT(score, 0.9);
+
+    da_handle_destroy(&svm_handle);
+}
+
+TYPED_TEST(svm_public_test, dual_coordinate_descent_multiclass) {
+    // Three classes separated along the first two features, row-major storage
+    da_int n = 150, p = 2;
+    std::vector<TypeParam> X(n * p), y(n);
+    std::mt19937 gen(5);
+    std::normal_distribution<double> normal(0.0, 0.3);
+    std::vector<TypeParam> centres{0.0, 0.0, 3.0, 0.0, 0.0, 3.0};
+    for (da_int i = 0; i < n; i++) {
+        da_int c = i % 3;
+        y[i] = (TypeParam)c;
+        X[i * p] = centres[2 * c] + (TypeParam)normal(gen);
+        X[i * p + 1] = centres[2 * c + 1] + (TypeParam)normal(gen);
+    }
+
+    da_handle svm_handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&svm_handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "storage order", "row-major"),
+              da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, svc), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "kernel", "linear"), da_status_success);
+    EXPECT_EQ(da_svm_set_data(svm_handle, n, p, X.data(), p, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+    TypeParam score;
+    EXPECT_EQ(da_svm_score(svm_handle, n, p, X.data(), p, y.data(), &score),
+              da_status_success);
+    EXPECT_GT(score, 0.98);
+    da_int dim = 3;
+    std::vector<da_int> n_iter(dim);
+    EXPECT_EQ(da_handle_get_result(svm_handle, da_result::da_svm_n_iterations, &dim,
+                                   n_iter.data()),
+              da_status_success);
+    for (auto it : n_iter)
+        EXPECT_GT(it, 0);
+
+    // Dual coordinate descent only applies to SVC and SVR with the linear kernel
+    EXPECT_EQ(da_options_set(svm_handle, "solver", "dcd"), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "kernel", "rbf"), da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_incompatible_options);
+    EXPECT_EQ(da_options_set(svm_handle, "kernel", "linear"), da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, nusvc), da_status_success);
+    EXPECT_EQ(da_svm_set_data(svm_handle, n, p, X.data(), p, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_incompatible_options);
+
+    da_handle_destroy(&svm_handle);
+}
+
+TYPED_TEST(svm_public_test, one_vs_one_pairs) {
+    // Five overlapping classes of different sizes, so that the one-vs-one sub-problems
+    // differ in size and are solved concurrently in a different order than they are
+    // stored
+    da_int n_class = 5, p = 3, n = 0;
+    std::vector<da_int> class_size{30, 50, 20, 60, 40};
+    std::vector<TypeParam> X, y;
+    std::mt19937 gen(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (da_int c = 0; c < n_class; c++)
+        n += class_size[c];
+    X.resize(n * p);
+    y.resize(n);
+    for (da_int c = 0, i = 0; c < n_class; c++) {
+        for (da_int l = 0; l < class_size[c]; l++, i++) {
+            y[i] = (TypeParam)c;
+            for (da_int j = 0; j < p; j++)
+                X[i + j * n] = (TypeParam)(c * (j == c % p ? 1.5 : 0.5) + normal(gen));
+        }
+    }
+
+    da_handle svm_handle = nullptr;
+    EXPECT_EQ(da_handle_init<TypeParam>(&svm_handle, da_handle_svm), da_status_success);
+    EXPECT_EQ(da_svm_select_model<TypeParam>(svm_handle, svc), da_status_success);
+    EXPECT_EQ(da_options_set(svm_handle, "gamma", (TypeParam)0.5), da_status_success);
+    EXPECT_EQ(da_svm_set_data(svm_handle, n, p, X.data(), n, y.data()),
+              da_status_success);
+    EXPECT_EQ(da_svm_compute<TypeParam>(svm_handle), da_status_success);
+    da_int n_classifiers = n_class * (n_class - 1) / 2;
+    std::vector<TypeParam> decision_values(n * n_classifiers), predictions(n);
+    EXPECT_EQ(da_svm_decision_function(svm_handle, n, p, X.data(), n, ovo,
+                                       decision_values.data(), n),
+              da_status_success);
+    EXPECT_EQ(da_svm_predict(svm_handle, n, p, X.data(), n, predictions.data()),
+              da_status_success);
+
+    // Each pair must match the binary problem restricted to its two classes, with the
+    // first class as the positive one
+    TypeParam tol = std::is_same_v<TypeParam, float> ? 1.0e-3 : 1.0e-8;
+    std::vector<da_int> votes(n * n_class, 0);
+    da_int k = 0;
+    for (da_int ci = 0; ci < n_class; ci++) {
+        for (da_int cj = ci + 1; cj < n_class; cj++, k++) {
+            std::vector<da_int> rows;
+            for (da_int i = 0; i < n; i++)
+                if (y[i] == ci || y[i] == cj)
+                    rows.push_back(i);
+            da_int n_pair = (da_int)rows.size();
+            std::vector<TypeParam> X_pair(n_pair * p), y_pair(n_pair), dv_pair(n);
+            for (da_int l = 0; l < n_pair; l++) {
+                y_pair[l] = y[rows[l]] == ci ? TypeParam(1) : TypeParam(0);
+                for (da_int j = 0; j < p; j++)
+                    X_pair[l + j * n_pair] = X[rows[l] + j * n];
+            }
+            da_handle pair_handle = nullptr;
+            EXPECT_EQ(da_handle_init<TypeParam>(&pair_handle, da_handle_svm),
+                      da_status_success);
+            EXPECT_EQ(da_svm_select_model<TypeParam>(pair_handle, svc),
+                      da_status_success);
+            EXPECT_EQ(da_options_set(pair_handle, "gamma", (TypeParam)0.5),
+                      da_status_success);
+            EXPECT_EQ(da_svm_set_data(pair_handle, n_pair, p, X_pair.data(), n_pair,
+                                      y_pair.data()),
+                      da_status_success);
+            EXPECT_EQ(da_svm_compute<TypeParam>(pair_handle), da_status_success);
+            EXPECT_EQ(da_svm_decision_function(pair_handle, n, p, X.data(), n, ovo,
+                                               dv_pair.data(), n),
+                      da_status_success);
+            TypeParam *dv_ovo = decision_values.data() + k * n;
+            EXPECT_ARR_NEAR(n, dv_pair.data(), dv_ovo, tol);
+            da_handle_destroy(&pair_handle);
+            for (da_int i = 0; i < n; i++)
+                votes[i * n_class + (decision_values[k * n + i] > 0 ? ci : cj)]++;
+        }
+    }
+
+    // The predictions are the classes with the most votes, ties going to the lowest
+    for (da_int i = 0; i < n; i++) {
+        da_int best = 0;
+        for (da_int c = 1; c < n_class; c++)
+            if (votes[i * n_class + c] > votes[i * n_class + best])
+                best = c;
+        EXPECT_EQ(predictions[i], (TypeParam)best);
+    }
+
+    da_handle_destroy(&svm_handle);
+}
+
 TYPED_TEST(svm_public_test, invalid_input) {
 
     std::vector<TypeParam> X{0.0, 1.0, 0.0, 2.0};
@@ -846,17 +1198,17 @@ const svm_param_t svm_param_pos[] = {
     // CLASSIFICATION
     // SVC
     {"svc_binary_random_tall_rbf", "binary_random_tall", da_svm_model::svc, {}, {}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", -1.0f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", -1.0}}, 0.86},
-    {"svc_binary_random_tall_linear", "binary_random_tall", da_svm_model::svc, {}, {{"kernel", "linear"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}}, {{"tolerance", 1e-8}, {"C", 0.5}}, 0.8},
+    {"svc_binary_random_tall_linear", "binary_random_tall", da_svm_model::svc, {}, {{"kernel", "linear"}, {"solver", "smo"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}}, {{"tolerance", 1e-8}, {"C", 0.5}}, 0.8},
     {"svc_binary_random_tall_polynomial", "binary_random_tall", da_svm_model::svc, {{"degree", 2}}, {{"kernel", "poly"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", -1.0f}, {"coef0", 0.78f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", -1.0}, {"coef0", 0.78}}, 0.86},
     {"svc_binary_random_tall_sigmoid", "binary_random_tall", da_svm_model::svc, {}, {{"kernel", "sigmoid"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", -1.0f}, {"coef0", 0.78f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", -1.0}, {"coef0", 0.78}}, 0.73},
     
     {"svc_binary_random_wide_rbf", "binary_random_wide", da_svm_model::svc, {}, {{"kernel", "rbf"}}, {{"tolerance", 1e-4f}, {"C", 1.5f}, {"gamma", 0.5f}}, {{"tolerance", 1e-8}, {"C", 1.5}, {"gamma", 0.5}}, 0.416},
-    {"svc_binary_random_wide_linear", "binary_random_wide", da_svm_model::svc, {}, {{"kernel", "linear"}}, {{"tolerance", 1e-4f}, {"C", 1.5f}}, {{"tolerance", 1e-8}, {"C", 1.5}}, 0.416},
+    {"svc_binary_random_wide_linear", "binary_random_wide", da_svm_model::svc, {}, {{"kernel", "linear"}, {"solver", "smo"}}, {{"tolerance", 1e-4f}, {"C", 1.5f}}, {{"tolerance", 1e-8}, {"C", 1.5}}, 0.416},
     {"svc_binary_random_wide_polynomial", "binary_random_wide", da_svm_model::svc, {{"degree", 3}}, {{"kernel", "poly"}}, {{"tolerance", 1e-4f}, {"C", 1.5f}, {"gamma", 0.5f}, {"coef0", 1.78f}}, {{"tolerance", 1e-8}, {"C", 1.5}, {"gamma", 0.5}, {"coef0", 1.78}}, 0.33},
     {"svc_binary_random_wide_sigmoid", "binary_random_wide", da_svm_model::svc, {}, {{"kernel", "sigmoid"}}, {{"tolerance", 1e-4f}, {"C", 1.5f}, {"gamma", 0.5f}, {"coef0", 1.78f}}, {{"tolerance", 1e-8}, {"C", 1.5}, {"gamma", 0.5}, {"coef0", 1.78}}, 0.5},
     
     {"svc_multiclass_random_tall_rbf", "multiclass_random_tall", da_svm_model::svc, {}, {}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", 0.9f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", 0.9}}, 0.133},
-    {"svc_multiclass_random_tall_linear", "multiclass_random_tall", da_svm_model::svc, {}, {{"kernel", "linear"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}}, {{"tolerance", 1e-8}, {"C", 0.5}}, 0.533, 2},
+    {"svc_multiclass_random_tall_linear", "multiclass_random_tall", da_svm_model::svc, {}, {{"kernel", "linear"}, {"solver", "smo"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}}, {{"tolerance", 1e-8}, {"C", 0.5}}, 0.533, 2},
     {"svc_multiclass_random_tall_polynomial", "multiclass_random_tall", da_svm_model::svc, {{"degree", 2}}, {{"kernel", "poly"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", 0.9f}, {"coef0", 2.0f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", 0.9}, {"coef0", 2.0}}, 0.433},
     {"svc_multiclass_random_tall_sigmoid", "multiclass_random_tall", da_svm_model::svc, {}, {{"kernel", "sigmoid"}}, {{"tolerance", 1e-4f}, {"C", 0.5f}, {"gamma", 0.9f}, {"coef0", 2.0f}}, {{"tolerance", 1e-8}, {"C", 0.5}, {"gamma", 0.9}, {"coef0", 2.0}}, 0.4},
     
@@ -879,12 +1231,12 @@ const svm_param_t svm_param_pos[] = {
     // REGRESSION
     // SVR
     {"svr_regression_random_tall_rbf", "regression_random_tall", da_svm_model::svr, {}, {}, {{"tolerance", 1e-4f}, {"C", 10.0f}, {"epsilon", 0.3f}}, {{"tolerance", 1e-8}, {"C", 10.0}, {"epsilon", 0.3}}, 0.080},
-    {"svr_regression_random_tall_linear", "regression_random_tall", da_svm_model::svr, {}, {{"kernel", "linear"}}, {{"tolerance", 1e-4f}, {"C", 10.0f}, {"epsilon", 0.3f}}, {{"tolerance", 1e-8}, {"C", 10.0}, {"epsilon", 0.3}}, 0.999},
+    {"svr_regression_random_tall_linear", "regression_random_tall", da_svm_model::svr, {}, {{"kernel", "linear"}, {"solver", "smo"}}, {{"tolerance", 1e-4f}, {"C", 10.0f}, {"epsilon", 0.3f}}, {{"tolerance", 1e-8}, {"C", 10.0}, {"epsilon", 0.3}}, 0.999},
     {"svr_regression_random_tall_polynomial", "regression_random_tall", da_svm_model::svr, {{"degree", 2}}, {{"kernel", "poly"}}, {{"tolerance", 1e-4f}, {"C", 10.0f}, {"epsilon", 0.3f}, {"gamma", -1.0f}, {"coef0", 0.78f}}, {{"tolerance", 1e-8}, {"C", 10.0}, {"epsilon", 0.3}, {"gamma", -1.0}, {"coef0", 0.78}}, 0.487},
     {"svr_regression_random_tall_sigmoid", "regression_random_tall", da_svm_model::svr, {}, {{"kernel", "sigmoid"}}, {{"tolerance", 1e-4f}, {"C", 10.0f}, {"epsilon", 0.3f}, {"gamma", -1.0f}, {"coef0", 0.78f}}, {{"tolerance", 1e-8}, {"C", 10.0}, {"epsilon", 0.3}, {"gamma", -1.0}, {"coef0", 0.78}}, 0.21},
     
     {"svr_regression_random_wide_rbf", "regression_random_wide", da_svm_model::svr, {}, {{"kernel", "rbf"}}, {{"tolerance", 1e-4f}, {"C", 0.2f}, {"epsilon", 0.6f}, {"gamma", 2.0f}}, {{"tolerance", 1e-8}, {"C", 0.2}, {"epsilon", 0.6}, {"gamma", 2.0}}, -0.403},
-    {"svr_regression_random_wide_linear", "regression_random_wide", da_svm_model::svr, {}, {{"kernel", "linear"}}, {{"tolerance", 1e-4f}, {"C", 0.2f}, {"epsilon", 0.6f}}, {{"tolerance", 1e-8}, {"C", 0.2}, {"epsilon", 0.6}}, -0.395},
+    {"svr_regression_random_wide_linear", "regression_random_wide", da_svm_model::svr, {}, {{"kernel", "linear"}, {"solver", "smo"}}, {{"tolerance", 1e-4f}, {"C", 0.2f}, {"epsilon", 0.6f}}, {{"tolerance", 1e-8}, {"C", 0.2}, {"epsilon", 0.6}}, -0.395},
     {"svr_regression_random_wide_polynomial", "regression_random_wide", da_svm_model::svr, {{"degree", 2}}, {{"kernel", "poly"}}, {{"tolerance", 1e-4f}, {"C", 0.2f}, {"epsilon", 0.6f}, {"gamma", 2.0f}, {"coef0", 3.0f}}, {{"tolerance", 1e-8}, {"C", 0.2}, {"epsilon", 0.6}, {"gamma", 2.0}, {"coef0", 3.0}}, -0.475},
     {"svr_regression_random_wide_sigmoid", "regression_random_wide", da_svm_model::svr, {}, {{"kernel", "sigmoid"}}, {{"tolerance", 1e-4f}, {"C", 0.2f}, {"epsilon", 0.6f}, {"gamma", 2.0f}, {"coef0", 3.0f}}, {{"tolerance", 1e-8}, {"C", 0.2}, {"epsilon", 0.6}, {"gamma", 2.0}, {"coef0", 3.0}}, -0.407},
     